@@ -0,0 +1,179 @@
+/*
+ * Decodificador del canal binario de telemetría (/ws/telemetry)
+ * Formato: src/utils/TelemetryCodec.h (cuadros clave y deltas en punto fijo)
+ *
+ * Uso:
+ *   <script src="telemetry.js"></script>
+ *   connectTelemetry(function(sample) {
+ *       console.log(sample.alert, sample.temperature, sample.ch4Lel);
+ *   });
+ */
+(function(root) {
+    'use strict';
+
+    const KEYFRAME = 0x4B;
+    const DELTA = 0x44;
+    const INVALID = -32768;
+    const STATE_CHANGED = 0x8000;
+
+    // Mismo orden que TelemetryField: nombre, escala (valor = entero / escala + offset), offset
+    const FIELDS = [
+        ['temperature', 100, 0],
+        ['humidity', 100, 0],
+        ['pressure', 10, 1000],
+        ['smokePpm', 1, 0],
+        ['smokeRaw', 1, 0],
+        ['ch4Ppm', 1, 0],
+        ['ch4Lel', 100, 0],
+        ['ch4Raw', 1, 0],
+        ['fireProbability', 1000, 0],
+        ['tempRate', 100, 0],
+        ['pressureRate', 100, 0]
+    ];
+    const KEYFRAME_SIZE = 14 + 2 * FIELDS.length;
+
+    const ALERT_LEVELS = ['NORMAL', 'COOKING', 'ANOMALY', 'CAUTION', 'WARNING',
+                          'FIRE_SUSPECTED', 'FIRE_CONFIRMED', 'GAS_CRITICAL', 'EXPLOSIVE'];
+
+    function TelemetryDecoder() {
+        this.synced = false;
+        this.sequence = 0;
+        this.cycle = 0;
+        this.timestamp = 0;
+        this.state = 0;
+        this.values = new Int16Array(FIELDS.length);
+        this.gaps = 0;
+    }
+
+    /**
+     * Decodifica un cuadro
+     * @param buffer ArrayBuffer recibido
+     * @return Muestra en unidades físicas, o null si perdió la sincronía
+     *         (hay que pedir un cuadro clave enviando cualquier mensaje)
+     */
+    TelemetryDecoder.prototype.decode = function(buffer) {
+        const view = new DataView(buffer);
+        const size = view.byteLength;
+
+        if (size >= KEYFRAME_SIZE && view.getUint8(0) === KEYFRAME) {
+            this.sequence = view.getUint8(1);
+            this.cycle = view.getUint32(2, true);
+            this.timestamp = view.getUint32(6, true);
+            this.state = view.getUint32(10, true);
+            for (let i = 0; i < FIELDS.length; i++) {
+                this.values[i] = view.getInt16(14 + 2 * i, true);
+            }
+            this.synced = true;
+            return this.sample();
+        }
+
+        if (size < 7 || view.getUint8(0) !== DELTA) {
+            return null;
+        }
+        if (!this.synced || view.getUint8(1) !== ((this.sequence + 1) & 0xFF)) {
+            if (this.synced) {
+                this.gaps++;
+            }
+            this.synced = false;
+            return null;
+        }
+
+        const next = Int16Array.from(this.values);
+        const mask = view.getUint16(5, true);
+        let position = 7;
+        for (let i = 0; i < FIELDS.length; i++) {
+            if (!(mask & (1 << i))) {
+                continue;
+            }
+            let value = 0;
+            let shift = 0;
+            let byte;
+            do {
+                if (position >= size || shift > 28) {
+                    this.synced = false;
+                    return null;
+                }
+                byte = view.getUint8(position++);
+                value += (byte & 0x7F) * Math.pow(2, shift);
+                shift += 7;
+            } while (byte & 0x80);
+            const delta = value % 2 ? -(value + 1) / 2 : value / 2;   // zigzag
+            next[i] = next[i] + delta;
+        }
+        if (mask & STATE_CHANGED) {
+            if (position + 4 > size) {
+                this.synced = false;
+                return null;
+            }
+            this.state = view.getUint32(position, true);
+        }
+
+        this.values = next;
+        this.cycle = (this.cycle + view.getUint8(2)) >>> 0;
+        this.timestamp = (this.timestamp + view.getUint16(3, true)) >>> 0;
+        this.sequence = view.getUint8(1);
+        return this.sample();
+    };
+
+    /**
+     * Muestra actual en unidades físicas (null = lectura no válida)
+     */
+    TelemetryDecoder.prototype.sample = function() {
+        const state = this.state;
+        const sample = {
+            cycle: this.cycle,
+            timestamp: this.timestamp,
+            state: state,
+            alert: ALERT_LEVELS[state & 0x0F],
+            rawAlert: ALERT_LEVELS[(state >> 4) & 0x0F],
+            smokeState: (state >> 8) & 0x07,
+            ch4State: (state >> 11) & 0x07,
+            envState: (state >> 14) & 0x0F,
+            fast: !!(state & 0x00040000),
+            smokeReady: !!(state & 0x00080000),
+            ch4Ready: !!(state & 0x00100000),
+            envReady: !!(state & 0x00200000),
+            smokeRising: !!(state & 0x00400000),
+            ch4Rising: !!(state & 0x00800000),
+            smokeQualityOk: !(state & 0x01000000),
+            ch4QualityOk: !(state & 0x02000000),
+            envQualityOk: !(state & 0x04000000)
+        };
+        for (let i = 0; i < FIELDS.length; i++) {
+            const raw = this.values[i];
+            sample[FIELDS[i][0]] = raw === INVALID ? null : raw / FIELDS[i][1] + FIELDS[i][2];
+        }
+        return sample;
+    };
+
+    /**
+     * Abre el WebSocket y entrega cada muestra decodificada
+     * Pide un cuadro clave al perder la sincronía y reconecta si se cierra.
+     * @param onSample Función que recibe cada muestra
+     * @param url Opcional (por defecto ws://<host>/ws/telemetry)
+     */
+    function connectTelemetry(onSample, url) {
+        url = url || (location.protocol === 'https:' ? 'wss://' : 'ws://') + location.host + '/ws/telemetry';
+        const decoder = new TelemetryDecoder();
+        const socket = new WebSocket(url);
+        socket.binaryType = 'arraybuffer';
+        socket.onmessage = function(event) {
+            const sample = decoder.decode(event.data);
+            if (sample) {
+                onSample(sample);
+            } else {
+                socket.send('key');
+            }
+        };
+        socket.onclose = function() {
+            setTimeout(function() { connectTelemetry(onSample, url); }, 3000);
+        };
+        return socket;
+    }
+
+    root.TelemetryDecoder = TelemetryDecoder;
+    root.connectTelemetry = connectTelemetry;
+    if (typeof module !== 'undefined' && module.exports) {
+        module.exports = { TelemetryDecoder: TelemetryDecoder, connectTelemetry: connectTelemetry };
+    }
+})(typeof window !== 'undefined' ? window : this);
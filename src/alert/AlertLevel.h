@@ -0,0 +1,21 @@
+/*
+Nivel de alerta global (ordenado de menor a mayor gravedad)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef ALERTLEVEL_H
+#define ALERTLEVEL_H
+
+enum GlobalAlertLevel {
+    ALERT_NORMAL,           // Todo OK
+    ALERT_COOKING,          // Vapor de cocina (falsa alarma evitada)
+    ALERT_ANOMALY,          // Algo raro, monitorear
+    ALERT_CAUTION,          // Precaución, sensor activado
+    ALERT_WARNING,          // Advertencia, 2+ sensores
+    ALERT_FIRE_SUSPECTED,   // Incendio probable
+    ALERT_FIRE_CONFIRMED,   // Incendio confirmado
+    ALERT_GAS_CRITICAL,     // Gas crítico
+    ALERT_EXPLOSIVE,        // Nivel explosivo
+    ALERT_LEVEL_COUNT
+};
+
+#endif // ALERTLEVEL_H
@@ -0,0 +1,388 @@
+/*
+Motor de reglas de alerta (tabla de decisión sobre bits de características):
+
+Cada lectura se reduce a una máscara de características (estado de
+los gases, subida sostenida, temperatura, tendencia, humedad, presión,
+modelo de incendio)
+Cada regla: todas las de "all", ninguna de "none" y al menos "min" de "count"
+Gana la primera regla que coincide (orden de la tabla); si ninguna, NORMAL
+Evaluación sin saltos por regla: costo fijo según la cantidad de reglas
+Umbrales con histéresis: una característica activa se libera recién al
+cruzar el umbral más la banda de salida (evita rebotes en el borde)
+Reglas y umbrales configurables por texto (/alert_rules.txt)
+Sin dependencias de Arduino (compilable en host)
+
+Formato del archivo (una directiva por línea, # para comentarios):
+    threshold TEMP_HIGH 40 1.5      (umbral y banda de salida opcional)
+    rule WARNING count=SMOKE_DETECTED|CH4_DETECTED|TEMP_HIGH|PRESSURE_DROP min=3
+    rule COOKING all=SMOKE_DETECTED|HUMIDITY_HIGH none=TEMP_WARM|CH4_DETECTED
+Si el archivo define reglas, reemplazan por completo a las de fábrica.
+*/
+#ifndef ALERTRULES_H
+#define ALERTRULES_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AlertLevel.h"
+
+#define ALERT_MAX_RULES 16
+
+// Características (bit = índice)
+enum AlertFeature {
+    FEAT_SMOKE_DETECTED,        // Humo DETECTED o CRITICAL
+    FEAT_SMOKE_CRITICAL,        // Humo CRITICAL
+    FEAT_CH4_DETECTED,          // CH4 DETECTED, CRITICAL o EXPLOSIVE
+    FEAT_CH4_CRITICAL,          // CH4 CRITICAL o EXPLOSIVE
+    FEAT_CH4_EXPLOSIVE,         // CH4 EXPLOSIVE
+    FEAT_ENV_FIRE,              // Ambiente FIRE_SUSPECTED o RAPID_TEMP_RISE
+    FEAT_SMOKE_PPM_HIGH,        // PPM de humo > umbral
+    FEAT_TEMP_WARM,             // Temperatura >= umbral (descarta cocina)
+    FEAT_TEMP_HIGH,             // Temperatura > umbral (cuenta como sensor activo)
+    FEAT_TEMP_GAS_FIRE,         // Temperatura > umbral (gas + fuego)
+    FEAT_TEMP_FIRE,             // Temperatura > umbral (incendio temprano)
+    FEAT_TEMP_CRITICAL,         // Temperatura > umbral (incendio confirmado)
+    FEAT_TEMP_RISING,           // Tasa de temperatura > umbral
+    FEAT_HUMIDITY_HIGH,         // Humedad > umbral (vapor)
+    FEAT_PRESSURE_DROP,         // Delta de presión < umbral
+    FEAT_PRESSURE_DROP_SEVERE,  // Delta de presión < umbral (mayor)
+    FEAT_FIRE_PROBABLE,         // Probabilidad del modelo de incendio > umbral
+    FEAT_SMOKE_RISING,          // Humo en subida sostenida (CUSUM)
+    FEAT_CH4_RISING,            // CH4 en subida sostenida (CUSUM, fuga lenta)
+    FEAT_COUNT
+};
+
+#define FEAT(f) (1u << (f))
+
+// Magnitud comparada por cada característica numérica
+enum AlertSource {
+    SRC_STATE,                  // Derivada del estado (sin umbral)
+    SRC_SMOKE_PPM,
+    SRC_TEMPERATURE,
+    SRC_TEMP_RATE,
+    SRC_HUMIDITY,
+    SRC_PRESSURE_DELTA,
+    SRC_FIRE_PROBABILITY,
+    SRC_COUNT
+};
+
+enum AlertCompare {
+    CMP_NONE,
+    CMP_GT,
+    CMP_GE,
+    CMP_LT
+};
+
+struct AlertFeatureSpec {
+    const char* name;
+    uint8_t source;             // AlertSource
+    uint8_t compare;            // AlertCompare
+    float threshold;            // Valor por defecto (entrada)
+    float band;                 // Banda de salida por defecto
+};
+
+// Regla compilada
+struct AlertRule {
+    uint32_t all;               // Todas presentes
+    uint32_t none;              // Ninguna presente
+    uint32_t count;             // Se cuentan las presentes...
+    uint8_t minCount;           // ...y deben ser al menos minCount
+    uint8_t level;              // GlobalAlertLevel resultante
+};
+
+// Entradas de una evaluación: bits de estado + magnitudes numéricas
+struct AlertInputs {
+    uint32_t stateBits;         // FEAT_* derivadas del estado
+    float values[SRC_COUNT];    // Indexado por AlertSource
+};
+
+constexpr AlertFeatureSpec ALERT_FEATURES[FEAT_COUNT] = {
+    { "SMOKE_DETECTED",        SRC_STATE,          CMP_NONE, 0,    0 },
+    { "SMOKE_CRITICAL",        SRC_STATE,          CMP_NONE, 0,    0 },
+    { "CH4_DETECTED",          SRC_STATE,          CMP_NONE, 0,    0 },
+    { "CH4_CRITICAL",          SRC_STATE,          CMP_NONE, 0,    0 },
+    { "CH4_EXPLOSIVE",         SRC_STATE,          CMP_NONE, 0,    0 },
+    { "ENV_FIRE",              SRC_STATE,          CMP_NONE, 0,    0 },
+    { "SMOKE_PPM_HIGH",        SRC_SMOKE_PPM,      CMP_GT,   300,  30 },
+    { "TEMP_WARM",             SRC_TEMPERATURE,    CMP_GE,   35,   1.0f },
+    { "TEMP_HIGH",             SRC_TEMPERATURE,    CMP_GT,   40,   1.0f },
+    { "TEMP_GAS_FIRE",         SRC_TEMPERATURE,    CMP_GT,   45,   1.0f },
+    { "TEMP_FIRE",             SRC_TEMPERATURE,    CMP_GT,   50,   1.0f },
+    { "TEMP_CRITICAL",         SRC_TEMPERATURE,    CMP_GT,   60,   1.0f },
+    { "TEMP_RISING",           SRC_TEMP_RATE,      CMP_GT,   5,    1.0f },
+    { "HUMIDITY_HIGH",         SRC_HUMIDITY,       CMP_GT,   75,   3.0f },
+    { "PRESSURE_DROP",         SRC_PRESSURE_DELTA, CMP_LT,   -3,   0.5f },
+    { "PRESSURE_DROP_SEVERE",  SRC_PRESSURE_DELTA, CMP_LT,   -5,   0.5f },
+    { "FIRE_PROBABLE",         SRC_FIRE_PROBABILITY, CMP_GT, 0.8f, 0.1f },
+    { "SMOKE_RISING",          SRC_STATE,          CMP_NONE, 0,    0 },
+    { "CH4_RISING",            SRC_STATE,          CMP_NONE, 0,    0 }
+};
+
+// Sensores que cuentan como "activados" en los patrones 5 y 6
+#define ALERT_ACTIVE_SENSORS (FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_CH4_DETECTED) | \
+                              FEAT(FEAT_TEMP_HIGH) | FEAT(FEAT_PRESSURE_DROP))
+
+// Reglas de fábrica: la evaluación original en cadena de if más la regla
+// del modelo de incendio (sin efecto con probabilidad 0)
+constexpr AlertRule DEFAULT_ALERT_RULES[] = {
+    // PATRÓN 1: GAS + FUEGO = MÁXIMA PRIORIDAD
+    { FEAT(FEAT_CH4_EXPLOSIVE), 0, 0, 0, ALERT_EXPLOSIVE },
+    { FEAT(FEAT_CH4_CRITICAL), 0,
+      FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_TEMP_GAS_FIRE), 1, ALERT_GAS_CRITICAL },
+
+    // PATRÓN 2: INCENDIO CONFIRMADO
+    { FEAT(FEAT_SMOKE_CRITICAL) | FEAT(FEAT_TEMP_CRITICAL) | FEAT(FEAT_PRESSURE_DROP_SEVERE), 0, 0, 0,
+      ALERT_FIRE_CONFIRMED },
+
+    // PATRÓN 3: INCENDIO SOSPECHOSO/TEMPRANO (ambiente + humo)
+    { FEAT(FEAT_ENV_FIRE), 0,
+      FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_SMOKE_PPM_HIGH), 1, ALERT_FIRE_SUSPECTED },
+    { FEAT(FEAT_TEMP_FIRE) | FEAT(FEAT_TEMP_RISING), 0,
+      FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_SMOKE_PPM_HIGH), 1, ALERT_FIRE_SUSPECTED },
+    // Modelo entrenado (FireModel): ya combina humo, calor, humedad y presión
+    { FEAT(FEAT_FIRE_PROBABLE), 0, 0, 0, ALERT_FIRE_SUSPECTED },
+
+    // PATRÓN 4: COCINA/VAPOR (humo + humedad alta, sin calor ni gas)
+    { FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_HUMIDITY_HIGH),
+      FEAT(FEAT_TEMP_WARM) | FEAT(FEAT_CH4_DETECTED), 0, 0, ALERT_COOKING },
+
+    // PATRONES 5 y 6: SENSORES ACTIVADOS
+    { 0, 0, ALERT_ACTIVE_SENSORS, 3, ALERT_WARNING },
+    { 0, 0, ALERT_ACTIVE_SENSORS, 2, ALERT_CAUTION },
+    { 0, 0, ALERT_ACTIVE_SENSORS, 1, ALERT_ANOMALY },
+
+    // PATRÓN 7: SUBIDA SOSTENIDA BAJO LOS UMBRALES (fuga lenta)
+    { 0, 0, FEAT(FEAT_SMOKE_RISING) | FEAT(FEAT_CH4_RISING), 1, ALERT_ANOMALY }
+};
+
+// Nombres de los niveles (para el archivo de reglas)
+constexpr const char* ALERT_LEVEL_NAMES[ALERT_LEVEL_COUNT] = {
+    "NORMAL", "COOKING", "ANOMALY", "CAUTION", "WARNING",
+    "FIRE_SUSPECTED", "FIRE_CONFIRMED", "GAS_CRITICAL", "EXPLOSIVE"
+};
+
+class AlertRuleSet {
+private:
+    AlertRule rules[ALERT_MAX_RULES];
+    uint8_t ruleCount;
+    float thresholds[FEAT_COUNT];
+    float bands[FEAT_COUNT];
+
+    static int popcount(uint32_t value) {
+        return __builtin_popcount(value);
+    }
+
+    static int findName(const char* const* names, int count, const char* token, size_t length) {
+        for (int i = 0; i < count; i++) {
+            if (strlen(names[i]) == length && strncmp(names[i], token, length) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int findFeature(const char* token, size_t length) {
+        for (int i = 0; i < FEAT_COUNT; i++) {
+            if (strlen(ALERT_FEATURES[i].name) == length &&
+                strncmp(ALERT_FEATURES[i].name, token, length) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Convierte "A|B|C" en máscara
+     * @return false si algún nombre no existe
+     */
+    static bool parseMask(const char* text, size_t length, uint32_t& mask) {
+        mask = 0;
+        size_t start = 0;
+        for (size_t i = 0; i <= length; i++) {
+            if (i == length || text[i] == '|') {
+                int feature = findFeature(text + start, i - start);
+                if (feature < 0) {
+                    return false;
+                }
+                mask |= FEAT(feature);
+                start = i + 1;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Siguiente palabra separada por espacios
+     * @return Longitud (0 al final de la línea)
+     */
+    static size_t nextToken(const char*& cursor, const char*& token) {
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        token = cursor;
+        while (*cursor && *cursor != ' ' && *cursor != '\t' && *cursor != '\r' && *cursor != '\n') cursor++;
+        return cursor - token;
+    }
+
+public:
+    AlertRuleSet() {
+        loadDefaults();
+    }
+
+    /**
+     * Restaura reglas y umbrales de fábrica
+     */
+    void loadDefaults() {
+        ruleCount = sizeof(DEFAULT_ALERT_RULES) / sizeof(DEFAULT_ALERT_RULES[0]);
+        for (uint8_t i = 0; i < ruleCount; i++) {
+            rules[i] = DEFAULT_ALERT_RULES[i];
+        }
+        for (int i = 0; i < FEAT_COUNT; i++) {
+            thresholds[i] = ALERT_FEATURES[i].threshold;
+            bands[i] = ALERT_FEATURES[i].band;
+        }
+    }
+
+    /**
+     * Vacía la tabla de reglas (los umbrales se conservan)
+     */
+    void clearRules() {
+        ruleCount = 0;
+    }
+
+    /**
+     * Agrega una regla al final de la tabla
+     * @return false si la tabla está llena
+     */
+    bool addRule(const AlertRule& rule) {
+        if (ruleCount >= ALERT_MAX_RULES) {
+            return false;
+        }
+        rules[ruleCount++] = rule;
+        return true;
+    }
+
+    /**
+     * Interpreta una línea del archivo de reglas
+     * @param line Línea (sin requerir terminador de línea)
+     * @param rule Regla resultante si la línea es "rule ..."
+     * @return 1 si es una regla, 0 si es umbral/comentario/vacía, -1 si es inválida
+     */
+    int parseLine(const char* line, AlertRule& rule) {
+        const char* cursor = line;
+        const char* token;
+        size_t length = nextToken(cursor, token);
+
+        if (length == 0 || token[0] == '#') {
+            return 0;
+        }
+
+        if (length == 9 && strncmp(token, "threshold", 9) == 0) {
+            length = nextToken(cursor, token);
+            int feature = findFeature(token, length);
+            if (feature < 0 || ALERT_FEATURES[feature].compare == CMP_NONE) {
+                return -1;
+            }
+            length = nextToken(cursor, token);
+            if (length == 0) {
+                return -1;
+            }
+            thresholds[feature] = strtof(token, nullptr);
+            length = nextToken(cursor, token);
+            if (length > 0) {
+                bands[feature] = strtof(token, nullptr);
+            }
+            return 0;
+        }
+
+        if (length != 4 || strncmp(token, "rule", 4) != 0) {
+            return -1;
+        }
+
+        length = nextToken(cursor, token);
+        int level = findName(ALERT_LEVEL_NAMES, ALERT_LEVEL_COUNT, token, length);
+        if (level < 0) {
+            return -1;
+        }
+
+        rule = AlertRule{ 0, 0, 0, 0, (uint8_t)level };
+        while ((length = nextToken(cursor, token)) > 0) {
+            const char* eq = (const char*)memchr(token, '=', length);
+            if (eq == nullptr) {
+                return -1;
+            }
+            size_t keyLength = eq - token;
+            const char* value = eq + 1;
+            size_t valueLength = length - keyLength - 1;
+
+            if (keyLength == 3 && strncmp(token, "all", 3) == 0) {
+                if (!parseMask(value, valueLength, rule.all)) return -1;
+            } else if (keyLength == 4 && strncmp(token, "none", 4) == 0) {
+                if (!parseMask(value, valueLength, rule.none)) return -1;
+            } else if (keyLength == 5 && strncmp(token, "count", 5) == 0) {
+                if (!parseMask(value, valueLength, rule.count)) return -1;
+            } else if (keyLength == 3 && strncmp(token, "min", 3) == 0) {
+                rule.minCount = (uint8_t)atoi(value);
+            } else {
+                return -1;
+            }
+        }
+
+        return 1;
+    }
+
+    /**
+     * Reduce las entradas a la máscara de características
+     * @param inputs Estados y magnitudes de la lectura
+     * @param previous Máscara de la muestra anterior (para la histéresis)
+     */
+    uint32_t extract(const AlertInputs& inputs, uint32_t previous = 0) const {
+        uint32_t features = inputs.stateBits;
+        for (int i = 0; i < FEAT_COUNT; i++) {
+            const AlertFeatureSpec& spec = ALERT_FEATURES[i];
+            float value = inputs.values[spec.source];
+
+            // Activa: el umbral se desplaza la banda en el sentido de salida
+            float band = ((previous >> i) & 1) ? bands[i] : 0.0f;
+            float high = thresholds[i] - band;
+            float low = thresholds[i] + band;
+
+            bool set = (spec.compare == CMP_GT && value > high) |
+                       (spec.compare == CMP_GE && value >= high) |
+                       (spec.compare == CMP_LT && value < low);
+            features |= (uint32_t)set << i;
+        }
+        return features;
+    }
+
+    /**
+     * Evalúa la tabla (primera regla que coincide)
+     * Recorre todas las reglas de atrás hacia adelante sin cortar:
+     * la última asignación es la de la primera coincidencia.
+     * @param features Máscara de características
+     * @return GlobalAlertLevel
+     */
+    uint8_t evaluate(uint32_t features) const {
+        uint8_t level = ALERT_NORMAL;
+        for (int i = ruleCount - 1; i >= 0; i--) {
+            const AlertRule& rule = rules[i];
+            bool match = ((features & rule.all) == rule.all) &
+                         ((features & rule.none) == 0) &
+                         (popcount(features & rule.count) >= rule.minCount);
+            level = match ? rule.level : level;
+        }
+        return level;
+    }
+
+    uint8_t getRuleCount() const {
+        return ruleCount;
+    }
+
+    float getThreshold(int feature) const {
+        return thresholds[feature];
+    }
+
+    float getBand(int feature) const {
+        return bands[feature];
+    }
+};
+
+#endif // ALERTRULES_H
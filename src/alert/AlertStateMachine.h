@@ -0,0 +1,157 @@
+/*
+Máquina de estados del nivel de alerta (antirrebote):
+
+Subida inmediata: un nivel más grave se publica en la misma muestra
+Bajada con retardo: N muestras consecutivas por debajo del nivel actual
+y un tiempo mínimo desde la última muestra que confirmó el nivel
+Al bajar se va al nivel más alto visto durante la espera (no de golpe a NORMAL)
+Contadores de transiciones y de muestras retenidas
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef ALERTSTATEMACHINE_H
+#define ALERTSTATEMACHINE_H
+
+#include <stdint.h>
+#include "AlertLevel.h"
+
+class AlertStateMachine {
+private:
+    GlobalAlertLevel level;         // Nivel publicado
+    GlobalAlertLevel pending;       // Mejor candidato para bajar
+    uint8_t pendingCount;           // Muestras consecutivas por debajo
+    uint8_t exitSamples;
+    uint32_t enteredAt;             // Momento de entrada al nivel actual
+    uint32_t confirmedAt;           // Última muestra igual o más grave
+    uint32_t dwellMs[ALERT_LEVEL_COUNT];
+
+    uint32_t escalations;
+    uint32_t deescalations;
+    uint32_t held;                  // Muestras más bajas retenidas
+    uint32_t entries[ALERT_LEVEL_COUNT];
+
+    void enter(GlobalAlertLevel next, uint32_t now) {
+        level = next;
+        enteredAt = now;
+        confirmedAt = now;
+        pendingCount = 0;
+        entries[next]++;
+    }
+
+public:
+    /**
+     * @param exitSampleCount Muestras consecutivas por debajo para bajar
+     * @param dwellTimeMs Permanencia mínima en niveles de precaución
+     *                    (contada desde la última confirmación del nivel)
+     * @param criticalDwellTimeMs Permanencia mínima desde FIRE_SUSPECTED hacia arriba
+     */
+    AlertStateMachine(uint8_t exitSampleCount, uint32_t dwellTimeMs, uint32_t criticalDwellTimeMs)
+        : level(ALERT_NORMAL),
+          pending(ALERT_NORMAL),
+          pendingCount(0),
+          exitSamples(exitSampleCount > 0 ? exitSampleCount : 1),
+          enteredAt(0),
+          confirmedAt(0),
+          escalations(0),
+          deescalations(0),
+          held(0) {
+        for (int i = 0; i < ALERT_LEVEL_COUNT; i++) {
+            dwellMs[i] = (i >= ALERT_FIRE_SUSPECTED) ? criticalDwellTimeMs : dwellTimeMs;
+            entries[i] = 0;
+        }
+        dwellMs[ALERT_NORMAL] = 0;
+    }
+
+    /**
+     * Procesa el nivel evaluado en una muestra
+     * @param evaluated Nivel calculado por SmartAlert
+     * @param now Tiempo actual (ms)
+     * @return true si el nivel publicado cambió
+     */
+    bool update(GlobalAlertLevel evaluated, uint32_t now) {
+        if (evaluated > level) {
+            enter(evaluated, now);
+            escalations++;
+            return true;
+        }
+
+        if (evaluated == level) {
+            confirmedAt = now;
+            pendingCount = 0;
+            return false;
+        }
+
+        // Por debajo: acumular y recordar el nivel más alto de la racha
+        pending = (pendingCount == 0 || evaluated > pending) ? evaluated : pending;
+        if (pendingCount < 0xFF) {
+            pendingCount++;
+        }
+
+        if (pendingCount >= exitSamples && (now - confirmedAt) >= dwellMs[level]) {
+            enter(pending, now);
+            deescalations++;
+            return true;
+        }
+
+        held++;
+        return false;
+    }
+
+    /**
+     * Cambia la permanencia mínima de un nivel
+     */
+    void setDwell(GlobalAlertLevel target, uint32_t ms) {
+        dwellMs[target] = ms;
+    }
+
+    /**
+     * Vuelve a NORMAL sin esperar (p. ej. tras recalibrar)
+     */
+    void reset(uint32_t now) {
+        level = ALERT_NORMAL;
+        enteredAt = now;
+        confirmedAt = now;
+        pendingCount = 0;
+    }
+
+    GlobalAlertLevel getLevel() const {
+        return level;
+    }
+
+    /**
+     * Tiempo en el nivel actual (ms)
+     */
+    uint32_t getTimeInLevel(uint32_t now) const {
+        return now - enteredAt;
+    }
+
+    uint32_t getEscalations() const {
+        return escalations;
+    }
+
+    uint32_t getDeescalations() const {
+        return deescalations;
+    }
+
+    /**
+     * Total de cambios de nivel publicados
+     */
+    uint32_t getTransitions() const {
+        return escalations + deescalations;
+    }
+
+    /**
+     * Muestras en las que un nivel más bajo se retuvo
+     */
+    uint32_t getHeld() const {
+        return held;
+    }
+
+    /**
+     * Veces que se entró a un nivel
+     */
+    uint32_t getEntries(GlobalAlertLevel target) const {
+        return entries[target];
+    }
+};
+
+#endif // ALERTSTATEMACHINE_H
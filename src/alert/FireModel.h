@@ -0,0 +1,115 @@
+/*
+Modelo de probabilidad de incendio (regresión logística en punto fijo):
+
+Variables: delta y pendiente de temperatura, delta de humedad, delta de
+presión, porcentaje de humo y de CH4 (todas mantenidas incrementalmente
+por los sensores)
+logit = bias + suma(peso * variable) en enteros (Q4 × Q12 → Q16)
+Sigmoide por tabla de 257 puntos con interpolación lineal
+Tiempo constante, sin flotantes en el cálculo
+Pesos generados por tools/train_fire_model.py (FireModelWeights.h)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef FIREMODEL_H
+#define FIREMODEL_H
+
+#include <stdint.h>
+#include <math.h>
+#include "FireModelWeights.h"
+
+#define FIRE_LOGIT_SHIFT (FIRE_MODEL_INPUT_SHIFT + FIRE_MODEL_WEIGHT_SHIFT)
+#define FIRE_SIGMOID_RANGE 8            // Tabla para logit en [-8, 8]
+#define FIRE_SIGMOID_STEPS_BITS 4       // 16 puntos por unidad de logit
+#define FIRE_SIGMOID_SIZE (2 * FIRE_SIGMOID_RANGE << FIRE_SIGMOID_STEPS_BITS)
+
+// Índices de las variables (mismo orden que el entrenamiento)
+enum FireFeature {
+    FIRE_TEMP_DELTA,        // °C sobre el baseline
+    FIRE_TEMP_RATE,         // °C/min
+    FIRE_HUMIDITY_DELTA,    // % sobre el baseline (negativo = aire más seco)
+    FIRE_PRESSURE_DELTA,    // hPa sobre el baseline
+    FIRE_SMOKE_PERCENT,     // 0-100
+    FIRE_CH4_PERCENT,       // 0-100
+    FIRE_FEATURE_COUNT
+};
+
+static_assert(FIRE_FEATURE_COUNT == FIRE_MODEL_FEATURES,
+              "FireModel: FireModelWeights.h no coincide con las variables del modelo");
+
+class FireModel {
+private:
+    uint16_t sigmoid[FIRE_SIGMOID_SIZE + 1];    // Probabilidad Q16 (saturada a 65535)
+
+public:
+    FireModel() {
+        for (int i = 0; i <= FIRE_SIGMOID_SIZE; i++) {
+            float logit = (float)(i - FIRE_SIGMOID_SIZE / 2) / (1 << FIRE_SIGMOID_STEPS_BITS);
+            float p = 65536.0f / (1.0f + expf(-logit));
+            sigmoid[i] = p >= 65535.0f ? 65535 : (uint16_t)(p + 0.5f);
+        }
+    }
+
+    /**
+     * Convierte una variable a Q4 recortada a su rango
+     * NaN (lectura inválida) cuenta como 0: sin aporte al logit
+     * @param feature Índice (FireFeature)
+     * @param value Valor en unidades nativas
+     */
+    static int32_t toFixed(int feature, float value) {
+        if (!(value == value)) {
+            value = 0;
+        }
+        float limit = FIRE_MODEL_LIMITS[feature];
+        value = value > limit ? limit : (value < -limit ? -limit : value);
+        float scaled = value * (1 << FIRE_MODEL_INPUT_SHIFT);
+        return (int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+    }
+
+    /**
+     * Logit del modelo
+     * @param inputs Variables en Q4 (ver toFixed)
+     * @return Logit en Q16
+     */
+    static int32_t logit(const int32_t inputs[FIRE_FEATURE_COUNT]) {
+        int32_t acc = FIRE_MODEL_BIAS;
+        for (int i = 0; i < FIRE_FEATURE_COUNT; i++) {
+            acc += FIRE_MODEL_WEIGHTS[i] * inputs[i];
+        }
+        return acc;
+    }
+
+    /**
+     * Probabilidad a partir del logit
+     * @param logitQ16 Logit en Q16
+     * @return Probabilidad Q16 (0 - 65535)
+     */
+    uint16_t probabilityFromLogit(int32_t logitQ16) const {
+        const int32_t range = (int32_t)FIRE_SIGMOID_RANGE << FIRE_LOGIT_SHIFT;
+        const int fracBits = FIRE_LOGIT_SHIFT - FIRE_SIGMOID_STEPS_BITS;
+
+        if (logitQ16 <= -range) return sigmoid[0];
+        if (logitQ16 >= range) return sigmoid[FIRE_SIGMOID_SIZE];
+
+        uint32_t offset = (uint32_t)(logitQ16 + range);
+        uint32_t index = offset >> fracBits;
+        uint32_t frac = offset & ((1u << fracBits) - 1);
+        int32_t a = sigmoid[index];
+        int32_t b = sigmoid[index + 1];
+        return (uint16_t)(a + (((b - a) * (int32_t)frac) >> fracBits));
+    }
+
+    /**
+     * Probabilidad de incendio
+     * @param features Variables en unidades nativas (FireFeature)
+     * @return 0.0 - 1.0
+     */
+    float probability(const float features[FIRE_FEATURE_COUNT]) const {
+        int32_t inputs[FIRE_FEATURE_COUNT];
+        for (int i = 0; i < FIRE_FEATURE_COUNT; i++) {
+            inputs[i] = toFixed(i, features[i]);
+        }
+        return probabilityFromLogit(logit(inputs)) / 65536.0f;
+    }
+};
+
+#endif // FIREMODEL_H
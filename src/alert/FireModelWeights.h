@@ -0,0 +1,32 @@
+/*
+Pesos del modelo de probabilidad de incendio (generado, no editar)
+
+Generado por tools/train_fire_model.py
+Datos: escenarios simulados (--synthetic 20000 --seed 1)
+Muestras: 20000 (5302 incendio)
+Entrenamiento: log-loss 0.1311, exactitud 97.2% (punto fijo)
+logit = bias + sum(peso * variable), variables recortadas a +-LIMITS
+*/
+#ifndef FIREMODELWEIGHTS_H
+#define FIREMODELWEIGHTS_H
+
+#include <stdint.h>
+
+#define FIRE_MODEL_FEATURES 6
+#define FIRE_MODEL_INPUT_SHIFT 4      // Variables en Q4
+#define FIRE_MODEL_WEIGHT_SHIFT 12    // Pesos en Q12 (logit en Q16)
+
+// Orden: temp_delta, temp_rate, humidity_delta, pressure_delta, smoke_pct, ch4_pct
+constexpr float FIRE_MODEL_LIMITS[FIRE_MODEL_FEATURES] = { 60.0f, 30.0f, 100.0f, 30.0f, 100.0f, 100.0f };
+
+constexpr int32_t FIRE_MODEL_BIAS = -320953;   // -4.8974
+constexpr int32_t FIRE_MODEL_WEIGHTS[FIRE_MODEL_FEATURES] = {
+          72,     // temp_delta      0.01754
+        1028,     // temp_rate       0.25091
+        -563,     // humidity_delta  -0.13748
+       -1475,     // pressure_delta  -0.36015
+         429,     // smoke_pct       0.10470
+          23,     // ch4_pct         0.00568
+};
+
+#endif // FIREMODELWEIGHTS_H
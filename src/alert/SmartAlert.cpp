@@ -0,0 +1,149 @@
+#include "SmartAlert.h"
+#include "../storage/FileManager.h"
+
+// Reglas de fábrica hasta que loadRules() cargue el archivo
+AlertRuleSet SmartAlert::rules;
+FireModel SmartAlert::fireModel;
+
+bool SmartAlert::loadRules(const char* path) {
+    FileManager* fileManager = FileManager::getInstance();
+    if (!fileManager->exists(path)) {
+        if (DEBUG_SERIAL) {
+            Serial.printf("✓ Alertas: %d reglas de fábrica\n", rules.getRuleCount());
+        }
+        return false;
+    }
+
+    String content = fileManager->readFile(path);
+
+    // Compilar sobre una copia: si algo falla, las reglas actuales no cambian
+    AlertRuleSet compiled;
+    compiled.clearRules();
+    int lineNumber = 0;
+    int ruleLines = 0;
+    int start = 0;
+
+    while (start <= (int)content.length()) {
+        int end = content.indexOf('\n', start);
+        if (end < 0) {
+            end = content.length();
+        }
+        String line = content.substring(start, end);
+        start = end + 1;
+        lineNumber++;
+
+        AlertRule rule;
+        int result = compiled.parseLine(line.c_str(), rule);
+        if (result == 1 && !compiled.addRule(rule)) {
+            result = -1;
+        }
+        if (result < 0) {
+            if (DEBUG_SERIAL) {
+                Serial.printf("❌ %s línea %d inválida: %s\n", path, lineNumber, line.c_str());
+            }
+            return false;
+        }
+        ruleLines += result;
+    }
+
+    // Solo umbrales: se conservan las reglas de fábrica
+    if (ruleLines == 0) {
+        for (const AlertRule& rule : DEFAULT_ALERT_RULES) {
+            compiled.addRule(rule);
+        }
+    }
+
+    rules = compiled;
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Alertas: %d reglas (%s)\n", rules.getRuleCount(), path);
+    }
+    return true;
+}
+
+float SmartAlert::fireProbability(const SmokeReading& smoke,
+                                  const CH4Reading& ch4,
+                                  const EnvironmentReading& env) {
+    // Valor retenido de un sensor caído: cuenta como sensor ausente
+    bool temperatureOk = !(env.temperatureQuality & QUALITY_HELD);
+    bool pressureOk = !(env.pressureQuality & QUALITY_HELD);
+
+    float features[FIRE_FEATURE_COUNT];
+    features[FIRE_TEMP_DELTA] = temperatureOk ? env.tempDelta : 0;
+    features[FIRE_TEMP_RATE] = temperatureOk ? env.tempRate : 0;
+    features[FIRE_HUMIDITY_DELTA] = temperatureOk ? env.humidityDelta : 0;
+    features[FIRE_PRESSURE_DELTA] = pressureOk ? env.pressureDelta : 0;
+    features[FIRE_SMOKE_PERCENT] = smoke.percentage;
+    features[FIRE_CH4_PERCENT] = ch4.percentage;
+    return fireModel.probability(features);
+}
+
+uint32_t SmartAlert::extractFeatures(const SmokeReading& smoke,
+                                     const CH4Reading& ch4,
+                                     const EnvironmentReading& env,
+                                     float fireProbability,
+                                     uint32_t previous) {
+    AlertInputs inputs;
+
+    // Estados derivados de las lecturas
+    bool smokeDetected = (smoke.state == SmokeState::DETECTED ||
+                          smoke.state == SmokeState::CRITICAL);
+    bool smokeCritical = (smoke.state == SmokeState::CRITICAL);
+    bool ch4Detected = (ch4.state == CH4State::DETECTED ||
+                        ch4.state == CH4State::CRITICAL ||
+                        ch4.state == CH4State::EXPLOSIVE);
+    bool ch4Critical = (ch4.state == CH4State::CRITICAL ||
+                        ch4.state == CH4State::EXPLOSIVE);
+    bool ch4Explosive = (ch4.state == CH4State::EXPLOSIVE);
+    bool fireSuspected = (env.state == EnvironmentState::FIRE_SUSPECTED ||
+                          env.state == EnvironmentState::RAPID_TEMP_RISE);
+
+    inputs.stateBits = ((uint32_t)smokeDetected << FEAT_SMOKE_DETECTED) |
+                       ((uint32_t)smokeCritical << FEAT_SMOKE_CRITICAL) |
+                       ((uint32_t)ch4Detected << FEAT_CH4_DETECTED) |
+                       ((uint32_t)ch4Critical << FEAT_CH4_CRITICAL) |
+                       ((uint32_t)ch4Explosive << FEAT_CH4_EXPLOSIVE) |
+                       ((uint32_t)fireSuspected << FEAT_ENV_FIRE) |
+                       ((uint32_t)smoke.rising << FEAT_SMOKE_RISING) |
+                       ((uint32_t)ch4.rising << FEAT_CH4_RISING);
+
+    // Valor retenido de un sensor caído: cuenta como sensor ausente (0 no
+    // cumple ninguna condición ambiental)
+    bool temperatureOk = !(env.temperatureQuality & QUALITY_HELD);
+    bool pressureOk = !(env.pressureQuality & QUALITY_HELD);
+
+    inputs.values[SRC_STATE] = 0;
+    inputs.values[SRC_SMOKE_PPM] = smoke.ppm;
+    inputs.values[SRC_TEMPERATURE] = temperatureOk ? env.temperature : 0;
+    inputs.values[SRC_TEMP_RATE] = temperatureOk ? env.tempRate : 0;
+    inputs.values[SRC_HUMIDITY] = temperatureOk ? env.humidity : 0;
+    inputs.values[SRC_PRESSURE_DELTA] = pressureOk ? env.pressureDelta : 0;
+    inputs.values[SRC_FIRE_PROBABILITY] = fireProbability;
+
+    return rules.extract(inputs, previous);
+}
+
+GlobalAlertLevel SmartAlert::evaluate(uint32_t features) {
+    return (GlobalAlertLevel)rules.evaluate(features);
+}
+
+GlobalAlertLevel SmartAlert::evaluate(const SmokeReading& smoke,
+                                      const CH4Reading& ch4,
+                                      const EnvironmentReading& env) {
+    return evaluate(extractFeatures(smoke, ch4, env, fireProbability(smoke, ch4, env)));
+}
+
+const char* SmartAlert::getLevelName(GlobalAlertLevel level) {
+    switch (level) {
+        case ALERT_NORMAL:          return "NORMAL";
+        case ALERT_COOKING:         return "COOKING";
+        case ALERT_ANOMALY:         return "ANOMALY";
+        case ALERT_CAUTION:         return "CAUTION";
+        case ALERT_WARNING:         return "WARNING";
+        case ALERT_FIRE_SUSPECTED:  return "FIRE_SUSPECTED";
+        case ALERT_FIRE_CONFIRMED:  return "FIRE_CONFIRMED";
+        case ALERT_GAS_CRITICAL:    return "GAS_CRITICAL";
+        case ALERT_EXPLOSIVE:       return "EXPLOSIVE";
+        default:                    return "UNKNOWN";
+    }
+}
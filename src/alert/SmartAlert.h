@@ -0,0 +1,82 @@
+/*
+Evaluación inteligente de alertas (fusión multi-sensor):
+
+Nivel de alerta global
+Patrones: gas + fuego, incendio confirmado/sospechoso, cocina/vapor,
+conteo de sensores activados, subida sostenida de gases (fuga lenta)
+Patrones expresados como tabla de reglas (AlertRules.h), ajustables
+por instalación desde /alert_rules.txt sin recompilar
+Probabilidad de incendio por modelo entrenado (FireModel.h): por encima
+del umbral FIRE_PROBABLE la regla de fábrica publica FIRE_SUSPECTED
+Función pura sobre las lecturas (no consulta los singletons)
+*/
+#ifndef SMARTALERT_H
+#define SMARTALERT_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+#include "../sensors/SmokeSensor.h"
+#include "../sensors/CH4Sensor.h"
+#include "../sensors/EnvironmentSensor.h"
+#include "AlertLevel.h"
+#include "AlertRules.h"
+#include "FireModel.h"
+
+
+class SmartAlert {
+private:
+    static AlertRuleSet rules;
+    static FireModel fireModel;
+
+public:
+    /**
+     * Carga reglas y umbrales desde LittleFS (si el archivo existe)
+     * Llamar antes de iniciar la tarea de sensores.
+     * Ante cualquier línea inválida se conservan las reglas de fábrica.
+     * @param path Ruta del archivo de reglas
+     * @return true si se usan las reglas del archivo
+     */
+    static bool loadRules(const char* path = ALERT_RULES_FILE_PATH);
+
+    /**
+     * Probabilidad de incendio según el modelo entrenado
+     * @return 0.0 - 1.0
+     */
+    static float fireProbability(const SmokeReading& smoke,
+                                 const CH4Reading& ch4,
+                                 const EnvironmentReading& env);
+
+    /**
+     * Reduce las lecturas a la máscara de características (FEAT_*)
+     * @param fireProbability Resultado de fireProbability() para estas lecturas
+     * @param previous Máscara de la muestra anterior (histéresis de umbrales)
+     */
+    static uint32_t extractFeatures(const SmokeReading& smoke,
+                                    const CH4Reading& ch4,
+                                    const EnvironmentReading& env,
+                                    float fireProbability,
+                                    uint32_t previous = 0);
+
+    /**
+     * Evalúa la tabla de reglas sobre una máscara ya extraída
+     */
+    static GlobalAlertLevel evaluate(uint32_t features);
+
+    /**
+     * Evaluación inteligente con múltiples sensores
+     * @param smoke Lectura del sensor de humo
+     * @param ch4 Lectura del sensor de metano
+     * @param env Lectura ambiental
+     * @return Nivel de alerta global
+     */
+    static GlobalAlertLevel evaluate(const SmokeReading& smoke,
+                                     const CH4Reading& ch4,
+                                     const EnvironmentReading& env);
+
+    /**
+     * Obtiene el nombre corto del nivel ("NORMAL", "FIRE_SUSPECTED", ...)
+     */
+    static const char* getLevelName(GlobalAlertLevel level);
+};
+
+#endif // SMARTALERT_H
@@ -0,0 +1,322 @@
+#include "AlertBenchmark.h"
+#include <LittleFS.h>
+#include "../sensors/AdcSampler.h"
+#include "../sensors/SmokeSensor.h"
+#include "../sensors/CH4Sensor.h"
+#include "../sensors/EnvironmentSensor.h"
+#include "../tasks/SensorTask.h"
+#include "../alert/SmartAlert.h"
+#include "../utils/Clock.h"
+
+// Periodos de lectura en reposo a comparar
+// (hasta ADC_RING_SIZE / ADC_SAMPLE_RATE_HZ s: con más se perderían muestras)
+static const uint32_t READ_INTERVALS[] = { 1000, 2500, 5000 };
+
+// Instante virtual de inicio de cada ejecución
+#define BENCH_EPOCH_MS 1000000UL
+
+// Calibración de ejemplo del datasheet del BMP280 (la traducción a crudo y
+// la compensación usan la misma, así que solo importa que sea válida)
+static const BMP280Calibration BENCH_BMP_CALIBRATION = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+/**
+ * Valor crudo del BMP280 que compensa a la temperatura pedida (búsqueda binaria)
+ */
+static int32_t bmpTemperatureRaw(float celsius, int32_t& tFine) {
+    int32_t target = (int32_t)lroundf(celsius * 100.0f);
+    int32_t low = 0;
+    int32_t high = (1 << 20) - 1;
+
+    while (low < high) {
+        int32_t mid = (low + high) / 2;
+        if (BMP280Driver::compensateTemperature(BENCH_BMP_CALIBRATION, mid, tFine) < target) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    BMP280Driver::compensateTemperature(BENCH_BMP_CALIBRATION, low, tFine);
+    return low;
+}
+
+/**
+ * Valor crudo del BMP280 que compensa a la presión pedida (decrece con adcP)
+ */
+static int32_t bmpPressureRaw(float hPa, int32_t tFine) {
+    uint32_t target = (uint32_t)(hPa * 100.0f * 256.0f);
+    int32_t low = 0;
+    int32_t high = (1 << 20) - 1;
+
+    while (low < high) {
+        int32_t mid = (low + high) / 2;
+        if (BMP280Driver::compensatePressure(BENCH_BMP_CALIBRATION, mid, tFine) > target) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Lectura cruda de AHT20 + BMP280 para el instante t del escenario
+ */
+static EnvironmentRaw environmentRaw(const BenchScenario& scenario, int32_t t) {
+    float temperature = scenario.signals[BENCH_TEMPERATURE].at(t, BENCH_REST[BENCH_TEMPERATURE]);
+    float humidity = scenario.signals[BENCH_HUMIDITY].at(t, BENCH_REST[BENCH_HUMIDITY]);
+    float pressure = scenario.signals[BENCH_PRESSURE].at(t, BENCH_REST[BENCH_PRESSURE]);
+
+    EnvironmentRaw raw;
+    raw.ahtFresh = true;
+    raw.bmpFresh = true;
+    raw.ahtHumidity = (uint32_t)constrain(humidity * (1048576.0f / 100.0f), 0.0f, 1048575.0f);
+    raw.ahtTemperature = (uint32_t)constrain((temperature + 50.0f) * (1048576.0f / 200.0f), 0.0f, 1048575.0f);
+
+    int32_t tFine;
+    raw.bmpTemperature = bmpTemperatureRaw(temperature, tFine);
+    raw.bmpPressure = bmpPressureRaw(pressure, tFine);
+    return raw;
+}
+
+void AlertBenchmark::onAlertTransition(const Event& event, void* context) {
+    BenchRun* run = static_cast<BenchRun*>(context);
+    long elapsed = (long)(event.timestamp - run->onsetMs);
+
+    if (elapsed < 0) {
+        run->prerollAlerts++;
+        return;
+    }
+
+    GlobalAlertLevel level = event.alert.to;
+    if (run->latencyMs[level] < 0) {
+        run->latencyMs[level] = elapsed;
+    }
+    if (level > run->peak) {
+        run->peak = level;
+    }
+}
+
+void AlertBenchmark::runScenario(const BenchScenario& scenario, uint32_t readIntervalMs,
+                                 bool warmup, BenchRun& run) {
+    AdcSampler* sampler = AdcSampler::getInstance();
+    SmokeSensor* smokeSensor = SmokeSensor::getInstance();
+    CH4Sensor* ch4Sensor = CH4Sensor::getInstance();
+    EnvironmentSensor* envSensor = EnvironmentSensor::getInstance();
+    SensorTask* sensorTask = SensorTask::getInstance();
+    EventBus* eventBus = EventBus::getInstance();
+
+    // Estado de arranque con calibraciones conocidas (resultados comparables entre equipos)
+    Clock::simulate(BENCH_EPOCH_MS);
+    sampler->setReplay(true);
+    envSensor->setReplay(true, &BENCH_BMP_CALIBRATION);
+    envSensor->setBaseline(BENCH_REST[BENCH_TEMPERATURE], BENCH_REST[BENCH_HUMIDITY],
+                           BENCH_REST[BENCH_PRESSURE]);
+
+    GasCalibration smokeCalibration = SmokeTraits::DEFAULT_CALIBRATION;
+    GasCalibration ch4Calibration = CH4Traits::DEFAULT_CALIBRATION;
+    smokeCalibration.isCalibrated = true;
+    ch4Calibration.isCalibrated = true;
+    smokeSensor->setCalibration(smokeCalibration);
+    ch4Sensor->setCalibration(ch4Calibration);
+    smokeSensor->restart(false);
+    ch4Sensor->restart(false);
+
+    sensorTask->reset(readIntervalMs);
+    while (eventBus->dispatch() > 0) {
+        // Descartar eventos de la ejecución anterior
+    }
+
+    run.onsetMs = BENCH_EPOCH_MS + BENCH_PREROLL_MS;
+    run.prerollAlerts = 0;
+    run.cycles = 0;
+    run.peak = ALERT_NORMAL;
+    for (int i = 0; i < ALERT_LEVEL_COUNT; i++) {
+        run.latencyMs[i] = -1;
+    }
+
+    eventBus->subscribe(onAlertTransition, &run, TOPIC_ALERT, PRIORITY_LOW);
+
+    const int smokeChannel = smokeSensor->getAdcChannel();
+    const int ch4Channel = ch4Sensor->getAdcChannel();
+    const uint32_t stepMs = 1000 / ADC_SAMPLE_RATE_HZ;
+    const unsigned long end = run.onsetMs + scenario.durationMs;
+    unsigned long nextCycle = BENCH_EPOCH_MS;
+    uint32_t noise = 12345;
+    uint32_t steps = 0;
+    bool coldStart = warmup;
+
+    for (unsigned long now = BENCH_EPOCH_MS; (long)(end - now) > 0; now += stepMs) {
+        Clock::advanceTo(now);
+        int32_t t = (int32_t)(now - run.onsetMs);
+
+        // Arranque en frío: los gases se encienden cuando empieza el evento
+        if (coldStart && t >= 0) {
+            smokeSensor->restart(true);
+            ch4Sensor->restart(true);
+            coldStart = false;
+        }
+
+        // Barrido ADC: perfil del escenario + ruido pseudoaleatorio reproducible
+        AdcFrame frame = {};
+        frame.count = sampler->getChannelCount();
+        for (int signal = BENCH_SMOKE; signal <= BENCH_CH4; signal++) {
+            int channel = signal == BENCH_SMOKE ? smokeChannel : ch4Channel;
+            if (channel < 0) {
+                continue;
+            }
+            noise = noise * 1103515245 + 12345;
+            int value = (int)scenario.signals[signal].at(t, BENCH_REST[signal]) +
+                        (int)((noise >> 16) % (2 * BENCH_NOISE_COUNTS + 1)) - BENCH_NOISE_COUNTS;
+            frame.values[channel] = (uint16_t)(constrain(value, 0, 4095) << ADC_OVERSAMPLE_BITS);
+        }
+
+        // Ciclo cuando vence el periodo del planificador o lo adelanta el ADC
+        bool wake = sampler->inject(frame);
+        if (wake || (long)(now - nextCycle) >= 0) {
+            envSensor->injectRaw(environmentRaw(scenario, t));
+            sensorTask->cycle(wake);
+            eventBus->dispatch();
+            run.cycles++;
+            nextCycle = now + sensorTask->getSnapshot().sampleIntervalMs;
+        }
+
+        // No acaparar la CPU (watchdog, WiFi)
+        if ((++steps & 0x3FF) == 0) {
+            yield();
+        }
+    }
+
+    eventBus->unsubscribe(onAlertTransition, &run);
+}
+
+bool AlertBenchmark::check(const BenchScenario& scenario, bool warmup, const BenchRun& run,
+                           char* reason, size_t reasonSize) {
+    reason[0] = '\0';
+
+    if (run.prerollAlerts > 0) {
+        snprintf(reason, reasonSize, "%lu alertas antes del evento", (unsigned long)run.prerollAlerts);
+        return false;
+    }
+
+    if (run.peak > scenario.maxPeak) {
+        snprintf(reason, reasonSize, "%s > %s", SmartAlert::getLevelName(run.peak),
+                 SmartAlert::getLevelName(scenario.maxPeak));
+        return false;
+    }
+
+    for (const BenchBound& bound : scenario.bounds) {
+        if (bound.level == ALERT_NORMAL) {
+            continue;
+        }
+        int32_t limit = warmup ? bound.coldMs : bound.warmMs;
+        int32_t latency = run.latencyMs[bound.level];
+        if (latency < 0 || latency > limit) {
+            snprintf(reason, reasonSize, "%s > %ld ms", SmartAlert::getLevelName(bound.level), (long)limit);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AlertBenchmark::run(const char* outputPath) {
+    AdcSampler* sampler = AdcSampler::getInstance();
+    SmokeSensor* smokeSensor = SmokeSensor::getInstance();
+    CH4Sensor* ch4Sensor = CH4Sensor::getInstance();
+    EnvironmentSensor* envSensor = EnvironmentSensor::getInstance();
+
+    if (sampler->isRunning() || SensorTask::getInstance()->isRunning()) {
+        Serial.println("❌ Benchmark: la adquisición ya está en marcha");
+        return false;
+    }
+
+    File output;
+    if (outputPath != nullptr) {
+        output = LittleFS.open(outputPath, "w");
+    }
+
+    // Encabezado: configuración, luego ms hasta la primera entrada a cada nivel
+    char line[256];
+    int length = snprintf(line, sizeof(line),
+                          "scenario,read_interval_ms,smoke_window,ch4_window,warmup,result,cycles,preroll_alerts,peak");
+    for (int level = 0; level < ALERT_LEVEL_COUNT; level++) {
+        length += snprintf(line + length, sizeof(line) - length, ",%s",
+                           SmartAlert::getLevelName((GlobalAlertLevel)level));
+    }
+
+    Serial.println("\n▶ Benchmark de tiempo hasta la alerta (ms desde el inicio del evento)");
+    Serial.println(line);
+    if (output) {
+        output.println(line);
+    }
+
+    unsigned long wallStart = millis();
+    int runs = 0;
+    int failures = 0;
+
+    for (const BenchScenario& scenario : BENCH_SCENARIOS) {
+        for (uint32_t interval : READ_INTERVALS) {
+            for (int warmup = 0; warmup <= 1; warmup++) {
+                BenchRun run;
+                runScenario(scenario, interval, warmup, run);
+                runs++;
+
+                char reason[48];
+                bool pass = check(scenario, warmup, run, reason, sizeof(reason));
+                failures += pass ? 0 : 1;
+
+                length = snprintf(line, sizeof(line), "%s,%lu,%d,%d,%d,%s%s,%lu,%lu,%s",
+                                  scenario.name, (unsigned long)interval,
+                                  1 << SMOKE_FILTER_LOG2, 1 << CH4_FILTER_LOG2, warmup,
+                                  pass ? "pass" : "FAIL: ", reason,
+                                  (unsigned long)run.cycles, (unsigned long)run.prerollAlerts,
+                                  SmartAlert::getLevelName(run.peak));
+                for (int level = 0; level < ALERT_LEVEL_COUNT; level++) {
+                    if (run.latencyMs[level] >= 0) {
+                        length += snprintf(line + length, sizeof(line) - length, ",%ld",
+                                           (long)run.latencyMs[level]);
+                    } else {
+                        length += snprintf(line + length, sizeof(line) - length, ",");
+                    }
+                }
+
+                Serial.println(line);
+                if (output) {
+                    output.println(line);
+                }
+            }
+        }
+    }
+
+    // Volver al funcionamiento normal (calibraciones y baseline del equipo)
+    Clock::realTime();
+    sampler->setReplay(false);
+    envSensor->setReplay(false);
+    if (!envSensor->loadBaseline()) {
+        envSensor->resetBaseline();
+    }
+    if (!smokeSensor->loadCalibration()) {
+        smokeSensor->resetCalibration();
+    }
+    if (!ch4Sensor->loadCalibration()) {
+        ch4Sensor->resetCalibration();
+    }
+    smokeSensor->restart(true);
+    ch4Sensor->restart(true);
+    SensorTask::getInstance()->reset();
+
+    if (output) {
+        output.close();
+    }
+
+    Serial.printf("■ Benchmark: %d ejecuciones en %lu ms\n", runs, millis() - wallStart);
+    if (failures > 0) {
+        Serial.printf("❌ Benchmark: %d de %d ejecuciones fuera de los límites\n", failures, runs);
+    } else {
+        Serial.printf("✓ Benchmark: las %d ejecuciones dentro de los límites\n", runs);
+    }
+    return failures == 0;
+}
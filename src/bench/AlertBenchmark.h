@@ -0,0 +1,70 @@
+/*
+Benchmark de tiempo hasta la alerta:
+
+Inyecta escenarios canónicos (BenchScenarios.h) en las clases reales de
+sensores y mide el tiempo desde el inicio del evento hasta la entrada en
+cada nivel publicado (GlobalAlertLevel, después del antirrebote)
+Matriz: escenario × periodo de lectura × arranque en frío (en ejecución)
+La ventana de los filtros de gas es de compilación (SMOKE_FILTER_LOG2,
+CH4_FILTER_LOG2): cada build aporta sus filas con la ventana en columnas
+Reloj virtual (como la reproducción de trazas): sin esperas reales
+Resultado: CSV por Serial y en ALERT_BENCHMARK_PATH, con una columna que
+indica si la ejecución cumple los límites del escenario (y cuál no cumple)
+*/
+#ifndef ALERTBENCHMARK_H
+#define ALERTBENCHMARK_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+#include "../alert/AlertLevel.h"
+#include "../events/EventBus.h"
+#include "BenchScenarios.h"
+
+#define BENCH_PREROLL_MS 60000      // Aire limpio antes del evento (filtros y tendencias asentados)
+#define BENCH_NOISE_COUNTS 8        // Ruido pico de los gases (cuentas ADC nativas)
+
+// Resultado de una ejecución
+struct BenchRun {
+    unsigned long onsetMs;                  // Inicio del evento (tiempo virtual)
+    int32_t latencyMs[ALERT_LEVEL_COUNT];   // Primera entrada a cada nivel (-1 = nunca)
+    uint32_t prerollAlerts;                 // Cambios de nivel antes del evento (falsas alarmas)
+    uint32_t cycles;                        // Ciclos de la tarea de sensores
+    GlobalAlertLevel peak;                  // Nivel máximo publicado
+};
+
+class AlertBenchmark {
+private:
+    /**
+     * Registra la entrada a un nivel (suscriptor de TOPIC_ALERT)
+     */
+    static void onAlertTransition(const Event& event, void* context);
+
+    /**
+     * Ejecuta un escenario con una configuración
+     * @param scenario Escenario a inyectar
+     * @param readIntervalMs Periodo de lectura en reposo
+     * @param warmup true: los gases se encienden al empezar el evento (arranque en frío)
+     * @param run Resultado
+     */
+    static void runScenario(const BenchScenario& scenario, uint32_t readIntervalMs,
+                            bool warmup, BenchRun& run);
+
+    /**
+     * Verifica una ejecución contra los límites del escenario
+     * @param reason Primer límite no cumplido (vacío si cumple)
+     * @return true si cumple
+     */
+    static bool check(const BenchScenario& scenario, bool warmup, const BenchRun& run,
+                      char* reason, size_t reasonSize);
+
+public:
+    /**
+     * Ejecuta la matriz completa y escribe la tabla
+     * Deja sensores, calibraciones y reloj como estaban al terminar.
+     * @param outputPath CSV de salida (nullptr = solo Serial)
+     * @return false si no se pudo preparar o alguna ejecución no cumple sus límites
+     */
+    static bool run(const char* outputPath);
+};
+
+#endif // ALERTBENCHMARK_H
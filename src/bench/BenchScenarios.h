@@ -0,0 +1,133 @@
+/*
+Escenarios canónicos del benchmark de tiempo hasta la alerta:
+
+Cada escenario describe la evolución de las magnitudes físicas desde el
+inicio del evento (t = 0) con perfiles lineales por tramos:
+  humo y CH4 en cuentas ADC nativas (0-4095, calibración por defecto)
+  temperatura °C, humedad %, presión hPa
+Antes de t = 0 cada perfil vale su primer punto (aire limpio)
+Límites de aceptación por escenario: tiempo máximo hasta ciertos niveles
+(en caliente y con arranque en frío) y nivel máximo admitido; una
+ejecución que los excede falla (regresión de reglas o filtros)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef BENCHSCENARIOS_H
+#define BENCHSCENARIOS_H
+
+#include <stdint.h>
+#include "../alert/AlertLevel.h"
+
+#define BENCH_MAX_BOUNDS 3
+
+enum BenchSignal {
+    BENCH_SMOKE,            // Cuentas ADC
+    BENCH_CH4,              // Cuentas ADC
+    BENCH_TEMPERATURE,      // °C
+    BENCH_HUMIDITY,         // %
+    BENCH_PRESSURE,         // hPa
+    BENCH_SIGNAL_COUNT
+};
+
+// Punto de un perfil: valor en el instante timeMs desde el inicio del evento
+struct BenchKeyframe {
+    int32_t timeMs;
+    float value;
+};
+
+struct BenchProfile {
+    const BenchKeyframe* points;
+    uint8_t count;              // 0 = valor de reposo constante
+
+    /**
+     * Valor del perfil (interpolación lineal, constante fuera de los extremos)
+     * @param timeMs Tiempo desde el inicio del evento (negativo = antes)
+     * @param rest Valor de reposo si el perfil está vacío
+     */
+    float at(int32_t timeMs, float rest) const {
+        if (count == 0) {
+            return rest;
+        }
+        if (timeMs < points[0].timeMs) {
+            return points[0].value;
+        }
+        for (int i = 1; i < count; i++) {
+            if (timeMs < points[i].timeMs) {
+                const BenchKeyframe& a = points[i - 1];
+                const BenchKeyframe& b = points[i];
+                return a.value + (b.value - a.value) * (timeMs - a.timeMs) / (b.timeMs - a.timeMs);
+            }
+        }
+        return points[count - 1].value;
+    }
+};
+
+// Entrada a un nivel antes de un tiempo máximo (ms desde el inicio del evento)
+struct BenchBound {
+    GlobalAlertLevel level;     // ALERT_NORMAL = lugar libre
+    int32_t warmMs;             // Sensores ya calentados
+    int32_t coldMs;             // Calentadores encendidos al empezar el evento
+};
+
+struct BenchScenario {
+    const char* name;
+    uint32_t durationMs;        // Tiempo observado desde el inicio del evento
+    BenchProfile signals[BENCH_SIGNAL_COUNT];
+    GlobalAlertLevel maxPeak;   // Nivel más alto admitido (falsas alarmas)
+    BenchBound bounds[BENCH_MAX_BOUNDS];
+};
+
+// Aire limpio (también es el baseline ambiental del benchmark)
+constexpr float BENCH_REST[BENCH_SIGNAL_COUNT] = { 250, 250, 22.0f, 45.0f, 1013.25f };
+
+#define BENCH_PROFILE(points) { points, sizeof(points) / sizeof(points[0]) }
+#define BENCH_REST_PROFILE { nullptr, 0 }
+
+// Humo: escalón de aire limpio a sobre el umbral de alarma
+constexpr BenchKeyframe SMOKE_STEP_SMOKE[] = { { 0, 250 }, { 0, 1800 } };
+
+// Fuga lenta de CH4: rampa hasta superar el umbral explosivo en 20 min
+constexpr BenchKeyframe CH4_LEAK_CH4[] = { { 0, 250 }, { 1200000, 2600 } };
+
+// Incendio rápido: humo en 1 min, +58 °C en 2 min, aire más seco, caída de presión
+constexpr BenchKeyframe FAST_FIRE_SMOKE[] = { { 0, 250 }, { 60000, 2000 } };
+constexpr BenchKeyframe FAST_FIRE_TEMPERATURE[] = { { 0, 22.0f }, { 120000, 80.0f } };
+constexpr BenchKeyframe FAST_FIRE_HUMIDITY[] = { { 0, 45.0f }, { 120000, 15.0f } };
+constexpr BenchKeyframe FAST_FIRE_PRESSURE[] = { { 0, 1013.25f }, { 60000, 1007.0f } };
+
+// Vapor de cocina: humedad alta, algo de calor y lectura de humo moderada
+constexpr BenchKeyframe KITCHEN_SMOKE[] = { { 0, 250 }, { 30000, 900 }, { 240000, 900 }, { 300000, 250 } };
+constexpr BenchKeyframe KITCHEN_TEMPERATURE[] = { { 0, 22.0f }, { 120000, 28.0f } };
+constexpr BenchKeyframe KITCHEN_HUMIDITY[] = { { 0, 45.0f }, { 60000, 90.0f }, { 240000, 90.0f }, { 300000, 50.0f } };
+
+// Límites: lo medido con ventanas 8/16 más margen para ventanas de filtro
+// mayores (unos 2 s) y para el calentamiento del CH4 (180 s) en frío
+constexpr BenchScenario BENCH_SCENARIOS[] = {
+    { "smoke_step", 300000, {
+        BENCH_PROFILE(SMOKE_STEP_SMOKE), BENCH_REST_PROFILE,
+        BENCH_REST_PROFILE, BENCH_REST_PROFILE, BENCH_REST_PROFILE },
+      ALERT_FIRE_SUSPECTED, {
+        { ALERT_FIRE_SUSPECTED, 1000, 1000 } } },
+    { "ch4_leak_ramp", 1500000, {
+        BENCH_REST_PROFILE, BENCH_PROFILE(CH4_LEAK_CH4),
+        BENCH_REST_PROFILE, BENCH_REST_PROFILE, BENCH_REST_PROFILE },
+      ALERT_EXPLOSIVE, {
+        { ALERT_ANOMALY, 120000, 300000 },
+        { ALERT_EXPLOSIVE, 1000000, 1000000 } } },
+    { "fast_fire", 300000, {
+        BENCH_PROFILE(FAST_FIRE_SMOKE), BENCH_REST_PROFILE,
+        BENCH_PROFILE(FAST_FIRE_TEMPERATURE), BENCH_PROFILE(FAST_FIRE_HUMIDITY),
+        BENCH_PROFILE(FAST_FIRE_PRESSURE) },
+      ALERT_FIRE_CONFIRMED, {
+        { ALERT_FIRE_SUSPECTED, 30000, 30000 },
+        { ALERT_FIRE_CONFIRMED, 100000, 100000 } } },
+    { "kitchen_steam", 360000, {
+        BENCH_PROFILE(KITCHEN_SMOKE), BENCH_REST_PROFILE,
+        BENCH_PROFILE(KITCHEN_TEMPERATURE), BENCH_PROFILE(KITCHEN_HUMIDITY),
+        BENCH_REST_PROFILE },
+      ALERT_ANOMALY, {
+        { ALERT_COOKING, 90000, 90000 } } }
+};
+
+#define BENCH_SCENARIO_COUNT (sizeof(BENCH_SCENARIOS) / sizeof(BENCH_SCENARIOS[0]))
+
+#endif // BENCHSCENARIOS_H
@@ -1,7 +1,10 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// Sin Arduino en las pruebas nativas (pio test -e native): solo constantes
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 
 // ==================== CONFIGURACIÓN DE PINES ====================
 #define LED_PIN 2                    // GPIO del LED de estado
@@ -21,13 +24,115 @@
 #define BUTTON_PIN 34                // Botón de reset de alarma
 
 // ==================== CONFIGURACIÓN DE SENSORES ====================
-#define SENSOR_READ_INTERVAL 5000    // Intervalo de lectura de sensores (ms)
+#define SENSOR_READ_INTERVAL 5000    // Intervalo de lectura de sensores en reposo (ms)
+#define SENSOR_FAST_INTERVAL 250     // Intervalo con actividad (sensor fuera de NORMAL)
+#define SENSOR_FAST_HOLD_MS 30000    // Tiempo sin actividad antes de volver al ritmo lento
+#define SENSOR_FAST_TEMP_RATE 2.0    // °C/min que activa el ritmo rápido
+#define SENSOR_FAST_PRESSURE_RATE -1.0 // hPa/min que activa el ritmo rápido
+#define STATUS_DISPLAY_INTERVAL 5000 // Intervalo del estado completo por Serial (ms)
+#define ALERT_EXIT_SAMPLES 3         // Muestras consecutivas por debajo para bajar de nivel
+#define ALERT_DWELL_MS 15000         // Permanencia mínima en niveles de precaución (ms)
+#define ALERT_DWELL_CRITICAL_MS 60000 // Permanencia mínima desde FIRE_SUSPECTED (ms)
 #define CH4_LEL_THRESHOLD 5.0        // % LEL para alarma crítica (5% = explosivo)
+#define ENV_TREND_WINDOW_MS 60000    // Ventana de la regresión de tendencias ambientales (ms)
+#define ENV_TREND_SPACING_MS 2000    // Separación mínima entre muestras de tendencia (ms)
+
+// Tarea de adquisición (lectura de sensores + evaluación de alerta)
+#define SENSOR_TASK_CORE 1           // APP_CPU (WiFi/AsyncTCP corren en el core 0)
+#define SENSOR_TASK_PRIORITY 2       // Por encima de loop() (prioridad 1)
+#define SENSOR_TASK_STACK 8192       // Bytes de stack
+
+// Muestreo ADC en segundo plano (timer → cola lock-free por canal)
+#define ADC_SAMPLE_RATE_HZ 100       // Frecuencia de muestreo por canal (100-1000 Hz)
+#define ADC_RING_SIZE 512            // Muestras en cola por canal (potencia de 2)
+#define ADC_MAX_CHANNELS 4           // Canales analógicos máximos
+#define ADC_OVERSAMPLE 16            // Conversiones por canal en cada barrido
+#define ADC_OVERSAMPLE_BITS 2        // Bits extra tras diezmar (16× → +2 bits)
+
+// Filtros de gas: promedio móvil de 2^N muestras por sensor
+// (se pueden fijar desde build_flags para comparar latencias, ver entorno "bench")
+#ifndef SMOKE_FILTER_LOG2
+#define SMOKE_FILTER_LOG2 3          // Humo: 8 muestras
+#endif
+#ifndef CH4_FILTER_LOG2
+#define CH4_FILTER_LOG2 4            // CH4: 16 muestras
+#endif
+
+// Detección de fugas lentas: CUSUM sobre la señal filtrada de cada gas
+// (subida sostenida respecto de la media de los últimos minutos, antes de los umbrales)
+#define GAS_CUSUM_BASELINE_SHIFT 16  // Referencia: media de 2^N muestras (2^16 a 100 Hz ≈ 11 min)
+#define GAS_CUSUM_DRIFT 16           // Desvío sobre la referencia tolerado como ruido (cuentas ADC)
+#define GAS_CUSUM_THRESHOLD 6000     // Exceso acumulado para marcar subida (cuentas × s)
+
+// Corrección de gases por temperatura y humedad (AHT20, grilla por gas en LittleFS)
+#define GAS_COMPENSATION true        // Aplicar la ganancia a cada muestra antes de convertir
+
+// Seguimiento del baseline de gases en aire limpio (envejecimiento del sensor)
+#define GAS_BASELINE_TRACKING true   // Ajustar baseline y umbrales sin recalibrar
+#define GAS_BASELINE_WINDOW 600000   // Ventana de aire limpio evaluada (ms)
+#define GAS_BASELINE_MAX_STDDEV 8.0f // Dispersión máxima de una ventana aceptada (cuentas ADC)
+#define GAS_BASELINE_MAX_DRIFT_DAY 20 // Deriva máxima por día (cuentas ADC)
+#define GAS_BASELINE_MAX_DRIFT 300   // Deriva máxima desde la calibración manual (cuentas ADC)
+#define GAS_BASELINE_CHECKPOINT 21600000UL // Guardar la calibración desplazada cada 6 h como máximo
+
+// Salud de los sensores (calidad de cada lectura, recuperación del bus I2C)
+#define HEALTH_STUCK_READS 30        // Lecturas idénticas seguidas → valor trabado
+#define HEALTH_FLAT_WINDOW 600000    // Ventana sin variación → señal plana (ms)
+#define HEALTH_GAS_FLAT_SPAN 1       // Rango máximo de una señal de gas plana (cuentas ADC)
+#define HEALTH_GAS_RAIL 8            // Cuentas junto a 0 o 4095: cable cortado o en corto
+#define HEALTH_I2C_MAX_ERRORS 3      // Lecturas seguidas con error de bus → fuera de línea
+#define HEALTH_STALE_MS 12000        // Sin medición nueva → valor retenido (ms)
+#define HEALTH_OFFLINE_MS 30000      // Sin medición nueva → fuera de línea (ms)
+#define HEALTH_RECOVERY_BACKOFF 1000 // Primer reintento de recuperación del bus (ms, se duplica)
+#define HEALTH_RECOVERY_BACKOFF_MAX 60000 // Espera máxima entre reintentos (ms)
+#define HEALTH_TEMP_DISAGREE 5.0f    // Diferencia de temperatura AHT20/BMP280 tolerada (°C)
+#define HEALTH_DISAGREE_READS 10     // Lecturas seguidas fuera de tolerancia → discrepancia
+
+// Conversión de gases (tabla precalculada de 4096 entradas por sensor)
+#define GAS_PPM_CURVE_LOGLOG false   // true: PPM por curva Rs/R0 del datasheet (log-log)
+
+// Registro de trazas: entradas crudas (ADC + I2C) a LittleFS, dos archivos rotativos
+// Apagado por defecto: ≈400 B/s con 2 canales a 100 Hz desgastan la flash
+// (se activa en el entorno "replay" de platformio.ini)
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED false
+#endif
+#define TRACE_FILE_MAX_BYTES 262144  // Tamaño por archivo antes de rotar (~10 min)
+#define TRACE_ADC_QUEUE_SIZE 256     // Barridos pendientes de escribir (potencia de 2)
+#define TRACE_ENV_QUEUE_SIZE 8       // Lecturas I2C pendientes de escribir (potencia de 2)
+#define TRACE_ALERT_QUEUE_SIZE 8     // Cambios de nivel pendientes de escribir (potencia de 2)
+#define TRACE_REPLAY_TOLERANCE 1000  // Desfase admitido entre cambio en vivo y reproducido (ms)
+#define TRACE_REPLAY_MAX_COMPARE 64  // Cambios de nivel comparados por reproducción
+#define TRACE_FLUSH_INTERVAL 1000    // Escritura agrupada cada N ms (desde loop)
+
+// Reproducción acelerada de una traza al arrancar (entorno "replay" de platformio.ini)
+#ifndef TRACE_REPLAY
+#define TRACE_REPLAY false
+#endif
+
+// Benchmark de tiempo hasta la alerta al arrancar (entorno "bench" de platformio.ini)
+#ifndef ALERT_BENCHMARK
+#define ALERT_BENCHMARK false
+#endif
 
 // ==================== CONFIGURACIÓN DE RED ====================
 #define AP_SSID "ESP-WIFI-MANAGER"   // Nombre del Access Point
 #define AP_PASSWORD "12345678"       // Contraseña del AP (mínimo 8 caracteres)
 #define WEB_SERVER_PORT 80           // Puerto del servidor web
+#define TEMPLATE_VALUE_LENGTH 40     // Longitud máxima del valor de un marcador
+#define TEMPLATE_CACHE_MS 5000       // Vigencia de los valores de red cacheados (ms)
+#define STATIC_MAX_ASSETS 12         // Archivos web del manifiesto (rutas con ETag)
+#define STATIC_PATH_LENGTH 32        // Longitud máxima de la ruta de un archivo web
+#define STATIC_MAX_AGE 3600          // Cache-Control de CSS/JS/imágenes (s); las páginas se revalidan
+#define API_READINGS_BUFFER 1024     // JSON de /api/v1/readings (bytes, dos buffers estáticos)
+#define API_ALERT_BUFFER 256         // JSON de /api/v1/alert (bytes, dos buffers estáticos)
+#define SSE_MAX_CLIENTS 4            // Clientes simultáneos de /events (pantallas)
+#define SSE_CLIENT_QUEUE 4           // Marcos en cola por cliente antes de coalescer lecturas
+#define SSE_FRAME_BUFFER 1152        // Marco SSE de lecturas (encabezado + JSON de la API)
+#define SSE_BUSY_RETRY_MS 30000      // Reintento indicado a los clientes rechazados (ms)
+#define TELEMETRY_MAX_CLIENTS 4      // Clientes simultáneos de /ws/telemetry
+#define TELEMETRY_KEYFRAME_INTERVAL 40 // Cuadros entre cuadros clave (10 s con ritmo rápido)
+#define TELEMETRY_CLIENT_QUEUE 8     // Mensajes en cola por cliente antes de saltear deltas
 
 // ==================== CONFIGURACIÓN OTA ====================
 // IMPORTANTE: Estas son configuraciones por defecto para desarrollo
@@ -55,6 +160,13 @@
 #define GATEWAY_FILE_PATH "/gateway.txt"
 #define SUBNET_FILE_PATH "/subnet.txt"
 #define DHCP_FILE_PATH "/dhcp.txt"
+#define ALERT_RULES_FILE_PATH "/alert_rules.txt"   // Reglas de alerta (opcional)
+#define TRACE_FILE_PATH "/trace.bin"              // Traza en curso
+#define TRACE_OLD_FILE_PATH "/trace.old.bin"      // Traza anterior (rotada)
+#define TRACE_REPLAY_PATH "/replay.bin"           // Traza a reproducir
+#define TRACE_TIMELINE_PATH "/replay_timeline.csv" // Resultado de la reproducción
+#define ALERT_BENCHMARK_PATH "/alert_benchmark.csv" // Resultado del benchmark
+#define STATIC_MANIFEST_PATH "/assets.manifest"   // Hashes de los archivos web (tools/build_static_assets.py)
 
 // ==================== NOMBRES DE PARÁMETROS HTTP ====================
 #define PARAM_SSID "ssid"
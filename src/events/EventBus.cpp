@@ -0,0 +1,126 @@
+#include "EventBus.h"
+
+// Inicializar instancia estática
+EventBus* EventBus::instance = nullptr;
+
+EventBus::EventBus()
+    : subscriberCount(0),
+      dispatched(0) {
+}
+
+EventBus* EventBus::getInstance() {
+    if (instance == nullptr) {
+        instance = new EventBus();
+    }
+    return instance;
+}
+
+bool EventBus::subscribe(EventHandler handler, void* context, uint8_t topics,
+                         EventPriority priority) {
+    if (handler == nullptr || subscriberCount >= EVENT_MAX_SUBSCRIBERS) {
+        return false;
+    }
+
+    // Inserción ordenada: después de los de igual o mayor prioridad
+    int position = subscriberCount;
+    while (position > 0 && subscribers[position - 1].priority > priority) {
+        subscribers[position] = subscribers[position - 1];
+        position--;
+    }
+
+    subscribers[position] = Subscriber{ handler, context, topics, (uint8_t)priority };
+    subscriberCount++;
+    return true;
+}
+
+bool EventBus::unsubscribe(EventHandler handler, void* context) {
+    for (int i = 0; i < subscriberCount; i++) {
+        if (subscribers[i].handler == handler && subscribers[i].context == context) {
+            for (int j = i; j < subscriberCount - 1; j++) {
+                subscribers[j] = subscribers[j + 1];
+            }
+            subscriberCount--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventBus::publish(const SmokeReading& reading, uint32_t cycle, unsigned long timestamp) {
+    Event event;
+    event.topic = TOPIC_SMOKE;
+    event.cycle = cycle;
+    event.timestamp = timestamp;
+    event.smoke = reading;
+    return readingQueue.push(event);
+}
+
+bool EventBus::publish(const CH4Reading& reading, uint32_t cycle, unsigned long timestamp) {
+    Event event;
+    event.topic = TOPIC_CH4;
+    event.cycle = cycle;
+    event.timestamp = timestamp;
+    event.ch4 = reading;
+    return readingQueue.push(event);
+}
+
+bool EventBus::publish(const EnvironmentReading& reading, uint32_t cycle, unsigned long timestamp) {
+    Event event;
+    event.topic = TOPIC_ENVIRONMENT;
+    event.cycle = cycle;
+    event.timestamp = timestamp;
+    event.env = reading;
+    return readingQueue.push(event);
+}
+
+bool EventBus::publish(const AlertTransition& transition, uint32_t cycle, unsigned long timestamp) {
+    Event event;
+    event.topic = TOPIC_ALERT;
+    event.cycle = cycle;
+    event.timestamp = timestamp;
+    event.alert = transition;
+    return alertQueue.push(event);
+}
+
+void EventBus::deliver(const Event& event) {
+    for (int i = 0; i < subscriberCount; i++) {
+        const Subscriber& subscriber = subscribers[i];
+        if (subscriber.topics & event.topic) {
+            subscriber.handler(event, subscriber.context);
+        }
+    }
+    dispatched++;
+}
+
+size_t EventBus::dispatch(size_t budget) {
+    size_t delivered = 0;
+    Event event;
+
+    while (delivered < budget && alertQueue.pop(event)) {
+        deliver(event);
+        delivered++;
+    }
+
+    while (delivered < budget && readingQueue.pop(event)) {
+        deliver(event);
+        delivered++;
+    }
+
+    return delivered;
+}
+
+size_t EventBus::pending() const {
+    return alertQueue.size() + readingQueue.size();
+}
+
+uint32_t EventBus::getDropped() const {
+    return alertQueue.getDropped() + readingQueue.getDropped();
+}
+
+uint32_t EventBus::getDispatched() const {
+    return dispatched;
+}
+
+uint8_t EventBus::getSubscriberCount() const {
+    return subscriberCount;
+}
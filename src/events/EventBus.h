@@ -0,0 +1,162 @@
+/*
+Bus de eventos publicar/suscribir:
+
+Tamaño fijo, sin memoria dinámica
+La tarea de sensores publica lecturas y transiciones de alerta
+Los suscriptores (LED, web, registro, notificador) se registran con
+un filtro de tópicos y una prioridad
+Publicar nunca bloquea: cola llena = evento descartado y contado
+Las transiciones de alerta tienen su propia cola y se despachan primero
+Despacho acotado desde loop (EVENT_DISPATCH_BUDGET eventos por llamada)
+
+Un solo productor (tarea de sensores) y un solo consumidor (loop)
+Suscribir solo desde loop o setup (mismo contexto que dispatch)
+Sin dependencias de Arduino (compilable en host): el productor fija el tiempo
+*/
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../alert/AlertLevel.h"
+#include "../sensors/SensorReadings.h"
+#include "../utils/SpscRing.h"
+
+#define EVENT_QUEUE_SIZE 32          // Eventos de lecturas en cola (potencia de 2)
+#define EVENT_ALERT_QUEUE_SIZE 8     // Transiciones de alerta en cola (potencia de 2)
+#define EVENT_MAX_SUBSCRIBERS 16     // Suscriptores máximos
+#define EVENT_DISPATCH_BUDGET 16     // Eventos máximos por llamada a dispatch()
+
+// Tópicos (máscara de bits para los filtros)
+enum EventTopic : uint8_t {
+    TOPIC_SMOKE         = 1 << 0,   // Lectura de humo
+    TOPIC_CH4           = 1 << 1,   // Lectura de metano
+    TOPIC_ENVIRONMENT   = 1 << 2,   // Lectura ambiental
+    TOPIC_ALERT         = 1 << 3,   // Cambio del nivel de alerta publicado
+    TOPIC_READINGS      = TOPIC_SMOKE | TOPIC_CH4 | TOPIC_ENVIRONMENT,
+    TOPIC_ALL           = 0xFF
+};
+
+// Prioridad de despacho (menor valor = se llama antes)
+enum EventPriority : uint8_t {
+    PRIORITY_CRITICAL,      // Sirena, notificador
+    PRIORITY_HIGH,          // Indicadores locales (LED)
+    PRIORITY_NORMAL,        // Web
+    PRIORITY_LOW            // Registro
+};
+
+// Cambio del nivel de alerta publicado
+struct AlertTransition {
+    GlobalAlertLevel from;
+    GlobalAlertLevel to;
+    GlobalAlertLevel raw;           // Nivel evaluado en la muestra del cambio
+    uint32_t features;              // Máscara FEAT_* de esa muestra
+};
+
+struct Event {
+    EventTopic topic;
+    uint32_t cycle;                 // Ciclo de la tarea de sensores
+    unsigned long timestamp;        // Tiempo del productor al publicar (ms)
+    union {
+        SmokeReading smoke;
+        CH4Reading ch4;
+        EnvironmentReading env;
+        AlertTransition alert;
+    };
+};
+
+typedef void (*EventHandler)(const Event& event, void* context);
+
+class EventBus {
+private:
+    static EventBus* instance;
+
+    struct Subscriber {
+        EventHandler handler;
+        void* context;
+        uint8_t topics;
+        uint8_t priority;
+    };
+
+    SpscRing<Event, EVENT_ALERT_QUEUE_SIZE> alertQueue;
+    SpscRing<Event, EVENT_QUEUE_SIZE> readingQueue;
+
+    Subscriber subscribers[EVENT_MAX_SUBSCRIBERS];  // Ordenados por prioridad
+    uint8_t subscriberCount;
+    uint32_t dispatched;
+
+    EventBus(); // Constructor privado
+
+    /**
+     * Entrega un evento a los suscriptores interesados, en orden de prioridad
+     */
+    void deliver(const Event& event);
+
+public:
+    /**
+     * Obtiene la instancia única de EventBus (Singleton)
+     * @return Puntero a la instancia
+     */
+    static EventBus* getInstance();
+
+    /**
+     * Registra un suscriptor
+     * Con igual prioridad se respeta el orden de registro.
+     * @param handler Función llamada con cada evento
+     * @param context Puntero entregado al handler (puede ser nullptr)
+     * @param topics Máscara de tópicos (EventTopic)
+     * @param priority Orden de despacho
+     * @return false si no quedan lugares
+     */
+    bool subscribe(EventHandler handler, void* context, uint8_t topics,
+                   EventPriority priority = PRIORITY_NORMAL);
+
+    /**
+     * Elimina un suscriptor registrado con el mismo handler y contexto
+     * @return true si existía
+     */
+    bool unsubscribe(EventHandler handler, void* context);
+
+    /**
+     * Publica una lectura (solo tarea de sensores, no bloquea)
+     * @param cycle Ciclo de la tarea de sensores
+     * @param timestamp Tiempo de publicación (ms)
+     * @return false si la cola estaba llena
+     */
+    bool publish(const SmokeReading& reading, uint32_t cycle, unsigned long timestamp);
+    bool publish(const CH4Reading& reading, uint32_t cycle, unsigned long timestamp);
+    bool publish(const EnvironmentReading& reading, uint32_t cycle, unsigned long timestamp);
+
+    /**
+     * Publica un cambio de nivel (solo tarea de sensores, no bloquea)
+     * @return false si la cola estaba llena
+     */
+    bool publish(const AlertTransition& transition, uint32_t cycle, unsigned long timestamp);
+
+    /**
+     * Entrega eventos pendientes (desde loop)
+     * Primero las transiciones de alerta, luego las lecturas.
+     * @param budget Máximo de eventos a entregar en esta llamada
+     * @return Eventos entregados
+     */
+    size_t dispatch(size_t budget = EVENT_DISPATCH_BUDGET);
+
+    /**
+     * Eventos en cola pendientes de despacho
+     */
+    size_t pending() const;
+
+    /**
+     * Eventos descartados por cola llena desde el arranque
+     */
+    uint32_t getDropped() const;
+
+    /**
+     * Eventos entregados desde el arranque
+     */
+    uint32_t getDispatched() const;
+
+    uint8_t getSubscriberCount() const;
+};
+
+#endif // EVENTBUS_H
@@ -9,10 +9,20 @@
 #include "wifi/WiFiManager.h"
 #include "led/LEDController.h"
 #include "web/MyWebServer.h"
+#include "web/ReadingsApi.h"
+#include "web/LiveEvents.h"
+#include "web/TelemetrySocket.h"
 #include "ota/OTAManager.h"
+#include "sensors/AdcSampler.h"
 #include "sensors/SmokeSensor.h"
 #include "sensors/CH4Sensor.h"
 #include "sensors/EnvironmentSensor.h"
+#include "alert/SmartAlert.h"
+#include "tasks/SensorTask.h"
+#include "events/EventBus.h"
+#include "trace/TraceRecorder.h"
+#include "trace/TraceReplay.h"
+#include "bench/AlertBenchmark.h"
 
 // Instancias de módulos
 FileManager* fileManager;
@@ -26,109 +36,34 @@ SmokeSensor* smokeSensor;
 CH4Sensor* ch4Sensor;
 EnvironmentSensor* envSensor;
 
-// Control
-unsigned long lastSensorRead = 0;
+// Tarea de adquisición
+SensorTask* sensorTask;
+EventBus* eventBus;
 
-// Nivel de alerta global mejorado
-enum GlobalAlertLevel {
-    ALERT_NORMAL,           // Todo OK
-    ALERT_COOKING,          // Vapor de cocina (falsa alarma evitada)
-    ALERT_ANOMALY,          // Algo raro, monitorear
-    ALERT_CAUTION,          // Precaución, sensor activado
-    ALERT_WARNING,          // Advertencia, 2+ sensores
-    ALERT_FIRE_SUSPECTED,   // Incendio probable
-    ALERT_FIRE_CONFIRMED,   // Incendio confirmado
-    ALERT_GAS_CRITICAL,     // Gas crítico
-    ALERT_EXPLOSIVE         // Nivel explosivo
-};
+// Control
+uint32_t lastSnapshotCycle = 0;
+unsigned long lastStatusDisplay = 0;
 
-GlobalAlertLevel currentAlert = ALERT_NORMAL;
-
-/**
- * Evaluación inteligente con múltiples sensores
- */
-GlobalAlertLevel evaluateSmartAlert() {
-    // Leer últimas lecturas
-    SmokeReading smoke = smokeSensor->getLastReading();
-    CH4Reading ch4 = ch4Sensor->getLastReading();
-    EnvironmentReading env = envSensor->getLastReading();
-    
-    int activeSensors = 0;
-    
-    // ========== ANÁLISIS DE PATRONES ==========
-    
-    // PATRÓN 1: GAS + FUEGO = MÁXIMA PRIORIDAD
-    if (ch4Sensor->isExplosive()) {
-        return ALERT_EXPLOSIVE;  // 💥 EVACUAR
-    }
-    
-    if (ch4Sensor->isCritical() && (smokeSensor->isSmokeDetected() || env.temperature > 45)) {
-        return ALERT_GAS_CRITICAL;  // 🚨 Gas + indicios de fuego
-    }
-    
-    // PATRÓN 2: INCENDIO CONFIRMADO
-    // Múltiples indicadores concuerdan
-    if (smokeSensor->isCritical() && 
-        env.temperature > 60 && 
-        env.pressureDelta < -5) {
-        return ALERT_FIRE_CONFIRMED;  // 🔥 Incendio real
-    }
-    
-    // PATRÓN 3: INCENDIO SOSPECHOSO/TEMPRANO
-    // Ambiente sugiere incendio antes de humo denso
-    if (envSensor->isFireSuspected() || 
-        (env.temperature > 50 && env.tempRate > 5)) {
-        if (smokeSensor->isSmokeDetected() || smoke.ppm > 300) {
-            return ALERT_FIRE_SUSPECTED;  // ⚠️ Probable incendio
-        }
-    }
-    
-    // PATRÓN 4: COCINA/VAPOR (Evitar falsa alarma)
-    // Humo detectado + humedad alta + temperatura normal
-    if (smokeSensor->isSmokeDetected() && 
-        env.humidity > 75 && 
-        env.temperature < 35 &&
-        !ch4Sensor->isCH4Detected()) {
-        return ALERT_COOKING;  // 🍳 Solo vapor, no peligroso
-    }
-    
-    // PATRÓN 5: MÚLTIPLES SENSORES ACTIVADOS
-    if (smokeSensor->isSmokeDetected()) activeSensors++;
-    if (ch4Sensor->isCH4Detected()) activeSensors++;
-    if (env.temperature > 40) activeSensors++;
-    if (env.pressureDelta < -3) activeSensors++;
-    
-    if (activeSensors >= 3) {
-        return ALERT_WARNING;  // 🟠 Múltiples indicadores
-    }
-    
-    if (activeSensors >= 2) {
-        return ALERT_CAUTION;  // 🟡 Dos sensores
-    }
-    
-    // PATRÓN 6: UN SOLO SENSOR ACTIVADO
-    if (activeSensors == 1) {
-        return ALERT_ANOMALY;  // 🤔 Monitorear
-    }
-    
-    return ALERT_NORMAL;  // ✅ Todo bien
-}
+GlobalAlertLevel currentAlert = ALERT_NORMAL;   // Nivel de la última instantánea
 
 /**
  * Muestra estado detallado de todos los sensores
+ * @param snapshot Instantánea publicada por la tarea de sensores
  */
-void displayFullStatus() {
+void displayFullStatus(const SensorSnapshot& snapshot) {
     Serial.println("\n╔═══════════════════════════════════════════════════════════════╗");
     Serial.println("║          SISTEMA INTELIGENTE DE ALARMA - ESTADO COMPLETO     ║");
     Serial.println("╠═══════════════════════════════════════════════════════════════╣");
     
     // SENSOR DE HUMO
-    if (smokeSensor->isReady()) {
-        SmokeReading smoke = smokeSensor->getLastReading();
+    if (snapshot.smokeReady) {
+        const SmokeReading& smoke = snapshot.smoke;
         Serial.println("║  🔥 SENSOR DE HUMO:                                           ║");
-        Serial.printf("║    Estado:      %-45s  ║\n", smokeSensor->getStateString().c_str());
+        Serial.printf("║    Estado:      %-45s  ║\n", SmokeTraits::stateName(smoke.state));
         Serial.printf("║    PPM:         %-45d  ║\n", smoke.ppm);
         Serial.printf("║    Porcentaje:  %-44d%%  ║\n", smoke.percentage);
+        Serial.printf("║    Tendencia:   %-45s  ║\n", smoke.rising ? "EN SUBIDA" : "ESTABLE");
+        Serial.printf("║    Calidad:     %-45s  ║\n", qualityName(smoke.quality));
     } else {
         Serial.println("║  🔥 SENSOR DE HUMO: Inicializando...                         ║");
     }
@@ -136,12 +71,14 @@ void displayFullStatus() {
     Serial.println("╠═══════════════════════════════════════════════════════════════╣");
     
     // SENSOR DE CH4
-    if (ch4Sensor->isReady()) {
-        CH4Reading ch4 = ch4Sensor->getLastReading();
+    if (snapshot.ch4Ready) {
+        const CH4Reading& ch4 = snapshot.ch4;
         Serial.println("║  💨 SENSOR DE METANO (CH4):                                   ║");
-        Serial.printf("║    Estado:      %-45s  ║\n", ch4Sensor->getStateString().c_str());
+        Serial.printf("║    Estado:      %-45s  ║\n", CH4Traits::stateName(ch4.state));
         Serial.printf("║    PPM:         %-45d  ║\n", ch4.ppm);
         Serial.printf("║    LEL:         %-43.2f%%  ║\n", ch4.lel);
+        Serial.printf("║    Tendencia:   %-45s  ║\n", ch4.rising ? "EN SUBIDA" : "ESTABLE");
+        Serial.printf("║    Calidad:     %-45s  ║\n", qualityName(ch4.quality));
     } else {
         Serial.println("║  💨 SENSOR DE METANO: Inicializando...                       ║");
     }
@@ -149,25 +86,34 @@ void displayFullStatus() {
     Serial.println("╠═══════════════════════════════════════════════════════════════╣");
     
     // SENSORES AMBIENTALES
-    if (envSensor->isReady()) {
-        EnvironmentReading env = envSensor->getLastReading();
+    if (snapshot.envReady) {
+        const EnvironmentReading& env = snapshot.env;
         Serial.println("║  🌡️ SENSORES AMBIENTALES:                                     ║");
-        Serial.printf("║    Estado:      %-45s  ║\n", envSensor->getStateString().c_str());
+        Serial.printf("║    Estado:      %-45s  ║\n", EnvironmentSensor::getStateName(env.state));
         Serial.printf("║    Temperatura: %.2f°C (Δ: %+.2f°C, tasa: %.2f°C/min)   ║\n", 
                      env.temperature, env.tempDelta, env.tempRate);
-        Serial.printf("║    Humedad:     %.2f%% (Δ: %+.2f%%)                       ║\n",
-                     env.humidity, env.humidityDelta);
-        Serial.printf("║    Presión:     %.2f hPa (Δ: %+.2f hPa)                   ║\n",
-                     env.pressure, env.pressureDelta);
+        Serial.printf("║    Humedad:     %.2f%% (Δ: %+.2f%%, tasa: %.2f%%/min)      ║\n",
+                     env.humidity, env.humidityDelta, env.humidityRate);
+        Serial.printf("║    Presión:     %.2f hPa (Δ: %+.2f hPa, tasa: %.2f hPa/min) ║\n",
+                     env.pressure, env.pressureDelta, env.pressureRate);
+        Serial.printf("║    Calidad:     %-45s  ║\n", qualityName(env.quality));
         
         // Probabilidad de incendio
-        float fireProbability = envSensor->calculateFireProbability();
         Serial.printf("║    Prob. Incendio: %.1f%%                                     ║\n",
-                     fireProbability * 100);
+                     snapshot.fireProbability * 100);
     } else {
         Serial.println("║  🌡️ SENSORES AMBIENTALES: Error o no disponibles            ║");
     }
     
+    // CALIBRACIONES EN CURSO
+    if (snapshot.smokeCalibration >= 0 || snapshot.ch4Calibration >= 0 || snapshot.envCalibration >= 0) {
+        Serial.println("╠═══════════════════════════════════════════════════════════════╣");
+        Serial.printf("║  ⏳ Calibrando: Humo %3d%%  CH4 %3d%%  Ambiente %3d%%             ║\n",
+                     snapshot.smokeCalibration < 0 ? 0 : snapshot.smokeCalibration,
+                     snapshot.ch4Calibration < 0 ? 0 : snapshot.ch4Calibration,
+                     snapshot.envCalibration < 0 ? 0 : snapshot.envCalibration);
+    }
+    
     Serial.println("╠═══════════════════════════════════════════════════════════════╣");
     
     // ALERTA GLOBAL
@@ -229,6 +175,57 @@ void displayFullStatus() {
     Serial.println("╚═══════════════════════════════════════════════════════════════╝\n");
 }
 
+/**
+ * Suscriptor de cambios del nivel de alerta (TOPIC_ALERT)
+ * Punto de enganche para sirena y notificaciones
+ * (el nivel vigente sale de la instantánea: un evento descartado por cola
+ * llena no deja el estado desactualizado)
+ * @param event Evento con la transición
+ */
+void onAlertTransition(const Event& event, void*) {
+    Serial.println("\n⚠️ ══════ CAMBIO DE NIVEL DE ALERTA ══════ ⚠️");
+    Serial.printf("   %s → %s\n",
+                 SmartAlert::getLevelName(event.alert.from),
+                 SmartAlert::getLevelName(event.alert.to));
+}
+
+// ============================================================
+// COMANDOS DE CONTROL (Serial)
+// ============================================================
+// Los sensores pertenecen a la tarea de sensores: las calibraciones se
+// piden por su buzón y se aplican al comienzo de su próximo ciclo
+
+void processCommands() {
+    if (Serial.available()) {
+        String cmd = Serial.readStringUntil('\n');
+        cmd.trim();
+        
+        if (cmd == "status") {
+            displayFullStatus(sensorTask->getSnapshot());
+        }
+        else if (cmd == "calibrate") {
+            // No bloqueante: avanza con cada lectura, alarmas siguen activas
+            Serial.println("Calibrando todos los sensores...");
+            sensorTask->post(SENSOR_CMD_CALIBRATE_GAS | SENSOR_CMD_CALIBRATE_ENV);
+        }
+        else if (cmd == "baseline") {
+            Serial.println("Calibrando baseline ambiental...");
+            sensorTask->post(SENSOR_CMD_CALIBRATE_ENV);
+        }
+        else if (cmd == "abort") {
+            Serial.println("Cancelando calibraciones en curso...");
+            sensorTask->post(SENSOR_CMD_ABORT_CALIBRATION);
+        }
+        else if (cmd == "test") {
+            Serial.println("Modo TEST - 30 segundos");
+            for (int i = 0; i < 30; i++) {
+                displayFullStatus(sensorTask->getSnapshot());
+                delay(1000);
+            }
+        }
+    }
+}
+
 void setup() {
     // Serial
     if (DEBUG_SERIAL) {
@@ -263,6 +260,36 @@ void setup() {
     envSensor = EnvironmentSensor::getInstance();
     envSensor->begin(I2C_SDA, I2C_SCL);
     
+    // Reglas de alerta de la instalación (si existe el archivo)
+    SmartAlert::loadRules();
+    
+    // Reproducción de una traza grabada (antes de tocar los sensores reales)
+    if (TRACE_REPLAY) {
+        TraceReplayResult replay;
+        TraceReplay::run(TRACE_REPLAY_PATH, TRACE_TIMELINE_PATH, replay);
+    }
+    
+    // Benchmark de tiempo hasta la alerta (escenarios sintéticos)
+    if (ALERT_BENCHMARK) {
+        AlertBenchmark::run(ALERT_BENCHMARK_PATH);
+    }
+    
+    // Eventos de la tarea de sensores (despachados en loop; después de la
+    // reproducción y el benchmark, que publican sus propios cambios de nivel)
+    eventBus = EventBus::getInstance();
+    eventBus->subscribe(onAlertTransition, nullptr, TOPIC_ALERT, PRIORITY_CRITICAL);
+    
+    // Traza de entradas crudas (antes del muestreo: incluye el primer barrido)
+    TraceRecorder::getInstance()->begin(AdcSampler::getInstance()->getChannelCount(),
+                                        ADC_SAMPLE_RATE_HZ, envSensor->getBMP280Calibration());
+    
+    // Muestreo ADC en segundo plano (canales registrados por los sensores)
+    AdcSampler::getInstance()->begin(ADC_SAMPLE_RATE_HZ);
+    
+    // Adquisición y evaluación de alertas en su propia tarea
+    sensorTask = SensorTask::getInstance();
+    sensorTask->begin();
+    
     Serial.println("\n⏳ Tiempos de calentamiento:");
     Serial.println("   • Smoke:     60 segundos");
     Serial.println("   • CH4:       180 segundos (3 min)");
@@ -302,95 +329,80 @@ void loop() {
         otaManager->handle();
     }
     
-    // ========== LECTURA Y ANÁLISIS DE SENSORES ==========
-    if (millis() - lastSensorRead >= SENSOR_READ_INTERVAL) {
-        lastSensorRead = millis();
+    // Traza de sensores a LittleFS (escritura agrupada)
+    TraceRecorder::getInstance()->flush();
+    
+    // Comandos por Serial (calibración, estado)
+    processCommands();
+    
+    // ========== EVENTOS DE LA TAREA DE SENSORES ==========
+    // (antes de la instantánea: sus eventos ya están en cola)
+    eventBus->dispatch();
+    
+    // Pantallas en vivo: entregar el último marco a los clientes que tenían la cola llena
+    LiveEvents::getInstance()->service();
+    TelemetrySocket::getInstance()->service();
+    
+    // ========== RESULTADOS DE LA TAREA DE SENSORES ==========
+    if (sensorTask->getVersion() != lastSnapshotCycle) {
+        SensorSnapshot snapshot = sensorTask->getSnapshot();
+        lastSnapshotCycle = snapshot.cycle;
+        
+        // Radio: dormir en reposo, latencia mínima con actividad
+        wifiManager->setPowerSave(!snapshot.fastSampling);
         
-        // Leer todos los sensores
-        SmokeReading smoke = smokeSensor->read();
-        CH4Reading ch4 = ch4Sensor->read();
-        EnvironmentReading env = envSensor->read();
+        // API web: serializar una vez por ciclo (las peticiones envían el buffer)
+        ReadingsApi::getInstance()->publish(snapshot);
+        LiveEvents::getInstance()->publish(snapshot);
+        TelemetrySocket::getInstance()->publish(snapshot);
         
-        // Evaluar alerta con inteligencia multi-sensor
-        GlobalAlertLevel newAlert = evaluateSmartAlert();
+        // Informar al cambiar el nivel o cada STATUS_DISPLAY_INTERVAL
+        // (con muestreo rápido llegan varias instantáneas por segundo)
+        bool alertChanged = snapshot.alert != currentAlert;
+        currentAlert = snapshot.alert;
         
-        // Detectar cambio de nivel
-        if (newAlert != currentAlert) {
-            currentAlert = newAlert;
-            Serial.println("\n⚠️ ══════ CAMBIO DE NIVEL DE ALERTA ══════ ⚠️");
+        bool report = alertChanged || millis() - lastStatusDisplay >= STATUS_DISPLAY_INTERVAL;
+        if (report) {
+            lastStatusDisplay = millis();
         }
         
         // Mostrar estado completo
-        if (DEBUG_SERIAL) {
-            displayFullStatus();
+        if (DEBUG_SERIAL && report) {
+            displayFullStatus(snapshot);
         }
         
         // ========== ACCIONES SEGÚN NIVEL ==========
         
-        if (currentAlert >= ALERT_FIRE_CONFIRMED) {
-            Serial.println("🚨🚨🚨 ¡¡¡EMERGENCIA!!! 🚨🚨🚨");
-            Serial.println("EVACUAR INMEDIATAMENTE\n");
-            
-            // TODO: Activar sirena máxima
-            // TODO: Enviar notificación de emergencia
-            // TODO: Llamada automática a emergencias
-        }
-        else if (currentAlert == ALERT_FIRE_SUSPECTED) {
-            Serial.println("⚠️ INCENDIO SOSPECHOSO");
-            Serial.println("Verificar situación y preparar evacuación\n");
-            
-            // TODO: Activar alarma
-            // TODO: Notificación urgente
-        }
-        else if (currentAlert == ALERT_WARNING) {
-            Serial.println("🟠 ADVERTENCIA - Múltiples sensores activados");
-            Serial.println("Ventilar área inmediatamente\n");
-            
-            // TODO: Alarma moderada
-            // TODO: Notificación de advertencia
-        }
-        else if (currentAlert == ALERT_COOKING) {
-            Serial.println("🍳 Detección de vapor/cocina - No es peligroso\n");
-            
-            // Solo notificación leve
+        if (report) {
+            if (currentAlert >= ALERT_FIRE_CONFIRMED) {
+                Serial.println("🚨🚨🚨 ¡¡¡EMERGENCIA!!! 🚨🚨🚨");
+                Serial.println("EVACUAR INMEDIATAMENTE\n");
+                
+                // TODO: Activar sirena máxima
+                // TODO: Enviar notificación de emergencia
+                // TODO: Llamada automática a emergencias
+            }
+            else if (currentAlert == ALERT_FIRE_SUSPECTED) {
+                Serial.println("⚠️ INCENDIO SOSPECHOSO");
+                Serial.println("Verificar situación y preparar evacuación\n");
+                
+                // TODO: Activar alarma
+                // TODO: Notificación urgente
+            }
+            else if (currentAlert == ALERT_WARNING) {
+                Serial.println("🟠 ADVERTENCIA - Múltiples sensores activados");
+                Serial.println("Ventilar área inmediatamente\n");
+                
+                // TODO: Alarma moderada
+                // TODO: Notificación de advertencia
+            }
+            else if (currentAlert == ALERT_COOKING) {
+                Serial.println("🍳 Detección de vapor/cocina - No es peligroso\n");
+                
+                // Solo notificación leve
+            }
         }
     }
     
     delay(10);
 }
-
-// ============================================================
-// COMANDOS DE CONTROL (OPCIONAL)
-// ============================================================
-//
-// void processCommands() {
-//     if (Serial.available()) {
-//         String cmd = Serial.readStringUntil('\n');
-//         cmd.trim();
-//         
-//         if (cmd == "status") {
-//             displayFullStatus();
-//         }
-//         else if (cmd == "calibrate") {
-//             Serial.println("Calibrando todos los sensores...");
-//             smokeSensor->calibrate(300, 1000);
-//             ch4Sensor->calibrate(300, 1000);
-//             envSensor->calibrateBaseline();
-//         }
-//         else if (cmd == "baseline") {
-//             Serial.println("Calibrando baseline ambiental...");
-//             envSensor->calibrateBaseline();
-//         }
-//         else if (cmd == "test") {
-//             Serial.println("Modo TEST - 30 segundos");
-//             for (int i = 0; i < 30; i++) {
-//                 smokeSensor->read();
-//                 ch4Sensor->read();
-//                 envSensor->read();
-//                 evaluateSmartAlert();
-//                 displayFullStatus();
-//                 delay(1000);
-//             }
-//         }
-//     }
-// }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "AHT20.h"
+
+// Comandos y bits de estado (datasheet AHT20)
+#define AHT20_CMD_INIT 0xBE
+#define AHT20_CMD_MEASURE 0xAC
+#define AHT20_STATUS_BUSY 0x80
+#define AHT20_STATUS_CALIBRATED 0x08
+
+AHT20Driver::AHT20Driver()
+    : wire(nullptr),
+      address(AHT20_ADDRESS),
+      measuring(false),
+      triggered(false),
+      triggerTime(0),
+      errorCount(0) {
+}
+
+int AHT20Driver::readStatus() {
+    if (wire->requestFrom(address, (uint8_t)1) != 1) {
+        errorCount++;
+        return -1;
+    }
+    return wire->read();
+}
+
+bool AHT20Driver::begin(TwoWire& bus, uint8_t addr) {
+    wire = &bus;
+    address = addr;
+    measuring = false;
+
+    // Tiempo de arranque tras encendido
+    delay(40);
+
+    int status = readStatus();
+    if (status < 0) {
+        return false;
+    }
+
+    // Cargar coeficientes de calibración si el sensor no lo hizo solo
+    if (!(status & AHT20_STATUS_CALIBRATED)) {
+        wire->beginTransmission(address);
+        wire->write(AHT20_CMD_INIT);
+        wire->write(0x08);
+        wire->write(0x00);
+        if (wire->endTransmission() != 0) {
+            errorCount++;
+            return false;
+        }
+        delay(10);
+
+        status = readStatus();
+        if (status < 0 || !(status & AHT20_STATUS_CALIBRATED)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool AHT20Driver::trigger(unsigned long now) {
+    if (wire == nullptr) {
+        return false;
+    }
+
+    // Medición anterior sin leer: solo se reemplaza si quedó colgada
+    if (measuring && (now - triggerTime) < AHT20_TIMEOUT_MS) {
+        return false;
+    }
+
+    // Limitar la frecuencia para que el autocalentamiento no sesgue la temperatura
+    if (triggered && (now - triggerTime) < AHT20_MIN_PERIOD_MS) {
+        return false;
+    }
+
+    wire->beginTransmission(address);
+    wire->write(AHT20_CMD_MEASURE);
+    wire->write(0x33);
+    wire->write(0x00);
+    if (wire->endTransmission() != 0) {
+        errorCount++;
+        measuring = false;
+        return false;
+    }
+
+    measuring = true;
+    triggered = true;
+    triggerTime = now;
+    return true;
+}
+
+bool AHT20Driver::isReady(unsigned long now) const {
+    return measuring && (now - triggerTime) >= AHT20_MEASURE_MS;
+}
+
+bool AHT20Driver::isMeasuring() const {
+    return measuring;
+}
+
+bool AHT20Driver::collect(unsigned long now, float& temperature, float& humidity) {
+    uint32_t rawHumidity;
+    uint32_t rawTemperature;
+    if (!collectRaw(now, rawHumidity, rawTemperature)) {
+        return false;
+    }
+    convert(rawHumidity, rawTemperature, temperature, humidity);
+    return true;
+}
+
+bool AHT20Driver::collectRaw(unsigned long now, uint32_t& rawHumidity, uint32_t& rawTemperature) {
+    if (!isReady(now)) {
+        return false;
+    }
+
+    uint8_t data[7];
+    if (wire->requestFrom(address, (uint8_t)7) != 7) {
+        errorCount++;
+        measuring = false;
+        return false;
+    }
+    for (int i = 0; i < 7; i++) {
+        data[i] = wire->read();
+    }
+
+    // Todavía convirtiendo: se reintenta en la próxima lectura
+    if (data[0] & AHT20_STATUS_BUSY) {
+        return false;
+    }
+
+    measuring = false;
+
+    if (crc8(data, 6) != data[6]) {
+        errorCount++;
+        return false;
+    }
+
+    // 20 bits de humedad y 20 bits de temperatura
+    rawHumidity = ((uint32_t)data[1] << 12) | ((uint32_t)data[2] << 4) | (data[3] >> 4);
+    rawTemperature = ((uint32_t)(data[3] & 0x0F) << 16) | ((uint32_t)data[4] << 8) | data[5];
+    return true;
+}
+
+uint32_t AHT20Driver::getErrorCount() const {
+    return errorCount;
+}
+
+void AHT20Driver::convert(uint32_t rawHumidity, uint32_t rawTemperature, float& temperature, float& humidity) {
+    humidity = rawHumidity * (100.0f / 1048576.0f);
+    temperature = rawTemperature * (200.0f / 1048576.0f) - 50.0f;
+}
+
+uint8_t AHT20Driver::crc8(const uint8_t* data, int length) {
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
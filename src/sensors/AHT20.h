@@ -0,0 +1,104 @@
+/*
+Driver AHT20 (temperatura + humedad) en dos fases:
+
+trigger() inicia la medición (escritura de 3 bytes, no bloquea)
+collect() lee el resultado ~80 ms después (lectura de 7 bytes + CRC)
+Sin esperas activas en el camino de lectura
+*/
+#ifndef AHT20_H
+#define AHT20_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define AHT20_ADDRESS 0x38
+#define AHT20_MEASURE_MS 80         // Tiempo de conversión (datasheet)
+#define AHT20_TIMEOUT_MS 1000       // Medición abandonada si no termina
+#define AHT20_MIN_PERIOD_MS 2000    // Periodo mínimo entre mediciones (autocalentamiento)
+
+class AHT20Driver {
+private:
+    TwoWire* wire;
+    uint8_t address;
+    bool measuring;                 // Hay una medición disparada sin leer
+    bool triggered;                 // Hubo al menos una medición
+    unsigned long triggerTime;
+    uint32_t errorCount;            // NACK, lecturas cortas y CRC incorrecto
+
+    /**
+     * Lee el byte de estado
+     * @return Estado, o -1 si falla el bus
+     */
+    int readStatus();
+
+public:
+    AHT20Driver();
+
+    /**
+     * Detecta el sensor y carga su calibración interna si hace falta
+     * (bloquea ~50 ms: en setup o al recuperar el bus)
+     * @param bus Bus I2C ya inicializado
+     * @param addr Dirección I2C
+     * @return true si el sensor respondió y está calibrado
+     */
+    bool begin(TwoWire& bus = Wire, uint8_t addr = AHT20_ADDRESS);
+
+    /**
+     * Dispara una medición (no bloquea)
+     * @param now Tiempo actual (ms)
+     * @return true si se disparó (false si ya hay una en curso, no pasó
+     *         AHT20_MIN_PERIOD_MS desde la anterior o falla el bus)
+     */
+    bool trigger(unsigned long now);
+
+    /**
+     * Verifica si pasó el tiempo de conversión de la medición en curso
+     * @param now Tiempo actual (ms)
+     */
+    bool isReady(unsigned long now) const;
+
+    /**
+     * Verifica si hay una medición disparada sin leer
+     */
+    bool isMeasuring() const;
+
+    /**
+     * Lee el resultado de la medición en curso (no bloquea)
+     * @param now Tiempo actual (ms)
+     * @param temperature Temperatura en °C
+     * @param humidity Humedad relativa en %
+     * @return true si había un resultado válido (CRC correcto)
+     */
+    bool collect(unsigned long now, float& temperature, float& humidity);
+
+    /**
+     * Igual que collect() pero entrega las palabras crudas de 20 bits
+     * (para registrar trazas; convertir con convert())
+     * @return true si había un resultado válido (CRC correcto)
+     */
+    bool collectRaw(unsigned long now, uint32_t& rawHumidity, uint32_t& rawTemperature);
+
+    /**
+     * Errores de bus acumulados (NACK, lecturas cortas, CRC incorrecto)
+     */
+    uint32_t getErrorCount() const;
+
+    /**
+     * Convierte las palabras crudas a unidades físicas (datasheet)
+     * @param rawHumidity Humedad cruda (20 bits)
+     * @param rawTemperature Temperatura cruda (20 bits)
+     * @param temperature Temperatura en °C
+     * @param humidity Humedad relativa en %
+     */
+    static void convert(uint32_t rawHumidity, uint32_t rawTemperature, float& temperature, float& humidity);
+
+    /**
+     * Verifica el CRC-8 del AHT20 (polinomio 0x31, inicial 0xFF)
+     * @param data Bytes leídos (estado + 5 de datos)
+     * @param length Cantidad de bytes
+     * @return CRC calculado
+     */
+    static uint8_t crc8(const uint8_t* data, int length);
+};
+
+#endif // AHT20_H
@@ -0,0 +1,47 @@
+/*
+Reductor de lotes de muestras ADC:
+
+Cuenta, suma, mínimo y máximo
+Promedio del lote
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef ADCBATCH_H
+#define ADCBATCH_H
+
+#include <stdint.h>
+
+struct AdcBatch {
+    uint32_t count;     // Muestras en el lote
+    uint32_t sum;       // Suma de las muestras
+    uint16_t min;       // Valor mínimo
+    uint16_t max;       // Valor máximo
+
+    AdcBatch() : count(0), sum(0), min(0xFFFF), max(0) {}
+
+    /**
+     * Agrega una muestra al lote
+     */
+    void add(uint16_t sample) {
+        count++;
+        sum += sample;
+        if (sample < min) min = sample;
+        if (sample > max) max = sample;
+    }
+
+    /**
+     * Promedio redondeado del lote (0 si está vacío)
+     */
+    int mean() const {
+        if (count == 0) return 0;
+        return (sum + count / 2) / count;
+    }
+
+    /**
+     * Verifica si el lote no tiene muestras
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+};
+
+#endif // ADCBATCH_H
@@ -0,0 +1,190 @@
+#include "AdcSampler.h"
+#include "../trace/TraceRecorder.h"
+
+// Inicializar instancia estática
+AdcSampler* AdcSampler::instance = nullptr;
+
+AdcSampler::AdcSampler()
+    : channelCount(0),
+      timer(nullptr),
+      rateHz(0),
+      running(false),
+      replaying(false),
+      wakeTask(nullptr) {
+    for (int i = 0; i < ADC_MAX_CHANNELS; i++) {
+        pins[i] = -1;
+        wakeThreshold[i].store(0xFFFF, std::memory_order_relaxed);
+        wakeArmed[i].store(true, std::memory_order_relaxed);
+    }
+}
+
+AdcSampler* AdcSampler::getInstance() {
+    if (instance == nullptr) {
+        instance = new AdcSampler();
+    }
+    return instance;
+}
+
+int AdcSampler::addChannel(int pin) {
+    // Reutilizar canal si el pin ya está registrado
+    for (int i = 0; i < channelCount; i++) {
+        if (pins[i] == pin) {
+            return i;
+        }
+    }
+
+    if (running || channelCount >= ADC_MAX_CHANNELS) {
+        return -1;
+    }
+
+    pins[channelCount] = pin;
+    return channelCount++;
+}
+
+void AdcSampler::onTimer(void* arg) {
+    static_cast<AdcSampler*>(arg)->sampleAll();
+}
+
+void AdcSampler::scan(AdcFrame& frame) {
+    uint32_t start = (uint32_t)esp_timer_get_time();
+
+    AdcScan::run(pins, channelCount, [](int pin) {
+        return (uint16_t)analogRead(pin);
+    }, frame);
+
+    frame.timestampUs = start;
+    frame.durationUs = (uint32_t)esp_timer_get_time() - start;
+}
+
+void AdcSampler::sampleAll() {
+    AdcFrame frame;
+    scan(frame);
+
+    TraceRecorder::getInstance()->recordAdc(frame);
+
+    TaskHandle_t task = wakeTask;
+    if (push(frame) && task != nullptr) {
+        xTaskNotifyGive(task);
+    }
+}
+
+bool AdcSampler::push(const AdcFrame& frame) {
+    bool wake = false;
+    for (int i = 0; i < frame.count; i++) {
+        rings[i].push(frame.values[i]);
+
+        // Flanco ascendente; se rearma al bajar 1/16 por debajo del umbral
+        uint16_t threshold = wakeThreshold[i].load(std::memory_order_relaxed);
+        bool armed = wakeArmed[i].load(std::memory_order_relaxed);
+        if (armed && frame.values[i] >= threshold) {
+            wakeArmed[i].store(false, std::memory_order_relaxed);
+            wake = true;
+        } else if (!armed && frame.values[i] < threshold - threshold / 16) {
+            wakeArmed[i].store(true, std::memory_order_relaxed);
+        }
+    }
+
+    return wake;
+}
+
+void AdcSampler::setReplay(bool enabled) {
+    if (enabled) {
+        stop();
+        for (int i = 0; i < channelCount; i++) {
+            rings[i].drain([](uint16_t) {});
+        }
+    }
+    replaying = enabled;
+}
+
+bool AdcSampler::inject(const AdcFrame& frame) {
+    if (!replaying) {
+        return false;
+    }
+    return push(frame);
+}
+
+bool AdcSampler::isStreaming() const {
+    return running || replaying;
+}
+
+bool AdcSampler::isReplaying() const {
+    return replaying;
+}
+
+int AdcSampler::getChannelCount() const {
+    return channelCount;
+}
+
+void AdcSampler::setWakeTask(TaskHandle_t task) {
+    wakeTask = task;
+}
+
+void AdcSampler::setWakeThreshold(int channel, uint16_t threshold) {
+    if (channel < 0 || channel >= ADC_MAX_CHANNELS) {
+        return;
+    }
+    wakeThreshold[channel].store(threshold, std::memory_order_relaxed);
+    wakeArmed[channel].store(true, std::memory_order_relaxed);
+}
+
+bool AdcSampler::begin(uint32_t sampleRateHz) {
+    if (running) {
+        return true;
+    }
+
+    if (channelCount == 0 || sampleRateHz == 0) {
+        return false;
+    }
+
+    if (timer == nullptr) {
+        esp_timer_create_args_t args = {};
+        args.callback = &AdcSampler::onTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "adc_sampler";
+
+        if (esp_timer_create(&args, &timer) != ESP_OK) {
+            if (DEBUG_SERIAL) {
+                Serial.println("❌ Error creando timer de muestreo ADC");
+            }
+            return false;
+        }
+    }
+
+    if (esp_timer_start_periodic(timer, 1000000ULL / sampleRateHz) != ESP_OK) {
+        return false;
+    }
+
+    rateHz = sampleRateHz;
+    running = true;
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Muestreo ADC: %d canales @ %u Hz (%dx, %d bits)\n",
+                     channelCount, rateHz, ADC_OVERSAMPLE, ADC_SCAN_BITS);
+    }
+
+    return true;
+}
+
+void AdcSampler::stop() {
+    if (running) {
+        esp_timer_stop(timer);
+        running = false;
+    }
+}
+
+bool AdcSampler::isRunning() const {
+    return running;
+}
+
+uint32_t AdcSampler::getSampleRate() const {
+    return rateHz;
+}
+
+uint32_t AdcSampler::getDropped(int channel) const {
+    if (channel < 0 || channel >= channelCount) {
+        return 0;
+    }
+    return rings[channel].getDropped();
+}
@@ -0,0 +1,175 @@
+/*
+Muestreo ADC en segundo plano:
+
+Timer periódico como productor
+Barrido intercalado y sobremuestreado de todos los canales (ver AdcScan.h)
+Una cola lock-free por canal (muestras en escala ADC_SCAN_BITS)
+Drenado y reducción desde read() de cada sensor
+Aviso a una tarea cuando un canal cruza su umbral (despertar anticipado)
+Barridos registrados en la traza (TraceRecorder) o inyectados al reproducirla
+*/
+#ifndef ADCSAMPLER_H
+#define ADCSAMPLER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include "AdcBatch.h"
+#include "AdcScan.h"
+#include "../config/Config.h"
+#include "../utils/SpscRing.h"
+
+class AdcSampler {
+private:
+    static AdcSampler* instance;
+
+    int pins[ADC_MAX_CHANNELS];
+    SpscRing<uint16_t, ADC_RING_SIZE> rings[ADC_MAX_CHANNELS];
+    int channelCount;
+    esp_timer_handle_t timer;
+    uint32_t rateHz;
+    bool running;
+    bool replaying;             // Barridos inyectados desde una traza
+
+    // Despertar anticipado (escala ADC_SCAN_BITS, 0xFFFF = desactivado)
+    // Escritos por la tarea de sensores y leídos por la tarea esp_timer
+    std::atomic<uint16_t> wakeThreshold[ADC_MAX_CHANNELS];
+    std::atomic<bool> wakeArmed[ADC_MAX_CHANNELS];
+    TaskHandle_t wakeTask;
+
+    AdcSampler(); // Constructor privado
+
+    /**
+     * Callback del timer (tarea esp_timer)
+     */
+    static void onTimer(void* arg);
+
+    /**
+     * Barre todos los canales y encola una muestra por canal
+     */
+    void sampleAll();
+
+    /**
+     * Encola un barrido y evalúa los umbrales de despertar
+     * @return true si algún canal cruzó su umbral
+     */
+    bool push(const AdcFrame& frame);
+
+public:
+    /**
+     * Obtiene la instancia única de AdcSampler (Singleton)
+     * @return Puntero a la instancia de AdcSampler
+     */
+    static AdcSampler* getInstance();
+
+    /**
+     * Registra un pin analógico (antes de begin())
+     * @param pin Pin GPIO analógico
+     * @return Índice del canal, o -1 si no hay espacio
+     */
+    int addChannel(int pin);
+
+    /**
+     * Inicia el muestreo periódico
+     * @param sampleRateHz Frecuencia de muestreo por canal
+     * @return true si el timer se inició correctamente
+     */
+    bool begin(uint32_t sampleRateHz = ADC_SAMPLE_RATE_HZ);
+
+    /**
+     * Detiene el muestreo
+     */
+    void stop();
+
+    /**
+     * Verifica si el muestreo está activo
+     */
+    bool isRunning() const;
+
+    /**
+     * Obtiene la frecuencia de muestreo actual
+     */
+    uint32_t getSampleRate() const;
+
+    /**
+     * Tarea a notificar (xTaskNotifyGive) cuando un canal cruza su umbral
+     * @param task Tarea destino (nullptr para desactivar)
+     */
+    void setWakeTask(TaskHandle_t task);
+
+    /**
+     * Umbral de despertar de un canal (flanco ascendente, con histéresis)
+     * @param channel Índice devuelto por addChannel()
+     * @param threshold Umbral en escala ADC_SCAN_BITS (0xFFFF desactiva)
+     */
+    void setWakeThreshold(int channel, uint16_t threshold);
+
+    /**
+     * Barrido inmediato de todos los canales (muestras alineadas en el tiempo)
+     * No usar desde otra tarea mientras el muestreo está activo.
+     * @param frame Resultado en escala ADC_SCAN_BITS
+     */
+    void scan(AdcFrame& frame);
+
+    /**
+     * Activa la reproducción de trazas (detiene el timer)
+     * Los sensores consumen los barridos de inject() como si fueran del timer.
+     * Descarta las muestras pendientes (no se mezclan con las inyectadas).
+     * @param enabled true para reproducir
+     */
+    void setReplay(bool enabled);
+
+    /**
+     * Encola un barrido grabado (reproducción)
+     * @param frame Barrido en escala ADC_SCAN_BITS
+     * @return true si algún canal cruzó su umbral de despertar
+     */
+    bool inject(const AdcFrame& frame);
+
+    /**
+     * Verifica si llegan barridos (timer activo o reproducción)
+     */
+    bool isStreaming() const;
+
+    /**
+     * Verifica si los barridos vienen de una traza (reproducción o benchmark)
+     */
+    bool isReplaying() const;
+
+    /**
+     * Cantidad de canales registrados
+     */
+    int getChannelCount() const;
+
+    /**
+     * Consume todas las muestras acumuladas de un canal
+     * Las muestras de distintos canales con igual posición pertenecen
+     * al mismo barrido.
+     * @param channel Índice devuelto por addChannel()
+     * @param onSample Callback invocado con cada muestra (escala ADC_SCAN_BITS)
+     * @return Resumen del lote consumido
+     */
+    template <typename Fn>
+    AdcBatch drain(int channel, Fn onSample) {
+        AdcBatch batch;
+        if (channel < 0 || channel >= channelCount) {
+            return batch;
+        }
+
+        rings[channel].drain([&](uint16_t sample) {
+            batch.add(sample);
+            onSample(sample);
+        });
+
+        return batch;
+    }
+
+    /**
+     * Muestras descartadas por cola llena en un canal
+     */
+    uint32_t getDropped(int channel) const;
+};
+
+#endif // ADCSAMPLER_H
@@ -0,0 +1,80 @@
+/*
+Barrido ADC intercalado con sobremuestreo:
+
+Un barrido toma N conversiones de cada canal en ronda (ch0, ch1, ch0, ch1...)
+Todas las salidas de un barrido quedan alineadas en el tiempo
+Diezmado a 12 + ADC_OVERSAMPLE_BITS bits (con ruido ≥ 1 LSB como dither)
+Parámetros en config/Config.h (ADC_OVERSAMPLE, ADC_OVERSAMPLE_BITS)
+*/
+#ifndef ADCSCAN_H
+#define ADCSCAN_H
+
+#include <stdint.h>
+#include "../config/Config.h"
+
+#define ADC_NATIVE_BITS 12
+#define ADC_SCAN_BITS (ADC_NATIVE_BITS + ADC_OVERSAMPLE_BITS)
+#define ADC_SCAN_SCALE (1 << ADC_OVERSAMPLE_BITS)   // Valor de barrido por LSB nativo
+
+static_assert(ADC_OVERSAMPLE >= 1, "ADC_OVERSAMPLE debe ser >= 1");
+static_assert(ADC_SCAN_BITS <= 16, "ADC_OVERSAMPLE_BITS: máximo 4 (16 bits)");
+
+// Resultado de un barrido: una muestra por canal, misma ventana de tiempo
+struct AdcFrame {
+    uint16_t values[ADC_MAX_CHANNELS];  // Escala ADC_SCAN_BITS
+    uint8_t count;                      // Canales válidos
+    uint32_t timestampUs;               // Inicio del barrido
+    uint32_t durationUs;                // Duración del barrido
+};
+
+namespace AdcScan {
+    /**
+     * Diezma la suma de N conversiones a ADC_SCAN_BITS bits (redondeado)
+     * Para N = 4^k y extraBits = k equivale a sum >> k.
+     * @param sum Suma de las conversiones de 12 bits
+     * @param count Número de conversiones sumadas
+     * @return Valor diezmado en escala ADC_SCAN_BITS
+     */
+    inline uint16_t decimate(uint32_t sum, uint32_t count) {
+        if (count == 0) {
+            return 0;
+        }
+        uint32_t scaled = ((sum << ADC_OVERSAMPLE_BITS) + count / 2) / count;
+        const uint32_t maxValue = (1u << ADC_SCAN_BITS) - 1;
+        return (uint16_t)(scaled > maxValue ? maxValue : scaled);
+    }
+
+    /**
+     * Barre los canales de forma intercalada y diezma
+     * @param pins Pines de cada canal
+     * @param count Número de canales
+     * @param readFn Conversión de un pin: uint16_t readFn(int pin)
+     * @param frame Resultado del barrido
+     */
+    template <typename ReadFn>
+    void run(const int* pins, int count, ReadFn readFn, AdcFrame& frame) {
+        uint32_t sums[ADC_MAX_CHANNELS] = {0};
+        if (count > ADC_MAX_CHANNELS) count = ADC_MAX_CHANNELS;
+
+        for (int k = 0; k < ADC_OVERSAMPLE; k++) {
+            for (int i = 0; i < count; i++) {
+                sums[i] += readFn(pins[i]);
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            frame.values[i] = decimate(sums[i], ADC_OVERSAMPLE);
+        }
+        frame.count = (uint8_t)count;
+    }
+
+    /**
+     * Convierte un valor de barrido a la escala nativa de 12 bits (redondeado)
+     */
+    inline int toNative(uint32_t value) {
+        uint32_t native = (value + ADC_SCAN_SCALE / 2) >> ADC_OVERSAMPLE_BITS;
+        return native > 4095 ? 4095 : (int)native;
+    }
+}
+
+#endif // ADCSCAN_H
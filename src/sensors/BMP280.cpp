@@ -0,0 +1,166 @@
+#include "BMP280.h"
+
+// Registros (datasheet BMP280)
+#define BMP280_REG_CALIB 0x88
+#define BMP280_REG_CHIP_ID 0xD0
+#define BMP280_REG_CTRL_MEAS 0xF4
+#define BMP280_REG_CONFIG 0xF5
+#define BMP280_REG_DATA 0xF7
+
+// Configuración: osrs_t x2, osrs_p x16, modo normal / standby 500 ms, filtro x16
+#define BMP280_CTRL_MEAS ((0x02 << 5) | (0x05 << 2) | 0x03)
+#define BMP280_CONFIG ((0x04 << 5) | (0x04 << 2))
+
+BMP280Driver::BMP280Driver()
+    : wire(nullptr),
+      address(BMP280_ADDRESS),
+      calib(),
+      errorCount(0) {
+}
+
+bool BMP280Driver::writeRegister(uint8_t reg, uint8_t value) {
+    wire->beginTransmission(address);
+    wire->write(reg);
+    wire->write(value);
+    if (wire->endTransmission() != 0) {
+        errorCount++;
+        return false;
+    }
+    return true;
+}
+
+bool BMP280Driver::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length) {
+    wire->beginTransmission(address);
+    wire->write(reg);
+    if (wire->endTransmission(false) != 0) {
+        errorCount++;
+        return false;
+    }
+
+    if (wire->requestFrom(address, length) != length) {
+        errorCount++;
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[i] = wire->read();
+    }
+    return true;
+}
+
+bool BMP280Driver::begin(TwoWire& bus, uint8_t addr) {
+    wire = &bus;
+    address = addr;
+
+    uint8_t id = 0;
+    if (!readRegisters(BMP280_REG_CHIP_ID, &id, 1) || id != BMP280_CHIP_ID) {
+        return false;
+    }
+
+    // Coeficientes little-endian: T1..T3, P1..P9
+    uint8_t raw[24];
+    if (!readRegisters(BMP280_REG_CALIB, raw, sizeof(raw))) {
+        return false;
+    }
+
+    uint16_t words[12];
+    for (int i = 0; i < 12; i++) {
+        words[i] = (uint16_t)(raw[2 * i] | (raw[2 * i + 1] << 8));
+    }
+
+    calib.digT1 = words[0];
+    calib.digT2 = (int16_t)words[1];
+    calib.digT3 = (int16_t)words[2];
+    calib.digP1 = words[3];
+    calib.digP2 = (int16_t)words[4];
+    calib.digP3 = (int16_t)words[5];
+    calib.digP4 = (int16_t)words[6];
+    calib.digP5 = (int16_t)words[7];
+    calib.digP6 = (int16_t)words[8];
+    calib.digP7 = (int16_t)words[9];
+    calib.digP8 = (int16_t)words[10];
+    calib.digP9 = (int16_t)words[11];
+
+    // config solo se escribe de forma fiable en modo sleep
+    return writeRegister(BMP280_REG_CTRL_MEAS, 0x00) &&
+           writeRegister(BMP280_REG_CONFIG, BMP280_CONFIG) &&
+           writeRegister(BMP280_REG_CTRL_MEAS, BMP280_CTRL_MEAS);
+}
+
+bool BMP280Driver::read(int32_t& temperatureCenti, uint32_t& pressureQ8) {
+    int32_t adcT;
+    int32_t adcP;
+    if (!readRaw(adcT, adcP)) {
+        return false;
+    }
+    return compensate(adcT, adcP, temperatureCenti, pressureQ8);
+}
+
+bool BMP280Driver::readRaw(int32_t& adcT, int32_t& adcP) {
+    if (wire == nullptr) {
+        return false;
+    }
+
+    // press_msb, press_lsb, press_xlsb, temp_msb, temp_lsb, temp_xlsb
+    uint8_t data[6];
+    if (!readRegisters(BMP280_REG_DATA, data, sizeof(data))) {
+        return false;
+    }
+
+    adcP = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+    adcT = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
+
+    // 0x80000: sin medición todavía (valor de reset)
+    return adcT != 0x80000 && adcP != 0x80000;
+}
+
+bool BMP280Driver::compensate(int32_t adcT, int32_t adcP, int32_t& temperatureCenti, uint32_t& pressureQ8) const {
+    int32_t tFine;
+    temperatureCenti = compensateTemperature(calib, adcT, tFine);
+    pressureQ8 = compensatePressure(calib, adcP, tFine);
+    return pressureQ8 != 0;
+}
+
+uint32_t BMP280Driver::getErrorCount() const {
+    return errorCount;
+}
+
+const BMP280Calibration& BMP280Driver::getCalibration() const {
+    return calib;
+}
+
+void BMP280Driver::setCalibration(const BMP280Calibration& calibration) {
+    calib = calibration;
+}
+
+int32_t BMP280Driver::compensateTemperature(const BMP280Calibration& cal, int32_t adcT, int32_t& tFine) {
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)cal.digT1 << 1))) * ((int32_t)cal.digT2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - ((int32_t)cal.digT1)) *
+                      ((adcT >> 4) - ((int32_t)cal.digT1))) >> 12) *
+                    ((int32_t)cal.digT3)) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t BMP280Driver::compensatePressure(const BMP280Calibration& cal, int32_t adcP, int32_t tFine) {
+    int64_t var1 = ((int64_t)tFine) - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)cal.digP6;
+    var2 = var2 + ((var1 * (int64_t)cal.digP5) << 17);
+    var2 = var2 + (((int64_t)cal.digP4) << 35);
+    var1 = ((var1 * var1 * (int64_t)cal.digP3) >> 8) + ((var1 * (int64_t)cal.digP2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)cal.digP1) >> 33;
+
+    if (var1 == 0) {
+        return 0;  // Evitar división por cero
+    }
+
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)cal.digP9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)cal.digP8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)cal.digP7) << 4);
+    return (uint32_t)p;
+}
+
+float BMP280Driver::altitude(float pressureHPa, float seaLevelHPa) {
+    return 44330.0f * (1.0f - powf(pressureHPa / seaLevelHPa, 0.1903f));
+}
@@ -0,0 +1,112 @@
+/*
+Driver BMP280 (presión + temperatura):
+
+Modo normal: el sensor mide solo, cada lectura es un único burst de 6 bytes
+Compensación entera de Bosch (temperatura 32 bits, presión 64 bits)
+Coeficientes de calibración leídos una vez en begin()
+*/
+#ifndef BMP280_H
+#define BMP280_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define BMP280_ADDRESS 0x76
+#define BMP280_ADDRESS_ALT 0x77
+#define BMP280_CHIP_ID 0x58
+
+// Coeficientes de calibración (registros 0x88-0x9F)
+struct BMP280Calibration {
+    uint16_t digT1;
+    int16_t digT2, digT3;
+    uint16_t digP1;
+    int16_t digP2, digP3, digP4, digP5, digP6, digP7, digP8, digP9;
+};
+
+class BMP280Driver {
+private:
+    TwoWire* wire;
+    uint8_t address;
+    BMP280Calibration calib;
+    uint32_t errorCount;            // NACK y lecturas cortas
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length);
+
+public:
+    BMP280Driver();
+
+    /**
+     * Detecta el sensor, lee la calibración y lo configura en modo normal
+     * (temp x2, presión x16, filtro x16, standby 500 ms)
+     * @param bus Bus I2C ya inicializado
+     * @param addr Dirección I2C (0x76 o 0x77)
+     * @return true si el chip respondió con el ID correcto
+     */
+    bool begin(TwoWire& bus = Wire, uint8_t addr = BMP280_ADDRESS);
+
+    /**
+     * Lee presión y temperatura en un único burst (0xF7-0xFC)
+     * @param temperatureCenti Temperatura en centésimas de °C
+     * @param pressureQ8 Presión en Pa con 8 bits fraccionarios (Q24.8)
+     * @return true si la lectura fue válida
+     */
+    bool read(int32_t& temperatureCenti, uint32_t& pressureQ8);
+
+    /**
+     * Igual que read() pero sin compensar (para registrar trazas)
+     * @param adcT Temperatura cruda (20 bits)
+     * @param adcP Presión cruda (20 bits)
+     * @return true si el sensor ya tenía una medición
+     */
+    bool readRaw(int32_t& adcT, int32_t& adcP);
+
+    /**
+     * Compensa valores crudos con la calibración del sensor
+     * @return true si la presión es válida
+     */
+    bool compensate(int32_t adcT, int32_t adcP, int32_t& temperatureCenti, uint32_t& pressureQ8) const;
+
+    /**
+     * Coeficientes leídos en begin() (o fijados por setCalibration())
+     */
+    const BMP280Calibration& getCalibration() const;
+
+    /**
+     * Reemplaza los coeficientes (reproducción de trazas sin sensor)
+     */
+    void setCalibration(const BMP280Calibration& calibration);
+
+    /**
+     * Errores de bus acumulados (NACK, lecturas cortas)
+     */
+    uint32_t getErrorCount() const;
+
+    /**
+     * Compensación de temperatura (Bosch, entera)
+     * @param cal Coeficientes de calibración
+     * @param adcT Valor crudo de 20 bits
+     * @param tFine Valor intermedio para la compensación de presión
+     * @return Temperatura en centésimas de °C
+     */
+    static int32_t compensateTemperature(const BMP280Calibration& cal, int32_t adcT, int32_t& tFine);
+
+    /**
+     * Compensación de presión (Bosch, entera de 64 bits)
+     * @param cal Coeficientes de calibración
+     * @param adcP Valor crudo de 20 bits
+     * @param tFine Resultado de compensateTemperature()
+     * @return Presión en Pa Q24.8 (0 si la calibración es inválida)
+     */
+    static uint32_t compensatePressure(const BMP280Calibration& cal, int32_t adcP, int32_t tFine);
+
+    /**
+     * Altitud barométrica aproximada
+     * @param pressureHPa Presión medida
+     * @param seaLevelHPa Presión a nivel del mar
+     * @return Metros
+     */
+    static float altitude(float pressureHPa, float seaLevelHPa = 1013.25);
+};
+
+#endif // BMP280_H
@@ -2,91 +2,103 @@
 #define CH4SENSOR_H
 
 #include <Arduino.h>
+#include "GasSensor.h"
+#include "../config/Config.h"
 
-// Estados del sensor
-enum class CH4State {
-    INITIALIZING,   // Inicializando/calentando
-    NORMAL,         // Aire limpio
-    DETECTED,       // Metano detectado
-    CRITICAL,       // Nivel crítico de metano
-    EXPLOSIVE,      // Nivel explosivo (> 5% LEL)
-    ERROR           // Error de lectura
-};
+// Filtro de suavizado por muestra (ver utils/Filters.h)
+// Alternativas: EmaFilter<3>, MedianFilter<7>, HampelFilter<7, 30>
+typedef BoxcarFilter<CH4_FILTER_LOG2> CH4Filter;  // Promedio de 2^CH4_FILTER_LOG2 muestras
 
-// Estructura de calibración
-struct CH4Calibration {
-    int baselineMin;        // Valor mínimo en aire limpio
-    int baselineMax;        // Valor máximo en aire limpio
-    int baselineAvg;        // Promedio del baseline
-    int thresholdCaution;   // Umbral de precaución (~0.5% LEL)
-    int thresholdWarning;   // Umbral de advertencia (~2% LEL)
-    int thresholdAlarm;     // Umbral de alarma (~4% LEL)
-    int thresholdExplosive; // Umbral explosivo (~5% LEL)
-    bool isCalibrated;      // ¿Está calibrado?
-};
+// Parámetros del sensor de metano para GasSensor
+struct CH4Traits {
+    typedef CH4State State;
+    typedef CH4Filter Filter;
+
+    static constexpr const char* NAME = "CH4";
+    static constexpr const char* CAL_PATH = "/ch4_cal.txt";
+    static constexpr const char* ANCHOR_PATH = "/ch4_anchor.txt";
+    static constexpr unsigned long WARMUP_TIME = 180000;    // 3 minutos
+    static constexpr bool CALIBRATE_REQUIRES_WARMUP = true;
+
+    static constexpr GasCalibration DEFAULT_CALIBRATION = {
+        0, 500, 250,        // min, max, avg
+        500,                // caution   (~0.5% LEL)
+        1000,               // warning   (~2% LEL)
+        1800,               // alarm     (~4% LEL)
+        2200,               // explosive (~5% LEL)
+        false
+    };
+
+    // Umbrales más conservadores para CH4 (gas explosivo)
+    // Persistidos en CSV: min,max,avg,caution,warning,alarm,explosive
+    static constexpr GasThresholdSpec THRESHOLDS[] = {
+        { &GasCalibration::thresholdCaution,    3, "Caution:" },
+        { &GasCalibration::thresholdWarning,    6, "Warning:" },
+        { &GasCalibration::thresholdAlarm,     10, "Alarm:" },
+        { &GasCalibration::thresholdExplosive, 12, "Explosive:" }
+    };
+
+    static constexpr GasStateRule<CH4State> STATE_TABLE[] = {
+        { &GasCalibration::thresholdExplosive, CH4State::EXPLOSIVE },
+        { &GasCalibration::thresholdAlarm,     CH4State::CRITICAL },
+        { &GasCalibration::thresholdWarning,   CH4State::DETECTED }
+    };
+
+    static constexpr int GasCalibration::* PERCENT_REFERENCE = &GasCalibration::thresholdExplosive;
+    static constexpr long UNCALIBRATED_PPM_MAX = 50000;
+    static constexpr long LEL_PPM = 50000;  // 5% de CH4 en aire = Lower Explosive Limit
 
-// Estructura de lectura del sensor
-struct CH4Reading {
-    int rawValue;           // Valor crudo ADC (0-4095)
-    float voltage;          // Voltaje (0-3.3V)
-    int percentage;         // Porcentaje (0-100%)
-    int ppm;                // Partes por millón
-    float lel;              // Lower Explosive Limit percentage (0-100%)
-    CH4State state;         // Estado actual
-    unsigned long timestamp; // Timestamp de la lectura
+    // Curva MQ-4 para metano (datasheet), usada con GAS_PPM_CURVE_LOGLOG
+    static constexpr GasCurvePoint CURVE[] = {
+        { 1.80f, 200 }, { 1.00f, 1000 }, { 0.60f, 5000 }, { 0.43f, 10000 }
+    };
+    static constexpr float CLEAN_AIR_RATIO = 4.4f;
+
+    // Corrección temperatura × humedad (datasheet MQ-4, Rs/R0 relativo a las
+    // condiciones de ensayo 20 °C / 65 %HR). Ganancia sobre la lectura: con Rs >> RL
+    // la lectura es ∝ 1/Rs
+    static constexpr const char* COMP_PATH = "/ch4_comp.txt";
+    static constexpr int16_t COMP_TEMPS[] = { -100, 0, 200, 400, 500 };    // Décimas de °C
+    static constexpr int16_t COMP_HUMIDITIES[] = { 330, 850 };             // Décimas de %
+    static constexpr uint16_t COMP_GAINS[] = {     // Q12, fila por temperatura
+        4825, 4480,     // -10 °C: 1.18  1.09
+        4610, 4222,     //   0 °C: 1.13  1.03
+        4308, 3963,     //  20 °C: 1.05  0.97
+        4093, 3748,     //  40 °C: 1.00  0.92
+        4007, 3662      //  50 °C: 0.98  0.89
+    };
+
+    /**
+     * Mapea la desviación al rango de PPM (0 a LEL en el umbral explosivo)
+     */
+    static long deviationToPPM(long deviation, const GasCalibration& cal) {
+        long range = cal.thresholdExplosive - cal.baselineAvg;
+        if (range <= 0) range = 1;
+        return deviation * LEL_PPM / range;
+    }
+
+    static const char* stateName(CH4State state) {
+        switch (state) {
+            case CH4State::INITIALIZING: return "INITIALIZING";
+            case CH4State::NORMAL:       return "NORMAL";
+            case CH4State::DETECTED:     return "DETECTED";
+            case CH4State::CRITICAL:     return "CRITICAL";
+            case CH4State::EXPLOSIVE:    return "EXPLOSIVE";
+            case CH4State::ERROR:        return "ERROR";
+            default:                     return "UNKNOWN";
+        }
+    }
 };
 
-class CH4Sensor {
+// Estructuras públicas (compatibles con la API anterior)
+typedef GasCalibration CH4Calibration;
+
+class CH4Sensor : public GasSensor<CH4Traits> {
 private:
     static CH4Sensor* instance;
-    int pin;
-    CH4Calibration calibration;
-    CH4Reading lastReading;
-    
-    // Variables de warmup (CH4 necesita más tiempo)
-    unsigned long warmupStartTime;
-    bool isWarmedUp;
-    static const unsigned long WARMUP_TIME = 180000; // 3 minutos
-    
-    // Variables de lectura suavizada
-    static const int SAMPLE_SIZE = 15;  // Más muestras para CH4
-    int readings[SAMPLE_SIZE];
-    int readIndex;
-    long total;
-    
+
     CH4Sensor(int sensorPin); // Constructor privado
-    
-    /**
-     * Lee el valor crudo del ADC con promediado
-     */
-    int readRawValue();
-    
-    /**
-     * Convierte valor ADC a voltaje
-     */
-    float rawToVoltage(int raw);
-    
-    /**
-     * Convierte valor ADC a porcentaje
-     */
-    int rawToPercentage(int raw);
-    
-    /**
-     * Estima PPM basado en calibración
-     */
-    int rawToPPM(int raw);
-    
-    /**
-     * Estima LEL (Lower Explosive Limit) percentage
-     * CH4 LEL = 5% en aire (50,000 PPM)
-     */
-    float rawToLEL(int raw);
-    
-    /**
-     * Determina el estado basado en el valor
-     */
-    CH4State determineState(int raw);
-    
+
 public:
     /**
      * Obtiene la instancia única de CH4Sensor (Singleton)
@@ -94,105 +106,32 @@ public:
      * @return Puntero a la instancia de CH4Sensor
      */
     static CH4Sensor* getInstance(int sensorPin = 39);
-    
+
     /**
-     * Inicializa el sensor
+     * Inicializa el sensor y muestra las advertencias de seguridad
      * @param enableWarmup Si true, esperará el tiempo de calentamiento (3 min)
      * @return true si se inicializó correctamente
      */
     bool begin(bool enableWarmup = true);
-    
-    /**
-     * Calibra el sensor en aire limpio
-     * @param samples Número de muestras a tomar
-     * @param delayMs Delay entre muestras
-     * @return true si la calibración fue exitosa
-     */
-    bool calibrate(int samples = 300, int delayMs = 1000);
-    
-    /**
-     * Lee el sensor y actualiza el estado
-     * @return Estructura con la lectura completa
-     */
-    CH4Reading read();
-    
-    /**
-     * Verifica si el sensor está listo (warmed up)
-     * @return true si el sensor está listo para usar
-     */
-    bool isReady() const;
-    
-    /**
-     * Obtiene la última lectura sin leer nuevamente
-     * @return Última lectura almacenada
-     */
-    CH4Reading getLastReading() const;
-    
-    /**
-     * Obtiene el estado actual del sensor
-     * @return Estado actual
-     */
-    CH4State getState() const;
-    
-    /**
-     * Obtiene la calibración actual
-     * @return Estructura de calibración
-     */
-    CH4Calibration getCalibration() const;
-    
-    /**
-     * Carga calibración desde archivo (si existe)
-     * @return true si se cargó correctamente
-     */
-    bool loadCalibration();
-    
-    /**
-     * Guarda calibración en archivo
-     * @return true si se guardó correctamente
-     */
-    bool saveCalibration();
-    
-    /**
-     * Resetea la calibración a valores por defecto
-     */
-    void resetCalibration();
-    
-    /**
-     * Obtiene el estado como string
-     * @return Texto descriptivo del estado
-     */
-    String getStateString() const;
-    
+
     /**
      * Verifica si hay metano detectado (cualquier nivel)
      * @return true si hay metano
      */
     bool isCH4Detected() const;
-    
+
     /**
      * Verifica si es nivel crítico
      * @return true si es crítico
      */
     bool isCritical() const;
-    
+
     /**
      * Verifica si está en nivel explosivo (>5% LEL)
      * @return true si es nivel explosivo
      */
     bool isExplosive() const;
-    
-    /**
-     * Obtiene el porcentaje del último reading
-     * @return Porcentaje 0-100
-     */
-    int getPercentage() const;
-    
-    /**
-     * Obtiene PPM del último reading
-     * @return PPM estimado
-     */
-    int getPPM() const;
-    
+
     /**
      * Obtiene LEL percentage del último reading
      * @return LEL% (0-100%, donde 100% = 5% CH4 en aire)
@@ -200,4 +139,4 @@ public:
     float getLEL() const;
 };
 
-#endif // CH4SENSOR_H
\ No newline at end of file
+#endif // CH4SENSOR_H
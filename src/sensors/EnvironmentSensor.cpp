@@ -1,6 +1,9 @@
 #include "EnvironmentSensor.h"
+#include "I2CBus.h"
 #include "../storage/FileManager.h"
 #include "../config/Config.h"
+#include "../utils/Clock.h"
+#include "../trace/TraceRecorder.h"
 
 // Ruta del archivo de baseline
 #define ENV_BASELINE_PATH "/env_baseline.txt"
@@ -13,22 +16,38 @@
 #define HUMIDITY_HIGH_THRESHOLD 80.0    // % - Humedad alta
 #define PRESSURE_DROP_THRESHOLD -5.0    // hPa - Caída significativa
 
+// Rango de operación de AHT20 y BMP280 (fuera: lectura inválida)
+#define ENV_TEMP_MIN -40.0              // °C
+#define ENV_TEMP_MAX 85.0               // °C
+#define ENV_PRESSURE_MIN 300.0          // hPa
+#define ENV_PRESSURE_MAX 1100.0         // hPa
+
 // Inicializar instancia estática
 EnvironmentSensor* EnvironmentSensor::instance = nullptr;
 
 EnvironmentSensor::EnvironmentSensor() 
-    : aht20Ready(false),
-      bmp280Ready(false) {
-    
-    // Inicializar tendencias
-    tempTrend.index = 0;
-    pressureTrend.index = 0;
-    for (int i = 0; i < 10; i++) {
-        tempTrend.values[i] = 0;
-        tempTrend.times[i] = 0;
-        pressureTrend.values[i] = 0;
-        pressureTrend.times[i] = 0;
-    }
+    : ahtTemperature(0),
+      ahtHumidity(0),
+      lastReading(),
+      tempTrend(ENV_TREND_WINDOW_MS),
+      humidityTrend(ENV_TREND_WINDOW_MS),
+      pressureTrend(ENV_TREND_WINDOW_MS),
+      lastTempTrendTime(0),
+      lastPressureTrendTime(0),
+      aht20Ready(false),
+      bmp280Ready(false),
+      busSdaPin(I2C_SDA),
+      busSclPin(I2C_SCL),
+      ahtHealth(HEALTH_I2C_MAX_ERRORS, HEALTH_STALE_MS, HEALTH_OFFLINE_MS,
+                HEALTH_RECOVERY_BACKOFF, HEALTH_RECOVERY_BACKOFF_MAX),
+      bmpHealth(HEALTH_I2C_MAX_ERRORS, HEALTH_STALE_MS, HEALTH_OFFLINE_MS,
+                HEALTH_RECOVERY_BACKOFF, HEALTH_RECOVERY_BACKOFF_MAX),
+      ahtFrames(INT32_MIN, INT32_MAX, HEALTH_STUCK_READS, 0, 0),
+      bmpFrames(INT32_MIN, INT32_MAX, HEALTH_STUCK_READS, 0, 0),
+      disagreeCount(0),
+      replaying(false),
+      replayRaw(),
+      lastCalibrationLog(0) {
     
     // Baseline por defecto
     resetBaseline();
@@ -46,14 +65,17 @@ bool EnvironmentSensor::initAHT20() {
         Serial.print("  Inicializando AHT20... ");
     }
     
-    if (aht20.begin()) {
+    if (aht20.begin(Wire)) {
         aht20Ready = true;
+        ahtHealth.setOnline(aht20.getErrorCount(), Clock::millis());
+        ahtFrames.reset();
         if (DEBUG_SERIAL) {
             Serial.println("✓ OK");
         }
         return true;
     } else {
         aht20Ready = false;
+        ahtHealth.setOffline(Clock::millis());
         if (DEBUG_SERIAL) {
             Serial.println("❌ FALLO");
         }
@@ -67,15 +89,11 @@ bool EnvironmentSensor::initBMP280() {
     }
     
     // Probar dirección 0x76 primero, luego 0x77
-    if (bmp280.begin(0x76) || bmp280.begin(0x77)) {
+    // (modo normal: temp x2, presión x16, filtro x16, standby 500 ms)
+    if (bmp280.begin(Wire, BMP280_ADDRESS) || bmp280.begin(Wire, BMP280_ADDRESS_ALT)) {
         bmp280Ready = true;
-        
-        // Configurar BMP280
-        bmp280.setSampling(Adafruit_BMP280::MODE_NORMAL,     // Modo operación
-                          Adafruit_BMP280::SAMPLING_X2,     // Temp oversampling
-                          Adafruit_BMP280::SAMPLING_X16,    // Pressure oversampling
-                          Adafruit_BMP280::FILTER_X16,      // Filtrado
-                          Adafruit_BMP280::STANDBY_MS_500); // Standby time
+        bmpHealth.setOnline(bmp280.getErrorCount(), Clock::millis());
+        bmpFrames.reset();
         
         if (DEBUG_SERIAL) {
             Serial.println("✓ OK");
@@ -83,6 +101,7 @@ bool EnvironmentSensor::initBMP280() {
         return true;
     } else {
         bmp280Ready = false;
+        bmpHealth.setOffline(Clock::millis());
         if (DEBUG_SERIAL) {
             Serial.println("❌ FALLO");
         }
@@ -97,7 +116,9 @@ bool EnvironmentSensor::begin(int sdaPin, int sclPin) {
         Serial.println("╚═══════════════════════════════════════╝");
     }
     
-    // Inicializar I2C
+    // Inicializar I2C (los pines se conservan para recuperar el bus)
+    busSdaPin = sdaPin;
+    busSclPin = sclPin;
     Wire.begin(sdaPin, sclPin);
     
     if (DEBUG_SERIAL) {
@@ -128,7 +149,11 @@ bool EnvironmentSensor::begin(int sdaPin, int sclPin) {
         }
     }
     
-    // Primera lectura
+    // Primera lectura: esperar una conversión completa del AHT20
+    if (ahtOK) {
+        aht20.trigger(Clock::millis());
+        delay(AHT20_MEASURE_MS);
+    }
     lastReading = read();
     
     if (DEBUG_SERIAL) {
@@ -146,28 +171,8 @@ bool EnvironmentSensor::begin(int sdaPin, int sclPin) {
     return true;
 }
 
-void EnvironmentSensor::addToTrend(TrendData& trend, float value, unsigned long time) {
-    trend.values[trend.index] = value;
-    trend.times[trend.index] = time;
-    trend.index = (trend.index + 1) % 10;
-}
-
-float EnvironmentSensor::calculateRate(const TrendData& trend) {
-    // Calcular tasa de cambio (por minuto)
-    int oldestIndex = trend.index;
-    int newestIndex = (trend.index - 1 + 10) % 10;
-    
-    float valueDelta = trend.values[newestIndex] - trend.values[oldestIndex];
-    unsigned long timeDelta = trend.times[newestIndex] - trend.times[oldestIndex];
-    
-    if (timeDelta == 0) return 0.0;
-    
-    // Convertir a por minuto
-    float ratePerMs = valueDelta / (float)timeDelta;
-    return ratePerMs * 60000.0;  // ms a minutos
-}
-
 bool EnvironmentSensor::detectRapidTempRise() {
+    // La pendiente es 0 hasta tener al menos 3 muestras en la ventana
     return (lastReading.tempRate > TEMP_RATE_THRESHOLD);
 }
 
@@ -217,27 +222,223 @@ EnvironmentState EnvironmentSensor::evaluateState() {
     return EnvironmentState::NORMAL;
 }
 
+void EnvironmentSensor::acquire(unsigned long now, EnvironmentRaw& raw) {
+    // AHT20: recoger la medición disparada en la lectura anterior y disparar la siguiente
+    raw.ahtFresh = aht20Ready && aht20.collectRaw(now, raw.ahtHumidity, raw.ahtTemperature);
+    if (aht20Ready) {
+        aht20.trigger(now);
+    }
+    
+    // BMP280: presión + temperatura en un único burst
+    raw.bmpFresh = bmp280Ready && bmp280.readRaw(raw.bmpTemperature, raw.bmpPressure);
+}
+
+void EnvironmentSensor::recoverBus(unsigned long now) {
+    bool ahtDue = ahtHealth.shouldRecover(now);
+    bool bmpDue = bmpHealth.shouldRecover(now);
+    if (!ahtDue && !bmpDue) {
+        return;
+    }
+    
+    // Un esclavo colgado puede retener SDA: pulsos de SCL + STOP antes de reiniciar
+    bool released = I2CBus::recover(Wire, busSdaPin, busSclPin);
+    if (DEBUG_SERIAL && !released) {
+        Serial.println("⚠ Bus I2C retenido (SDA/SCL en bajo)");
+    }
+    
+    if (ahtDue) {
+        bool ok = released && aht20.begin(Wire);
+        ahtHealth.recovered(ok, aht20.getErrorCount(), now);
+        aht20Ready = ok;
+        if (ok) {
+            ahtFrames.reset();
+        }
+        if (DEBUG_SERIAL) {
+            if (ok) {
+                Serial.println("✓ AHT20 recuperado");
+            } else {
+                Serial.printf("❌ AHT20 sin respuesta (reintento en %lu s)\n",
+                              (unsigned long)ahtHealth.getBackoff() / 1000);
+            }
+        }
+    }
+    
+    if (bmpDue) {
+        bool ok = released && (bmp280.begin(Wire, BMP280_ADDRESS) || bmp280.begin(Wire, BMP280_ADDRESS_ALT));
+        bmpHealth.recovered(ok, bmp280.getErrorCount(), now);
+        bmp280Ready = ok;
+        if (ok) {
+            bmpFrames.reset();
+        }
+        if (DEBUG_SERIAL) {
+            if (ok) {
+                Serial.println("✓ BMP280 recuperado");
+            } else {
+                Serial.printf("❌ BMP280 sin respuesta (reintento en %lu s)\n",
+                              (unsigned long)bmpHealth.getBackoff() / 1000);
+            }
+        }
+    }
+}
+
+void EnvironmentSensor::assessQuality(const EnvironmentRaw& raw, EnvironmentReading& reading) {
+    unsigned long now = reading.timestamp;
+    
+    // Trama repetida: un sensor vivo siempre cambia los bits bajos
+    if (raw.ahtFresh) {
+        ahtFrames.update((int32_t)(raw.ahtHumidity ^ (raw.ahtTemperature << 12)), now);
+    }
+    if (raw.bmpFresh) {
+        bmpFrames.update((int32_t)((uint32_t)raw.bmpPressure ^ ((uint32_t)raw.bmpTemperature << 12)), now);
+    }
+    uint8_t ahtQuality = ahtFrames.getFlags();
+    uint8_t bmpQuality = bmpFrames.getFlags();
+    
+    // Bus: errores del driver y mediciones viejas (reproduciendo no hay bus)
+    if (!replaying) {
+        ahtQuality |= ahtHealth.update(aht20.getErrorCount(), raw.ahtFresh,
+                                       ahtQuality & QUALITY_STUCK, now);
+        bmpQuality |= bmpHealth.update(bmp280.getErrorCount(), raw.bmpFresh,
+                                       bmpQuality & QUALITY_STUCK, now);
+        
+        // Caído: deja de usarse (compensación, estado) hasta recuperarlo
+        if (aht20Ready && !ahtHealth.isOnline()) {
+            aht20Ready = false;
+            if (DEBUG_SERIAL) {
+                Serial.printf("⚠ AHT20 fuera de línea (%s)\n", qualityName(ahtQuality & ~QUALITY_OFFLINE));
+            }
+        }
+        if (bmp280Ready && !bmpHealth.isOnline()) {
+            bmp280Ready = false;
+            if (DEBUG_SERIAL) {
+                Serial.printf("⚠ BMP280 fuera de línea (%s)\n", qualityName(bmpQuality & ~QUALITY_OFFLINE));
+            }
+        }
+    }
+    
+    // Rango de operación de los sensores
+    if ((aht20Ready || ahtHealth.isAttached()) &&
+        (reading.temperature < ENV_TEMP_MIN || reading.temperature > ENV_TEMP_MAX || reading.humidity <= 0)) {
+        ahtQuality |= QUALITY_OUT_OF_RANGE;
+    }
+    if ((bmp280Ready || bmpHealth.isAttached()) &&
+        (reading.temperatureBMP < ENV_TEMP_MIN || reading.temperatureBMP > ENV_TEMP_MAX ||
+         reading.pressure < ENV_PRESSURE_MIN || reading.pressure > ENV_PRESSURE_MAX)) {
+        bmpQuality |= QUALITY_OUT_OF_RANGE;
+    }
+    
+    // Discrepancia sostenida: en la misma placa ambos miden casi la misma temperatura
+    if (aht20Ready && bmp280Ready &&
+        fabsf(reading.temperature - reading.temperatureBMP) > HEALTH_TEMP_DISAGREE) {
+        if (disagreeCount < HEALTH_DISAGREE_READS) {
+            disagreeCount++;
+        }
+    } else {
+        disagreeCount = 0;
+    }
+    
+    reading.temperatureQuality = ahtQuality;
+    reading.pressureQuality = bmpQuality;
+    reading.quality = ahtQuality | bmpQuality;
+    if (disagreeCount >= HEALTH_DISAGREE_READS) {
+        reading.quality |= QUALITY_DISAGREE;
+    }
+}
+
+void EnvironmentSensor::setReplay(bool enabled, const BMP280Calibration* calibration) {
+    replaying = enabled;
+    replayRaw = EnvironmentRaw();
+    
+    if (enabled) {
+        // Los valores vienen de la traza: ambos sensores "presentes"
+        if (calibration != nullptr) {
+            bmp280.setCalibration(*calibration);
+        }
+        aht20Ready = true;
+        bmp280Ready = true;
+    } else {
+        // Volver al bus: detectar de nuevo qué sensores responden
+        initAHT20();
+        initBMP280();
+    }
+
+    // Los valores retenidos son de la otra fuente: hasta la primera medición
+    // nueva se retiene el baseline (deltas nulos, no dispara características)
+    ahtTemperature = baseline.temperature;
+    ahtHumidity = baseline.humidity;
+    lastReading = EnvironmentReading();
+    lastReading.temperature = baseline.temperature;
+    lastReading.temperatureBMP = baseline.temperature;
+    lastReading.humidity = baseline.humidity;
+    lastReading.pressure = baseline.pressure;
+    lastReading.altitude = BMP280Driver::altitude(baseline.pressure);
+    ahtFrames.reset();
+    bmpFrames.reset();
+    disagreeCount = 0;
+
+    tempTrend.reset();
+    humidityTrend.reset();
+    pressureTrend.reset();
+}
+
+void EnvironmentSensor::injectRaw(const EnvironmentRaw& raw) {
+    // Conservar "fresco" hasta que read() lo consuma
+    if (raw.ahtFresh) {
+        replayRaw.ahtFresh = true;
+        replayRaw.ahtHumidity = raw.ahtHumidity;
+        replayRaw.ahtTemperature = raw.ahtTemperature;
+    }
+    if (raw.bmpFresh) {
+        replayRaw.bmpFresh = true;
+        replayRaw.bmpTemperature = raw.bmpTemperature;
+        replayRaw.bmpPressure = raw.bmpPressure;
+    }
+}
+
 EnvironmentReading EnvironmentSensor::read() {
     EnvironmentReading reading;
-    reading.timestamp = millis();
+    reading.timestamp = Clock::millis();
+    
+    // Valores crudos: del bus, o de la traza en reproducción
+    EnvironmentRaw raw;
+    if (replaying) {
+        raw = replayRaw;
+        replayRaw.ahtFresh = false;
+        replayRaw.bmpFresh = false;
+    } else {
+        recoverBus(reading.timestamp);
+        acquire(reading.timestamp, raw);
+        if (raw.ahtFresh || raw.bmpFresh) {
+            TraceRecorder::getInstance()->recordEnvironment(raw, reading.timestamp);
+        }
+    }
     
-    // Leer AHT20 (Temperatura + Humedad)
-    if (aht20Ready) {
-        sensors_event_t humidity_event, temp_event;
-        aht20.getEvent(&humidity_event, &temp_event);
-        
-        reading.temperature = temp_event.temperature;
-        reading.humidity = humidity_event.relative_humidity;
+    // AHT20 (Temperatura + Humedad): se conserva el último valor entre mediciones
+    bool ahtFresh = raw.ahtFresh;
+    if (ahtFresh) {
+        AHT20Driver::convert(raw.ahtHumidity, raw.ahtTemperature, ahtTemperature, ahtHumidity);
+    }
+    if (aht20Ready || ahtHealth.isAttached()) {
+        reading.temperature = ahtTemperature;
+        reading.humidity = ahtHumidity;
     } else {
         reading.temperature = 0;
         reading.humidity = 0;
     }
     
-    // Leer BMP280 (Presión + Temperatura)
-    if (bmp280Ready) {
-        reading.temperatureBMP = bmp280.readTemperature();
-        reading.pressure = bmp280.readPressure() / 100.0;  // Pa a hPa
-        reading.altitude = bmp280.readAltitude(1013.25);   // Nivel del mar estándar
+    // BMP280 (Presión + Temperatura)
+    int32_t bmpTempCenti;
+    uint32_t bmpPressureQ8;
+    bool bmpFresh = raw.bmpFresh && bmp280.compensate(raw.bmpTemperature, raw.bmpPressure,
+                                                      bmpTempCenti, bmpPressureQ8);
+    if (bmpFresh) {
+        reading.temperatureBMP = bmpTempCenti / 100.0;
+        reading.pressure = bmpPressureQ8 / 25600.0;                     // Pa Q24.8 a hPa
+        reading.altitude = BMP280Driver::altitude(reading.pressure);   // Nivel del mar estándar
+    } else if (bmp280Ready || bmpHealth.isAttached()) {
+        reading.temperatureBMP = lastReading.temperatureBMP;
+        reading.pressure = lastReading.pressure;
+        reading.altitude = lastReading.altitude;
     } else {
         reading.temperatureBMP = 0;
         reading.pressure = 0;
@@ -249,12 +450,34 @@ EnvironmentReading EnvironmentSensor::read() {
     reading.humidityDelta = reading.humidity - baseline.humidity;
     reading.pressureDelta = reading.pressure - baseline.pressure;
     
-    // Agregar a tendencias
-    addToTrend(tempTrend, reading.temperature, reading.timestamp);
-    addToTrend(pressureTrend, reading.pressure, reading.timestamp);
+    // Calidad de los datos y sensores caídos
+    assessQuality(raw, reading);
     
-    // Calcular tasas de cambio
-    reading.tempRate = calculateRate(tempTrend);
+    // Sin mediciones nuevas la pendiente quedaría congelada: se descarta la
+    // ventana y se rearma cuando el sensor vuelve
+    if (reading.temperatureQuality & QUALITY_HELD) {
+        tempTrend.reset();
+        humidityTrend.reset();
+    }
+    if (reading.pressureQuality & QUALITY_HELD) {
+        pressureTrend.reset();
+    }
+    
+    // Agregar a tendencias (solo valores medidos, espaciados aunque se lea más rápido)
+    if (ahtFresh && (tempTrend.size() == 0 || reading.timestamp - lastTempTrendTime >= ENV_TREND_SPACING_MS)) {
+        lastTempTrendTime = reading.timestamp;
+        tempTrend.add(reading.timestamp, reading.temperature);
+        humidityTrend.add(reading.timestamp, reading.humidity);
+    }
+    if (bmpFresh && (pressureTrend.size() == 0 || reading.timestamp - lastPressureTrendTime >= ENV_TREND_SPACING_MS)) {
+        lastPressureTrendTime = reading.timestamp;
+        pressureTrend.add(reading.timestamp, reading.pressure);
+    }
+    
+    // Tasas de cambio: pendiente de la regresión en la ventana
+    reading.tempRate = tempTrend.slopePerMinute();
+    reading.humidityRate = humidityTrend.slopePerMinute();
+    reading.pressureRate = pressureTrend.slopePerMinute();
     
     // Evaluar estado
     reading.state = evaluateState();
@@ -262,10 +485,13 @@ EnvironmentReading EnvironmentSensor::read() {
     // Guardar como última lectura
     lastReading = reading;
     
+    // Calibración incremental de baseline
+    updateCalibration(reading);
+    
     return reading;
 }
 
-bool EnvironmentSensor::calibrateBaseline() {
+bool EnvironmentSensor::calibrateBaseline(int samples, int intervalMs) {
     if (!isReady()) {
         if (DEBUG_SERIAL) {
             Serial.println("❌ No se puede calibrar: sensores no listos");
@@ -273,65 +499,98 @@ bool EnvironmentSensor::calibrateBaseline() {
         return false;
     }
     
+    if (samples <= 0 || intervalMs < 0) {
+        return false;
+    }
+    
+    calibrationSession.start(samples, intervalMs, Clock::millis());
+    lastCalibrationLog = 0;
+    
     if (DEBUG_SERIAL) {
         Serial.println("\n╔═══════════════════════════════════════╗");
         Serial.println("║    CALIBRANDO BASELINE AMBIENTAL      ║");
         Serial.println("╚═══════════════════════════════════════╝");
-        Serial.println("Tomando 100 muestras en 5 minutos...");
+        Serial.printf("Acumulando %d muestras en segundo plano...\n", samples);
         Serial.println("Asegúrate de condiciones normales\n");
     }
     
-    float tempSum = 0;
-    float humiditySum = 0;
-    float pressureSum = 0;
-    int samples = 100;
-    int delayMs = 3000;  // 3 segundos entre muestras
+    return true;
+}
+
+void EnvironmentSensor::abortCalibration() {
+    if (!calibrationSession.isRunning()) {
+        return;
+    }
     
-    for (int i = 0; i < samples; i++) {
-        EnvironmentReading reading = read();
-        
-        tempSum += reading.temperature;
-        humiditySum += reading.humidity;
-        pressureSum += reading.pressure;
-        
-        if (DEBUG_SERIAL && (i % 10 == 0)) {
-            Serial.printf("Progreso: %d%% (T:%.1f H:%.1f P:%.1f)\n", 
-                         (i * 100) / samples,
-                         reading.temperature,
-                         reading.humidity,
-                         reading.pressure);
-        }
-        
-        delay(delayMs);
+    calibrationSession.abort();
+    
+    if (DEBUG_SERIAL) {
+        Serial.println("⚠ Calibración ambiental cancelada - Se conserva el baseline anterior");
+    }
+}
+
+bool EnvironmentSensor::isCalibrating() const {
+    return calibrationSession.isRunning();
+}
+
+int EnvironmentSensor::getCalibrationProgress() const {
+    return calibrationSession.getProgress();
+}
+
+void EnvironmentSensor::updateCalibration(const EnvironmentReading& reading) {
+    // Un sensor caído o fuera de rango no aporta muestras (se espera a que vuelva)
+    const uint8_t unusable = QUALITY_OFFLINE | QUALITY_STALE | QUALITY_OUT_OF_RANGE | QUALITY_STUCK;
+    if (!calibrationSession.shouldSample(reading.timestamp) || (reading.quality & unusable)) {
+        return;
+    }
+    
+    calibrationSession.stats(0).add(reading.temperature);
+    calibrationSession.stats(1).add(reading.humidity);
+    calibrationSession.stats(2).add(reading.pressure);
+    
+    if (calibrationSession.commitSample(reading.timestamp)) {
+        finishCalibration();
+        return;
     }
     
+    // Mostrar progreso cada 10%
+    int progress = calibrationSession.getProgress();
+    if (DEBUG_SERIAL && progress / 10 > lastCalibrationLog) {
+        lastCalibrationLog = progress / 10;
+        Serial.printf("Calibración ambiental: %d%% (T:%.1f H:%.1f P:%.1f)\n",
+                     progress,
+                     reading.temperature,
+                     reading.humidity,
+                     reading.pressure);
+    }
+}
+
+void EnvironmentSensor::finishCalibration() {
     // Calcular promedios
-    baseline.temperature = tempSum / samples;
-    baseline.humidity = humiditySum / samples;
-    baseline.pressure = pressureSum / samples;
-    baseline.timestamp = millis();
+    baseline.temperature = calibrationSession.stats(0).mean;
+    baseline.humidity = calibrationSession.stats(1).mean;
+    baseline.pressure = calibrationSession.stats(2).mean;
+    baseline.timestamp = Clock::millis();
     baseline.isCalibrated = true;
     
     if (DEBUG_SERIAL) {
         Serial.println("\n✓ Calibración completada:");
         Serial.println("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
-        Serial.printf("  Temperatura:  %.2f °C\n", baseline.temperature);
-        Serial.printf("  Humedad:      %.2f %%\n", baseline.humidity);
-        Serial.printf("  Presión:      %.2f hPa\n", baseline.pressure);
+        Serial.printf("  Temperatura:  %.2f °C (σ %.2f)\n", baseline.temperature, calibrationSession.stats(0).stddev());
+        Serial.printf("  Humedad:      %.2f %% (σ %.2f)\n", baseline.humidity, calibrationSession.stats(1).stddev());
+        Serial.printf("  Presión:      %.2f hPa (σ %.2f)\n", baseline.pressure, calibrationSession.stats(2).stddev());
         Serial.println("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     }
     
     // Guardar baseline
     saveBaseline();
-    
-    return true;
 }
 
 void EnvironmentSensor::setBaseline(float temp, float humidity, float pressure) {
     baseline.temperature = temp;
     baseline.humidity = humidity;
     baseline.pressure = pressure;
-    baseline.timestamp = millis();
+    baseline.timestamp = Clock::millis();
     baseline.isCalibrated = true;
 }
 
@@ -350,9 +609,9 @@ bool EnvironmentSensor::loadBaseline() {
     // Parse formato: temp,humidity,pressure
     float values[3];
     int index = 0;
-    int start = 0;
+    unsigned int start = 0;
     
-    for (int i = 0; i <= data.length(); i++) {
+    for (unsigned int i = 0; i <= data.length(); i++) {
         if (i == data.length() || data[i] == ',') {
             if (index < 3) {
                 values[index++] = data.substring(start, i).toFloat();
@@ -417,6 +676,18 @@ bool EnvironmentSensor::isBMP280Ready() const {
     return bmp280Ready;
 }
 
+const DeviceHealth& EnvironmentSensor::getAHT20Health() const {
+    return ahtHealth;
+}
+
+const DeviceHealth& EnvironmentSensor::getBMP280Health() const {
+    return bmpHealth;
+}
+
+const BMP280Calibration& EnvironmentSensor::getBMP280Calibration() const {
+    return bmp280.getCalibration();
+}
+
 bool EnvironmentSensor::isReady() const {
     return (aht20Ready || bmp280Ready);
 }
@@ -426,7 +697,11 @@ EnvironmentState EnvironmentSensor::getState() const {
 }
 
 String EnvironmentSensor::getStateString() const {
-    switch (lastReading.state) {
+    return getStateName(lastReading.state);
+}
+
+const char* EnvironmentSensor::getStateName(EnvironmentState state) {
+    switch (state) {
         case EnvironmentState::NORMAL:           return "NORMAL";
         case EnvironmentState::HIGH_TEMP:        return "HIGH_TEMP";
         case EnvironmentState::RAPID_TEMP_RISE:  return "RAPID_TEMP_RISE";
@@ -476,52 +751,10 @@ float EnvironmentSensor::getTempRate() const {
     return lastReading.tempRate;
 }
 
-float EnvironmentSensor::calculateFireProbability() const {
-    float probability = 0.0;
-    
-    // Factor 1: Temperatura absoluta y delta
-    if (lastReading.temperature > TEMP_CRITICAL_THRESHOLD) {
-        probability += 0.5;  // Muy alta
-    } else if (lastReading.temperature > TEMP_HIGH_THRESHOLD) {
-        probability += 0.3;  // Alta
-    } else if (lastReading.tempDelta > 15) {
-        probability += 0.2;  // Subida moderada
-    }
-    
-    // Factor 2: Tasa de cambio de temperatura
-    if (lastReading.tempRate > 10) {
-        probability += 0.4;  // Subida muy rápida
-    } else if (lastReading.tempRate > TEMP_RATE_THRESHOLD) {
-        probability += 0.2;  // Subida rápida
-    }
-    
-    // Factor 3: Humedad baja (fuego seca el aire)
-    if (lastReading.humidity < 20) {
-        probability += 0.2;
-    } else if (lastReading.humidity < 30) {
-        probability += 0.1;
-    }
-    
-    // Factor 4: Caída de presión (aire caliente sube)
-    if (lastReading.pressureDelta < -5) {
-        probability += 0.3;
-    } else if (lastReading.pressureDelta < -3) {
-        probability += 0.15;
-    }
-    
-    // Bonus: Correlación de múltiples factores
-    int activeFactors = 0;
-    if (lastReading.tempDelta > 15) activeFactors++;
-    if (lastReading.tempRate > TEMP_RATE_THRESHOLD) activeFactors++;
-    if (lastReading.humidity < 30) activeFactors++;
-    if (lastReading.pressureDelta < -3) activeFactors++;
-    
-    if (activeFactors >= 3) {
-        probability += 0.3;  // Múltiples indicadores
-    } else if (activeFactors >= 2) {
-        probability += 0.15;
-    }
-    
-    // Limitar a 0.0 - 1.0
-    return constrain(probability, 0.0, 1.0);
+float EnvironmentSensor::getHumidityRate() const {
+    return lastReading.humidityRate;
+}
+
+float EnvironmentSensor::getPressureRate() const {
+    return lastReading.pressureRate;
 }
\ No newline at end of file
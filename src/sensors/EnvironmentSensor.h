@@ -3,41 +3,24 @@
 
 #include <Arduino.h>
 #include <Wire.h>
-#include <Adafruit_AHTX0.h>
-#include <Adafruit_BMP280.h>
+#include "AHT20.h"
+#include "BMP280.h"
+#include "SensorReadings.h"
+#include "../utils/CalibrationSession.h"
+#include "../utils/SensorHealth.h"
+#include "../utils/TrendEstimator.h"
 
-// Estados del sensor ambiental
-enum class EnvironmentState {
-    NORMAL,             // Condiciones normales
-    HIGH_TEMP,          // Temperatura alta
-    RAPID_TEMP_RISE,    // Subida rápida de temperatura
-    LOW_HUMIDITY,       // Humedad baja (riesgo incendio)
-    HIGH_HUMIDITY,      // Humedad alta (vapor/cocina)
-    PRESSURE_DROP,      // Caída de presión (aire caliente)
-    FIRE_SUSPECTED,     // Patrón de incendio detectado
-    ERROR               // Error de lectura
-};
+// Muestras máximas por tendencia (ENV_TREND_WINDOW_MS / ENV_TREND_SPACING_MS)
+#define ENV_TREND_CAPACITY 32
 
-// Estructura de lectura ambiental
-struct EnvironmentReading {
-    // Temperatura
-    float temperature;          // °C (de AHT20)
-    float temperatureBMP;       // °C (de BMP280 - validación)
-    float tempDelta;            // Diferencia con baseline
-    float tempRate;             // °C/min (tasa de cambio)
-    
-    // Humedad
-    float humidity;             // % (de AHT20)
-    float humidityDelta;        // Diferencia con baseline
-    
-    // Presión
-    float pressure;             // hPa (de BMP280)
-    float pressureDelta;        // Diferencia con baseline hPa
-    float altitude;             // Metros (calculado)
-    
-    // Estado
-    EnvironmentState state;     // Estado evaluado
-    unsigned long timestamp;    // Timestamp de lectura
+// Valores crudos de una lectura (lo que se registra en las trazas)
+struct EnvironmentRaw {
+    bool ahtFresh;              // Hubo medición nueva del AHT20
+    bool bmpFresh;              // Hubo medición nueva del BMP280
+    uint32_t ahtHumidity;       // 20 bits
+    uint32_t ahtTemperature;    // 20 bits
+    int32_t bmpTemperature;     // adcT, 20 bits
+    int32_t bmpPressure;        // adcP, 20 bits
 };
 
 // Estructura de baseline (valores normales)
@@ -49,30 +32,47 @@ struct EnvironmentBaseline {
     bool isCalibrated;
 };
 
-// Estructura para detección de tendencias
-struct TrendData {
-    float values[10];       // Últimas 10 lecturas
-    int index;              // Índice actual
-    unsigned long times[10]; // Timestamps
-};
-
 class EnvironmentSensor {
 private:
     static EnvironmentSensor* instance;
     
-    Adafruit_AHTX0 aht20;
-    Adafruit_BMP280 bmp280;
+    AHT20Driver aht20;
+    BMP280Driver bmp280;
+    
+    // Último resultado del AHT20 (se mide entre una lectura y la siguiente)
+    float ahtTemperature;
+    float ahtHumidity;
     
     EnvironmentReading lastReading;
     EnvironmentBaseline baseline;
     
-    // Tendencias
-    TrendData tempTrend;
-    TrendData pressureTrend;
+    // Tendencias (regresión lineal en ventana de tiempo)
+    TrendEstimator<ENV_TREND_CAPACITY> tempTrend;
+    TrendEstimator<ENV_TREND_CAPACITY> humidityTrend;
+    TrendEstimator<ENV_TREND_CAPACITY> pressureTrend;
+    unsigned long lastTempTrendTime;
+    unsigned long lastPressureTrendTime;
     
     bool aht20Ready;
     bool bmp280Ready;
     
+    // Salud del bus: errores, mediciones viejas, tramas repetidas, recuperación
+    int busSdaPin;
+    int busSclPin;
+    DeviceHealth ahtHealth;
+    DeviceHealth bmpHealth;
+    SignalMonitor ahtFrames;
+    SignalMonitor bmpFrames;
+    int disagreeCount;          // Lecturas seguidas con AHT20 y BMP280 en desacuerdo
+    
+    // Reproducción de trazas: valores crudos inyectados en lugar del bus
+    bool replaying;
+    EnvironmentRaw replayRaw;
+    
+    // Calibración de baseline en curso (temp, humedad, presión)
+    CalibrationSession<3> calibrationSession;
+    int lastCalibrationLog;
+    
     EnvironmentSensor(); // Constructor privado
     
     /**
@@ -86,14 +86,25 @@ private:
     bool initBMP280();
     
     /**
-     * Agrega un valor a la tendencia
+     * Recoge/dispara el AHT20 y lee el BMP280 (operaciones de bus)
+     * @param now Tiempo actual (ms)
+     * @param raw Valores crudos obtenidos
+     */
+    void acquire(unsigned long now, EnvironmentRaw& raw);
+    
+    /**
+     * Libera el bus y reinicia los sensores fuera de línea (con espera
+     * creciente entre intentos)
+     * @param now Tiempo actual (ms)
      */
-    void addToTrend(TrendData& trend, float value, unsigned long time);
+    void recoverBus(unsigned long now);
     
     /**
-     * Calcula la tasa de cambio (unidad/minuto)
+     * Evalúa la calidad de la lectura y detecta sensores caídos
+     * @param raw Valores crudos de esta lectura
+     * @param reading Lectura ya convertida (se completan las banderas de calidad)
      */
-    float calculateRate(const TrendData& trend);
+    void assessQuality(const EnvironmentRaw& raw, EnvironmentReading& reading);
     
     /**
      * Detecta subida rápida de temperatura
@@ -110,6 +121,16 @@ private:
      */
     EnvironmentState evaluateState();
     
+    /**
+     * Agrega la lectura actual a la calibración en curso (si corresponde)
+     */
+    void updateCalibration(const EnvironmentReading& reading);
+    
+    /**
+     * Fija el baseline con la estadística acumulada
+     */
+    void finishCalibration();
+    
 public:
     /**
      * Obtiene la instancia única de EnvironmentSensor (Singleton)
@@ -126,17 +147,51 @@ public:
     bool begin(int sdaPin = 21, int sclPin = 22);
     
     /**
-     * Lee todos los sensores ambientales
+     * Lee todos los sensores ambientales (no bloquea)
+     * Recoge la medición del AHT20 disparada en la lectura anterior y
+     * dispara la siguiente; el BMP280 se lee en un único burst.
      * @return Estructura con todas las lecturas
      */
     EnvironmentReading read();
     
     /**
-     * Establece el baseline (valores normales)
-     * Toma 100 muestras en 5 minutos
-     * @return true si se estableció correctamente
+     * Activa la reproducción de trazas: read() usa los valores de
+     * injectRaw() en lugar de los sensores
+     * @param enabled true para reproducir, false para volver al bus
+     * @param calibration Coeficientes del BMP280 de la traza (nullptr = los actuales)
+     */
+    void setReplay(bool enabled, const BMP280Calibration* calibration = nullptr);
+    
+    /**
+     * Entrega los valores crudos para la próxima read() (reproducción)
+     */
+    void injectRaw(const EnvironmentRaw& raw);
+    
+    /**
+     * Inicia la calibración del baseline (no bloqueante)
+     * Cada read() aporta como máximo una muestra; se mantiene el
+     * baseline anterior hasta completar.
+     * @param samples Número de muestras (default: 100)
+     * @param intervalMs Tiempo mínimo entre muestras (default: 3000)
+     * @return true si la calibración se inició
+     */
+    bool calibrateBaseline(int samples = 100, int intervalMs = 3000);
+    
+    /**
+     * Cancela la calibración en curso (se conserva el baseline anterior)
+     */
+    void abortCalibration();
+    
+    /**
+     * Verifica si hay una calibración en curso
+     */
+    bool isCalibrating() const;
+    
+    /**
+     * Obtiene el progreso de la calibración en curso
+     * @return Porcentaje 0-100
      */
-    bool calibrateBaseline();
+    int getCalibrationProgress() const;
     
     /**
      * Establece baseline manualmente
@@ -178,6 +233,21 @@ public:
      */
     bool isBMP280Ready() const;
     
+    /**
+     * Salud del AHT20 en el bus (caídas y recuperaciones)
+     */
+    const DeviceHealth& getAHT20Health() const;
+    
+    /**
+     * Salud del BMP280 en el bus (caídas y recuperaciones)
+     */
+    const DeviceHealth& getBMP280Health() const;
+    
+    /**
+     * Coeficientes de calibración del BMP280 (se guardan en las trazas)
+     */
+    const BMP280Calibration& getBMP280Calibration() const;
+    
     /**
      * Verifica si ambos sensores están listos
      */
@@ -193,6 +263,11 @@ public:
      */
     String getStateString() const;
     
+    /**
+     * Obtiene el nombre de un estado (para lecturas ya copiadas)
+     */
+    static const char* getStateName(EnvironmentState state);
+    
     /**
      * Verifica si hay condiciones de incendio sospechosas
      */
@@ -229,10 +304,14 @@ public:
     float getTempRate() const;
     
     /**
-     * Calcula probabilidad de incendio (0.0 - 1.0)
-     * Basado en múltiples factores ambientales
+     * Obtiene tasa de cambio de humedad (%/min)
+     */
+    float getHumidityRate() const;
+    
+    /**
+     * Obtiene tasa de cambio de presión (hPa/min)
      */
-    float calculateFireProbability() const;
+    float getPressureRate() const;
 };
 
 #endif // ENVIRONMENTSENSOR_H
\ No newline at end of file
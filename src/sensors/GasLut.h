@@ -0,0 +1,90 @@
+/*
+Tabla de conversión precalculada para sensores de gas:
+
+Una entrada por valor del ADC de 12 bits (4096 entradas)
+PPM, LEL, porcentaje y estado en punto fijo
+Curva de sensibilidad log-log (Rs/R0 → PPM) por tramos
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef GASLUT_H
+#define GASLUT_H
+
+#include <math.h>
+#include <stdint.h>
+
+#define GAS_LUT_SIZE 4096
+#define GAS_CURVE_PPM_MAX 1000000.0f   // Tope de la extrapolación de la curva
+
+// Entrada de la tabla (6 bytes → 24 KB por sensor)
+struct GasLutEntry {
+    uint16_t ppm;           // PPM (satura en 65535)
+    uint16_t lelCenti;      // % LEL * 100 (satura en 655.35%)
+    uint8_t percentage;     // Porcentaje 0-100
+    uint8_t state;          // Estado (valor del enum del sensor)
+};
+
+// Punto de la curva de sensibilidad del datasheet
+struct GasCurvePoint {
+    float ratio;            // Rs/R0
+    float ppm;              // Concentración para ese Rs/R0
+};
+
+namespace GasCurve {
+    /**
+     * Relación Rs/RL a partir del valor ADC (divisor con resistencia de carga)
+     * Vout = Vc * RL / (RL + Rs)  →  Rs/RL = (Vc - Vout) / Vout
+     */
+    inline float resistanceRatio(int raw) {
+        if (raw < 1) raw = 1;
+        if (raw > GAS_LUT_SIZE - 1) raw = GAS_LUT_SIZE - 1;
+        return (float)(GAS_LUT_SIZE - 1 - raw) / (float)raw;
+    }
+
+    /**
+     * Interpola PPM en escala log-log entre los puntos de la curva
+     * Los puntos deben estar ordenados por PPM ascendente (Rs/R0 descendente).
+     * Fuera del rango se extrapola con el tramo más cercano.
+     * @param points Puntos de la curva
+     * @param count Número de puntos (>= 2)
+     * @param ratio Rs/R0 medido
+     * @return PPM estimado (0 - GAS_CURVE_PPM_MAX)
+     */
+    inline float ppmFromRatio(const GasCurvePoint* points, int count, float ratio) {
+        if (count < 2) {
+            return 0;
+        }
+        if (ratio <= 0) {
+            return GAS_CURVE_PPM_MAX;   // Rs = 0: salida saturada
+        }
+
+        // Buscar el tramo que contiene el ratio
+        int seg = 0;
+        while (seg < count - 2 && ratio < points[seg + 1].ratio) {
+            seg++;
+        }
+
+        float x0 = logf(points[seg].ratio);
+        float x1 = logf(points[seg + 1].ratio);
+        float y0 = logf(points[seg].ppm);
+        float y1 = logf(points[seg + 1].ppm);
+
+        if (x1 == x0) {
+            return points[seg].ppm;
+        }
+
+        float y = y0 + (logf(ratio) - x0) * (y1 - y0) / (x1 - x0);
+        float ppm = expf(y);
+        return ppm < GAS_CURVE_PPM_MAX ? ppm : GAS_CURVE_PPM_MAX;
+    }
+
+    /**
+     * Satura un valor al rango de uint16_t
+     */
+    inline uint16_t saturate16(long value) {
+        if (value < 0) return 0;
+        if (value > 65535) return 65535;
+        return (uint16_t)value;
+    }
+}
+
+#endif // GASLUT_H
@@ -0,0 +1,722 @@
+#include "GasSensor.h"
+#include "AdcSampler.h"
+#include "SmokeSensor.h"
+#include "CH4Sensor.h"
+#include "../storage/FileManager.h"
+#include "../config/Config.h"
+#include "../utils/Clock.h"
+#include <new>
+
+// Intervalo del log de progreso del warmup
+#define WARMUP_LOG_INTERVAL 30000
+
+template <typename Traits>
+GasSensor<Traits>::GasSensor(int sensorPin)
+    : pin(sensorPin),
+      warmupStartTime(0),
+      lastWarmupLog(0),
+      isWarmedUp(false),
+      cusum(GAS_CUSUM_DRIFT << ADC_OVERSAMPLE_BITS,
+            ((int32_t)GAS_CUSUM_THRESHOLD * ADC_SAMPLE_RATE_HZ) << ADC_OVERSAMPLE_BITS),
+      baselineTracker(GAS_BASELINE_WINDOW, GAS_BASELINE_MAX_STDDEV,
+                      GAS_BASELINE_MAX_DRIFT_DAY, GAS_BASELINE_MAX_DRIFT),
+      lastBaselineCheckpoint(0),
+      baselineDirty(false),
+      compensationGain(COMP_GAIN_ONE),
+      health(HEALTH_GAS_RAIL * ADC_SCAN_SCALE, (4095 - HEALTH_GAS_RAIL) * ADC_SCAN_SCALE,
+             HEALTH_STUCK_READS, HEALTH_FLAT_WINDOW, HEALTH_GAS_FLAT_SPAN * ADC_SCAN_SCALE),
+      quality(QUALITY_OK),
+      adcChannel(-1),
+      lut(nullptr),
+      lastCalibrationLog(0) {
+
+    // Valores por defecto de calibración y corrección
+    resetCalibration();
+    compensation.set(Traits::COMP_TEMPS, sizeof(Traits::COMP_TEMPS) / sizeof(Traits::COMP_TEMPS[0]),
+                     Traits::COMP_HUMIDITIES, sizeof(Traits::COMP_HUMIDITIES) / sizeof(Traits::COMP_HUMIDITIES[0]),
+                     Traits::COMP_GAINS);
+}
+
+template <typename Traits>
+void GasSensor<Traits>::resetCalibration() {
+    calibration = Traits::DEFAULT_CALIBRATION;
+    baselineTracker.setAnchor(calibration.baselineAvg);
+    baselineDirty = false;
+    rebuildLut();
+}
+
+template <typename Traits>
+void GasSensor<Traits>::setCalibration(const GasCalibration& cal) {
+    calibration = cal;
+    baselineTracker.setAnchor(calibration.baselineAvg);
+    baselineDirty = false;
+    rebuildLut();
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::begin(bool enableWarmup) {
+    // Configurar ADC
+    analogSetAttenuation(ADC_11db);  // Rango completo 0-3.3V
+    analogReadResolution(12);         // 12 bits (0-4095)
+
+    // Registrar canal para el muestreo en segundo plano
+    adcChannel = AdcSampler::getInstance()->addChannel(pin);
+
+    if (DEBUG_SERIAL) {
+        Serial.println("\n╔═══════════════════════════════════╗");
+        Serial.printf("║    INICIALIZANDO SENSOR %-10s║\n", Traits::NAME);
+        Serial.println("╚═══════════════════════════════════╝");
+        Serial.printf("Pin: GPIO %d\n", pin);
+    }
+
+    // Reservar tabla de conversión (se usa cálculo directo si no hay memoria)
+    if (lut == nullptr) {
+        lut = new (std::nothrow) GasLutEntry[GAS_LUT_SIZE];
+        if (lut == nullptr && DEBUG_SERIAL) {
+            Serial.println("⚠ Sin memoria para tabla de conversión - cálculo directo");
+        }
+    }
+
+    // Intentar cargar calibración guardada
+    if (loadCalibration()) {
+        if (DEBUG_SERIAL) {
+            Serial.println("✓ Calibración cargada desde archivo");
+        }
+    } else {
+        rebuildLut();
+        if (DEBUG_SERIAL) {
+            Serial.println("⚠ Usando calibración por defecto");
+            Serial.println("  Recomendación: Ejecutar calibración");
+        }
+    }
+
+    // Corrección por temperatura y humedad
+    loadCompensation();
+
+    // Iniciar warmup si está habilitado
+    restart(enableWarmup);
+
+    // Primera lectura
+    lastReading = read();
+
+    if (DEBUG_SERIAL) {
+        Serial.println("✓ Sensor inicializado\n");
+    }
+
+    return true;
+}
+
+template <typename Traits>
+void GasSensor<Traits>::restart(bool enableWarmup) {
+    filter.reset();
+    cusum.reset();
+    baselineTracker.restartWindow();
+    health.reset();
+    quality = QUALITY_OK;
+    lastBatch = AdcBatch();
+
+    if (enableWarmup) {
+        warmupStartTime = Clock::millis();
+        lastWarmupLog = warmupStartTime;
+        isWarmedUp = false;
+
+        if (DEBUG_SERIAL) {
+            Serial.printf("⏳ Calentando sensor (%lu segundos)...\n", Traits::WARMUP_TIME / 1000);
+        }
+    } else {
+        isWarmedUp = true;
+    }
+}
+
+template <typename Traits>
+int GasSensor<Traits>::readRawValue() {
+    AdcSampler* sampler = AdcSampler::getInstance();
+    uint16_t average = filter.value();
+    const uint16_t gain = GAS_COMPENSATION ? compensationGain : COMP_GAIN_ONE;
+    const uint16_t maxValue = (1u << ADC_SCAN_BITS) - 1;
+
+    // Consumir todas las muestras acumuladas desde la última lectura
+    // (el filtro trabaja en escala ADC_SCAN_BITS para no perder los bits extra)
+    if (sampler->isStreaming()) {
+        lastBatch = sampler->drain(adcChannel, [&](uint16_t sample) {
+            average = filter.update(CompensationGrid::apply(sample, gain, maxValue));
+            cusum.update(average);
+        });
+        if (!lastBatch.isEmpty()) {
+            quality = health.update(lastBatch.min, lastBatch.max, Clock::millis());
+        }
+        compensateBatch(lastBatch, gain);
+
+        // Reproduciendo una traza no hay ADC real: sin barridos se repite el promedio
+        if (!lastBatch.isEmpty() || !sampler->isRunning()) {
+            return AdcScan::toNative(average);
+        }
+    }
+
+    // Sin muestreo en segundo plano: una conversión directa
+    uint16_t sample = (uint16_t)(analogRead(pin) << ADC_OVERSAMPLE_BITS);
+    quality = health.update(sample, Clock::millis());
+    sample = CompensationGrid::apply(sample, gain, maxValue);
+    lastBatch = AdcBatch();
+    lastBatch.add(sample);
+    return AdcScan::toNative(filter.update(sample));
+}
+
+template <typename Traits>
+void GasSensor<Traits>::compensateBatch(AdcBatch& batch, uint16_t gain) {
+    if (batch.isEmpty() || gain == COMP_GAIN_ONE) {
+        return;
+    }
+
+    const uint16_t maxValue = (1u << ADC_SCAN_BITS) - 1;
+    batch.sum = (uint32_t)(((uint64_t)batch.sum * gain + (COMP_GAIN_ONE / 2)) >> COMP_GAIN_SHIFT);
+    batch.min = CompensationGrid::apply(batch.min, gain, maxValue);
+    batch.max = CompensationGrid::apply(batch.max, gain, maxValue);
+}
+
+template <typename Traits>
+void GasSensor<Traits>::setEnvironment(float temperature, float humidity, bool valid) {
+    if (!valid) {
+        compensationGain = COMP_GAIN_ONE;
+        return;
+    }
+
+    temperature = constrain(temperature, -100.0f, 150.0f);
+    humidity = constrain(humidity, 0.0f, 100.0f);
+    compensationGain = compensation.gain((int16_t)lroundf(temperature * 10.0f),
+                                         (int16_t)lroundf(humidity * 10.0f));
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::loadCompensation() {
+    FileManager* fm = FileManager::getInstance();
+
+    if (!fm->exists(Traits::COMP_PATH)) {
+        return false;
+    }
+
+    String content = fm->readFile(Traits::COMP_PATH);
+
+    // Leer sobre una copia: si algo falla, la grilla actual no cambia
+    CompensationGrid grid;
+    grid.clear();
+    int lineNumber = 0;
+    int start = 0;
+
+    while (start <= (int)content.length()) {
+        int end = content.indexOf('\n', start);
+        if (end < 0) {
+            end = content.length();
+        }
+        String line = content.substring(start, end);
+        start = end + 1;
+        lineNumber++;
+
+        if (grid.parseLine(line.c_str()) < 0) {
+            if (DEBUG_SERIAL) {
+                Serial.printf("❌ %s línea %d inválida: %s\n", Traits::COMP_PATH, lineNumber, line.c_str());
+            }
+            return false;
+        }
+    }
+
+    if (!grid.isComplete()) {
+        if (DEBUG_SERIAL) {
+            Serial.printf("❌ %s incompleto - Usando corrección por defecto\n", Traits::COMP_PATH);
+        }
+        return false;
+    }
+
+    compensation = grid;
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Corrección %s: grilla %d × %d desde %s\n", Traits::NAME,
+                     grid.getTemperaturePoints(), grid.getHumidityPoints(), Traits::COMP_PATH);
+    }
+    return true;
+}
+
+template <typename Traits>
+float GasSensor<Traits>::getCompensationGain() const {
+    return (float)compensationGain / COMP_GAIN_ONE;
+}
+
+template <typename Traits>
+float GasSensor<Traits>::rawToVoltage(int raw) const {
+    return raw * (3.3f / 4095.0f);
+}
+
+template <typename Traits>
+int GasSensor<Traits>::rawToPercentage(int raw) const {
+    // Mapear basado en calibración
+    if (!calibration.isCalibrated) {
+        return map(raw, 0, 4095, 0, 100);
+    }
+
+    // Calcular porcentaje relativo al baseline
+    int range = calibration.*Traits::PERCENT_REFERENCE - calibration.baselineAvg;
+    int value = raw - calibration.baselineAvg;
+
+    if (range <= 0) range = 1;
+    if (value < 0) value = 0;
+    if (value > range) value = range;
+
+    return map(value, 0, range, 0, 100);
+}
+
+template <typename Traits>
+long GasSensor<Traits>::rawToPPM(int raw) const {
+    // Curva del datasheet: Rs/R0 con R0 derivado del baseline en aire limpio
+    if (GAS_PPM_CURVE_LOGLOG) {
+        if (raw <= calibration.baselineAvg) {
+            return 0;
+        }
+
+        float r0 = GasCurve::resistanceRatio(calibration.baselineAvg) / Traits::CLEAN_AIR_RATIO;
+        float ratio = GasCurve::resistanceRatio(raw) / r0;
+        int points = sizeof(Traits::CURVE) / sizeof(Traits::CURVE[0]);
+
+        return (long)GasCurve::ppmFromRatio(Traits::CURVE, points, ratio);
+    }
+
+    if (!calibration.isCalibrated) {
+        return map(raw, 0, 4095, 0, Traits::UNCALIBRATED_PPM_MAX);
+    }
+
+    // Calcular PPM basado en desviación del baseline
+    long deviation = raw - calibration.baselineAvg;
+    if (deviation < 0) deviation = 0;
+
+    return Traits::deviationToPPM(deviation, calibration);
+}
+
+template <typename Traits>
+long GasSensor<Traits>::ppmToLELCenti(long ppm) const {
+    // LEL% = (PPM / LEL_PPM) * 100
+    if (Traits::LEL_PPM <= 0) {
+        return 0;
+    }
+    return (long)((long long)ppm * 10000 / Traits::LEL_PPM);
+}
+
+template <typename Traits>
+typename GasSensor<Traits>::State GasSensor<Traits>::determineLevel(int raw) const {
+    if (raw < 0 || raw > 4095) {
+        return State::ERROR;
+    }
+
+    // Tabla ordenada de mayor a menor umbral
+    for (const GasStateRule<State>& rule : Traits::STATE_TABLE) {
+        if (raw >= calibration.*rule.threshold) {
+            return rule.state;
+        }
+    }
+
+    return State::NORMAL;
+}
+
+template <typename Traits>
+GasLutEntry GasSensor<Traits>::computeEntry(int raw) const {
+    long ppm = rawToPPM(raw);
+
+    GasLutEntry entry;
+    entry.ppm = GasCurve::saturate16(ppm);
+    entry.lelCenti = GasCurve::saturate16(ppmToLELCenti(ppm));
+    entry.percentage = (uint8_t)rawToPercentage(raw);
+    entry.state = (uint8_t)determineLevel(raw);
+    return entry;
+}
+
+template <typename Traits>
+void GasSensor<Traits>::rebuildLut() {
+    // Despertar la tarea de sensores al cruzar el umbral más bajo de la tabla
+    const GasStateRule<State>& lowest = Traits::STATE_TABLE[sizeof(Traits::STATE_TABLE) / sizeof(Traits::STATE_TABLE[0]) - 1];
+    long wake = (long)(calibration.*lowest.threshold) << ADC_OVERSAMPLE_BITS;
+    AdcSampler::getInstance()->setWakeThreshold(adcChannel, wake < 0xFFFF ? (uint16_t)wake : 0xFFFF);
+
+    if (lut == nullptr) {
+        return;
+    }
+
+    for (int raw = 0; raw < GAS_LUT_SIZE; raw++) {
+        lut[raw] = computeEntry(raw);
+    }
+}
+
+template <typename Traits>
+void GasSensor<Traits>::updateWarmup() {
+    if (isWarmedUp) {
+        return;
+    }
+
+    unsigned long elapsed = Clock::millis() - warmupStartTime;
+
+    if (elapsed >= Traits::WARMUP_TIME) {
+        isWarmedUp = true;
+        cusum.reset();  // La deriva del calentamiento no es una subida
+        if (DEBUG_SERIAL) {
+            Serial.printf("✓ Sensor %s calentado - Listo para usar\n", Traits::NAME);
+        }
+    } else if (Clock::millis() - lastWarmupLog >= WARMUP_LOG_INTERVAL) {
+        // Mostrar progreso cada 30 segundos
+        lastWarmupLog = Clock::millis();
+        if (DEBUG_SERIAL) {
+            Serial.printf("⏳ %s calentando... %lu segundos restantes\n",
+                         Traits::NAME, (Traits::WARMUP_TIME - elapsed) / 1000);
+        }
+    }
+}
+
+template <typename Traits>
+typename GasSensor<Traits>::Reading GasSensor<Traits>::read() {
+    // Verificar warmup
+    updateWarmup();
+
+    // Leer valor
+    int raw = readRawValue();
+
+    // Calibración incremental (no afecta la lectura actual)
+    updateCalibration(Clock::millis());
+
+    // Conversión: una entrada de la tabla precalculada
+    if (raw < 0) raw = 0;
+    if (raw > GAS_LUT_SIZE - 1) raw = GAS_LUT_SIZE - 1;
+    GasLutEntry entry = lut ? lut[raw] : computeEntry(raw);
+
+    // Crear estructura de lectura
+    Reading reading;
+    reading.rawValue = raw;
+    reading.voltage = rawToVoltage(raw);
+    reading.percentage = entry.percentage;
+    reading.ppm = entry.ppm;
+    reading.lel = entry.lelCenti / 100.0f;
+    reading.state = isWarmedUp ? (State)entry.state : State::INITIALIZING;
+    reading.rising = isWarmedUp && cusum.isRising();
+    reading.quality = quality;
+    reading.timestamp = Clock::millis();
+
+    // Envejecimiento del sensor: el baseline sigue al aire limpio
+    updateBaseline(reading);
+
+    // Guardar como última lectura
+    lastReading = reading;
+
+    return reading;
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::calibrate(int samples, int delayMs) {
+    if (Traits::CALIBRATE_REQUIRES_WARMUP && !isWarmedUp) {
+        if (DEBUG_SERIAL) {
+            Serial.printf("❌ ERROR: Sensor %s no está calentado\n", Traits::NAME);
+            Serial.printf("   Espera %lu segundos antes de calibrar\n", Traits::WARMUP_TIME / 1000);
+        }
+        return false;
+    }
+
+    if (samples <= 0 || delayMs < 0) {
+        return false;
+    }
+
+    calibrationSession.start(samples, delayMs, Clock::millis());
+    lastCalibrationLog = 0;
+
+    if (DEBUG_SERIAL) {
+        Serial.println("\n╔═══════════════════════════════════╗");
+        Serial.printf("║     CALIBRANDO SENSOR %-12s║\n", Traits::NAME);
+        Serial.println("╚═══════════════════════════════════╝");
+        Serial.println("⚠ IMPORTANTE: Asegúrate de estar en");
+        Serial.println("  un ambiente con AIRE LIMPIO");
+        Serial.printf("  Acumulando %d muestras en segundo plano...\n\n", samples);
+    }
+
+    return true;
+}
+
+template <typename Traits>
+void GasSensor<Traits>::abortCalibration() {
+    if (!calibrationSession.isRunning()) {
+        return;
+    }
+
+    calibrationSession.abort();
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("⚠ Calibración %s cancelada - Se conserva la anterior\n", Traits::NAME);
+    }
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::isCalibrating() const {
+    return calibrationSession.isRunning();
+}
+
+template <typename Traits>
+int GasSensor<Traits>::getCalibrationProgress() const {
+    return calibrationSession.getProgress();
+}
+
+template <typename Traits>
+CalibrationStatus GasSensor<Traits>::getCalibrationStatus() const {
+    return calibrationSession.getStatus();
+}
+
+template <typename Traits>
+void GasSensor<Traits>::updateCalibration(unsigned long now) {
+    if (!calibrationSession.shouldSample(now) || lastBatch.isEmpty()) {
+        return;
+    }
+
+    // Media del lote para media/varianza; rango crudo para min/max
+    // (lote en escala ADC_SCAN_BITS, calibración en escala de 12 bits)
+    const float scale = 1.0f / ADC_SCAN_SCALE;
+    WelfordStats& stats = calibrationSession.stats(0);
+    stats.add(lastBatch.sum * scale / lastBatch.count);
+    stats.includeRange(lastBatch.min * scale, lastBatch.max * scale);
+
+    if (calibrationSession.commitSample(now)) {
+        finishCalibration();
+        return;
+    }
+
+    // Mostrar progreso cada 10%
+    int progress = calibrationSession.getProgress();
+    if (DEBUG_SERIAL && progress / 10 > lastCalibrationLog) {
+        lastCalibrationLog = progress / 10;
+        Serial.printf("Calibración %s: %d%% (Actual: %d)\n", Traits::NAME, progress, AdcScan::toNative(lastBatch.mean()));
+    }
+}
+
+template <typename Traits>
+void GasSensor<Traits>::finishCalibration() {
+    const WelfordStats& stats = calibrationSession.stats(0);
+
+    // Calcular baseline
+    calibration.baselineMin = (int)stats.min;
+    calibration.baselineMax = (int)stats.max;
+    calibration.baselineAvg = (int)(stats.mean + 0.5f);
+
+    // Calcular umbrales automáticamente
+    int variance = (calibration.baselineMax - calibration.baselineMin) / 2;
+
+    for (const GasThresholdSpec& spec : Traits::THRESHOLDS) {
+        calibration.*spec.field = calibration.baselineAvg + variance * spec.factor;
+    }
+
+    calibration.isCalibrated = true;
+    baselineTracker.setAnchor(calibration.baselineAvg);
+    baselineDirty = false;
+    rebuildLut();
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("\n✓ Calibración %s completada:\n", Traits::NAME);
+        Serial.println("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
+        Serial.printf("  Baseline Min:      %d\n", calibration.baselineMin);
+        Serial.printf("  Baseline Max:      %d\n", calibration.baselineMax);
+        Serial.printf("  Baseline Avg:      %d\n", calibration.baselineAvg);
+        Serial.printf("  Desv. estándar:    %.1f\n", stats.stddev());
+        for (const GasThresholdSpec& spec : Traits::THRESHOLDS) {
+            Serial.printf("  Umbral %-11s%d\n", spec.label, calibration.*spec.field);
+        }
+        Serial.println("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+    }
+
+    // Guardar calibración
+    saveCalibration();
+}
+
+template <typename Traits>
+void GasSensor<Traits>::updateBaseline(const Reading& reading) {
+    if (!GAS_BASELINE_TRACKING || lastBatch.isEmpty()) {
+        return;
+    }
+
+    // Aire limpio: sensor listo y sano, sin calibración en curso, bajo el primer umbral y sin subida
+    bool clean = isWarmedUp && calibration.isCalibrated && !calibrationSession.isRunning() &&
+                 reading.quality == QUALITY_OK && reading.state == State::NORMAL && !reading.rising &&
+                 reading.rawValue < calibration.thresholdCaution;
+    unsigned long now = Clock::millis();
+
+    if (baselineTracker.add(lastBatch.mean() * (1.0f / ADC_SCAN_SCALE), clean, now)) {
+        applyBaseline(baselineTracker.getBaseline());
+    }
+
+    // Punto de control espaciado (desgaste de la flash); nunca con datos inyectados
+    if (baselineDirty && now - lastBaselineCheckpoint >= GAS_BASELINE_CHECKPOINT &&
+        !AdcSampler::getInstance()->isReplaying()) {
+        lastBaselineCheckpoint = now;
+        baselineDirty = false;
+        saveCalibration();
+    }
+}
+
+template <typename Traits>
+void GasSensor<Traits>::applyBaseline(int baseline) {
+    int delta = baseline - calibration.baselineAvg;
+    if (delta == 0) {
+        return;
+    }
+
+    calibration.baselineMin += delta;
+    calibration.baselineMax += delta;
+    calibration.baselineAvg += delta;
+    for (const GasThresholdSpec& spec : Traits::THRESHOLDS) {
+        calibration.*spec.field += delta;
+    }
+
+    rebuildLut();
+    baselineDirty = true;
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("↕ Baseline %s: %d (deriva %+d desde la calibración)\n",
+                     Traits::NAME, calibration.baselineAvg, baselineTracker.getDrift());
+    }
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::isReady() const {
+    return isWarmedUp && calibration.isCalibrated;
+}
+
+template <typename Traits>
+typename GasSensor<Traits>::Reading GasSensor<Traits>::getLastReading() const {
+    return lastReading;
+}
+
+template <typename Traits>
+typename GasSensor<Traits>::State GasSensor<Traits>::getState() const {
+    return lastReading.state;
+}
+
+template <typename Traits>
+AdcBatch GasSensor<Traits>::getLastBatch() const {
+    return lastBatch;
+}
+
+template <typename Traits>
+int GasSensor<Traits>::getAdcChannel() const {
+    return adcChannel;
+}
+
+template <typename Traits>
+GasCalibration GasSensor<Traits>::getCalibration() const {
+    return calibration;
+}
+
+template <typename Traits>
+int GasSensor<Traits>::getBaselineDrift() const {
+    return calibration.baselineAvg - baselineTracker.getAnchor();
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::loadCalibration() {
+    FileManager* fm = FileManager::getInstance();
+
+    if (!fm->exists(Traits::CAL_PATH)) {
+        return false;
+    }
+
+    String data = fm->readFile(Traits::CAL_PATH);
+    if (data.length() == 0) {
+        return false;
+    }
+
+    // Parse formato: min,max,avg,umbral1,...,umbralN
+    const int expected = 3 + sizeof(Traits::THRESHOLDS) / sizeof(Traits::THRESHOLDS[0]);
+    int values[expected];
+    int index = 0;
+    int start = 0;
+
+    for (int i = 0; i <= (int)data.length(); i++) {
+        if (i == (int)data.length() || data[i] == ',') {
+            if (index < expected) {
+                values[index++] = data.substring(start, i).toInt();
+                start = i + 1;
+            }
+        }
+    }
+
+    if (index != expected) {
+        return false;
+    }
+
+    calibration.baselineMin = values[0];
+    calibration.baselineMax = values[1];
+    calibration.baselineAvg = values[2];
+
+    index = 3;
+    for (const GasThresholdSpec& spec : Traits::THRESHOLDS) {
+        calibration.*spec.field = values[index++];
+    }
+
+    // Deriva ya seguida respecto de la calibración manual (archivo aparte;
+    // sin él, el baseline no se movió desde la calibración)
+    int anchor = calibration.baselineAvg;
+    if (fm->exists(Traits::ANCHOR_PATH)) {
+        String anchorData = fm->readFile(Traits::ANCHOR_PATH);
+        if (anchorData.length() > 0) {
+            anchor = anchorData.toInt();
+        }
+    }
+    baselineTracker.setAnchor(anchor, (calibration.baselineAvg - anchor) * 256);
+    baselineDirty = false;
+
+    calibration.isCalibrated = true;
+    rebuildLut();
+    return true;
+}
+
+template <typename Traits>
+bool GasSensor<Traits>::saveCalibration() {
+    FileManager* fm = FileManager::getInstance();
+
+    // Formato: min,max,avg,umbral1,...,umbralN
+    String data = String(calibration.baselineMin) + "," +
+                  String(calibration.baselineMax) + "," +
+                  String(calibration.baselineAvg);
+
+    for (const GasThresholdSpec& spec : Traits::THRESHOLDS) {
+        data += "," + String(calibration.*spec.field);
+    }
+
+    bool result = fm->writeFile(Traits::CAL_PATH, data);
+
+    // Baseline calibrado en su propio archivo: el CSV mantiene el formato
+    // que leen firmwares anteriores y las herramientas
+    int anchor = baselineTracker.getAnchor();
+    if (anchor != calibration.baselineAvg) {
+        result = fm->writeFile(Traits::ANCHOR_PATH, String(anchor)) && result;
+    } else if (fm->exists(Traits::ANCHOR_PATH)) {
+        fm->deleteFile(Traits::ANCHOR_PATH);
+    }
+
+    if (DEBUG_SERIAL) {
+        if (result) {
+            Serial.printf("✓ Calibración %s guardada en LittleFS\n", Traits::NAME);
+        } else {
+            Serial.printf("❌ Error al guardar calibración %s\n", Traits::NAME);
+        }
+    }
+
+    return result;
+}
+
+template <typename Traits>
+String GasSensor<Traits>::getStateString() const {
+    return Traits::stateName(lastReading.state);
+}
+
+template <typename Traits>
+int GasSensor<Traits>::getPercentage() const {
+    return lastReading.percentage;
+}
+
+template <typename Traits>
+int GasSensor<Traits>::getPPM() const {
+    return lastReading.ppm;
+}
+
+// ==================== INSTANCIAS ====================
+// Agregar aquí cada nuevo gas (CO, H2, ...)
+template class GasSensor<SmokeTraits>;
+template class GasSensor<CH4Traits>;
@@ -0,0 +1,359 @@
+/*
+Motor común para sensores de gas MEMS (analógicos):
+
+Calentamiento (warmup)
+Muestreo en segundo plano + filtro por muestra
+Conversión a voltaje / porcentaje / PPM / LEL (tabla precalculada)
+Calibración incremental (no bloqueante) y persistencia en LittleFS (CSV)
+Seguimiento del baseline en aire limpio (deriva acotada, puntos de control)
+Corrección por temperatura y humedad (grilla bilineal, una ganancia por muestra)
+Mapeo de estados por tabla de umbrales
+Detección de subida sostenida (CUSUM) sobre la señal filtrada
+
+Todo lo que cambia entre gases (umbrales, tabla de estados, warmup,
+curva de conversión) lo aporta una clase Traits con miembros constexpr.
+No hay métodos virtuales: cada sensor es GasSensor<SuTraits>.
+
+Requisitos de Traits:
+    typedef ... State;                     // enum class con INITIALIZING, NORMAL, ERROR
+    typedef ... Filter;                    // Filtro de utils/Filters.h
+    static constexpr const char* NAME;     // Nombre corto ("SMOKE", "CH4")
+    static constexpr const char* CAL_PATH; // Archivo de calibración
+    static constexpr const char* ANCHOR_PATH; // Baseline calibrado (si derivó)
+    static constexpr unsigned long WARMUP_TIME;          // ms
+    static constexpr bool CALIBRATE_REQUIRES_WARMUP;
+    static constexpr GasCalibration DEFAULT_CALIBRATION;
+    static constexpr GasThresholdSpec THRESHOLDS[];      // Umbrales persistidos
+    static constexpr GasStateRule<State> STATE_TABLE[];  // De mayor a menor
+    static constexpr int GasCalibration::* PERCENT_REFERENCE; // 100% de escala
+    static constexpr long UNCALIBRATED_PPM_MAX;
+    static constexpr long LEL_PPM;         // 0 si el gas no es combustible
+    static constexpr GasCurvePoint CURVE[];                // Rs/R0 → PPM
+    static constexpr float CLEAN_AIR_RATIO;                // Rs/R0 en aire limpio
+    static constexpr const char* COMP_PATH;                // Grilla de corrección (texto)
+    static constexpr int16_t COMP_TEMPS[];                 // Eje de temperatura (décimas de °C)
+    static constexpr int16_t COMP_HUMIDITIES[];            // Eje de humedad (décimas de %)
+    static constexpr uint16_t COMP_GAINS[];                // Ganancias Q12 por defecto
+    static long deviationToPPM(long deviation, const GasCalibration& cal);
+    static const char* stateName(State state);
+*/
+#ifndef GASSENSOR_H
+#define GASSENSOR_H
+
+#include <Arduino.h>
+#include "AdcBatch.h"
+#include "GasLut.h"
+#include "SensorReadings.h"
+#include "../config/Config.h"
+#include "../utils/Filters.h"
+#include "../utils/CusumDetector.h"
+#include "../utils/BaselineTracker.h"
+#include "../utils/CompensationGrid.h"
+#include "../utils/CalibrationSession.h"
+#include "../utils/SensorHealth.h"
+
+// Estructura de calibración (común a todos los gases)
+struct GasCalibration {
+    int baselineMin;        // Valor mínimo en aire limpio
+    int baselineMax;        // Valor máximo en aire limpio
+    int baselineAvg;        // Promedio del baseline
+    int thresholdCaution;   // Umbral de precaución
+    int thresholdWarning;   // Umbral de advertencia
+    int thresholdAlarm;     // Umbral de alarma
+    int thresholdExplosive; // Umbral explosivo (solo gases combustibles)
+    bool isCalibrated;      // ¿Está calibrado?
+};
+
+// Umbral persistido y calculado en la calibración
+struct GasThresholdSpec {
+    int GasCalibration::* field;    // Campo de GasCalibration
+    int factor;                     // Múltiplo de (max - min) / 2 sobre el baseline
+    const char* label;              // Texto para el log de calibración
+};
+
+// Regla de la tabla de estados: raw >= umbral → estado
+template <typename State>
+struct GasStateRule {
+    int GasCalibration::* threshold;
+    State state;
+};
+
+template <typename Traits>
+class GasSensor {
+public:
+    typedef typename Traits::State State;
+    typedef GasReading<State> Reading;
+
+protected:
+    int pin;
+    GasCalibration calibration;
+    Reading lastReading;
+
+    // Variables de warmup
+    unsigned long warmupStartTime;
+    unsigned long lastWarmupLog;
+    bool isWarmedUp;
+
+    // Filtro de lectura suavizada
+    typename Traits::Filter filter;
+
+    // Subida sostenida de la señal filtrada (muestra a muestra, solo con muestreo en segundo plano)
+    CusumDetector<GAS_CUSUM_BASELINE_SHIFT> cusum;
+
+    // Deriva lenta del baseline en aire limpio (desplaza baseline y umbrales)
+    BaselineTracker baselineTracker;
+    unsigned long lastBaselineCheckpoint;
+    bool baselineDirty;     // Calibración desplazada sin guardar
+
+    // Corrección por temperatura y humedad (ganancia vigente, Q12)
+    CompensationGrid compensation;
+    uint16_t compensationGain;
+
+    // Salud del canal: trabado, plano o en un riel (sobre muestras sin corregir)
+    SignalMonitor health;
+    uint8_t quality;
+
+    // Muestreo en segundo plano
+    int adcChannel;         // Canal en AdcSampler (-1 si no registrado)
+    AdcBatch lastBatch;     // Último lote consumido (escala ADC_SCAN_BITS)
+
+    // Tabla de conversión raw → PPM/LEL/%/estado (se regenera al cambiar la calibración)
+    GasLutEntry* lut;
+
+    // Calibración en curso (la calibración vigente sigue activa hasta terminar)
+    CalibrationSession<1> calibrationSession;
+    int lastCalibrationLog; // Último 10% informado
+
+    GasSensor(int sensorPin); // Solo accesible desde el singleton derivado
+
+    /**
+     * Consume el lote acumulado por AdcSampler y lo filtra
+     * (lectura directa del ADC si el muestreo no está activo)
+     */
+    int readRawValue();
+
+    /**
+     * Convierte valor ADC a voltaje
+     */
+    float rawToVoltage(int raw) const;
+
+    /**
+     * Convierte valor ADC a porcentaje
+     */
+    int rawToPercentage(int raw) const;
+
+    /**
+     * Estima PPM según la curva del gas (lineal o log-log)
+     */
+    long rawToPPM(int raw) const;
+
+    /**
+     * Convierte PPM a % del LEL * 100
+     */
+    long ppmToLELCenti(long ppm) const;
+
+    /**
+     * Determina el nivel recorriendo la tabla de umbrales
+     * (sin considerar el warmup)
+     */
+    State determineLevel(int raw) const;
+
+    /**
+     * Calcula una entrada de la tabla de conversión
+     */
+    GasLutEntry computeEntry(int raw) const;
+
+    /**
+     * Regenera la tabla de conversión con la calibración actual
+     * (y el umbral de despertar del muestreo ADC)
+     */
+    void rebuildLut();
+
+    /**
+     * Verifica si terminó el calentamiento
+     */
+    void updateWarmup();
+
+    /**
+     * Agrega el lote actual a la calibración en curso (si corresponde)
+     */
+    void updateCalibration(unsigned long now);
+
+    /**
+     * Calcula baseline y umbrales con la estadística acumulada
+     */
+    void finishCalibration();
+
+    /**
+     * Agrega la lectura al seguimiento del baseline (si es de aire limpio)
+     * y guarda un punto de control si corresponde
+     */
+    void updateBaseline(const Reading& reading);
+
+    /**
+     * Desplaza baseline y umbrales al nuevo baseline (mismas distancias)
+     */
+    void applyBaseline(int baseline);
+
+    /**
+     * Aplica la ganancia de corrección al resumen de un lote
+     */
+    static void compensateBatch(AdcBatch& batch, uint16_t gain);
+
+public:
+    /**
+     * Inicializa el sensor
+     * @param enableWarmup Si true, esperará el tiempo de calentamiento
+     * @return true si se inicializó correctamente
+     */
+    bool begin(bool enableWarmup = true);
+
+    /**
+     * Reinicia filtro y calentamiento, como al volver a encender el sensor
+     * (la calibración se conserva)
+     * @param enableWarmup Si true, vuelve a esperar el tiempo de calentamiento
+     */
+    void restart(bool enableWarmup = true);
+
+    /**
+     * Actualiza la condición ambiental para la corrección de las próximas muestras
+     * @param temperature Temperatura (°C)
+     * @param humidity Humedad relativa (%)
+     * @param valid false si no hay lectura ambiental (sin corrección)
+     */
+    void setEnvironment(float temperature, float humidity, bool valid);
+
+    /**
+     * Carga la grilla de corrección desde archivo (si existe)
+     * Sin archivo o con errores se usa la grilla por defecto del gas.
+     * @return true si se cargó el archivo
+     */
+    bool loadCompensation();
+
+    /**
+     * Obtiene la ganancia de corrección vigente
+     * @return Ganancia (1.0 = sin corrección)
+     */
+    float getCompensationGain() const;
+
+    /**
+     * Inicia la calibración en aire limpio (no bloqueante)
+     * Cada read() aporta como máximo una muestra; las alarmas siguen
+     * evaluándose con la calibración anterior hasta que termine.
+     * @param samples Número de muestras a tomar
+     * @param delayMs Tiempo mínimo entre muestras
+     * @return true si la calibración se inició
+     */
+    bool calibrate(int samples = 300, int delayMs = 1000);
+
+    /**
+     * Cancela la calibración en curso (se conserva la anterior)
+     */
+    void abortCalibration();
+
+    /**
+     * Verifica si hay una calibración en curso
+     */
+    bool isCalibrating() const;
+
+    /**
+     * Obtiene el progreso de la calibración en curso
+     * @return Porcentaje 0-100
+     */
+    int getCalibrationProgress() const;
+
+    /**
+     * Obtiene el estado de la última calibración iniciada
+     */
+    CalibrationStatus getCalibrationStatus() const;
+
+    /**
+     * Lee el sensor y actualiza el estado
+     * @return Estructura con la lectura completa
+     */
+    Reading read();
+
+    /**
+     * Verifica si el sensor está listo (warmed up y calibrado)
+     * @return true si el sensor está listo para usar
+     */
+    bool isReady() const;
+
+    /**
+     * Obtiene la última lectura sin leer nuevamente
+     * @return Última lectura almacenada
+     */
+    Reading getLastReading() const;
+
+    /**
+     * Obtiene el estado actual del sensor
+     * @return Estado actual
+     */
+    State getState() const;
+
+    /**
+     * Obtiene el resumen del último lote de muestras consumido
+     * @return Cuenta, suma, mínimo y máximo del lote (escala ADC_SCAN_BITS)
+     */
+    AdcBatch getLastBatch() const;
+
+    /**
+     * Obtiene el canal asignado en AdcSampler
+     * @return Índice del canal (-1 si no registrado)
+     */
+    int getAdcChannel() const;
+
+    /**
+     * Obtiene la calibración actual
+     * @return Estructura de calibración
+     */
+    GasCalibration getCalibration() const;
+
+    /**
+     * Obtiene la deriva seguida desde la última calibración manual
+     * @return Cuentas ADC sumadas al baseline calibrado
+     */
+    int getBaselineDrift() const;
+
+    /**
+     * Carga calibración desde archivo (si existe)
+     * @return true si se cargó correctamente
+     */
+    bool loadCalibration();
+
+    /**
+     * Guarda calibración en archivo
+     * @return true si se guardó correctamente
+     */
+    bool saveCalibration();
+
+    /**
+     * Resetea la calibración a valores por defecto
+     */
+    void resetCalibration();
+
+    /**
+     * Establece la calibración manualmente (no se guarda en archivo)
+     */
+    void setCalibration(const GasCalibration& cal);
+
+    /**
+     * Obtiene el estado como string
+     * @return Texto descriptivo del estado
+     */
+    String getStateString() const;
+
+    /**
+     * Obtiene el porcentaje del último reading
+     * @return Porcentaje 0-100
+     */
+    int getPercentage() const;
+
+    /**
+     * Obtiene PPM del último reading
+     * @return PPM estimado
+     */
+    int getPPM() const;
+};
+
+#endif // GASSENSOR_H
@@ -0,0 +1,44 @@
+#include "I2CBus.h"
+
+/**
+ * Suelta una línea (la sube el pull-up)
+ */
+static void release(int pin) {
+    pinMode(pin, INPUT_PULLUP);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+}
+
+/**
+ * Lleva una línea a bajo
+ */
+static void drive(int pin) {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+}
+
+bool I2CBus::recover(TwoWire& bus, int sdaPin, int sclPin) {
+    bus.end();
+    release(sdaPin);
+    release(sclPin);
+
+    // SCL retenido por un esclavo: no hay pulsos que dar
+    if (digitalRead(sclPin) == LOW) {
+        bus.begin(sdaPin, sclPin);
+        return false;
+    }
+
+    // Pulsos de reloj hasta que el esclavo suelte SDA
+    for (int pulse = 0; pulse < I2C_RECOVERY_PULSES && digitalRead(sdaPin) == LOW; pulse++) {
+        drive(sclPin);
+        release(sclPin);
+    }
+
+    // START + STOP: SDA baja y sube con SCL en alto (reinicia la lógica de los esclavos)
+    drive(sdaPin);
+    release(sdaPin);
+
+    bool released = digitalRead(sdaPin) == HIGH && digitalRead(sclPin) == HIGH;
+    bus.begin(sdaPin, sclPin);
+    return released;
+}
@@ -0,0 +1,32 @@
+/*
+Recuperación del bus I2C sin reiniciar el equipo:
+
+Un esclavo que quedó a mitad de un byte (reset del maestro, ruido, corte
+de alimentación breve) retiene SDA en bajo y el periférico I2C ya no puede
+generar un START: todas las transacciones fallan hasta apagar la placa
+Se toman los pines a mano (drenador abierto: "alto" = entrada con pull-up),
+se dan hasta 9 pulsos de SCL para que el esclavo termine el byte y suelte
+SDA, se genera un STOP y se vuelve a iniciar el periférico
+Bloquea ~100 µs; se llama desde la tarea dueña del bus
+*/
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define I2C_RECOVERY_PULSES 9           // Bits de un byte + ACK
+#define I2C_RECOVERY_HALF_PERIOD_US 5   // Medio periodo de SCL (100 kHz)
+
+namespace I2CBus {
+    /**
+     * Libera un bus trabado y reinicia el periférico
+     * @param bus Bus a recuperar (se detiene y se vuelve a iniciar)
+     * @param sdaPin Pin SDA
+     * @param sclPin Pin SCL
+     * @return true si SDA y SCL quedaron en alto (bus libre)
+     */
+    bool recover(TwoWire& bus, int sdaPin, int sclPin);
+}
+
+#endif // I2CBUS_H
@@ -0,0 +1,88 @@
+/*
+Lecturas que publican los sensores (bus de eventos, instantáneas, API):
+
+Solo los tipos, sin los drivers: quien consume lecturas no depende de
+Arduino ni del hardware (compilable en host)
+*/
+#ifndef SENSORREADINGS_H
+#define SENSORREADINGS_H
+
+#include <stdint.h>
+
+// Estructura de lectura del sensor
+template <typename State>
+struct GasReading {
+    int rawValue;           // Valor crudo ADC (0-4095)
+    float voltage;          // Voltaje (0-3.3V)
+    int percentage;         // Porcentaje (0-100%)
+    int ppm;                // Partes por millón (estimado)
+    float lel;              // % del Lower Explosive Limit (0 si no aplica)
+    State state;            // Estado actual
+    bool rising;            // Subida sostenida aún bajo los umbrales (CUSUM)
+    uint8_t quality;        // Banderas QUALITY_* (0 = datos confiables)
+    unsigned long timestamp; // Timestamp de la lectura
+};
+
+// Estados del sensor de humo
+enum class SmokeState {
+    INITIALIZING,   // Inicializando/calentando
+    NORMAL,         // Aire limpio
+    DETECTED,       // Humo detectado
+    CRITICAL,       // Nivel crítico de humo
+    ERROR           // Error de lectura
+};
+
+typedef GasReading<SmokeState> SmokeReading;
+
+// Estados del sensor de metano
+enum class CH4State {
+    INITIALIZING,   // Inicializando/calentando
+    NORMAL,         // Aire limpio
+    DETECTED,       // Metano detectado
+    CRITICAL,       // Nivel crítico de metano
+    EXPLOSIVE,      // Nivel explosivo (> 5% LEL)
+    ERROR           // Error de lectura
+};
+
+typedef GasReading<CH4State> CH4Reading;
+
+// Estados del sensor ambiental
+enum class EnvironmentState {
+    NORMAL,             // Condiciones normales
+    HIGH_TEMP,          // Temperatura alta
+    RAPID_TEMP_RISE,    // Subida rápida de temperatura
+    LOW_HUMIDITY,       // Humedad baja (riesgo incendio)
+    HIGH_HUMIDITY,      // Humedad alta (vapor/cocina)
+    PRESSURE_DROP,      // Caída de presión (aire caliente)
+    FIRE_SUSPECTED,     // Patrón de incendio detectado
+    ERROR               // Error de lectura
+};
+
+// Estructura de lectura ambiental
+struct EnvironmentReading {
+    // Temperatura
+    float temperature;          // °C (de AHT20)
+    float temperatureBMP;       // °C (de BMP280 - validación)
+    float tempDelta;            // Diferencia con baseline
+    float tempRate;             // °C/min (pendiente en la ventana de tendencia)
+    
+    // Humedad
+    float humidity;             // % (de AHT20)
+    float humidityDelta;        // Diferencia con baseline
+    float humidityRate;         // %/min (pendiente en la ventana de tendencia)
+    
+    // Presión
+    float pressure;             // hPa (de BMP280)
+    float pressureDelta;        // Diferencia con baseline hPa
+    float pressureRate;         // hPa/min (pendiente en la ventana de tendencia)
+    float altitude;             // Metros (calculado)
+    
+    // Estado
+    EnvironmentState state;     // Estado evaluado
+    uint8_t quality;            // Banderas QUALITY_* (0 = datos confiables)
+    uint8_t temperatureQuality; // Banderas del AHT20 (temperatura, humedad)
+    uint8_t pressureQuality;    // Banderas del BMP280 (presión)
+    unsigned long timestamp;    // Timestamp de lectura
+};
+
+#endif // SENSORREADINGS_H
@@ -2,82 +2,96 @@
 #define SMOKESENSOR_H
 
 #include <Arduino.h>
+#include "GasSensor.h"
+#include "../config/Config.h"
 
-// Estados del sensor
-enum class SmokeState {
-    INITIALIZING,   // Inicializando/calentando
-    NORMAL,         // Aire limpio
-    DETECTED,       // Humo detectado
-    CRITICAL,       // Nivel crítico de humo
-    ERROR           // Error de lectura
-};
+// Filtro de suavizado por muestra (ver utils/Filters.h)
+// Alternativas: EmaFilter<3>, MedianFilter<7>, HampelFilter<7, 30>
+typedef BoxcarFilter<SMOKE_FILTER_LOG2> SmokeFilter;  // Promedio de 2^SMOKE_FILTER_LOG2 muestras
 
-// Estructura de calibración
-struct SmokeCalibration {
-    int baselineMin;        // Valor mínimo en aire limpio
-    int baselineMax;        // Valor máximo en aire limpio
-    int baselineAvg;        // Promedio del baseline
-    int thresholdCaution;   // Umbral de precaución
-    int thresholdWarning;   // Umbral de advertencia
-    int thresholdAlarm;     // Umbral de alarma
-    bool isCalibrated;      // ¿Está calibrado?
-};
+// Parámetros del sensor de humo para GasSensor
+struct SmokeTraits {
+    typedef SmokeState State;
+    typedef SmokeFilter Filter;
+
+    static constexpr const char* NAME = "SMOKE";
+    static constexpr const char* CAL_PATH = "/smoke_cal.txt";
+    static constexpr const char* ANCHOR_PATH = "/smoke_anchor.txt";
+    static constexpr unsigned long WARMUP_TIME = 60000;     // 60 segundos
+    static constexpr bool CALIBRATE_REQUIRES_WARMUP = false;
+
+    static constexpr GasCalibration DEFAULT_CALIBRATION = {
+        0, 500, 250,        // min, max, avg
+        400, 800, 1500,     // caution, warning, alarm
+        4096,               // explosive (no aplica: inalcanzable)
+        false
+    };
+
+    // Persistidos en CSV: min,max,avg,caution,warning,alarm
+    static constexpr GasThresholdSpec THRESHOLDS[] = {
+        { &GasCalibration::thresholdCaution, 2, "Caution:" },
+        { &GasCalibration::thresholdWarning, 4, "Warning:" },
+        { &GasCalibration::thresholdAlarm,   8, "Alarm:" }
+    };
+
+    static constexpr GasStateRule<SmokeState> STATE_TABLE[] = {
+        { &GasCalibration::thresholdAlarm,   SmokeState::CRITICAL },
+        { &GasCalibration::thresholdWarning, SmokeState::DETECTED }
+    };
+
+    static constexpr int GasCalibration::* PERCENT_REFERENCE = &GasCalibration::thresholdAlarm;
+    static constexpr long UNCALIBRATED_PPM_MAX = 1000;
+    static constexpr long LEL_PPM = 0;
 
-// Estructura de lectura del sensor
-struct SmokeReading {
-    int rawValue;           // Valor crudo ADC (0-4095)
-    float voltage;          // Voltaje (0-3.3V)
-    int percentage;         // Porcentaje (0-100%)
-    int ppm;                // Partes por millón (estimado)
-    SmokeState state;       // Estado actual
-    unsigned long timestamp; // Timestamp de la lectura
+    // Curva MQ-2 para humo (datasheet), usada con GAS_PPM_CURVE_LOGLOG
+    static constexpr GasCurvePoint CURVE[] = {
+        { 3.43f, 200 }, { 1.53f, 1000 }, { 0.60f, 10000 }
+    };
+    static constexpr float CLEAN_AIR_RATIO = 9.83f;
+
+    // Corrección temperatura × humedad (datasheet MQ-2, Rs/R0 relativo a las
+    // condiciones de ensayo 20 °C / 65 %HR). Ganancia sobre la lectura: con Rs >> RL
+    // la lectura es ∝ 1/Rs
+    static constexpr const char* COMP_PATH = "/smoke_comp.txt";
+    static constexpr int16_t COMP_TEMPS[] = { -100, 0, 200, 400, 500 };    // Décimas de °C
+    static constexpr int16_t COMP_HUMIDITIES[] = { 330, 850 };             // Décimas de %
+    static constexpr uint16_t COMP_GAINS[] = {     // Q12, fila por temperatura
+        5601, 5256,     // -10 °C: 1.37  1.28
+        5170, 4739,     //   0 °C: 1.26  1.16
+        4308, 3963,     //  20 °C: 1.05  0.97
+        3877, 3533,     //  40 °C: 0.95  0.86
+        3791, 3360      //  50 °C: 0.93  0.82
+    };
+
+    /**
+     * Factor de conversión aproximado (ajustar según datasheet del sensor)
+     * 1 unidad ADC ≈ 2 PPM
+     */
+    static long deviationToPPM(long deviation, const GasCalibration&) {
+        return deviation * 2;
+    }
+
+    static const char* stateName(SmokeState state) {
+        switch (state) {
+            case SmokeState::INITIALIZING: return "INITIALIZING";
+            case SmokeState::NORMAL:       return "NORMAL";
+            case SmokeState::DETECTED:     return "DETECTED";
+            case SmokeState::CRITICAL:     return "CRITICAL";
+            case SmokeState::ERROR:        return "ERROR";
+            default:                       return "UNKNOWN";
+        }
+    }
 };
 
-class SmokeSensor {
+// Estructuras públicas (compatibles con la API anterior)
+typedef GasCalibration SmokeCalibration;
+
+class SmokeSensor : public GasSensor<SmokeTraits> {
 private:
     static SmokeSensor* instance;
-    int pin;
-    SmokeCalibration calibration;
-    SmokeReading lastReading;
-    
-    // Variables de warmup
-    unsigned long warmupStartTime;
-    bool isWarmedUp;
-    static const unsigned long WARMUP_TIME = 60000; // 60 segundos
-    
-    // Variables de lectura suavizada
-    static const int SAMPLE_SIZE = 10;
-    int readings[SAMPLE_SIZE];
-    int readIndex;
-    long total;
-    
+
     SmokeSensor(int sensorPin); // Constructor privado
-    
-    /**
-     * Lee el valor crudo del ADC con promediado
-     */
-    int readRawValue();
-    
-    /**
-     * Convierte valor ADC a voltaje
-     */
-    float rawToVoltage(int raw);
-    
-    /**
-     * Convierte valor ADC a porcentaje
-     */
-    int rawToPercentage(int raw);
-    
-    /**
-     * Estima PPM basado en calibración
-     */
-    int rawToPPM(int raw);
-    
-    /**
-     * Determina el estado basado en el valor
-     */
-    SmokeState determineState(int raw);
-    
+
 public:
     /**
      * Obtiene la instancia única de SmokeSensor (Singleton)
@@ -85,98 +99,18 @@ public:
      * @return Puntero a la instancia de SmokeSensor
      */
     static SmokeSensor* getInstance(int sensorPin = 36);
-    
-    /**
-     * Inicializa el sensor
-     * @param enableWarmup Si true, esperará el tiempo de calentamiento
-     * @return true si se inicializó correctamente
-     */
-    bool begin(bool enableWarmup = true);
-    
-    /**
-     * Calibra el sensor en aire limpio
-     * @param samples Número de muestras a tomar
-     * @param delayMs Delay entre muestras
-     * @return true si la calibración fue exitosa
-     */
-    bool calibrate(int samples = 300, int delayMs = 1000);
-    
-    /**
-     * Lee el sensor y actualiza el estado
-     * @return Estructura con la lectura completa
-     */
-    SmokeReading read();
-    
-    /**
-     * Verifica si el sensor está listo (warmed up)
-     * @return true si el sensor está listo para usar
-     */
-    bool isReady() const;
-    
-    /**
-     * Obtiene la última lectura sin leer nuevamente
-     * @return Última lectura almacenada
-     */
-    SmokeReading getLastReading() const;
-    
-    /**
-     * Obtiene el estado actual del sensor
-     * @return Estado actual
-     */
-    SmokeState getState() const;
-    
-    /**
-     * Obtiene la calibración actual
-     * @return Estructura de calibración
-     */
-    SmokeCalibration getCalibration() const;
-    
-    /**
-     * Carga calibración desde archivo (si existe)
-     * @return true si se cargó correctamente
-     */
-    bool loadCalibration();
-    
-    /**
-     * Guarda calibración en archivo
-     * @return true si se guardó correctamente
-     */
-    bool saveCalibration();
-    
-    /**
-     * Resetea la calibración a valores por defecto
-     */
-    void resetCalibration();
-    
-    /**
-     * Obtiene el estado como string
-     * @return Texto descriptivo del estado
-     */
-    String getStateString() const;
-    
+
     /**
      * Verifica si hay humo detectado (cualquier nivel)
      * @return true si hay humo
      */
     bool isSmokeDetected() const;
-    
+
     /**
      * Verifica si es nivel crítico
      * @return true si es crítico
      */
     bool isCritical() const;
-    
-    /**
-     * Obtiene el porcentaje del último reading
-     * @return Porcentaje 0-100
-     */
-    int getPercentage() const;
-    
-    /**
-     * Obtiene PPM del último reading
-     * @return PPM estimado
-     */
-    int getPPM() const;
 };
 
-#endif // SMOKESENSOR_H
\ No newline at end of file
+#endif // SMOKESENSOR_H
@@ -62,8 +62,8 @@ bool FileManager::writeFile(const char* path, const String& content) {
     file.close();
     
     if (DEBUG_SERIAL) {
-        Serial.printf("Archivo escrito: %s -> %s (%d bytes)\n", 
-                     path, content.c_str(), bytesWritten);
+        Serial.printf("Archivo escrito: %s -> %s (%u bytes)\n", 
+                     path, content.c_str(), (unsigned)bytesWritten);
     }
     
     return bytesWritten > 0;
@@ -82,7 +82,7 @@ bool FileManager::appendFile(const char* path, const String& content) {
     file.close();
     
     if (DEBUG_SERIAL) {
-        Serial.printf("Contenido añadido a: %s (%d bytes)\n", path, bytesWritten);
+        Serial.printf("Contenido añadido a: %s (%u bytes)\n", path, (unsigned)bytesWritten);
     }
     
     return bytesWritten > 0;
@@ -148,7 +148,7 @@ void FileManager::listFiles() {
     File file = root.openNextFile();
     
     while (file) {
-        Serial.printf("  %s (%d bytes)\n", file.name(), file.size());
+        Serial.printf("  %s (%u bytes)\n", file.name(), (unsigned)file.size());
         file = root.openNextFile();
     }
     
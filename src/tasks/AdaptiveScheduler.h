@@ -0,0 +1,68 @@
+/*
+Planificador de muestreo adaptativo:
+
+Periodo lento en reposo (radio en ahorro de energía)
+Periodo rápido en cuanto hay actividad (sensor fuera de NORMAL o tendencia)
+Histéresis: se mantiene rápido un tiempo tras la última actividad y luego
+desacelera duplicando el periodo hasta volver al lento
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef ADAPTIVESCHEDULER_H
+#define ADAPTIVESCHEDULER_H
+
+#include <stdint.h>
+
+class AdaptiveScheduler {
+private:
+    uint32_t slowMs;
+    uint32_t fastMs;
+    uint32_t holdMs;
+    uint32_t interval;      // Periodo actual
+    uint32_t lastActive;    // Última vez con actividad
+
+public:
+    /**
+     * @param slowIntervalMs Periodo en reposo
+     * @param fastIntervalMs Periodo con actividad
+     * @param holdTimeMs Tiempo sin actividad antes de desacelerar
+     */
+    AdaptiveScheduler(uint32_t slowIntervalMs, uint32_t fastIntervalMs, uint32_t holdTimeMs)
+        : slowMs(slowIntervalMs),
+          fastMs(fastIntervalMs),
+          holdMs(holdTimeMs),
+          interval(slowIntervalMs),
+          lastActive(0) {}
+
+    /**
+     * Actualiza el periodo con el resultado del último ciclo
+     * @param active true si algún sensor o tendencia indica actividad
+     * @param now Tiempo actual (ms)
+     * @return Periodo hasta el próximo ciclo (ms)
+     */
+    uint32_t update(bool active, uint32_t now) {
+        if (active) {
+            lastActive = now;
+            interval = fastMs;
+        } else if (interval < slowMs && (now - lastActive) >= holdMs) {
+            // Desaceleración gradual: 250 → 500 → 1000 → ... → lento
+            interval = (interval * 2 < slowMs) ? interval * 2 : slowMs;
+        }
+        return interval;
+    }
+
+    /**
+     * Periodo actual (ms)
+     */
+    uint32_t getInterval() const {
+        return interval;
+    }
+
+    /**
+     * Verifica si está por encima del ritmo de reposo
+     */
+    bool isFast() const {
+        return interval < slowMs;
+    }
+};
+
+#endif // ADAPTIVESCHEDULER_H
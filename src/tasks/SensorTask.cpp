@@ -0,0 +1,224 @@
+#include "SensorTask.h"
+#include "../sensors/AdcSampler.h"
+#include "../events/EventBus.h"
+#include "../utils/Clock.h"
+
+// Inicializar instancia estática
+SensorTask* SensorTask::instance = nullptr;
+
+SensorTask::SensorTask()
+    : handle(nullptr),
+      scheduler(SENSOR_READ_INTERVAL, SENSOR_FAST_INTERVAL, SENSOR_FAST_HOLD_MS),
+      alertState(ALERT_EXIT_SAMPLES, ALERT_DWELL_MS, ALERT_DWELL_CRITICAL_MS),
+      alertFeatures(0),
+      cycles(0),
+      commands(0) {
+}
+
+SensorTask* SensorTask::getInstance() {
+    if (instance == nullptr) {
+        instance = new SensorTask();
+    }
+    return instance;
+}
+
+bool SensorTask::begin() {
+    if (handle != nullptr) {
+        return true;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        &SensorTask::taskEntry,
+        "sensors",
+        SENSOR_TASK_STACK,
+        this,
+        SENSOR_TASK_PRIORITY,
+        &handle,
+        SENSOR_TASK_CORE);
+
+    if (result != pdPASS) {
+        handle = nullptr;
+        if (DEBUG_SERIAL) {
+            Serial.println("❌ Error creando tarea de sensores");
+        }
+        return false;
+    }
+
+    // Gas sobre umbral entre ciclos: despertar sin esperar el periodo
+    AdcSampler::getInstance()->setWakeTask(handle);
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Tarea de sensores: core %d, cada %d ms (%d ms con actividad)\n",
+                     SENSOR_TASK_CORE, SENSOR_READ_INTERVAL, SENSOR_FAST_INTERVAL);
+    }
+
+    return true;
+}
+
+bool SensorTask::isRunning() const {
+    return handle != nullptr;
+}
+
+void SensorTask::taskEntry(void* arg) {
+    static_cast<SensorTask*>(arg)->run();
+}
+
+void SensorTask::run() {
+    bool adcWake = false;
+    TickType_t cycleStart = xTaskGetTickCount();
+    for (;;) {
+        runCommands();
+        cycle(adcWake);
+
+        // Periodo contado desde el comienzo del ciclo (su duración no se acumula)
+        TickType_t deadline = cycleStart + pdMS_TO_TICKS(scheduler.getInterval());
+        TickType_t now = xTaskGetTickCount();
+        TickType_t wait = (int32_t)(deadline - now) > 0 ? deadline - now : 0;
+
+        // Esperar el plazo o un aviso del muestreo ADC
+        adcWake = ulTaskNotifyTake(pdTRUE, wait) > 0;
+
+        // Un aviso adelanta el ciclo y un ciclo atrasado no se recupera en
+        // ráfaga: en ambos casos la cuenta sigue desde ahora
+        cycleStart = (adcWake || wait == 0) ? xTaskGetTickCount() : deadline;
+    }
+}
+
+void SensorTask::post(uint32_t command) {
+    if (command & SENSOR_CMD_ABORT_CALIBRATION) {
+        commands.fetch_and(~(uint32_t)(SENSOR_CMD_CALIBRATE_GAS | SENSOR_CMD_CALIBRATE_ENV),
+                           std::memory_order_relaxed);
+    }
+    commands.fetch_or(command, std::memory_order_release);
+}
+
+void SensorTask::runCommands() {
+    uint32_t pending = commands.exchange(0, std::memory_order_acquire);
+    if (pending == 0) {
+        return;
+    }
+
+    SmokeSensor* smokeSensor = SmokeSensor::getInstance();
+    CH4Sensor* ch4Sensor = CH4Sensor::getInstance();
+    EnvironmentSensor* envSensor = EnvironmentSensor::getInstance();
+
+    // Cancelar primero: "abort" seguido de "calibrate" vuelve a empezar
+    if (pending & SENSOR_CMD_ABORT_CALIBRATION) {
+        smokeSensor->abortCalibration();
+        ch4Sensor->abortCalibration();
+        envSensor->abortCalibration();
+    }
+
+    // No bloqueantes: avanzan con cada lectura, las alarmas siguen activas
+    if (pending & SENSOR_CMD_CALIBRATE_GAS) {
+        bool smokeStarted = smokeSensor->calibrate(300, 1000);
+        bool ch4Started = ch4Sensor->calibrate(300, 1000);
+        if (DEBUG_SERIAL && (!smokeStarted || !ch4Started)) {
+            Serial.printf("⚠ Calibración de gas no iniciada (humo %s, CH4 %s)\n",
+                         smokeStarted ? "ok" : "no", ch4Started ? "ok" : "no");
+        }
+    }
+    if (pending & SENSOR_CMD_CALIBRATE_ENV) {
+        if (!envSensor->calibrateBaseline() && DEBUG_SERIAL) {
+            Serial.println("⚠ Calibración ambiental no iniciada");
+        }
+    }
+}
+
+bool SensorTask::isActive(const SensorSnapshot& snapshot) {
+    if (snapshot.alert != ALERT_NORMAL) {
+        return true;
+    }
+
+    // Gases: cualquier nivel sobre NORMAL (INITIALIZING/ERROR no cuentan)
+    if (snapshot.smoke.state == SmokeState::DETECTED || snapshot.smoke.state == SmokeState::CRITICAL) {
+        return true;
+    }
+    if (snapshot.ch4.state == CH4State::DETECTED || snapshot.ch4.state == CH4State::CRITICAL ||
+        snapshot.ch4.state == CH4State::EXPLOSIVE) {
+        return true;
+    }
+
+    // Ambiente: la humedad fuera de rango es una condición lenta y no
+    // justifica el ritmo rápido (clima húmedo lo dejaría siempre activo)
+    EnvironmentState env = snapshot.env.state;
+    if (env != EnvironmentState::NORMAL && env != EnvironmentState::ERROR &&
+        env != EnvironmentState::LOW_HUMIDITY && env != EnvironmentState::HIGH_HUMIDITY) {
+        return true;
+    }
+
+    // Tendencias
+    return snapshot.env.tempRate > SENSOR_FAST_TEMP_RATE ||
+           snapshot.env.pressureRate < SENSOR_FAST_PRESSURE_RATE;
+}
+
+void SensorTask::cycle(bool adcWake) {
+    SmokeSensor* smokeSensor = SmokeSensor::getInstance();
+    CH4Sensor* ch4Sensor = CH4Sensor::getInstance();
+    EnvironmentSensor* envSensor = EnvironmentSensor::getInstance();
+
+    SensorSnapshot next;
+
+    // Leer todos los sensores (ambiente primero: corrige las muestras de gas)
+    next.env = envSensor->read();
+    bool envValid = envSensor->isAHT20Ready();
+    smokeSensor->setEnvironment(next.env.temperature, next.env.humidity, envValid);
+    ch4Sensor->setEnvironment(next.env.temperature, next.env.humidity, envValid);
+    next.smoke = smokeSensor->read();
+    next.ch4 = ch4Sensor->read();
+
+    // Evaluar alerta con inteligencia multi-sensor
+    next.fireProbability = SmartAlert::fireProbability(next.smoke, next.ch4, next.env);
+    alertFeatures = SmartAlert::extractFeatures(next.smoke, next.ch4, next.env,
+                                                next.fireProbability, alertFeatures);
+    next.alertFeatures = alertFeatures;
+    next.rawAlert = SmartAlert::evaluate(alertFeatures);
+
+    // Antirrebote: subir al instante, bajar con retardo
+    GlobalAlertLevel previousAlert = alertState.getLevel();
+    bool alertChanged = alertState.update(next.rawAlert, Clock::millis());
+    next.alert = alertState.getLevel();
+    next.alertTransitions = alertState.getTransitions();
+
+    next.smokeReady = smokeSensor->isReady();
+    next.ch4Ready = ch4Sensor->isReady();
+    next.envReady = envSensor->isReady();
+
+    next.smokeCalibration = smokeSensor->isCalibrating() ? smokeSensor->getCalibrationProgress() : -1;
+    next.ch4Calibration = ch4Sensor->isCalibrating() ? ch4Sensor->getCalibrationProgress() : -1;
+    next.envCalibration = envSensor->isCalibrating() ? envSensor->getCalibrationProgress() : -1;
+
+    // Periodo del próximo ciclo según la actividad
+    // (un aviso del ADC cuenta como actividad: el filtro aún no alcanzó el umbral)
+    next.sampleIntervalMs = scheduler.update(isActive(next) || adcWake, Clock::millis());
+    next.fastSampling = scheduler.isFast();
+
+    next.cycle = ++cycles;
+    next.timestamp = Clock::millis();
+
+    // Eventos primero: quien vea la instantánea nueva ya tiene sus eventos en cola
+    EventBus* bus = EventBus::getInstance();
+    if (alertChanged) {
+        bus->publish(AlertTransition{ previousAlert, next.alert, next.rawAlert, alertFeatures },
+                     next.cycle, next.timestamp);
+    }
+    bus->publish(next.smoke, next.cycle, next.timestamp);
+    bus->publish(next.ch4, next.cycle, next.timestamp);
+    bus->publish(next.env, next.cycle, next.timestamp);
+
+    snapshot.write(next);
+}
+
+void SensorTask::reset(uint32_t slowIntervalMs) {
+    scheduler = AdaptiveScheduler(slowIntervalMs, SENSOR_FAST_INTERVAL, SENSOR_FAST_HOLD_MS);
+    alertState.reset(Clock::millis());
+    alertFeatures = 0;
+}
+
+SensorSnapshot SensorTask::getSnapshot() const {
+    return snapshot.read();
+}
+
+uint32_t SensorTask::getVersion() const {
+    return snapshot.getVersion();
+}
@@ -0,0 +1,149 @@
+/*
+Tarea de adquisición de sensores:
+
+Tarea FreeRTOS fija al core de aplicación
+Lee humo, CH4 y ambiente y evalúa la alerta global en cada ciclo
+Nivel publicado con antirrebote (AlertStateMachine): sube al instante,
+baja tras varias muestras consistentes y un tiempo mínimo
+Publica una instantánea completa por seqlock (sin locks para los lectores)
+Periodo adaptativo: lento en reposo, rápido con actividad (AdaptiveScheduler)
+Despierta antes de tiempo si el muestreo ADC ve un gas cruzar su umbral
+Publica lecturas y cambios de nivel en el EventBus (antes que la instantánea)
+Único consumidor de los sensores una vez iniciada: otras tareas piden
+calibraciones por post() y la tarea las aplica al comienzo del ciclo
+*/
+#ifndef SENSORTASK_H
+#define SENSORTASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include "../config/Config.h"
+#include "../alert/SmartAlert.h"
+#include "../alert/AlertStateMachine.h"
+#include "../utils/SeqLock.h"
+#include "AdaptiveScheduler.h"
+
+// Instantánea publicada al final de cada ciclo
+struct SensorSnapshot {
+    SmokeReading smoke;
+    CH4Reading ch4;
+    EnvironmentReading env;
+    GlobalAlertLevel alert;         // Nivel publicado (con antirrebote)
+    GlobalAlertLevel rawAlert;      // Resultado de SmartAlert::evaluate() en este ciclo
+    uint32_t alertFeatures;         // Máscara FEAT_* evaluada
+    uint32_t alertTransitions;      // Cambios de nivel publicados desde el arranque
+    float fireProbability;          // 0.0 - 1.0 (SmartAlert::fireProbability)
+
+    bool smokeReady;                // Calentado
+    bool ch4Ready;
+    bool envReady;
+
+    int8_t smokeCalibration;        // Progreso 0-100, -1 si no calibra
+    int8_t ch4Calibration;
+    int8_t envCalibration;
+
+    uint32_t sampleIntervalMs;      // Periodo hasta el próximo ciclo
+    bool fastSampling;              // Ritmo rápido activo
+
+    uint32_t cycle;                 // Número de ciclo (0 = sin datos)
+    unsigned long timestamp;        // millis() al publicar
+};
+
+// Comandos para la tarea de sensores (bits: se acumulan hasta el próximo ciclo)
+enum SensorCommand : uint32_t {
+    SENSOR_CMD_CALIBRATE_GAS = 1u << 0,        // Calibrar humo y CH4 en aire limpio
+    SENSOR_CMD_CALIBRATE_ENV = 1u << 1,        // Baseline ambiental
+    SENSOR_CMD_ABORT_CALIBRATION = 1u << 2     // Cancelar las calibraciones en curso
+};
+
+class SensorTask {
+private:
+    static SensorTask* instance;
+
+    TaskHandle_t handle;
+    AdaptiveScheduler scheduler;
+    AlertStateMachine alertState;
+    uint32_t alertFeatures;     // Máscara del ciclo anterior (histéresis)
+    uint32_t cycles;
+    SeqLock<SensorSnapshot> snapshot;
+    std::atomic<uint32_t> commands;     // SensorCommand pendientes (buzón)
+
+    SensorTask(); // Constructor privado
+
+    /**
+     * Punto de entrada de la tarea FreeRTOS
+     */
+    static void taskEntry(void* arg);
+
+    /**
+     * Ciclo de adquisición periódico (no retorna)
+     */
+    void run();
+
+    /**
+     * Aplica los comandos pendientes (desde la tarea, antes del ciclo)
+     */
+    void runCommands();
+
+    /**
+     * Verifica si la instantánea justifica el ritmo rápido
+     * (sensor fuera de NORMAL, alerta activa o tendencia sobre umbral)
+     */
+    static bool isActive(const SensorSnapshot& snapshot);
+
+public:
+    /**
+     * Obtiene la instancia única de SensorTask (Singleton)
+     * @return Puntero a la instancia
+     */
+    static SensorTask* getInstance();
+
+    /**
+     * Crea la tarea de adquisición (los sensores ya deben estar inicializados)
+     * @return true si la tarea se creó
+     */
+    bool begin();
+
+    /**
+     * Verifica si la tarea está corriendo
+     */
+    bool isRunning() const;
+
+    /**
+     * Ejecuta un ciclo completo y publica la instantánea
+     * (lo usa la tarea; llamar directamente solo si no está corriendo,
+     * p. ej. al reproducir una traza)
+     * @param adcWake true si el ciclo lo adelantó un aviso del muestreo ADC
+     */
+    void cycle(bool adcWake = false);
+
+    /**
+     * Pide un comando a la tarea (seguro desde cualquier tarea)
+     * Se aplica al comienzo del próximo ciclo; cancelar descarta las
+     * calibraciones pedidas antes y todavía no aplicadas
+     * @param command Uno o más SensorCommand
+     */
+    void post(uint32_t command);
+
+    /**
+     * Vuelve al estado de arranque: nivel NORMAL, ritmo lento, sin histéresis
+     * (solo si la tarea no está corriendo, p. ej. entre escenarios de un benchmark)
+     * @param slowIntervalMs Periodo en reposo
+     */
+    void reset(uint32_t slowIntervalMs = SENSOR_READ_INTERVAL);
+
+    /**
+     * Obtiene una copia consistente de la última instantánea
+     * Seguro desde cualquier tarea (loop, AsyncTCP).
+     */
+    SensorSnapshot getSnapshot() const;
+
+    /**
+     * Número de instantáneas publicadas (para detectar datos nuevos)
+     */
+    uint32_t getVersion() const;
+};
+
+#endif // SENSORTASK_H
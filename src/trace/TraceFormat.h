@@ -0,0 +1,330 @@
+/*
+Formato binario de trazas de sensores:
+
+Encabezado fijo (canales, escala ADC, frecuencia, calibración del BMP280)
+seguido de registros con tipo de 1 byte:
+  ADC_ABSOLUTE  tiempo absoluto (u32 ms) + valor u16 por canal
+  ADC_DELTA     dt u8 ms + diferencia i8 por canal respecto al barrido anterior
+  ENVIRONMENT   tiempo absoluto (u32 ms) + palabras crudas del AHT20 y BMP280
+  ALERT         tiempo absoluto (u32 ms) + cambio de nivel publicado en vivo
+                (desde, hacia, evaluado, máscara de características)
+La reproducción compara sus cambios de nivel con los ALERT grabados
+El ruido del ADC es pequeño: la mayoría de los barridos ocupan 2 + canales bytes
+Little-endian; sin dependencias de Arduino (compilable en host)
+*/
+#ifndef TRACEFORMAT_H
+#define TRACEFORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define TRACE_MAGIC 0x43525446          // "FTRC"
+#define TRACE_VERSION 2                 // Solo se leen trazas de esta versión
+#define TRACE_MAX_CHANNELS 4
+#define TRACE_HEADER_SIZE 40
+#define TRACE_MAX_RECORD_SIZE 22        // ENVIRONMENT
+
+enum TraceRecordType : uint8_t {
+    TRACE_ADC_ABSOLUTE = 1,
+    TRACE_ADC_DELTA = 2,
+    TRACE_ENVIRONMENT = 3,
+    TRACE_ALERT = 4
+};
+
+#define TRACE_AHT_FRESH 0x01
+#define TRACE_BMP_FRESH 0x02
+
+struct TraceHeader {
+    uint8_t channels;
+    uint8_t scanBits;                   // Escala de los valores ADC
+    uint16_t sampleRateHz;
+    uint32_t startMs;                   // Reloj al crear el archivo
+    uint8_t bmpCalibration[24];         // BMP280Calibration tal cual
+};
+
+// Barrido ADC (escala scanBits)
+struct TraceAdcRecord {
+    uint32_t timeMs;
+    uint8_t count;
+    uint16_t values[TRACE_MAX_CHANNELS];
+};
+
+// Lectura cruda de los sensores I2C
+struct TraceEnvRecord {
+    uint32_t timeMs;
+    uint8_t flags;                      // TRACE_AHT_FRESH | TRACE_BMP_FRESH
+    uint32_t ahtHumidity;
+    uint32_t ahtTemperature;
+    int32_t bmpTemperature;
+    int32_t bmpPressure;
+};
+
+// Cambio de nivel publicado en vivo (GlobalAlertLevel)
+struct TraceAlertRecord {
+    uint32_t timeMs;
+    uint8_t from;
+    uint8_t to;
+    uint8_t raw;                        // Nivel evaluado en la muestra del cambio
+    uint32_t features;                  // Máscara FEAT_*
+};
+
+namespace TraceBytes {
+    inline void put16(uint8_t*& out, uint16_t value) {
+        *out++ = (uint8_t)value;
+        *out++ = (uint8_t)(value >> 8);
+    }
+
+    inline void put32(uint8_t*& out, uint32_t value) {
+        put16(out, (uint16_t)value);
+        put16(out, (uint16_t)(value >> 16));
+    }
+
+    inline uint16_t get16(const uint8_t* in) {
+        return (uint16_t)(in[0] | (in[1] << 8));
+    }
+
+    inline uint32_t get32(const uint8_t* in) {
+        return get16(in) | ((uint32_t)get16(in + 2) << 16);
+    }
+}
+
+class TraceEncoder {
+private:
+    TraceAdcRecord last;
+    bool hasLast;
+
+public:
+    TraceEncoder() : last(), hasLast(false) {}
+
+    /**
+     * Olvida el barrido anterior (el próximo se escribe absoluto)
+     */
+    void reset() {
+        hasLast = false;
+    }
+
+    /**
+     * Escribe el encabezado
+     * @param out Buffer de al menos TRACE_HEADER_SIZE bytes
+     * @return Bytes escritos
+     */
+    static size_t encodeHeader(const TraceHeader& header, uint8_t* out) {
+        uint8_t* start = out;
+        TraceBytes::put32(out, TRACE_MAGIC);
+        *out++ = TRACE_VERSION;
+        *out++ = header.channels;
+        *out++ = header.scanBits;
+        *out++ = 0;
+        TraceBytes::put16(out, header.sampleRateHz);
+        TraceBytes::put16(out, 0);
+        TraceBytes::put32(out, header.startMs);
+        memcpy(out, header.bmpCalibration, sizeof(header.bmpCalibration));
+        out += sizeof(header.bmpCalibration);
+        return out - start;
+    }
+
+    /**
+     * Codifica un barrido (delta si es posible, absoluto si no)
+     * @param out Buffer de al menos TRACE_MAX_RECORD_SIZE bytes
+     * @return Bytes escritos
+     */
+    size_t encodeAdc(const TraceAdcRecord& record, uint8_t* out) {
+        uint8_t* start = out;
+        uint32_t dt = record.timeMs - last.timeMs;
+        bool delta = hasLast && record.count == last.count && dt <= 0xFF;
+
+        for (int i = 0; delta && i < record.count; i++) {
+            int diff = (int)record.values[i] - (int)last.values[i];
+            delta = diff >= -128 && diff <= 127;
+        }
+
+        if (delta) {
+            *out++ = TRACE_ADC_DELTA;
+            *out++ = (uint8_t)dt;
+            for (int i = 0; i < record.count; i++) {
+                *out++ = (uint8_t)(int8_t)((int)record.values[i] - (int)last.values[i]);
+            }
+        } else {
+            *out++ = TRACE_ADC_ABSOLUTE;
+            TraceBytes::put32(out, record.timeMs);
+            *out++ = record.count;
+            for (int i = 0; i < record.count; i++) {
+                TraceBytes::put16(out, record.values[i]);
+            }
+        }
+
+        last = record;
+        hasLast = true;
+        return out - start;
+    }
+
+    /**
+     * Codifica una lectura de sensores I2C
+     * @param out Buffer de al menos TRACE_MAX_RECORD_SIZE bytes
+     * @return Bytes escritos
+     */
+    static size_t encodeEnvironment(const TraceEnvRecord& record, uint8_t* out) {
+        uint8_t* start = out;
+        *out++ = TRACE_ENVIRONMENT;
+        TraceBytes::put32(out, record.timeMs);
+        *out++ = record.flags;
+        TraceBytes::put32(out, record.ahtHumidity);
+        TraceBytes::put32(out, record.ahtTemperature);
+        TraceBytes::put32(out, (uint32_t)record.bmpTemperature);
+        TraceBytes::put32(out, (uint32_t)record.bmpPressure);
+        return out - start;
+    }
+
+    /**
+     * Codifica un cambio de nivel de alerta
+     * @param out Buffer de al menos TRACE_MAX_RECORD_SIZE bytes
+     * @return Bytes escritos
+     */
+    static size_t encodeAlert(const TraceAlertRecord& record, uint8_t* out) {
+        uint8_t* start = out;
+        *out++ = TRACE_ALERT;
+        TraceBytes::put32(out, record.timeMs);
+        *out++ = record.from;
+        *out++ = record.to;
+        *out++ = record.raw;
+        TraceBytes::put32(out, record.features);
+        return out - start;
+    }
+};
+
+/**
+ * Compara los cambios de nivel grabados en vivo con los reproducidos
+ * Iguales: misma cantidad, mismos niveles en el mismo orden y cada uno a
+ * menos de toleranceMs del vivo
+ * @param stored Cambios guardados en cada arreglo (se comparan los primeros)
+ * @return Índice del primer cambio distinto (-1 si son iguales)
+ */
+inline int32_t traceCompareAlerts(const TraceAlertRecord* live, uint32_t liveCount,
+                                  const TraceAlertRecord* replayed, uint32_t replayedCount,
+                                  uint32_t stored, long toleranceMs) {
+    uint32_t count = liveCount < replayedCount ? liveCount : replayedCount;
+    count = count < stored ? count : stored;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t offset = (int32_t)(replayed[i].timeMs - live[i].timeMs);
+        if (live[i].from != replayed[i].from || live[i].to != replayed[i].to ||
+            offset > toleranceMs || offset < -toleranceMs) {
+            return (int32_t)i;
+        }
+    }
+    return liveCount == replayedCount ? -1 : (int32_t)count;
+}
+
+/**
+ * Lector secuencial de trazas
+ * Source debe tener size_t read(uint8_t* buffer, size_t length)
+ * (File de LittleFS, o un adaptador sobre FILE* en host)
+ */
+template <typename Source>
+class TraceDecoder {
+private:
+    Source& source;
+    TraceAdcRecord last;
+    bool hasLast;
+
+    bool readExact(uint8_t* buffer, size_t length) {
+        return source.read(buffer, length) == length;
+    }
+
+public:
+    explicit TraceDecoder(Source& input) : source(input), last(), hasLast(false) {}
+
+    /**
+     * Lee y valida el encabezado
+     * @return false si no es una traza de esta versión
+     */
+    bool readHeader(TraceHeader& header) {
+        uint8_t raw[TRACE_HEADER_SIZE];
+        if (!readExact(raw, sizeof(raw)) || TraceBytes::get32(raw) != TRACE_MAGIC ||
+            raw[4] != TRACE_VERSION) {
+            return false;
+        }
+        header.channels = raw[5];
+        header.scanBits = raw[6];
+        header.sampleRateHz = TraceBytes::get16(raw + 8);
+        header.startMs = TraceBytes::get32(raw + 12);
+        memcpy(header.bmpCalibration, raw + 16, sizeof(header.bmpCalibration));
+        return header.channels <= TRACE_MAX_CHANNELS;
+    }
+
+    /**
+     * Lee el próximo registro
+     * @param type Tipo leído
+     * @param adc Barrido (si type es ADC_*; siempre con tiempo y valores absolutos)
+     * @param env Lectura I2C (si type es ENVIRONMENT)
+     * @param alert Cambio de nivel (si type es ALERT)
+     * @return false al final del archivo o si el registro está truncado/corrupto
+     */
+    bool next(TraceRecordType& type, TraceAdcRecord& adc, TraceEnvRecord& env,
+              TraceAlertRecord& alert) {
+        uint8_t tag;
+        uint8_t raw[TRACE_MAX_RECORD_SIZE];
+
+        if (!readExact(&tag, 1)) {
+            return false;
+        }
+        type = (TraceRecordType)tag;
+
+        switch (tag) {
+            case TRACE_ADC_ABSOLUTE: {
+                if (!readExact(raw, 5) || raw[4] > TRACE_MAX_CHANNELS ||
+                    !readExact(raw + 5, raw[4] * 2)) {
+                    return false;
+                }
+                adc.timeMs = TraceBytes::get32(raw);
+                adc.count = raw[4];
+                for (int i = 0; i < adc.count; i++) {
+                    adc.values[i] = TraceBytes::get16(raw + 5 + 2 * i);
+                }
+                last = adc;
+                hasLast = true;
+                return true;
+            }
+            case TRACE_ADC_DELTA: {
+                if (!hasLast || !readExact(raw, 1 + last.count)) {
+                    return false;
+                }
+                adc = last;
+                adc.timeMs += raw[0];
+                for (int i = 0; i < adc.count; i++) {
+                    adc.values[i] = (uint16_t)(last.values[i] + (int8_t)raw[1 + i]);
+                }
+                last = adc;
+                return true;
+            }
+            case TRACE_ENVIRONMENT: {
+                if (!readExact(raw, 21)) {
+                    return false;
+                }
+                env.timeMs = TraceBytes::get32(raw);
+                env.flags = raw[4];
+                env.ahtHumidity = TraceBytes::get32(raw + 5);
+                env.ahtTemperature = TraceBytes::get32(raw + 9);
+                env.bmpTemperature = (int32_t)TraceBytes::get32(raw + 13);
+                env.bmpPressure = (int32_t)TraceBytes::get32(raw + 17);
+                return true;
+            }
+            case TRACE_ALERT: {
+                if (!readExact(raw, 11)) {
+                    return false;
+                }
+                alert.timeMs = TraceBytes::get32(raw);
+                alert.from = raw[4];
+                alert.to = raw[5];
+                alert.raw = raw[6];
+                alert.features = TraceBytes::get32(raw + 7);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+};
+
+#endif // TRACEFORMAT_H
@@ -0,0 +1,207 @@
+#include "TraceRecorder.h"
+#include "../utils/Clock.h"
+
+static_assert(sizeof(BMP280Calibration) == sizeof(TraceHeader::bmpCalibration),
+              "TraceRecorder: BMP280Calibration no coincide con el encabezado de la traza");
+
+// Inicializar instancia estática
+TraceRecorder* TraceRecorder::instance = nullptr;
+
+TraceRecorder::TraceRecorder()
+    : recording(false),
+      fileSize(0),
+      header(),
+      lastFlush(0),
+      bytesWritten(0) {
+}
+
+TraceRecorder* TraceRecorder::getInstance() {
+    if (instance == nullptr) {
+        instance = new TraceRecorder();
+    }
+    return instance;
+}
+
+bool TraceRecorder::begin(uint8_t channels, uint16_t sampleRateHz, const BMP280Calibration& calibration) {
+    if (recording || !TRACE_ENABLED) {
+        return recording;
+    }
+
+    header.channels = channels > TRACE_MAX_CHANNELS ? TRACE_MAX_CHANNELS : channels;
+    header.scanBits = ADC_SCAN_BITS;
+    header.sampleRateHz = sampleRateHz;
+    memcpy(header.bmpCalibration, &calibration, sizeof(header.bmpCalibration));
+
+    // La traza del arranque anterior pasa a ser la "vieja" (el incidente
+    // que provocó el reinicio queda disponible para descargar)
+    if (LittleFS.exists(TRACE_FILE_PATH)) {
+        LittleFS.remove(TRACE_OLD_FILE_PATH);
+        LittleFS.rename(TRACE_FILE_PATH, TRACE_OLD_FILE_PATH);
+    }
+
+    if (!openFile()) {
+        if (DEBUG_SERIAL) {
+            Serial.println("❌ Error abriendo archivo de traza");
+        }
+        return false;
+    }
+
+    lastFlush = millis();
+    recording = true;
+    EventBus::getInstance()->subscribe(onAlertTransition, this, TOPIC_ALERT, PRIORITY_LOW);
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Traza de sensores: %s (%d canales, rota cada %d KB)\n",
+                     TRACE_FILE_PATH, header.channels, TRACE_FILE_MAX_BYTES / 1024);
+    }
+
+    return true;
+}
+
+bool TraceRecorder::openFile() {
+    file = LittleFS.open(TRACE_FILE_PATH, "w");
+    if (!file) {
+        return false;
+    }
+
+    uint8_t raw[TRACE_HEADER_SIZE];
+    header.startMs = Clock::millis();
+    size_t length = TraceEncoder::encodeHeader(header, raw);
+
+    encoder.reset();
+    fileSize = file.write(raw, length);
+    bytesWritten += fileSize;
+    return fileSize == length;
+}
+
+void TraceRecorder::rotate() {
+    file.close();
+    LittleFS.remove(TRACE_OLD_FILE_PATH);
+    LittleFS.rename(TRACE_FILE_PATH, TRACE_OLD_FILE_PATH);
+
+    if (!openFile()) {
+        recording = false;
+        if (DEBUG_SERIAL) {
+            Serial.println("❌ Error rotando archivo de traza, grabación detenida");
+        }
+    }
+}
+
+void TraceRecorder::stop() {
+    if (!recording) {
+        return;
+    }
+    flush(true);
+    recording = false;
+    file.close();
+    EventBus::getInstance()->unsubscribe(onAlertTransition, this);
+}
+
+bool TraceRecorder::isRecording() const {
+    return recording;
+}
+
+void TraceRecorder::recordAdc(const AdcFrame& frame) {
+    if (!recording) {
+        return;
+    }
+
+    TraceAdcRecord record;
+    record.timeMs = Clock::millis();
+    record.count = frame.count > header.channels ? header.channels : frame.count;
+    for (int i = 0; i < record.count; i++) {
+        record.values[i] = frame.values[i];
+    }
+    adcQueue.push(record);
+}
+
+void TraceRecorder::recordEnvironment(const EnvironmentRaw& raw, unsigned long timeMs) {
+    if (!recording) {
+        return;
+    }
+
+    TraceEnvRecord record;
+    record.timeMs = timeMs;
+    record.flags = (raw.ahtFresh ? TRACE_AHT_FRESH : 0) | (raw.bmpFresh ? TRACE_BMP_FRESH : 0);
+    record.ahtHumidity = raw.ahtHumidity;
+    record.ahtTemperature = raw.ahtTemperature;
+    record.bmpTemperature = raw.bmpTemperature;
+    record.bmpPressure = raw.bmpPressure;
+    envQueue.push(record);
+}
+
+void TraceRecorder::onAlertTransition(const Event& event, void* context) {
+    TraceRecorder* self = static_cast<TraceRecorder*>(context);
+    if (!self->recording) {
+        return;
+    }
+
+    TraceAlertRecord record;
+    record.timeMs = event.timestamp;
+    record.from = event.alert.from;
+    record.to = event.alert.to;
+    record.raw = event.alert.raw;
+    record.features = event.alert.features;
+    self->alertQueue.push(record);
+}
+
+size_t TraceRecorder::flush(bool force) {
+    if (!recording || (!force && millis() - lastFlush < TRACE_FLUSH_INTERVAL)) {
+        return 0;
+    }
+    lastFlush = millis();
+
+    // Mezclar las colas por tiempo: la reproducción necesita los
+    // registros en orden para colocar cada lectura I2C en su ciclo
+    // (diferencias en int32_t: los tiempos son uint32_t y pueden dar la vuelta)
+    uint8_t buffer[512];
+    size_t used = 0;
+    size_t total = 0;
+    TraceAdcRecord adc = {};
+    TraceEnvRecord env = {};
+    TraceAlertRecord alert = {};
+    bool hasAdc = adcQueue.pop(adc);
+    bool hasEnv = envQueue.pop(env);
+    bool hasAlert = alertQueue.pop(alert);
+
+    while (hasAdc || hasEnv || hasAlert) {
+        // El más antiguo de los tres (a igual tiempo: I2C, alerta, ADC)
+        if (hasEnv && (!hasAdc || (int32_t)(env.timeMs - adc.timeMs) <= 0) &&
+            (!hasAlert || (int32_t)(env.timeMs - alert.timeMs) <= 0)) {
+            used += TraceEncoder::encodeEnvironment(env, buffer + used);
+            hasEnv = envQueue.pop(env);
+        } else if (hasAlert && (!hasAdc || (int32_t)(alert.timeMs - adc.timeMs) <= 0)) {
+            used += TraceEncoder::encodeAlert(alert, buffer + used);
+            hasAlert = alertQueue.pop(alert);
+        } else {
+            used += encoder.encodeAdc(adc, buffer + used);
+            hasAdc = adcQueue.pop(adc);
+        }
+
+        if (used > sizeof(buffer) - TRACE_MAX_RECORD_SIZE || !(hasAdc || hasEnv || hasAlert)) {
+            file.write(buffer, used);
+            fileSize += used;
+            total += used;
+            used = 0;
+        }
+    }
+
+    if (total > 0) {
+        file.flush();
+        bytesWritten += total;
+    }
+
+    if (fileSize >= TRACE_FILE_MAX_BYTES) {
+        rotate();
+    }
+
+    return total;
+}
+
+uint32_t TraceRecorder::getDropped() const {
+    return adcQueue.getDropped() + envQueue.getDropped() + alertQueue.getDropped();
+}
+
+uint32_t TraceRecorder::getBytesWritten() const {
+    return bytesWritten;
+}
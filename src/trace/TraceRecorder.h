@@ -0,0 +1,111 @@
+/*
+Registro de trazas (caja negra de los sensores):
+
+Graba las entradas crudas de la cadena de detección: cada barrido ADC
+y cada lectura cruda de AHT20/BMP280, con su tiempo
+También los cambios de nivel publicados, para comparar la reproducción
+con lo que ocurrió en vivo
+Productores sin bloqueo: el timer ADC y la tarea de sensores solo encolan
+La codificación y escritura a LittleFS ocurre en loop (flush agrupado)
+Dos archivos rotativos: la traza en curso y la anterior
+Formato: ver TraceFormat.h
+*/
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../config/Config.h"
+#include "../sensors/AdcScan.h"
+#include "../sensors/EnvironmentSensor.h"
+#include "../events/EventBus.h"
+#include "../utils/SpscRing.h"
+#include "TraceFormat.h"
+
+class TraceRecorder {
+private:
+    static TraceRecorder* instance;
+
+    SpscRing<TraceAdcRecord, TRACE_ADC_QUEUE_SIZE> adcQueue;   // Timer ADC → loop
+    SpscRing<TraceEnvRecord, TRACE_ENV_QUEUE_SIZE> envQueue;   // Tarea de sensores → loop
+    SpscRing<TraceAlertRecord, TRACE_ALERT_QUEUE_SIZE> alertQueue; // Bus de eventos (loop) → loop
+
+    volatile bool recording;
+    File file;
+    size_t fileSize;
+    TraceHeader header;
+    TraceEncoder encoder;
+    unsigned long lastFlush;
+    uint32_t bytesWritten;
+
+    TraceRecorder(); // Constructor privado
+
+    /**
+     * Abre un archivo nuevo y escribe el encabezado
+     */
+    bool openFile();
+
+    /**
+     * Cierra la traza en curso y la pasa a TRACE_OLD_FILE_PATH
+     */
+    void rotate();
+
+    /**
+     * Encola un cambio de nivel (suscriptor del bus de eventos)
+     */
+    static void onAlertTransition(const Event& event, void* context);
+
+public:
+    /**
+     * Obtiene la instancia única de TraceRecorder (Singleton)
+     * @return Puntero a la instancia
+     */
+    static TraceRecorder* getInstance();
+
+    /**
+     * Empieza a grabar (después de inicializar los sensores)
+     * La traza anterior de esta sesión de arranque pasa a ser la "vieja".
+     * @param channels Canales ADC registrados
+     * @param sampleRateHz Frecuencia de muestreo ADC
+     * @param calibration Coeficientes del BMP280 (para compensar al reproducir)
+     * @return true si se abrió el archivo
+     */
+    bool begin(uint8_t channels, uint16_t sampleRateHz, const BMP280Calibration& calibration);
+
+    /**
+     * Deja de grabar y cierra el archivo
+     */
+    void stop();
+
+    bool isRecording() const;
+
+    /**
+     * Encola un barrido ADC (desde el timer de muestreo, no bloquea)
+     */
+    void recordAdc(const AdcFrame& frame);
+
+    /**
+     * Encola una lectura cruda I2C (desde la tarea de sensores, no bloquea)
+     */
+    void recordEnvironment(const EnvironmentRaw& raw, unsigned long timeMs);
+
+    /**
+     * Codifica y escribe lo encolado (desde loop)
+     * Escribe como máximo cada TRACE_FLUSH_INTERVAL ms salvo force.
+     * @param force Escribir aunque no haya pasado el intervalo
+     * @return Bytes escritos
+     */
+    size_t flush(bool force = false);
+
+    /**
+     * Registros descartados por cola llena
+     */
+    uint32_t getDropped() const;
+
+    /**
+     * Bytes escritos desde begin()
+     */
+    uint32_t getBytesWritten() const;
+};
+
+#endif // TRACERECORDER_H
@@ -0,0 +1,229 @@
+#include "TraceReplay.h"
+#include "../sensors/AdcSampler.h"
+#include "../sensors/EnvironmentSensor.h"
+#include "../sensors/SmokeSensor.h"
+#include "../sensors/CH4Sensor.h"
+#include "../tasks/SensorTask.h"
+#include "../alert/SmartAlert.h"
+#include "../utils/Clock.h"
+
+// Destino de la línea de tiempo (contexto del suscriptor)
+struct TimelineOutput {
+    File* file;
+    uint32_t startMs;
+    uint32_t transitions;
+    TraceAlertRecord* replayed;     // Primeros TRACE_REPLAY_MAX_COMPARE cambios
+};
+
+// Cambios de nivel a comparar (fuera de la pila de setup)
+static TraceAlertRecord liveAlerts[TRACE_REPLAY_MAX_COMPARE];
+static TraceAlertRecord replayedAlerts[TRACE_REPLAY_MAX_COMPARE];
+
+void TraceReplay::onAlertTransition(const Event& event, void* context) {
+    TimelineOutput* output = static_cast<TimelineOutput*>(context);
+    if (output->transitions < TRACE_REPLAY_MAX_COMPARE) {
+        TraceAlertRecord& record = output->replayed[output->transitions];
+        record.timeMs = event.timestamp;
+        record.from = event.alert.from;
+        record.to = event.alert.to;
+        record.raw = event.alert.raw;
+        record.features = event.alert.features;
+    }
+    output->transitions++;
+
+    char line[96];
+    snprintf(line, sizeof(line), "%lu,%lu,%s,%s,%s,0x%05lX",
+             (unsigned long)(event.timestamp - output->startMs),
+             (unsigned long)event.cycle,
+             SmartAlert::getLevelName(event.alert.from),
+             SmartAlert::getLevelName(event.alert.to),
+             SmartAlert::getLevelName(event.alert.raw),
+             (unsigned long)event.alert.features);
+
+    Serial.printf("   ⏱ %s\n", line);
+    if (output->file != nullptr) {
+        output->file->println(line);
+    }
+}
+
+unsigned long TraceReplay::runCycle(bool adcWake, TraceReplayResult& result) {
+    SensorTask* sensorTask = SensorTask::getInstance();
+    sensorTask->cycle(adcWake);
+    EventBus::getInstance()->dispatch();
+    result.cycles++;
+
+    return Clock::millis() + sensorTask->getSnapshot().sampleIntervalMs;
+}
+
+bool TraceReplay::run(const char* tracePath, const char* timelinePath, TraceReplayResult& result) {
+    result = TraceReplayResult();
+
+    File trace = LittleFS.open(tracePath, "r");
+    if (!trace) {
+        Serial.printf("❌ Reproducción: no existe %s\n", tracePath);
+        return false;
+    }
+
+    TraceDecoder<File> decoder(trace);
+    TraceHeader header;
+    AdcSampler* sampler = AdcSampler::getInstance();
+
+    if (!decoder.readHeader(header)) {
+        Serial.printf("❌ Reproducción: %s no es una traza válida\n", tracePath);
+        trace.close();
+        return false;
+    }
+
+    if (header.channels != sampler->getChannelCount() || header.scanBits != ADC_SCAN_BITS) {
+        Serial.printf("❌ Reproducción: traza con %d canales de %d bits (firmware: %d de %d)\n",
+                     header.channels, header.scanBits, sampler->getChannelCount(), ADC_SCAN_BITS);
+        trace.close();
+        return false;
+    }
+
+    File timeline;
+    if (timelinePath != nullptr) {
+        timeline = LittleFS.open(timelinePath, "w");
+        if (timeline) {
+            timeline.println("time_ms,cycle,from,to,raw,features");
+        }
+    }
+
+    TimelineOutput output = { timeline ? &timeline : nullptr, header.startMs, 0, replayedAlerts };
+
+    Serial.printf("\n▶ Reproduciendo %s (%u bytes, %d canales @ %u Hz)\n",
+                 tracePath, (unsigned)trace.size(), header.channels, header.sampleRateHz);
+
+    // Sensores alimentados por la traza, tiempo virtual desde el inicio de la grabación
+    BMP280Calibration calibration;
+    memcpy(&calibration, header.bmpCalibration, sizeof(calibration));
+    EnvironmentSensor* envSensor = EnvironmentSensor::getInstance();
+    sampler->setReplay(true);
+    envSensor->setReplay(true, &calibration);
+    Clock::simulate(header.startMs);
+
+    EventBus* eventBus = EventBus::getInstance();
+    eventBus->subscribe(onAlertTransition, &output, TOPIC_ALERT, PRIORITY_LOW);
+
+    unsigned long wallStart = millis();
+    unsigned long nextCycle = header.startMs;
+    TraceRecordType type;
+    TraceAdcRecord adc;
+    TraceEnvRecord env;
+    TraceAlertRecord alert;
+
+    while (decoder.next(type, adc, env, alert)) {
+        result.records++;
+
+        if (type == TRACE_ALERT) {
+            // Cambio publicado en vivo: solo se guarda para comparar al final
+            if (result.liveTransitions < TRACE_REPLAY_MAX_COMPARE) {
+                liveAlerts[result.liveTransitions] = alert;
+            }
+            result.liveTransitions++;
+        } else if (type == TRACE_ENVIRONMENT) {
+            // Ciclos anteriores a la lectura, luego la lectura para el ciclo en curso
+            while ((long)(env.timeMs - nextCycle) > 0) {
+                Clock::advanceTo(nextCycle);
+                nextCycle = runCycle(false, result);
+            }
+
+            EnvironmentRaw raw;
+            raw.ahtFresh = env.flags & TRACE_AHT_FRESH;
+            raw.bmpFresh = env.flags & TRACE_BMP_FRESH;
+            raw.ahtHumidity = env.ahtHumidity;
+            raw.ahtTemperature = env.ahtTemperature;
+            raw.bmpTemperature = env.bmpTemperature;
+            raw.bmpPressure = env.bmpPressure;
+            envSensor->injectRaw(raw);
+
+            Clock::advanceTo(env.timeMs);
+            if ((long)(env.timeMs - nextCycle) >= 0) {
+                nextCycle = runCycle(false, result);
+            }
+        } else {
+            // Ciclos que el planificador habría ejecutado antes de este barrido
+            while ((long)(adc.timeMs - nextCycle) >= 0) {
+                Clock::advanceTo(nextCycle);
+                nextCycle = runCycle(false, result);
+            }
+
+            AdcFrame frame = {};
+            frame.count = adc.count;
+            for (int i = 0; i < adc.count; i++) {
+                frame.values[i] = adc.values[i];
+            }
+
+            Clock::advanceTo(adc.timeMs);
+            if (sampler->inject(frame)) {
+                nextCycle = runCycle(true, result);
+            }
+        }
+
+        // No acaparar la CPU (watchdog, WiFi)
+        if ((result.records & 0x3FF) == 0) {
+            yield();
+        }
+    }
+
+    result.complete = trace.position() >= trace.size();
+    result.virtualMs = Clock::millis() - header.startMs;
+    result.wallMs = millis() - wallStart;
+    result.transitions = output.transitions;
+    result.firstMismatch = traceCompareAlerts(liveAlerts, result.liveTransitions,
+                                              replayedAlerts, result.transitions,
+                                              TRACE_REPLAY_MAX_COMPARE, TRACE_REPLAY_TOLERANCE);
+
+    // Volver al funcionamiento normal
+    eventBus->unsubscribe(onAlertTransition, &output);
+    Clock::realTime();
+    envSensor->setReplay(false);
+    sampler->setReplay(false);
+    // El baseline pudo seguir al aire de la traza: volver al guardado
+    // Filtros y calentamiento quedaron con el final de la traza: se reinician
+    SmokeSensor* smokeSensor = SmokeSensor::getInstance();
+    CH4Sensor* ch4Sensor = CH4Sensor::getInstance();
+    if (!smokeSensor->loadCalibration()) {
+        smokeSensor->resetCalibration();
+    }
+    if (!ch4Sensor->loadCalibration()) {
+        ch4Sensor->resetCalibration();
+    }
+    smokeSensor->restart(true);
+    ch4Sensor->restart(true);
+    SensorTask::getInstance()->reset();
+    trace.close();
+    if (timeline) {
+        timeline.close();
+    }
+
+    Serial.printf("■ Reproducción: %u registros, %u ciclos, %u cambios de nivel\n",
+                 result.records, result.cycles, result.transitions);
+    Serial.printf("  %lu s de traza en %lu ms (x%lu)%s\n",
+                 (unsigned long)(result.virtualMs / 1000), (unsigned long)result.wallMs,
+                 (unsigned long)(result.virtualMs / (result.wallMs > 0 ? result.wallMs : 1)),
+                 result.complete ? "" : " ⚠ traza truncada");
+
+    if (result.firstMismatch < 0) {
+        Serial.printf("  ✓ Igual a la ejecución en vivo (%u cambios de nivel)\n", result.liveTransitions);
+    } else {
+        // Cambio distinto, o uno de los dos tiene más cambios
+        int32_t i = result.firstMismatch;
+        Serial.printf("  ❌ Difiere de la ejecución en vivo en el cambio #%ld (vivo %u, reproducción %u)\n",
+                     (long)i + 1, result.liveTransitions, result.transitions);
+        if ((uint32_t)i < result.liveTransitions && i < TRACE_REPLAY_MAX_COMPARE) {
+            Serial.printf("     vivo:        %lu ms %s → %s\n",
+                         (unsigned long)(liveAlerts[i].timeMs - header.startMs),
+                         SmartAlert::getLevelName((GlobalAlertLevel)liveAlerts[i].from),
+                         SmartAlert::getLevelName((GlobalAlertLevel)liveAlerts[i].to));
+        }
+        if ((uint32_t)i < result.transitions && i < TRACE_REPLAY_MAX_COMPARE) {
+            Serial.printf("     reproducido: %lu ms %s → %s\n",
+                         (unsigned long)(replayedAlerts[i].timeMs - header.startMs),
+                         SmartAlert::getLevelName((GlobalAlertLevel)replayedAlerts[i].from),
+                         SmartAlert::getLevelName((GlobalAlertLevel)replayedAlerts[i].to));
+        }
+    }
+
+    return true;
+}
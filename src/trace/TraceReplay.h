@@ -0,0 +1,64 @@
+/*
+Reproducción acelerada de trazas:
+
+Alimenta la cadena de detección completa (filtros, calibración, tendencias,
+reglas, antirrebote, eventos) con una traza grabada por TraceRecorder
+Reloj virtual: cada registro fija el instante; los ciclos de la tarea de
+sensores se ejecutan cuando el tiempo virtual alcanza el periodo que pidió
+el planificador (o al instante si el muestreo ADC lo despierta)
+Sin esperas: la velocidad queda limitada solo por la CPU y LittleFS
+Resultado: línea de tiempo de cambios de alerta por Serial y en CSV
+Los cambios publicados en vivo (registros ALERT) se comparan con los
+reproducidos: mismos niveles, en el mismo orden, con un desfase de hasta
+TRACE_REPLAY_TOLERANCE ms (los ciclos en vivo dependen del scheduler de FreeRTOS)
+La comparación es exacta solo para trazas grabadas desde el arranque: una
+traza rotada empieza con filtros y alertas ya en marcha
+Se ejecuta antes de arrancar la tarea de sensores (TRACE_REPLAY)
+*/
+#ifndef TRACEREPLAY_H
+#define TRACEREPLAY_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../config/Config.h"
+#include "../events/EventBus.h"
+#include "TraceFormat.h"
+
+// Resumen de una reproducción
+struct TraceReplayResult {
+    uint32_t records;           // Registros leídos
+    uint32_t cycles;            // Ciclos de la tarea de sensores ejecutados
+    uint32_t transitions;       // Cambios de nivel publicados
+    uint32_t virtualMs;         // Duración de la traza
+    uint32_t wallMs;            // Tiempo real empleado
+    bool complete;              // false si la traza terminó en un registro corrupto
+    uint32_t liveTransitions;   // Cambios de nivel grabados en vivo
+    int32_t firstMismatch;      // Primer cambio distinto del vivo (-1 = iguales)
+};
+
+class TraceReplay {
+private:
+    /**
+     * Escribe un cambio de nivel en la línea de tiempo
+     */
+    static void onAlertTransition(const Event& event, void* context);
+
+    /**
+     * Ejecuta un ciclo de la tarea de sensores en el instante actual
+     * @return Instante del próximo ciclo según el planificador
+     */
+    static unsigned long runCycle(bool adcWake, TraceReplayResult& result);
+
+public:
+    /**
+     * Reproduce una traza y escribe la línea de tiempo de alertas
+     * Deja sensores y reloj en modo normal al terminar.
+     * @param tracePath Traza a reproducir
+     * @param timelinePath CSV de salida (nullptr = solo Serial)
+     * @param result Resumen de la reproducción
+     * @return false si la traza no existe o no es compatible
+     */
+    static bool run(const char* tracePath, const char* timelinePath, TraceReplayResult& result);
+};
+
+#endif // TRACEREPLAY_H
@@ -0,0 +1,166 @@
+/*
+Seguimiento automático del baseline en aire limpio (envejecimiento del sensor):
+
+Ventanas de tiempo fijo con la estadística de los promedios de cada lectura
+Una ventana cuenta solo si todas sus lecturas fueron de aire limpio (el
+llamador decide: estado, tendencia, umbrales) y su dispersión es baja
+Cada ventana limpia acerca el baseline a su media con paso acotado:
+la deriva por día y la deriva total desde la última calibración manual
+tienen tope (una fuga lenta no puede "normalizarse")
+Desplazamiento en 1/256 cuentas (los pasos diarios son fracciones de cuenta)
+El tiempo se recibe como parámetro (reloj virtual en host)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef BASELINETRACKER_H
+#define BASELINETRACKER_H
+
+#include <stdint.h>
+#include "Welford.h"
+
+#define BASELINE_TRACKER_DAY_MS 86400000UL
+
+class BaselineTracker {
+private:
+    // Parámetros
+    uint32_t windowMs;          // Duración de cada ventana
+    float maxStddev;            // Dispersión máxima de una ventana limpia (cuentas)
+    int32_t maxStepQ8;          // Paso máximo por ventana (1/256 cuentas)
+    int32_t maxOffsetQ8;        // Deriva total máxima (1/256 cuentas)
+
+    // Ventana en curso
+    WelfordStats window;
+    uint32_t windowStart;
+
+    // Baseline seguido = referencia + desplazamiento
+    int32_t anchor;             // Baseline de la última calibración manual
+    int32_t offsetQ8;           // Deriva acumulada (1/256 cuentas)
+
+    uint32_t acceptedWindows;
+    uint32_t rejectedWindows;
+
+    static int32_t roundQ8(int32_t valueQ8) {
+        return (valueQ8 >= 0 ? valueQ8 + 128 : valueQ8 - 128) / 256;
+    }
+
+public:
+    /**
+     * @param windowLengthMs Duración de cada ventana (ms)
+     * @param maxWindowStddev Dispersión máxima de una ventana limpia (cuentas)
+     * @param maxDriftPerDay Deriva máxima por día (cuentas)
+     * @param maxTotalDrift Deriva máxima desde la calibración manual (cuentas)
+     */
+    BaselineTracker(uint32_t windowLengthMs, float maxWindowStddev,
+                    int32_t maxDriftPerDay, int32_t maxTotalDrift)
+        : windowMs(windowLengthMs),
+          maxStddev(maxWindowStddev),
+          maxOffsetQ8(maxTotalDrift * 256),
+          windowStart(0),
+          anchor(0),
+          offsetQ8(0),
+          acceptedWindows(0),
+          rejectedWindows(0) {
+        maxStepQ8 = (int32_t)((uint64_t)maxDriftPerDay * 256 * windowLengthMs / BASELINE_TRACKER_DAY_MS);
+        if (maxStepQ8 < 1) {
+            maxStepQ8 = 1;
+        }
+    }
+
+    /**
+     * Fija la referencia (calibración manual o valores cargados)
+     * @param baseline Baseline de la calibración manual (cuentas)
+     * @param driftQ8 Deriva ya acumulada (1/256 cuentas)
+     */
+    void setAnchor(int32_t baseline, int32_t driftQ8 = 0) {
+        anchor = baseline;
+        offsetQ8 = driftQ8 < -maxOffsetQ8 ? -maxOffsetQ8 : (driftQ8 > maxOffsetQ8 ? maxOffsetQ8 : driftQ8);
+        window.reset();
+    }
+
+    /**
+     * Descarta la ventana en curso (reinicio del sensor)
+     */
+    void restartWindow() {
+        window.reset();
+    }
+
+    /**
+     * Agrega el promedio de una lectura
+     * Una lectura que no es de aire limpio descarta la ventana en curso.
+     * @param mean Promedio de la lectura (cuentas)
+     * @param clean true si la lectura es de aire limpio
+     * @param now Tiempo actual (ms)
+     * @return true si cambió el baseline entero
+     */
+    bool add(float mean, bool clean, uint32_t now) {
+        if (!clean) {
+            if (window.count > 0) {
+                rejectedWindows++;
+                window.reset();
+            }
+            return false;
+        }
+
+        if (window.count == 0) {
+            windowStart = now;
+        }
+        window.add(mean);
+
+        if (now - windowStart < windowMs) {
+            return false;
+        }
+
+        // Ventana completa: se descarta si el aire no estuvo estable
+        bool stable = window.count >= 2 && window.stddev() <= maxStddev;
+        float windowMean = window.mean;
+        window.reset();
+
+        if (!stable) {
+            rejectedWindows++;
+            return false;
+        }
+        acceptedWindows++;
+
+        // Paso hacia la media de la ventana, acotado por ventana y en total
+        int32_t before = roundQ8(offsetQ8);
+        int32_t step = (int32_t)((windowMean - anchor) * 256.0f) - offsetQ8;
+        step = step < -maxStepQ8 ? -maxStepQ8 : (step > maxStepQ8 ? maxStepQ8 : step);
+        offsetQ8 += step;
+        offsetQ8 = offsetQ8 < -maxOffsetQ8 ? -maxOffsetQ8 : (offsetQ8 > maxOffsetQ8 ? maxOffsetQ8 : offsetQ8);
+
+        return roundQ8(offsetQ8) != before;
+    }
+
+    /**
+     * Baseline seguido (cuentas)
+     */
+    int32_t getBaseline() const {
+        return anchor + roundQ8(offsetQ8);
+    }
+
+    /**
+     * Baseline de la última calibración manual (cuentas)
+     */
+    int32_t getAnchor() const {
+        return anchor;
+    }
+
+    /**
+     * Deriva acumulada desde la calibración manual (cuentas)
+     */
+    int32_t getDrift() const {
+        return roundQ8(offsetQ8);
+    }
+
+    /**
+     * Ventanas aceptadas y descartadas desde el arranque
+     */
+    uint32_t getAcceptedWindows() const {
+        return acceptedWindows;
+    }
+
+    uint32_t getRejectedWindows() const {
+        return rejectedWindows;
+    }
+};
+
+#endif // BASELINETRACKER_H
@@ -0,0 +1,130 @@
+/*
+Calibración incremental (máquina de estados reanudable):
+
+Una muestra por tick desde el camino normal de lectura
+Estadística de Welford por canal
+Progreso, inicio y aborto en tiempo de ejecución
+El tiempo se recibe como parámetro (reloj virtual en host)
+*/
+#ifndef CALIBRATIONSESSION_H
+#define CALIBRATIONSESSION_H
+
+#include <stdint.h>
+#include "Welford.h"
+
+// Estados de la calibración
+enum class CalibrationStatus {
+    IDLE,           // Sin calibración en curso
+    RUNNING,        // Acumulando muestras
+    COMPLETED,      // Terminada (resultado disponible)
+    ABORTED         // Cancelada antes de terminar
+};
+
+template <int Channels>
+class CalibrationSession {
+private:
+    CalibrationStatus status;
+    uint32_t targetSamples;
+    uint32_t intervalMs;
+    uint32_t lastSampleTime;
+    WelfordStats channelStats[Channels];
+
+public:
+    CalibrationSession()
+        : status(CalibrationStatus::IDLE),
+          targetSamples(0),
+          intervalMs(0),
+          lastSampleTime(0) {}
+
+    /**
+     * Inicia (o reinicia) la acumulación de muestras
+     * @param samples Número de muestras a acumular
+     * @param minIntervalMs Tiempo mínimo entre muestras
+     * @param now Tiempo actual (ms)
+     * @return false si los parámetros no son válidos
+     */
+    bool start(uint32_t samples, uint32_t minIntervalMs, uint32_t now) {
+        if (samples == 0) {
+            return false;
+        }
+
+        for (int i = 0; i < Channels; i++) {
+            channelStats[i].reset();
+        }
+
+        targetSamples = samples;
+        intervalMs = minIntervalMs;
+        lastSampleTime = now;
+        status = CalibrationStatus::RUNNING;
+        return true;
+    }
+
+    /**
+     * Cancela la calibración en curso (los datos se descartan)
+     */
+    void abort() {
+        if (status == CalibrationStatus::RUNNING) {
+            status = CalibrationStatus::ABORTED;
+        }
+    }
+
+    /**
+     * Indica si corresponde tomar una muestra en este tick
+     * @param now Tiempo actual (ms)
+     */
+    bool shouldSample(uint32_t now) const {
+        if (status != CalibrationStatus::RUNNING) {
+            return false;
+        }
+        return channelStats[0].count == 0 || (now - lastSampleTime) >= intervalMs;
+    }
+
+    /**
+     * Obtiene la estadística de un canal para agregar la muestra del tick
+     */
+    WelfordStats& stats(int channel) {
+        return channelStats[channel];
+    }
+
+    const WelfordStats& stats(int channel) const {
+        return channelStats[channel];
+    }
+
+    /**
+     * Registra que se agregó la muestra del tick
+     * @param now Tiempo actual (ms)
+     * @return true si con esta muestra la calibración quedó completa
+     */
+    bool commitSample(uint32_t now) {
+        lastSampleTime = now;
+
+        if (channelStats[0].count >= targetSamples) {
+            status = CalibrationStatus::COMPLETED;
+            return true;
+        }
+        return false;
+    }
+
+    CalibrationStatus getStatus() const {
+        return status;
+    }
+
+    bool isRunning() const {
+        return status == CalibrationStatus::RUNNING;
+    }
+
+    /**
+     * Progreso 0-100%
+     */
+    int getProgress() const {
+        if (status == CalibrationStatus::COMPLETED) return 100;
+        if (targetSamples == 0) return 0;
+        return (int)((channelStats[0].count * 100) / targetSamples);
+    }
+
+    uint32_t getTargetSamples() const {
+        return targetSamples;
+    }
+};
+
+#endif // CALIBRATIONSESSION_H
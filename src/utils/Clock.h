@@ -0,0 +1,58 @@
+/*
+Reloj de la cadena de detección:
+
+Tiempo real (millis()) en funcionamiento normal
+Tiempo virtual para reproducir trazas más rápido que el tiempo real:
+la reproducción fija el instante de cada muestra y los sensores,
+tendencias y alertas lo ven como si hubiera transcurrido
+*/
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <Arduino.h>
+
+class Clock {
+private:
+    static inline bool simulated = false;
+    static inline unsigned long simulatedMs = 0;
+
+public:
+    /**
+     * Tiempo actual en ms (virtual si hay una simulación activa)
+     */
+    static unsigned long millis() {
+        return simulated ? simulatedMs : ::millis();
+    }
+
+    /**
+     * Pasa a tiempo virtual
+     * @param startMs Instante inicial
+     */
+    static void simulate(unsigned long startMs) {
+        simulatedMs = startMs;
+        simulated = true;
+    }
+
+    /**
+     * Avanza el tiempo virtual (nunca retrocede)
+     * @param nowMs Nuevo instante
+     */
+    static void advanceTo(unsigned long nowMs) {
+        if ((long)(nowMs - simulatedMs) > 0) {
+            simulatedMs = nowMs;
+        }
+    }
+
+    /**
+     * Vuelve al tiempo real
+     */
+    static void realTime() {
+        simulated = false;
+    }
+
+    static bool isSimulated() {
+        return simulated;
+    }
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,248 @@
+/*
+Superficie de corrección temperatura × humedad (interpolación bilineal):
+
+Grilla pequeña de ganancias sobre dos ejes crecientes
+Ejes en décimas (°C, %), ganancias en Q12 (4096 = sin corrección)
+Interpolación bilineal en punto fijo; fuera de la grilla se usa el borde
+Se evalúa una vez por lectura ambiental: a cada muestra solo le queda
+una multiplicación y un desplazamiento
+Grilla configurable por texto (un archivo por gas)
+Sin dependencias de Arduino (compilable en host)
+
+Formato del archivo (una directiva por línea, # para comentarios):
+    temp -10 0 20 40 50         (eje de temperatura, °C)
+    hum 33 85                   (eje de humedad, %)
+    gain 1.30 1.22              (una fila por temperatura, en orden)
+*/
+#ifndef COMPENSATIONGRID_H
+#define COMPENSATIONGRID_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMP_GRID_MAX_AXIS 8        // Puntos máximos por eje
+#define COMP_GAIN_SHIFT 12
+#define COMP_GAIN_ONE (1 << COMP_GAIN_SHIFT)
+#define COMP_WEIGHT_SHIFT 12        // Pesos de interpolación en Q12
+#define COMP_WEIGHT_ONE (1 << COMP_WEIGHT_SHIFT)
+
+class CompensationGrid {
+private:
+    uint8_t tempCount;
+    uint8_t humCount;
+    uint8_t rowCount;                                       // Filas leídas (parseLine)
+    int16_t tempAxis[COMP_GRID_MAX_AXIS];                   // Décimas de °C
+    int16_t humAxis[COMP_GRID_MAX_AXIS];                    // Décimas de %
+    uint16_t gains[COMP_GRID_MAX_AXIS][COMP_GRID_MAX_AXIS]; // [temperatura][humedad], Q12
+
+    /**
+     * Tramo del eje que contiene x y peso del extremo superior (Q12)
+     */
+    static int locate(const int16_t* axis, uint8_t count, int16_t x, int32_t& weight) {
+        weight = 0;
+        if (count < 2 || x <= axis[0]) {
+            return 0;
+        }
+        if (x >= axis[count - 1]) {
+            weight = COMP_WEIGHT_ONE;
+            return count - 2;
+        }
+
+        int i = 0;
+        while (x >= axis[i + 1]) {
+            i++;
+        }
+        weight = ((int32_t)(x - axis[i]) << COMP_WEIGHT_SHIFT) / (axis[i + 1] - axis[i]);
+        return i;
+    }
+
+    static bool isIncreasing(const int16_t* axis, uint8_t count) {
+        for (int i = 1; i < count; i++) {
+            if (axis[i] <= axis[i - 1]) {
+                return false;
+            }
+        }
+        return count > 0;
+    }
+
+    /**
+     * Lista de números separados por espacios
+     * @return Cantidad leída (-1 si sobran o alguno no es un número)
+     */
+    static int parseNumbers(const char* cursor, float* values, int capacity) {
+        int count = 0;
+        while (true) {
+            while (*cursor == ' ' || *cursor == '\t') cursor++;
+            if (*cursor == 0 || *cursor == '\r' || *cursor == '\n' || *cursor == '#') {
+                return count;
+            }
+            char* end;
+            float value = strtof(cursor, &end);
+            if (end == cursor || count >= capacity) {
+                return -1;
+            }
+            values[count++] = value;
+            cursor = end;
+        }
+    }
+
+public:
+    CompensationGrid() {
+        setUnity();
+    }
+
+    /**
+     * Grilla neutra (ganancia 1 en todo el rango)
+     */
+    void setUnity() {
+        tempCount = 1;
+        humCount = 1;
+        rowCount = 0;
+        tempAxis[0] = 0;
+        humAxis[0] = 0;
+        gains[0][0] = COMP_GAIN_ONE;
+    }
+
+    /**
+     * Carga la grilla desde tablas
+     * @param temps Eje de temperatura (décimas de °C, creciente)
+     * @param tempPoints Puntos del eje de temperatura
+     * @param hums Eje de humedad (décimas de %, creciente)
+     * @param humPoints Puntos del eje de humedad
+     * @param values Ganancias Q12, fila por temperatura (tempPoints × humPoints)
+     * @return false si las dimensiones o los ejes no son válidos (la grilla no cambia)
+     */
+    bool set(const int16_t* temps, uint8_t tempPoints, const int16_t* hums, uint8_t humPoints,
+             const uint16_t* values) {
+        if (tempPoints > COMP_GRID_MAX_AXIS || humPoints > COMP_GRID_MAX_AXIS ||
+            !isIncreasing(temps, tempPoints) || !isIncreasing(hums, humPoints)) {
+            return false;
+        }
+
+        tempCount = tempPoints;
+        humCount = humPoints;
+        rowCount = tempPoints;
+        memcpy(tempAxis, temps, tempPoints * sizeof(int16_t));
+        memcpy(humAxis, hums, humPoints * sizeof(int16_t));
+        for (int t = 0; t < tempPoints; t++) {
+            memcpy(gains[t], values + t * humPoints, humPoints * sizeof(uint16_t));
+        }
+        return true;
+    }
+
+    /**
+     * Vacía la grilla antes de leer un archivo con parseLine()
+     */
+    void clear() {
+        tempCount = 0;
+        humCount = 0;
+        rowCount = 0;
+    }
+
+    /**
+     * Interpreta una línea del archivo
+     * @param line Línea (sin requerir terminador de línea)
+     * @return 0 si se aceptó (o es comentario/vacía), -1 si es inválida
+     */
+    int parseLine(const char* line) {
+        const char* cursor = line;
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        if (*cursor == 0 || *cursor == '#' || *cursor == '\r' || *cursor == '\n') {
+            return 0;
+        }
+
+        float values[COMP_GRID_MAX_AXIS];
+        int count;
+
+        if (strncmp(cursor, "temp ", 5) == 0) {
+            count = parseNumbers(cursor + 5, values, COMP_GRID_MAX_AXIS);
+            if (count < 1 || rowCount > 0) {
+                return -1;
+            }
+            tempCount = count;
+            for (int i = 0; i < count; i++) {
+                tempAxis[i] = (int16_t)lroundf(values[i] * 10.0f);
+            }
+            return isIncreasing(tempAxis, tempCount) ? 0 : -1;
+        }
+
+        if (strncmp(cursor, "hum ", 4) == 0) {
+            count = parseNumbers(cursor + 4, values, COMP_GRID_MAX_AXIS);
+            if (count < 1 || rowCount > 0) {
+                return -1;
+            }
+            humCount = count;
+            for (int i = 0; i < count; i++) {
+                humAxis[i] = (int16_t)lroundf(values[i] * 10.0f);
+            }
+            return isIncreasing(humAxis, humCount) ? 0 : -1;
+        }
+
+        if (strncmp(cursor, "gain ", 5) == 0) {
+            count = parseNumbers(cursor + 5, values, COMP_GRID_MAX_AXIS);
+            if (humCount == 0 || count != humCount || rowCount >= tempCount) {
+                return -1;
+            }
+            for (int i = 0; i < count; i++) {
+                if (values[i] <= 0 || values[i] >= 4.0f) {
+                    return -1;
+                }
+                gains[rowCount][i] = (uint16_t)(values[i] * COMP_GAIN_ONE + 0.5f);
+            }
+            rowCount++;
+            return 0;
+        }
+
+        return -1;
+    }
+
+    /**
+     * Verifica que el archivo leído completó la grilla
+     */
+    bool isComplete() const {
+        return tempCount > 0 && humCount > 0 && rowCount == tempCount;
+    }
+
+    /**
+     * Ganancia para una condición ambiental
+     * @param tempDeci Temperatura en décimas de °C
+     * @param humDeci Humedad en décimas de %
+     * @return Ganancia Q12
+     */
+    uint16_t gain(int16_t tempDeci, int16_t humDeci) const {
+        int32_t wt, wh;
+        int t = locate(tempAxis, tempCount, tempDeci, wt);
+        int h = locate(humAxis, humCount, humDeci, wh);
+        int t1 = tempCount > 1 ? t + 1 : t;
+        int h1 = humCount > 1 ? h + 1 : h;
+
+        // Q12 × Q12 en 32 bits (ganancia < 4.0); el segundo peso lleva a 64 bits
+        uint32_t low = (uint32_t)gains[t][h] * (COMP_WEIGHT_ONE - wh) + (uint32_t)gains[t][h1] * wh;
+        uint32_t high = (uint32_t)gains[t1][h] * (COMP_WEIGHT_ONE - wh) + (uint32_t)gains[t1][h1] * wh;
+        uint64_t value = (uint64_t)low * (COMP_WEIGHT_ONE - wt) + (uint64_t)high * wt;
+        return (uint16_t)((value + (1ull << (2 * COMP_WEIGHT_SHIFT - 1))) >> (2 * COMP_WEIGHT_SHIFT));
+    }
+
+    /**
+     * Aplica una ganancia a una muestra
+     * @param sample Muestra (cualquier escala)
+     * @param gainQ12 Ganancia de gain()
+     * @param maxValue Saturación de la escala
+     */
+    static uint16_t apply(uint16_t sample, uint16_t gainQ12, uint16_t maxValue) {
+        uint32_t value = ((uint32_t)sample * gainQ12 + (COMP_GAIN_ONE / 2)) >> COMP_GAIN_SHIFT;
+        return (uint16_t)(value > maxValue ? maxValue : value);
+    }
+
+    uint8_t getTemperaturePoints() const {
+        return tempCount;
+    }
+
+    uint8_t getHumidityPoints() const {
+        return humCount;
+    }
+};
+
+#endif // COMPENSATIONGRID_H
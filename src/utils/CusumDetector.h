@@ -0,0 +1,93 @@
+/*
+Detector de subida sostenida (CUSUM / Page-Hinkley unilateral):
+
+Referencia: media exponencial lenta de la propia señal (2^BaselineShift muestras)
+S = max(0, S + (x - referencia - deriva)); subida cuando S alcanza el umbral
+Una rampa lenta deja la referencia atrás y S crece sin parar; el ruido y
+las derivas más lentas que la referencia se cancelan
+S se satura en 2 × umbral: al terminar la subida la marca se libera en
+tiempo acotado (cuando S vuelve a 0)
+Memoria O(1), solo enteros; alimentar muestra a muestra a ritmo constante
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef CUSUMDETECTOR_H
+#define CUSUMDETECTOR_H
+
+#include <stdint.h>
+
+template <unsigned BaselineShift>
+class CusumDetector {
+    static_assert(BaselineShift >= 4 && BaselineShift <= 16, "CusumDetector: referencia de 2^4 a 2^16 muestras");
+
+private:
+    int32_t baselineAcc;    // Referencia << BaselineShift
+    int32_t sum;            // S (cuentas × muestras)
+    int32_t drift;          // Desvío tolerado por muestra
+    int32_t threshold;      // Umbral de S
+    bool primed;
+    bool rising;
+
+public:
+    /**
+     * @param driftCounts Desvío sobre la referencia que se considera ruido (cuentas)
+     * @param thresholdCounts Umbral de la suma acumulada (cuentas × muestras)
+     */
+    CusumDetector(int32_t driftCounts, int32_t thresholdCounts)
+        : drift(driftCounts), threshold(thresholdCounts) {
+        reset();
+    }
+
+    /**
+     * Agrega una muestra
+     * @return true mientras haya una subida sostenida
+     */
+    bool update(uint16_t sample) {
+        if (!primed) {
+            baselineAcc = (int32_t)sample << BaselineShift;
+            primed = true;
+        }
+
+        int32_t baseline = baselineAcc >> BaselineShift;
+        baselineAcc += (int32_t)sample - baseline;
+
+        int32_t s = sum + ((int32_t)sample - baseline - drift);
+        sum = s < 0 ? 0 : (s > 2 * threshold ? 2 * threshold : s);
+
+        if (sum >= threshold) {
+            rising = true;
+        } else if (sum == 0) {
+            rising = false;
+        }
+        return rising;
+    }
+
+    bool isRising() const {
+        return rising;
+    }
+
+    /**
+     * Suma acumulada actual (0 - 2 × umbral)
+     */
+    int32_t getSum() const {
+        return sum;
+    }
+
+    /**
+     * Referencia actual (misma escala que las muestras)
+     */
+    uint16_t getBaseline() const {
+        return (uint16_t)(baselineAcc >> BaselineShift);
+    }
+
+    /**
+     * Olvida la historia (la próxima muestra fija la referencia)
+     */
+    void reset() {
+        baselineAcc = 0;
+        sum = 0;
+        primed = false;
+        rising = false;
+    }
+};
+
+#endif // CUSUMDETECTOR_H
@@ -0,0 +1,116 @@
+/*
+Documento publicado en doble buffer (un escritor, muchos lectores):
+
+El escritor arma el documento completo en el buffer de atrás y lo publica
+con un único intercambio de índice; los lectores toman el del frente
+Cada lector retiene el buffer mientras lo envía (contador de referencias):
+el escritor nunca pisa un buffer retenido, y si el de atrás sigue ocupado
+omite esa publicación (el frente queda vigente hasta la próxima)
+Sin copias ni memoria dinámica; solo atómicos
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef DOUBLEBUFFER_H
+#define DOUBLEBUFFER_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+template <size_t Capacity>
+class DoubleBuffer {
+private:
+    char data[2][Capacity];
+    size_t length[2];
+    std::atomic<uint32_t> front;        // Buffer publicado (0 o 1)
+    std::atomic<uint32_t> refs[2];      // Lectores que retienen cada buffer
+    std::atomic<uint32_t> version;      // Publicaciones (0 = sin documento)
+    uint32_t skipped;                   // Publicaciones omitidas (buffer de atrás retenido)
+
+public:
+    DoubleBuffer() : front(0), version(0), skipped(0) {
+        length[0] = 0;
+        length[1] = 0;
+        data[0][0] = 0;
+        data[1][0] = 0;
+        refs[0] = 0;
+        refs[1] = 0;
+    }
+
+    /**
+     * Buffer de atrás para escribir (solo el escritor)
+     * @return nullptr si un lector todavía lo retiene
+     */
+    char* beginWrite() {
+        uint32_t back = front.load() ^ 1;
+        if (refs[back].load() != 0) {
+            skipped++;
+            return nullptr;
+        }
+        return data[back];
+    }
+
+    /**
+     * Publica el buffer de atrás (después de beginWrite())
+     * @param size Longitud del documento
+     */
+    void publish(size_t size) {
+        uint32_t back = front.load() ^ 1;
+        length[back] = size;
+        front.store(back);
+        version.fetch_add(1);
+    }
+
+    /**
+     * Retiene el documento publicado (cualquier tarea)
+     * @param size Longitud del documento
+     * @param slot Buffer retenido (para release())
+     * @return Documento; válido hasta release()
+     */
+    const char* acquire(size_t& size, uint32_t& slot) {
+        while (true) {
+            uint32_t current = front.load();
+            refs[current].fetch_add(1);
+            // Si se publicó otro entre medio, el escritor pudo empezar a pisar este
+            if (front.load() == current) {
+                slot = current;
+                size = length[current];
+                return data[current];
+            }
+            refs[current].fetch_sub(1);
+        }
+    }
+
+    /**
+     * Libera un buffer retenido con acquire()
+     */
+    void release(uint32_t slot) {
+        refs[slot].fetch_sub(1);
+    }
+
+    constexpr size_t capacity() const {
+        return Capacity;
+    }
+
+    /**
+     * Publicaciones desde el arranque (0 = todavía no hay documento)
+     */
+    uint32_t getVersion() const {
+        return version.load();
+    }
+
+    /**
+     * Publicaciones omitidas por lectores lentos
+     */
+    uint32_t getSkipped() const {
+        return skipped;
+    }
+
+    /**
+     * Lectores con un buffer retenido en este momento
+     */
+    uint32_t getReaders() const {
+        return refs[0].load() + refs[1].load();
+    }
+};
+
+#endif // DOUBLEBUFFER_H
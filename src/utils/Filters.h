@@ -0,0 +1,257 @@
+/*
+Filtros de suavizado configurables en tiempo de compilación:
+
+BoxcarFilter  - Promedio móvil, ventana potencia de 2 (solo sumas y shifts)
+EmaFilter     - Media móvil exponencial en punto fijo
+MedianFilter  - Mediana móvil (ventana impar)
+HampelFilter  - Rechazo de outliers por mediana + MAD
+
+Todos comparten la misma interfaz:
+    uint16_t update(uint16_t sample);   // Agrega muestra, devuelve salida
+    uint16_t value() const;             // Última salida
+    void reset();                       // Vuelve al estado inicial
+
+Sin dependencias de Arduino (compilable en host). Sin memoria dinámica.
+*/
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Promedio móvil con ventana de 2^Log2Window muestras
+ * Costo: 1 suma, 1 resta, 1 shift por muestra
+ * Memoria: 2 * 2^Log2Window + 8 bytes
+ */
+template <unsigned Log2Window>
+class BoxcarFilter {
+    static_assert(Log2Window >= 1 && Log2Window <= 8, "BoxcarFilter: ventana de 2 a 256 muestras");
+
+public:
+    static const unsigned WINDOW = 1u << Log2Window;
+
+private:
+    uint16_t samples[WINDOW];
+    uint32_t total;
+    uint16_t index;
+    bool primed;
+
+public:
+    BoxcarFilter() { reset(); }
+
+    uint16_t update(uint16_t sample) {
+        // Primera muestra: llenar la ventana para evitar arrancar desde cero
+        if (!primed) {
+            for (unsigned i = 0; i < WINDOW; i++) samples[i] = sample;
+            total = (uint32_t)sample << Log2Window;
+            primed = true;
+            return sample;
+        }
+
+        total -= samples[index];
+        samples[index] = sample;
+        total += sample;
+        index = (index + 1) & (WINDOW - 1);
+
+        return value();
+    }
+
+    uint16_t value() const {
+        return (uint16_t)(total >> Log2Window);
+    }
+
+    void reset() {
+        for (unsigned i = 0; i < WINDOW; i++) samples[i] = 0;
+        total = 0;
+        index = 0;
+        primed = false;
+    }
+};
+
+/**
+ * Media móvil exponencial: y += (x - y) / 2^Shift
+ * Estado en punto fijo Q8 para no perder resolución con shifts grandes
+ * Costo: 1 resta, 1 shift, 1 suma por muestra
+ * Memoria: 8 bytes
+ */
+template <unsigned Shift>
+class EmaFilter {
+    static_assert(Shift >= 1 && Shift <= 12, "EmaFilter: shift de 1 a 12");
+
+private:
+    static const unsigned FRAC_BITS = 8;
+
+    int32_t state;  // Q8
+    bool primed;
+
+public:
+    EmaFilter() { reset(); }
+
+    uint16_t update(uint16_t sample) {
+        int32_t x = (int32_t)sample << FRAC_BITS;
+
+        if (!primed) {
+            state = x;
+            primed = true;
+        } else {
+            state += (x - state) >> Shift;
+        }
+
+        return value();
+    }
+
+    uint16_t value() const {
+        return (uint16_t)((state + (1 << (FRAC_BITS - 1))) >> FRAC_BITS);
+    }
+
+    void reset() {
+        state = 0;
+        primed = false;
+    }
+};
+
+/**
+ * Mediana móvil sobre Window muestras (impar)
+ * Mantiene una copia ordenada: inserción/borrado O(Window) por muestra
+ * Memoria: 4 * Window + 4 bytes
+ */
+template <unsigned Window>
+class MedianFilter {
+    static_assert(Window >= 3 && Window <= 63 && (Window & 1) == 1, "MedianFilter: ventana impar de 3 a 63");
+
+private:
+    uint16_t history[Window];   // Orden de llegada
+    uint16_t sorted[Window];    // Orden ascendente
+    uint16_t index;
+    bool primed;
+
+public:
+    MedianFilter() { reset(); }
+
+    uint16_t update(uint16_t sample) {
+        if (!primed) {
+            for (unsigned i = 0; i < Window; i++) {
+                history[i] = sample;
+                sorted[i] = sample;
+            }
+            primed = true;
+            return sample;
+        }
+
+        // Quitar la muestra más antigua de la copia ordenada
+        uint16_t old = history[index];
+        unsigned pos = 0;
+        while (sorted[pos] != old) pos++;
+        for (; pos + 1 < Window; pos++) sorted[pos] = sorted[pos + 1];
+
+        // Insertar la nueva muestra en su lugar
+        pos = Window - 1;
+        while (pos > 0 && sorted[pos - 1] > sample) {
+            sorted[pos] = sorted[pos - 1];
+            pos--;
+        }
+        sorted[pos] = sample;
+
+        history[index] = sample;
+        index = (index + 1) % Window;
+
+        return value();
+    }
+
+    uint16_t value() const {
+        return sorted[Window / 2];
+    }
+
+    void reset() {
+        for (unsigned i = 0; i < Window; i++) {
+            history[i] = 0;
+            sorted[i] = 0;
+        }
+        index = 0;
+        primed = false;
+    }
+};
+
+/**
+ * Filtro de Hampel: reemplaza por la mediana las muestras que se alejan
+ * más de K/10 desviaciones robustas (1.4826 * MAD) de la mediana
+ * Ejemplo: HampelFilter<7, 30> = ventana 7, umbral 3.0 sigma
+ * El MAD se toma como mínimo 1 LSB (umbral ~K * 1.5 LSB con señal plana)
+ * Costo: O(Window) mediana + O(Window^2) MAD (Window pequeño)
+ * Memoria: 6 * Window + 10 bytes
+ */
+template <unsigned Window, unsigned KTenths = 30>
+class HampelFilter {
+    static_assert(KTenths > 0, "HampelFilter: umbral debe ser positivo");
+
+private:
+    MedianFilter<Window> median;
+    uint16_t window[Window];    // Muestras crudas en orden de llegada
+    uint16_t index;
+    uint16_t output;
+    bool primed;
+
+    uint16_t medianAbsoluteDeviation(uint16_t center) const {
+        uint16_t dev[Window];
+
+        // Ordenamiento por inserción (Window es pequeño)
+        for (unsigned i = 0; i < Window; i++) {
+            uint16_t d = window[i] > center ? window[i] - center : center - window[i];
+            unsigned j = i;
+            while (j > 0 && dev[j - 1] > d) {
+                dev[j] = dev[j - 1];
+                j--;
+            }
+            dev[j] = d;
+        }
+
+        return dev[Window / 2];
+    }
+
+public:
+    HampelFilter() { reset(); }
+
+    uint16_t update(uint16_t sample) {
+        if (!primed) {
+            for (unsigned i = 0; i < Window; i++) window[i] = sample;
+            primed = true;
+        }
+
+        uint16_t center = median.update(sample);
+
+        window[index] = sample;
+        index = (index + 1) % Window;
+
+        // MAD mínimo de 1 LSB: con señal plana (MAD = 0) un escalón real
+        // de 1 LSB no debe tomarse como outlier
+        uint64_t mad = medianAbsoluteDeviation(center);
+        if (mad == 0) {
+            mad = 1;
+        }
+        uint64_t deviation = sample > center ? sample - center : center - sample;
+
+        // |x - med| > K * 1.4826 * MAD, en enteros (escala 10 * 10000)
+        if (deviation * 100000u > (uint64_t)KTenths * 14826u * mad) {
+            output = center;
+        } else {
+            output = sample;
+        }
+
+        return output;
+    }
+
+    uint16_t value() const {
+        return output;
+    }
+
+    void reset() {
+        median.reset();
+        for (unsigned i = 0; i < Window; i++) window[i] = 0;
+        index = 0;
+        output = 0;
+        primed = false;
+    }
+};
+
+#endif // FILTERS_H
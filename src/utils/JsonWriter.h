@@ -0,0 +1,190 @@
+/*
+Escritor de JSON sobre un buffer fijo:
+
+Sin String ni memoria dinámica: agrega directamente en el buffer del llamador
+Objetos anidados (comas automáticas), números, booleanos y texto escapado
+NaN e infinitos se escriben como null (JSON no los admite)
+Si el buffer no alcanza se marca el desbordamiento y el resultado no es válido
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define JSON_MAX_DEPTH 8
+
+class JsonWriter {
+private:
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    bool overflow;
+    uint8_t depth;
+    bool needComma[JSON_MAX_DEPTH];
+
+    void append(char c) {
+        if (length + 1 < capacity) {
+            buffer[length++] = c;
+            buffer[length] = 0;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void appendRaw(const char* text) {
+        while (*text) {
+            append(*text++);
+        }
+    }
+
+    void appendString(const char* text) {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        append('"');
+        for (; *text; text++) {
+            char c = *text;
+            if (c == '"' || c == '\\') {
+                append('\\');
+                append(c);
+            } else if ((uint8_t)c < 0x20) {
+                appendRaw("\\u00");
+                append(HEX_DIGITS[(c >> 4) & 0x0F]);
+                append(HEX_DIGITS[c & 0x0F]);
+            } else {
+                append(c);
+            }
+        }
+        append('"');
+    }
+
+    /**
+     * Coma si hace falta y nombre del campo (nullptr en arreglos o en la raíz)
+     */
+    void prefix(const char* key) {
+        if (depth > 0) {
+            if (needComma[depth - 1]) {
+                append(',');
+            }
+            needComma[depth - 1] = true;
+        }
+        if (key != nullptr) {
+            appendString(key);
+            append(':');
+        }
+    }
+
+    __attribute__((format(printf, 2, 3)))
+    void appendFormatted(const char* format, ...) {
+        if (overflow) {
+            return;
+        }
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(buffer + length, capacity - length, format, args);
+        va_end(args);
+        if (written < 0 || (size_t)written >= capacity - length) {
+            overflow = true;
+            buffer[length] = 0;
+            return;
+        }
+        length += written;
+    }
+
+public:
+    /**
+     * @param output Buffer de salida (queda terminado en 0)
+     * @param size Tamaño del buffer
+     */
+    JsonWriter(char* output, size_t size)
+        : buffer(output), capacity(size), length(0), overflow(size == 0), depth(0) {
+        if (size > 0) {
+            buffer[0] = 0;
+        }
+    }
+
+    /**
+     * Abre un objeto (key = nullptr en la raíz)
+     */
+    void beginObject(const char* key = nullptr) {
+        prefix(key);
+        append('{');
+        if (depth < JSON_MAX_DEPTH) {
+            needComma[depth++] = false;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void endObject() {
+        if (depth > 0) {
+            depth--;
+        }
+        append('}');
+    }
+
+    void field(const char* key, const char* value) {
+        prefix(key);
+        if (value == nullptr) {
+            appendRaw("null");
+        } else {
+            appendString(value);
+        }
+    }
+
+    void field(const char* key, bool value) {
+        prefix(key);
+        appendRaw(value ? "true" : "false");
+    }
+
+    // Enteros por tipo base: int32_t es int en host y long en el ESP32
+    void field(const char* key, int value) {
+        field(key, (long)value);
+    }
+
+    void field(const char* key, unsigned int value) {
+        field(key, (unsigned long)value);
+    }
+
+    void field(const char* key, long value) {
+        prefix(key);
+        appendFormatted("%ld", value);
+    }
+
+    void field(const char* key, unsigned long value) {
+        prefix(key);
+        appendFormatted("%lu", value);
+    }
+
+    /**
+     * Número con decimales fijos
+     * @param decimals Cifras después del punto
+     */
+    void field(const char* key, float value, int decimals) {
+        prefix(key);
+        if (isnan(value) || isinf(value)) {
+            appendRaw("null");
+        } else {
+            appendFormatted("%.*f", decimals, (double)value);
+        }
+    }
+
+    /**
+     * Longitud escrita (sin el terminador)
+     */
+    size_t size() const {
+        return length;
+    }
+
+    /**
+     * Verifica que el documento entró completo y está cerrado
+     */
+    bool isComplete() const {
+        return !overflow && depth == 0;
+    }
+};
+
+#endif // JSONWRITER_H
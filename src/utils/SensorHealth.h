@@ -0,0 +1,337 @@
+/*
+Salud de los sensores (calidad de cada lectura):
+
+Banderas de calidad comunes a todos los sensores (bits, 0 = OK)
+SignalMonitor: valor trabado (la lectura se repite idéntica, sin el ruido
+de un sensor vivo), señal plana (el rango de toda una ventana de tiempo no
+supera un mínimo) y fuera de rango (rieles del ADC, límites físicos)
+DeviceHealth: errores de bus y mediciones viejas de un dispositivo I2C;
+lo declara fuera de línea y programa reintentos con espera creciente
+El tiempo se recibe como parámetro (reloj virtual en host)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef SENSORHEALTH_H
+#define SENSORHEALTH_H
+
+#include <stdint.h>
+
+#define QUALITY_OK 0
+
+// Banderas de calidad de una lectura
+enum QualityFlag : uint8_t {
+    QUALITY_OUT_OF_RANGE = 0x01,    // Fuera del rango físico o en un riel del ADC
+    QUALITY_STUCK = 0x02,           // Valor idéntico en muchas lecturas seguidas
+    QUALITY_FLATLINE = 0x04,        // Sin variación en toda una ventana
+    QUALITY_DISAGREE = 0x08,        // AHT20 y BMP280 no coinciden en temperatura
+    QUALITY_STALE = 0x10,           // Sin mediciones nuevas (valor retenido)
+    QUALITY_BUS_ERROR = 0x20,       // NACK o CRC incorrecto en esta lectura
+    QUALITY_OFFLINE = 0x40          // Dispositivo fuera del bus (recuperación en curso)
+};
+
+// Sin medición nueva: el valor es el último retenido
+#define QUALITY_HELD (QUALITY_STALE | QUALITY_OFFLINE)
+
+/**
+ * Nombre de la bandera más grave
+ * @param flags Banderas de calidad
+ * @return "OK" si no hay ninguna
+ */
+inline const char* qualityName(uint8_t flags) {
+    if (flags & QUALITY_OFFLINE) return "FUERA DE LÍNEA";
+    if (flags & QUALITY_BUS_ERROR) return "ERROR DE BUS";
+    if (flags & QUALITY_STALE) return "SIN DATOS NUEVOS";
+    if (flags & QUALITY_OUT_OF_RANGE) return "FUERA DE RANGO";
+    if (flags & QUALITY_STUCK) return "VALOR TRABADO";
+    if (flags & QUALITY_FLATLINE) return "SEÑAL PLANA";
+    if (flags & QUALITY_DISAGREE) return "DISCREPANCIA";
+    return "OK";
+}
+
+class SignalMonitor {
+private:
+    // Parámetros
+    int32_t low;                // Mínimo válido
+    int32_t high;               // Máximo válido
+    uint16_t stuckLimit;        // Lecturas idénticas seguidas para "trabado" (0 = no se evalúa)
+    uint32_t flatWindowMs;      // Ventana de la señal plana (0 = no se evalúa)
+    int32_t flatSpan;           // Rango máximo de una ventana plana
+
+    // Valor trabado
+    int32_t lastValue;
+    bool primed;                // La lectura anterior no tuvo variación interna
+    uint16_t repeats;
+
+    // Ventana en curso
+    int32_t windowMin;
+    int32_t windowMax;
+    uint32_t windowStart;
+    bool windowOpen;
+    bool flat;
+
+    uint8_t flags;
+
+public:
+    /**
+     * @param minValid Mínimo válido (por debajo: fuera de rango)
+     * @param maxValid Máximo válido (por encima: fuera de rango)
+     * @param stuckReads Lecturas idénticas seguidas para marcar valor trabado (0 = no evaluar)
+     * @param flatWindow Duración de la ventana de señal plana (ms, 0 = no evaluar)
+     * @param flatRange Rango máximo de la señal en una ventana plana
+     */
+    SignalMonitor(int32_t minValid, int32_t maxValid, uint16_t stuckReads,
+                  uint32_t flatWindow, int32_t flatRange)
+        : low(minValid),
+          high(maxValid),
+          stuckLimit(stuckReads),
+          flatWindowMs(flatWindow),
+          flatSpan(flatRange) {
+        reset();
+    }
+
+    /**
+     * Olvida la historia (sensor reiniciado o reemplazado)
+     */
+    void reset() {
+        lastValue = 0;
+        primed = false;
+        repeats = 0;
+        windowMin = 0;
+        windowMax = 0;
+        windowStart = 0;
+        windowOpen = false;
+        flat = false;
+        flags = QUALITY_OK;
+    }
+
+    /**
+     * Agrega una lectura que resume varias muestras
+     * @param minValue Mínimo de la lectura
+     * @param maxValue Máximo de la lectura
+     * @param now Tiempo actual (ms)
+     * @return Banderas de calidad (QUALITY_OUT_OF_RANGE, QUALITY_STUCK, QUALITY_FLATLINE)
+     */
+    uint8_t update(int32_t minValue, int32_t maxValue, uint32_t now) {
+        flags = QUALITY_OK;
+
+        if (minValue < low || maxValue > high) {
+            flags |= QUALITY_OUT_OF_RANGE;
+        }
+
+        // Trabado: lectura sin variación interna e igual a la anterior
+        if (primed && minValue == maxValue && minValue == lastValue) {
+            if (repeats < 0xFFFF) {
+                repeats++;
+            }
+        } else {
+            repeats = 0;
+        }
+        primed = minValue == maxValue;
+        lastValue = minValue;
+
+        if (stuckLimit > 0 && repeats >= stuckLimit) {
+            flags |= QUALITY_STUCK;
+        }
+
+        // Plana: se marca al cerrar la ventana y se libera apenas vuelve la variación
+        if (flatWindowMs > 0) {
+            if (!windowOpen) {
+                windowOpen = true;
+                windowStart = now;
+                windowMin = minValue;
+                windowMax = maxValue;
+            } else {
+                if (minValue < windowMin) windowMin = minValue;
+                if (maxValue > windowMax) windowMax = maxValue;
+            }
+
+            if (windowMax - windowMin > flatSpan) {
+                flat = false;
+            }
+            if (now - windowStart >= flatWindowMs) {
+                flat = windowMax - windowMin <= flatSpan;
+                windowOpen = false;
+            }
+            if (flat) {
+                flags |= QUALITY_FLATLINE;
+            }
+        }
+
+        return flags;
+    }
+
+    /**
+     * Agrega una lectura de un único valor
+     */
+    uint8_t update(int32_t value, uint32_t now) {
+        return update(value, value, now);
+    }
+
+    /**
+     * Banderas de la última lectura
+     */
+    uint8_t getFlags() const {
+        return flags;
+    }
+};
+
+class DeviceHealth {
+private:
+    // Parámetros
+    uint8_t errorLimit;         // Lecturas seguidas con error de bus para declararlo fuera de línea
+    uint32_t staleMs;           // Sin medición nueva: valor retenido
+    uint32_t offlineMs;         // Sin medición nueva: fuera de línea
+    uint32_t backoffMin;        // Primera espera entre reintentos
+    uint32_t backoffMax;        // Espera máxima entre reintentos
+
+    bool attached;              // Respondió alguna vez (solo esos se recuperan)
+    bool online;
+    uint32_t lastErrorCount;    // Contador de errores del driver en la lectura anterior
+    uint8_t consecutiveErrors;
+    uint32_t lastFresh;         // Última medición nueva
+    uint32_t nextAttempt;       // Próximo reintento de recuperación
+    uint32_t backoff;           // Espera actual (se duplica en cada fallo)
+    uint32_t dropouts;          // Veces que quedó fuera de línea
+    uint32_t recoveries;        // Recuperaciones exitosas
+
+public:
+    /**
+     * @param maxErrors Lecturas seguidas con error de bus para declararlo fuera de línea
+     * @param staleAfterMs Sin medición nueva durante este tiempo: valor retenido
+     * @param offlineAfterMs Sin medición nueva durante este tiempo: fuera de línea
+     * @param firstBackoffMs Primera espera entre reintentos (ms)
+     * @param maxBackoffMs Espera máxima entre reintentos (ms)
+     */
+    DeviceHealth(uint8_t maxErrors, uint32_t staleAfterMs, uint32_t offlineAfterMs,
+                 uint32_t firstBackoffMs, uint32_t maxBackoffMs)
+        : errorLimit(maxErrors),
+          staleMs(staleAfterMs),
+          offlineMs(offlineAfterMs),
+          backoffMin(firstBackoffMs),
+          backoffMax(maxBackoffMs),
+          attached(false),
+          online(false),
+          lastErrorCount(0),
+          consecutiveErrors(0),
+          lastFresh(0),
+          nextAttempt(0),
+          backoff(firstBackoffMs),
+          dropouts(0),
+          recoveries(0) {
+    }
+
+    /**
+     * El dispositivo respondió (inicialización o recuperación correcta)
+     * @param errorCount Contador de errores actual del driver
+     * @param now Tiempo actual (ms)
+     */
+    void setOnline(uint32_t errorCount, uint32_t now) {
+        attached = true;
+        online = true;
+        lastErrorCount = errorCount;
+        consecutiveErrors = 0;
+        lastFresh = now;
+        backoff = backoffMin;
+    }
+
+    /**
+     * El dispositivo no respondió a la inicialización
+     * (solo se reintenta si ya había respondido antes)
+     */
+    void setOffline(uint32_t now) {
+        if (attached && online) {
+            online = false;
+            dropouts++;
+            nextAttempt = now;
+            backoff = backoffMin;
+        }
+    }
+
+    /**
+     * Resultado de una lectura
+     * @param errorCount Contador acumulado de errores del driver
+     * @param fresh Hubo medición nueva
+     * @param faulty Los datos delatan un sensor colgado (p. ej. valor trabado)
+     * @param now Tiempo actual (ms)
+     * @return Banderas de calidad (QUALITY_BUS_ERROR, QUALITY_STALE, QUALITY_OFFLINE)
+     */
+    uint8_t update(uint32_t errorCount, bool fresh, bool faulty, uint32_t now) {
+        bool busError = errorCount != lastErrorCount;
+        lastErrorCount = errorCount;
+        uint8_t flags = busError ? QUALITY_BUS_ERROR : QUALITY_OK;
+
+        if (!attached) {
+            return flags;
+        }
+        if (!online) {
+            return flags | QUALITY_STALE | QUALITY_OFFLINE;
+        }
+
+        if (fresh && !busError) {
+            lastFresh = now;
+            consecutiveErrors = 0;
+        } else if (busError && consecutiveErrors < 0xFF) {
+            consecutiveErrors++;
+        }
+
+        uint32_t age = now - lastFresh;
+        if (age > staleMs) {
+            flags |= QUALITY_STALE;
+        }
+
+        if (consecutiveErrors >= errorLimit || age > offlineMs || faulty) {
+            setOffline(now);
+            flags |= QUALITY_OFFLINE;
+        }
+        return flags;
+    }
+
+    /**
+     * Verifica si corresponde intentar la recuperación
+     */
+    bool shouldRecover(uint32_t now) const {
+        return attached && !online && (int32_t)(now - nextAttempt) >= 0;
+    }
+
+    /**
+     * Resultado de un intento de recuperación
+     * @param success true si el dispositivo volvió a responder
+     * @param errorCount Contador de errores actual del driver
+     * @param now Tiempo actual (ms)
+     */
+    void recovered(bool success, uint32_t errorCount, uint32_t now) {
+        if (success) {
+            recoveries++;
+            setOnline(errorCount, now);
+            return;
+        }
+
+        lastErrorCount = errorCount;
+        nextAttempt = now + backoff;
+        backoff = backoff > backoffMax / 2 ? backoffMax : backoff * 2;
+    }
+
+    bool isAttached() const {
+        return attached;
+    }
+
+    bool isOnline() const {
+        return online;
+    }
+
+    /**
+     * Espera hasta el próximo reintento (ms)
+     */
+    uint32_t getBackoff() const {
+        return backoff;
+    }
+
+    uint32_t getDropouts() const {
+        return dropouts;
+    }
+
+    uint32_t getRecoveries() const {
+        return recoveries;
+    }
+};
+
+#endif // SENSORHEALTH_H
@@ -0,0 +1,98 @@
+/*
+Publicación de datos por seqlock:
+
+Un solo escritor (tarea de sensores), múltiples lectores sin bloqueo
+El escritor nunca espera; los lectores reintentan si leyeron a mitad de
+una escritura (secuencia impar o cambiada)
+Los datos se copian palabra a palabra con atómicos relajados: sin carreras
+de datos según el modelo de memoria de C++
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock: T debe ser trivialmente copiable");
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> sequence;     // Impar mientras se escribe
+    std::atomic<uint32_t> words[WORDS];
+
+public:
+    SeqLock() : sequence(0) {
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Publica un nuevo valor (solo el escritor)
+     */
+    void write(const T& value) {
+        uint32_t buffer[WORDS] = {0};
+        memcpy(buffer, &value, sizeof(T));
+
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * Intenta leer una copia consistente (un solo intento)
+     * @param value Destino (solo se modifica si la lectura fue consistente)
+     * @return false si había una escritura en curso
+     */
+    bool tryRead(T& value) const {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        uint32_t buffer[WORDS];
+        for (size_t i = 0; i < WORDS; i++) {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        memcpy(&value, buffer, sizeof(T));
+        return true;
+    }
+
+    /**
+     * Lee una copia consistente, reintentando mientras haya escrituras
+     */
+    T read() const {
+        T value;
+        while (!tryRead(value)) {
+        }
+        return value;
+    }
+
+    /**
+     * Número de escrituras publicadas (0 si nunca se escribió)
+     */
+    uint32_t getVersion() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+};
+
+#endif // SEQLOCK_H
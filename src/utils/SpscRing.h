@@ -0,0 +1,119 @@
+/*
+Cola circular lock-free:
+
+Un solo productor (timer/tarea de muestreo)
+Un solo consumidor (lectura del sensor)
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing: la capacidad debe ser potencia de 2");
+
+private:
+    static const uint32_t MASK = Capacity - 1;
+
+    T buffer[Capacity];
+    std::atomic<uint32_t> head;     // Escrito solo por el productor
+    std::atomic<uint32_t> tail;     // Escrito solo por el consumidor
+    std::atomic<uint32_t> dropped;  // Elementos descartados por cola llena
+
+public:
+    SpscRing() : head(0), tail(0), dropped(0) {}
+
+    /**
+     * Inserta un elemento (solo productor)
+     * @param item Elemento a insertar
+     * @return false si la cola estaba llena (el elemento se descarta)
+     */
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+
+        if (h - t >= Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer[h & MASK] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Extrae un elemento (solo consumidor)
+     * @param item Referencia donde guardar el elemento
+     * @return false si la cola estaba vacía
+     */
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+
+        if (t == h) {
+            return false;
+        }
+
+        item = buffer[t & MASK];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consume todos los elementos disponibles (solo consumidor)
+     * Los elementos que el productor inserte durante el drenado
+     * quedan para la siguiente llamada.
+     * @param fn Callback invocado con cada elemento, en orden
+     * @return Número de elementos consumidos
+     */
+    template <typename Fn>
+    size_t drain(Fn fn) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        size_t count = h - t;
+
+        while (t != h) {
+            fn(buffer[t & MASK]);
+            t++;
+        }
+
+        tail.store(t, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Número aproximado de elementos en cola
+     */
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Verifica si la cola está vacía
+     */
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    /**
+     * Elementos descartados por cola llena desde el arranque
+     */
+    uint32_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Capacidad total de la cola
+     */
+    static size_t capacity() {
+        return Capacity;
+    }
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,298 @@
+/*
+Codificación binaria compacta de telemetría (canal WebSocket):
+
+Cada muestra: ciclo, timestamp, palabra de estados y campos en punto fijo int16
+Cuadro clave: todos los valores (36 bytes)
+Cuadro delta: máscara de campos que cambiaron y la diferencia de cada uno
+contra la muestra anterior en zigzag + varint (1 byte si |diferencia| < 64)
+Cuadro clave periódico y cada vez que un delta no alcanza (saltos de ciclo
+o de tiempo); el número de secuencia permite al decodificador detectar
+cuadros perdidos y esperar el próximo cuadro clave
+Las diferencias se calculan sobre los valores ya cuantizados: el
+decodificador reproduce exactamente la muestra del codificador
+Todo en little-endian. Decodificador equivalente en data/telemetry.js
+Sin dependencias de Arduino (compilable en host)
+
+Cuadro clave:  tipo(1) seq(1) ciclo(4) timestamp(4) estados(4) campos(2 × N)
+Cuadro delta:  tipo(1) seq(1) Δciclo(1) Δtimestamp(2) máscara(2) varints... [estados(4)]
+*/
+#ifndef TELEMETRYCODEC_H
+#define TELEMETRYCODEC_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TELEMETRY_KEYFRAME 0x4B             // 'K'
+#define TELEMETRY_DELTA 0x44                // 'D'
+#define TELEMETRY_INVALID INT16_MIN         // Lectura no válida (NaN)
+#define TELEMETRY_STATE_CHANGED 0x8000      // Bit de la máscara: cambió la palabra de estados
+
+// Campos en punto fijo (el orden es parte del formato)
+enum TelemetryField : uint8_t {
+    TF_TEMPERATURE,         // 0.01 °C
+    TF_HUMIDITY,            // 0.01 %
+    TF_PRESSURE,            // 0.1 hPa sobre 1000 hPa
+    TF_SMOKE_PPM,           // 1 ppm
+    TF_SMOKE_RAW,           // Cuentas ADC
+    TF_CH4_PPM,             // 1 ppm
+    TF_CH4_LEL,             // 0.01 % LEL
+    TF_CH4_RAW,             // Cuentas ADC
+    TF_FIRE_PROBABILITY,    // 0.001
+    TF_TEMP_RATE,           // 0.01 °C/min
+    TF_PRESSURE_RATE,       // 0.01 hPa/min
+    TELEMETRY_FIELDS
+};
+
+// Palabra de estados (desplazamiento de cada grupo de bits)
+#define TS_ALERT_SHIFT 0            // 4 bits: GlobalAlertLevel publicado
+#define TS_RAW_ALERT_SHIFT 4        // 4 bits: GlobalAlertLevel evaluado
+#define TS_SMOKE_STATE_SHIFT 8      // 3 bits: SmokeState
+#define TS_CH4_STATE_SHIFT 11       // 3 bits: CH4State
+#define TS_ENV_STATE_SHIFT 14       // 4 bits: EnvironmentState
+#define TS_FAST 0x00040000UL        // Muestreo rápido activo
+#define TS_SMOKE_READY 0x00080000UL
+#define TS_CH4_READY 0x00100000UL
+#define TS_ENV_READY 0x00200000UL
+#define TS_SMOKE_RISING 0x00400000UL
+#define TS_CH4_RISING 0x00800000UL
+#define TS_SMOKE_QUALITY 0x01000000UL   // Calidad distinta de OK
+#define TS_CH4_QUALITY 0x02000000UL
+#define TS_ENV_QUALITY 0x04000000UL
+
+#define TELEMETRY_KEYFRAME_SIZE (14 + 2 * TELEMETRY_FIELDS)
+#define TELEMETRY_MAX_FRAME (7 + 3 * TELEMETRY_FIELDS + 4)     // Peor delta (≥ cuadro clave)
+
+// Muestra ya cuantizada
+struct TelemetrySample {
+    uint32_t cycle;
+    uint32_t timestamp;             // ms
+    uint32_t state;                 // Bits TS_*
+    int16_t fields[TELEMETRY_FIELDS];
+};
+
+/**
+ * Valor físico → punto fijo (con saturación; NaN → TELEMETRY_INVALID)
+ * @param value Valor físico
+ * @param scale Unidades por LSB invertidas (p. ej. 100 para 0.01)
+ * @param offset Valor que se codifica como 0
+ */
+inline int16_t telemetryFixed(float value, float scale, float offset = 0.0f) {
+    if (isnan(value)) {
+        return TELEMETRY_INVALID;
+    }
+    float fixed = roundf((value - offset) * scale);
+    if (fixed > INT16_MAX) return INT16_MAX;
+    if (fixed <= INT16_MIN) return INT16_MIN + 1;
+    return (int16_t)fixed;
+}
+
+class TelemetryEncoder {
+private:
+    TelemetrySample previous;
+    bool hasPrevious;
+    uint8_t sequence;
+    uint16_t sinceKeyframe;
+    uint16_t keyframeInterval;
+
+    static void put16(uint8_t* out, uint16_t value) {
+        out[0] = value & 0xFF;
+        out[1] = value >> 8;
+    }
+
+    static void put32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out[i] = (value >> (8 * i)) & 0xFF;
+        }
+    }
+
+    static size_t putVarint(uint8_t* out, int32_t delta) {
+        uint32_t value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);   // zigzag
+        size_t size = 0;
+        while (value >= 0x80) {
+            out[size++] = (value & 0x7F) | 0x80;
+            value >>= 7;
+        }
+        out[size++] = value;
+        return size;
+    }
+
+    size_t writeKeyframe(const TelemetrySample& sample, uint8_t seq, uint8_t* out) const {
+        out[0] = TELEMETRY_KEYFRAME;
+        out[1] = seq;
+        put32(out + 2, sample.cycle);
+        put32(out + 6, sample.timestamp);
+        put32(out + 10, sample.state);
+        for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+            put16(out + 14 + 2 * i, (uint16_t)sample.fields[i]);
+        }
+        return TELEMETRY_KEYFRAME_SIZE;
+    }
+
+public:
+    /**
+     * @param keyframeEvery Cuadros entre cuadros clave (0 = solo cuando hace falta)
+     */
+    explicit TelemetryEncoder(uint16_t keyframeEvery)
+        : hasPrevious(false), sequence(0), sinceKeyframe(0), keyframeInterval(keyframeEvery) {
+        memset(&previous, 0, sizeof(previous));
+    }
+
+    /**
+     * Codifica una muestra nueva (delta contra la anterior o cuadro clave)
+     * @param sample Muestra cuantizada
+     * @param out Salida (al menos TELEMETRY_MAX_FRAME bytes)
+     * @param keyframe true si se emitió un cuadro clave
+     * @return Bytes escritos
+     */
+    size_t encode(const TelemetrySample& sample, uint8_t* out, bool& keyframe) {
+        uint32_t cycleDelta = sample.cycle - previous.cycle;
+        uint32_t timeDelta = sample.timestamp - previous.timestamp;
+        sequence++;
+
+        keyframe = !hasPrevious || cycleDelta == 0 || cycleDelta > 0xFF || timeDelta > 0xFFFF ||
+                   (keyframeInterval > 0 && sinceKeyframe + 1 >= keyframeInterval);
+
+        size_t size;
+        if (keyframe) {
+            size = writeKeyframe(sample, sequence, out);
+            sinceKeyframe = 0;
+        } else {
+            out[0] = TELEMETRY_DELTA;
+            out[1] = sequence;
+            out[2] = (uint8_t)cycleDelta;
+            put16(out + 3, (uint16_t)timeDelta);
+            uint16_t mask = sample.state != previous.state ? TELEMETRY_STATE_CHANGED : 0;
+            size = 7;
+            for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+                int32_t delta = (int32_t)sample.fields[i] - previous.fields[i];
+                if (delta != 0) {
+                    mask |= 1 << i;
+                    size += putVarint(out + size, delta);
+                }
+            }
+            if (mask & TELEMETRY_STATE_CHANGED) {
+                put32(out + size, sample.state);
+                size += 4;
+            }
+            put16(out + 5, mask);
+            sinceKeyframe++;
+        }
+
+        previous = sample;
+        hasPrevious = true;
+        return size;
+    }
+
+    /**
+     * Cuadro clave de la última muestra con su misma secuencia
+     * (para un cliente que se une o perdió cuadros; los deltas siguientes le sirven)
+     * @return Bytes escritos, 0 si todavía no hay muestras
+     */
+    size_t encodeKeyframe(uint8_t* out) const {
+        return hasPrevious ? writeKeyframe(previous, sequence, out) : 0;
+    }
+};
+
+class TelemetryDecoder {
+private:
+    TelemetrySample current;
+    bool synced;
+    uint8_t sequence;
+    uint32_t gaps;
+
+    static uint16_t get16(const uint8_t* in) {
+        return in[0] | (in[1] << 8);
+    }
+
+    static uint32_t get32(const uint8_t* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+    }
+
+public:
+    TelemetryDecoder() : synced(false), sequence(0), gaps(0) {
+        memset(&current, 0, sizeof(current));
+    }
+
+    /**
+     * Decodifica un cuadro
+     * @param frame Cuadro recibido
+     * @param size Longitud
+     * @param sample Muestra reconstruida
+     * @return false si el cuadro es inválido o falta el cuadro clave (perdió sincronía)
+     */
+    bool decode(const uint8_t* frame, size_t size, TelemetrySample& sample) {
+        if (size >= TELEMETRY_KEYFRAME_SIZE && frame[0] == TELEMETRY_KEYFRAME) {
+            sequence = frame[1];
+            current.cycle = get32(frame + 2);
+            current.timestamp = get32(frame + 6);
+            current.state = get32(frame + 10);
+            for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+                current.fields[i] = (int16_t)get16(frame + 14 + 2 * i);
+            }
+            synced = true;
+            sample = current;
+            return true;
+        }
+
+        if (size < 7 || frame[0] != TELEMETRY_DELTA) {
+            return false;
+        }
+        if (!synced || frame[1] != (uint8_t)(sequence + 1)) {
+            if (synced) {
+                gaps++;
+            }
+            synced = false;
+            return false;
+        }
+
+        TelemetrySample next = current;
+        uint16_t mask = get16(frame + 5);
+        size_t position = 7;
+        for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+            if (!(mask & (1 << i))) {
+                continue;
+            }
+            uint32_t value = 0;
+            int shift = 0;
+            while (true) {
+                if (position >= size || shift > 28) {
+                    synced = false;
+                    return false;
+                }
+                uint8_t byte = frame[position++];
+                value |= (uint32_t)(byte & 0x7F) << shift;
+                shift += 7;
+                if (!(byte & 0x80)) {
+                    break;
+                }
+            }
+            int32_t delta = (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+            next.fields[i] = (int16_t)(next.fields[i] + delta);
+        }
+        if (mask & TELEMETRY_STATE_CHANGED) {
+            if (position + 4 > size) {
+                synced = false;
+                return false;
+            }
+            next.state = get32(frame + position);
+        }
+
+        next.cycle += frame[2];
+        next.timestamp += get16(frame + 3);
+        sequence = frame[1];
+        current = next;
+        sample = current;
+        return true;
+    }
+
+    /**
+     * Veces que se perdió la sincronía por cuadros faltantes
+     */
+    uint32_t getGaps() const {
+        return gaps;
+    }
+};
+
+#endif // TELEMETRYCODEC_H
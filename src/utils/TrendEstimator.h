@@ -0,0 +1,218 @@
+/*
+Estimador de tendencia por mínimos cuadrados (ventana de tiempo):
+
+Regresión lineal valor = a + b·t sobre las muestras de los últimos N ms
+Sumas acumuladas: O(1) por muestra (amortizado al expulsar las viejas)
+Pendiente, ordenada y varianza residual
+Recalcula las sumas periódicamente para acotar el error de redondeo
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef TRENDESTIMATOR_H
+#define TRENDESTIMATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+template <size_t Capacity>
+class TrendEstimator {
+    static_assert(Capacity >= 3, "TrendEstimator: capacidad mínima 3");
+
+private:
+    // Muestra almacenada (tiempo absoluto para poder recalcular)
+    struct Sample {
+        uint32_t time;
+        float value;
+    };
+
+    Sample samples[Capacity];
+    size_t head;            // Próxima posición de escritura
+    size_t count;           // Muestras dentro de la ventana
+    uint32_t windowMs;
+
+    // Referencias: x = (t - refTime) en segundos, y = valor - refValue
+    uint32_t refTime;
+    float refValue;
+
+    // Sumas de la regresión
+    float sx, sy, sxx, sxy, syy;
+    uint16_t updatesSinceRebase;
+
+    size_t oldestIndex() const {
+        return (head + Capacity - count) % Capacity;
+    }
+
+    void accumulate(const Sample& s, float sign) {
+        float x = (int32_t)(s.time - refTime) / 1000.0f;
+        float y = s.value - refValue;
+        sx += sign * x;
+        sy += sign * y;
+        sxx += sign * x * x;
+        sxy += sign * x * y;
+        syy += sign * y * y;
+    }
+
+    /**
+     * Recalcula las sumas desde el buffer con la muestra más vieja
+     * como referencia (evita la deriva de sumar y restar en float)
+     */
+    void rebase() {
+        sx = sy = sxx = sxy = syy = 0;
+        updatesSinceRebase = 0;
+        if (count == 0) {
+            return;
+        }
+
+        const Sample& oldest = samples[oldestIndex()];
+        refTime = oldest.time;
+        refValue = oldest.value;
+
+        for (size_t i = 0, idx = oldestIndex(); i < count; i++, idx = (idx + 1) % Capacity) {
+            accumulate(samples[idx], 1.0f);
+        }
+    }
+
+    /**
+     * Sumas centradas: Sxx, Sxy, Syy alrededor de la media
+     */
+    void centered(float& cxx, float& cxy, float& cyy) const {
+        float n = (float)count;
+        cxx = sxx - sx * sx / n;
+        cxy = sxy - sx * sy / n;
+        cyy = syy - sy * sy / n;
+    }
+
+public:
+    /**
+     * @param windowLengthMs Ventana de tiempo de la regresión
+     */
+    explicit TrendEstimator(uint32_t windowLengthMs = 60000)
+        : windowMs(windowLengthMs) {
+        reset();
+    }
+
+    /**
+     * Descarta todas las muestras
+     */
+    void reset() {
+        head = 0;
+        count = 0;
+        refTime = 0;
+        refValue = 0;
+        sx = sy = sxx = sxy = syy = 0;
+        updatesSinceRebase = 0;
+    }
+
+    /**
+     * Cambia la longitud de la ventana (aplica desde la próxima muestra)
+     */
+    void setWindow(uint32_t windowLengthMs) {
+        windowMs = windowLengthMs;
+    }
+
+    uint32_t getWindow() const {
+        return windowMs;
+    }
+
+    /**
+     * Agrega una muestra y expulsa las que quedaron fuera de la ventana
+     * @param timeMs Tiempo de la muestra (ms, creciente)
+     * @param value Valor medido
+     */
+    void add(uint32_t timeMs, float value) {
+        if (count == 0) {
+            refTime = timeMs;
+            refValue = value;
+        }
+
+        // Buffer lleno: la más vieja sale aunque siga en la ventana
+        if (count == Capacity) {
+            accumulate(samples[oldestIndex()], -1.0f);
+            count--;
+        }
+
+        samples[head].time = timeMs;
+        samples[head].value = value;
+        head = (head + 1) % Capacity;
+        count++;
+        accumulate(samples[(head + Capacity - 1) % Capacity], 1.0f);
+
+        // Expulsar muestras fuera de la ventana
+        while (count > 1 && (timeMs - samples[oldestIndex()].time) > windowMs) {
+            accumulate(samples[oldestIndex()], -1.0f);
+            count--;
+        }
+
+        if (++updatesSinceRebase >= Capacity) {
+            rebase();
+        }
+    }
+
+    /**
+     * Muestras dentro de la ventana
+     */
+    size_t size() const {
+        return count;
+    }
+
+    /**
+     * Hay suficientes muestras (>= 3) y dispersión en el tiempo
+     */
+    bool isValid() const {
+        if (count < 3) {
+            return false;
+        }
+        float cxx, cxy, cyy;
+        centered(cxx, cxy, cyy);
+        return cxx > 0;
+    }
+
+    /**
+     * Pendiente en unidades por minuto (0 si no es válida)
+     */
+    float slopePerMinute() const {
+        if (!isValid()) {
+            return 0;
+        }
+        float cxx, cxy, cyy;
+        centered(cxx, cxy, cyy);
+        return (cxy / cxx) * 60.0f;
+    }
+
+    /**
+     * Valor ajustado en el instante de la muestra más reciente
+     */
+    float intercept() const {
+        if (count == 0) {
+            return 0;
+        }
+
+        float n = (float)count;
+        float meanX = sx / n;
+        float meanY = sy / n;
+        const Sample& newest = samples[(head + Capacity - 1) % Capacity];
+
+        if (!isValid()) {
+            return newest.value;
+        }
+
+        float slope = slopePerMinute() / 60.0f;
+        float x = (int32_t)(newest.time - refTime) / 1000.0f;
+        return refValue + meanY + slope * (x - meanX);
+    }
+
+    /**
+     * Varianza de los residuos respecto de la recta (unidades²)
+     */
+    float residualVariance() const {
+        if (!isValid()) {
+            return 0;
+        }
+        float cxx, cxy, cyy;
+        centered(cxx, cxy, cyy);
+        float sse = cyy - (cxy * cxy) / cxx;
+        if (sse < 0) sse = 0;
+        return sse / (float)(count - 2);
+    }
+};
+
+#endif // TRENDESTIMATOR_H
@@ -0,0 +1,66 @@
+/*
+Estadística incremental (algoritmo de Welford):
+
+Media y varianza en una sola pasada, numéricamente estable
+Mínimo y máximo
+Sin dependencias de Arduino (compilable en host)
+*/
+#ifndef WELFORD_H
+#define WELFORD_H
+
+#include <math.h>
+#include <stdint.h>
+
+struct WelfordStats {
+    uint32_t count;     // Muestras acumuladas
+    float mean;         // Media
+    float m2;           // Suma de cuadrados de las diferencias
+    float min;          // Valor mínimo
+    float max;          // Valor máximo
+
+    WelfordStats() { reset(); }
+
+    void reset() {
+        count = 0;
+        mean = 0;
+        m2 = 0;
+        min = INFINITY;
+        max = -INFINITY;
+    }
+
+    /**
+     * Agrega una muestra
+     */
+    void add(float x) {
+        count++;
+        float delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+        includeRange(x, x);
+    }
+
+    /**
+     * Extiende mínimo/máximo sin afectar media ni varianza
+     * (útil cuando cada muestra resume un lote con su propio rango)
+     */
+    void includeRange(float lo, float hi) {
+        if (lo < min) min = lo;
+        if (hi > max) max = hi;
+    }
+
+    /**
+     * Varianza muestral (0 con menos de 2 muestras)
+     */
+    float variance() const {
+        return count > 1 ? m2 / (count - 1) : 0;
+    }
+
+    /**
+     * Desviación estándar muestral
+     */
+    float stddev() const {
+        return sqrtf(variance());
+    }
+};
+
+#endif // WELFORD_H
@@ -0,0 +1,113 @@
+#include "HtmlTemplate.h"
+#include <stdlib.h>
+#include <string.h>
+
+HtmlTemplate::HtmlTemplate()
+    : text(nullptr),
+      textLength(0),
+      segmentCount(0) {
+}
+
+HtmlTemplate::~HtmlTemplate() {
+    free(text);
+}
+
+bool HtmlTemplate::addSegment(size_t offset, size_t length, uint8_t placeholder) {
+    if (segmentCount >= TEMPLATE_MAX_SEGMENTS || offset > 0xFFFF || length > 0xFFFF) {
+        segmentCount = 0;           // Plantilla incompleta: isLoaded() vuelve a false
+        return false;
+    }
+    segments[segmentCount++] = {(uint16_t)offset, (uint16_t)length, placeholder};
+    return true;
+}
+
+bool HtmlTemplate::parse(const char* source, size_t length, const char* const* names, uint8_t nameCount) {
+    free(text);
+    text = (char*)malloc(length > 0 ? length : 1);
+    textLength = 0;
+    segmentCount = 0;
+    if (text == nullptr) {
+        return false;
+    }
+    memcpy(text, source, length);
+    textLength = length;
+
+    size_t literalStart = 0;
+    size_t position = 0;
+    while (position < length) {
+        if (text[position] != '%') {
+            position++;
+            continue;
+        }
+
+        // ¿%NOMBRE% registrado?
+        uint8_t id = TEMPLATE_LITERAL;
+        size_t nameLength = 0;
+        for (uint8_t i = 0; i < nameCount && id == TEMPLATE_LITERAL; i++) {
+            size_t candidate = strlen(names[i]);
+            if (position + candidate + 1 < length && text[position + candidate + 1] == '%' &&
+                memcmp(text + position + 1, names[i], candidate) == 0) {
+                id = i;
+                nameLength = candidate;
+            }
+        }
+        if (id == TEMPLATE_LITERAL) {
+            position++;
+            continue;
+        }
+
+        if (position > literalStart && !addSegment(literalStart, position - literalStart, TEMPLATE_LITERAL)) {
+            return false;
+        }
+        if (!addSegment(0, 0, id)) {
+            return false;
+        }
+        position += nameLength + 2;
+        literalStart = position;
+    }
+
+    if (length > literalStart && !addSegment(literalStart, length - literalStart, TEMPLATE_LITERAL)) {
+        return false;
+    }
+    return true;
+}
+
+size_t HtmlTemplate::render(uint8_t* buffer, size_t maxLength, TemplateCursor& cursor,
+                            const char* const* values) const {
+    size_t written = 0;
+
+    while (written < maxLength && cursor.segment < segmentCount) {
+        const Segment& segment = segments[cursor.segment];
+        const char* source;
+        size_t length;
+        if (segment.placeholder == TEMPLATE_LITERAL) {
+            source = text + segment.offset;
+            length = segment.length;
+        } else {
+            source = values[segment.placeholder] != nullptr ? values[segment.placeholder] : "";
+            length = strlen(source);
+        }
+
+        size_t count = length - cursor.offset;
+        if (count > maxLength - written) {
+            count = maxLength - written;
+        }
+        memcpy(buffer + written, source + cursor.offset, count);
+        written += count;
+        cursor.offset += count;
+
+        if (cursor.offset >= length) {
+            cursor.segment++;
+            cursor.offset = 0;
+        }
+    }
+    return written;
+}
+
+bool HtmlTemplate::isLoaded() const {
+    return text != nullptr && segmentCount > 0;
+}
+
+uint8_t HtmlTemplate::getSegmentCount() const {
+    return segmentCount;
+}
@@ -0,0 +1,73 @@
+/*
+Plantilla HTML precompilada:
+
+El archivo se lee y se analiza una sola vez (al arrancar): queda en memoria
+como una lista de segmentos, texto fijo (rango de bytes) o marcador (ID)
+Solo son marcadores los nombres registrados entre '%' (%SSID%, %IP%...);
+cualquier otro '%' (porcentajes del CSS) es texto fijo
+Render por tramos para respuestas chunked: copia rangos y valores por ID,
+sin String, sin comparar nombres y sin volver a leer LittleFS
+El cursor de cada respuesta guarda dónde quedó el tramo anterior
+Sin dependencias de Arduino (compilable en host); MyWebServer lee el archivo
+*/
+#ifndef HTMLTEMPLATE_H
+#define HTMLTEMPLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TEMPLATE_MAX_SEGMENTS 32    // Segmentos por plantilla (texto fijo + marcadores)
+#define TEMPLATE_LITERAL 0xFF       // Segmento de texto fijo
+
+// Posición de una respuesta en curso
+struct TemplateCursor {
+    uint16_t segment;
+    uint16_t offset;                // Bytes ya enviados del segmento
+};
+
+class HtmlTemplate {
+private:
+    struct Segment {
+        uint16_t offset;            // Inicio en el texto (solo literales)
+        uint16_t length;
+        uint8_t placeholder;        // ID del marcador o TEMPLATE_LITERAL
+    };
+
+    char* text;
+    size_t textLength;
+    Segment segments[TEMPLATE_MAX_SEGMENTS];
+    uint8_t segmentCount;
+
+    bool addSegment(size_t offset, size_t length, uint8_t placeholder);
+
+public:
+    HtmlTemplate();
+    ~HtmlTemplate();
+
+    /**
+     * Analiza una plantilla en memoria (se copia)
+     * @param source Texto de la plantilla
+     * @param length Longitud
+     * @param names Nombres de los marcadores (el índice es el ID)
+     * @param nameCount Cantidad de nombres
+     * @return false si no hay memoria o supera TEMPLATE_MAX_SEGMENTS
+     */
+    bool parse(const char* source, size_t length, const char* const* names, uint8_t nameCount);
+
+    /**
+     * Escribe el próximo tramo de la página
+     * @param buffer Salida
+     * @param maxLength Espacio disponible
+     * @param cursor Posición de esta respuesta (empieza en {0, 0})
+     * @param values Valor de cada marcador por ID (nullptr = vacío)
+     * @return Bytes escritos (0 = página completa)
+     */
+    size_t render(uint8_t* buffer, size_t maxLength, TemplateCursor& cursor,
+                  const char* const* values) const;
+
+    bool isLoaded() const;
+
+    uint8_t getSegmentCount() const;
+};
+
+#endif // HTMLTEMPLATE_H
@@ -0,0 +1,245 @@
+#include "LiveEvents.h"
+#include "ReadingsApi.h"
+#include "../alert/SmartAlert.h"
+#include "../utils/JsonWriter.h"
+
+// Respuesta a los clientes que exceden SSE_MAX_CLIENTS
+static const char BUSY_JSON[] = "{\"error\":\"límite de clientes\"}";
+
+// Inicializar instancia estática
+LiveEvents* LiveEvents::instance = nullptr;
+
+LiveEvents::LiveEvents()
+    : source(nullptr),
+      framesSent(0),
+      framesCoalesced(0),
+      clientsRejected(0) {
+    lock = xSemaphoreCreateMutex();
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        clients[i] = {nullptr, false, false, false};
+    }
+    frame[0] = 0;
+}
+
+LiveEvents* LiveEvents::getInstance() {
+    if (instance == nullptr) {
+        instance = new LiveEvents();
+    }
+    return instance;
+}
+
+void LiveEvents::registerRoutes(AsyncWebServer& server) {
+    if (source != nullptr) {
+        return;
+    }
+
+    source = new AsyncEventSource("/events");
+    source->onConnect([](AsyncEventSourceClient* client) {
+        getInstance()->handleConnect(client);
+    });
+    source->onDisconnect([](AsyncEventSourceClient* client) {
+        getInstance()->handleDisconnect(client);
+    });
+    server.addHandler(source);
+
+    EventBus::getInstance()->subscribe(onAlertTransition, this, TOPIC_ALERT, PRIORITY_NORMAL);
+}
+
+void LiveEvents::handleConnect(AsyncEventSourceClient* client) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    Client* slot = nullptr;
+    for (int i = 0; i < SSE_MAX_CLIENTS && slot == nullptr; i++) {
+        if (clients[i].client == nullptr) {
+            slot = &clients[i];
+        }
+    }
+    if (slot != nullptr) {
+        // Recibe el estado actual en la próxima vuelta de loop
+        *slot = {client, readingsFrame != nullptr, alertFrame != nullptr, false};
+    } else {
+        clientsRejected++;
+    }
+    xSemaphoreGive(lock);
+
+    if (slot == nullptr) {
+        client->send(BUSY_JSON, "busy", 0, SSE_BUSY_RETRY_MS);
+        client->close();
+        if (DEBUG_SERIAL) {
+            Serial.printf("⚠ /events: límite de %d clientes, conexión rechazada\n", SSE_MAX_CLIENTS);
+        }
+    }
+}
+
+void LiveEvents::handleDisconnect(AsyncEventSourceClient* client) {
+    // El servidor libera el cliente al volver de aquí: si loop le está
+    // escribiendo (fuera del mutex), se espera a que termine
+    while (true) {
+        bool sending = false;
+        xSemaphoreTake(lock, portMAX_DELAY);
+        for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+            if (clients[i].client != client) {
+                continue;
+            }
+            if (clients[i].sending) {
+                sending = true;
+            } else {
+                clients[i] = {nullptr, false, false, false};
+            }
+        }
+        xSemaphoreGive(lock);
+        if (!sending) {
+            return;
+        }
+        vTaskDelay(1);
+    }
+}
+
+void LiveEvents::broadcast(const AsyncEvent_SharedData_t& message, bool alert) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    // Último marco de cada tipo: lo reciben los pendientes y los que se conectan
+    (alert ? alertFrame : readingsFrame) = message;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        Client& slot = clients[i];
+        if (slot.client == nullptr) {
+            continue;
+        }
+        // Un marco todavía sin entregar queda reemplazado por el nuevo
+        bool& pending = alert ? slot.alertPending : slot.readingsPending;
+        if (pending) {
+            framesCoalesced++;
+        }
+        pending = true;
+    }
+    xSemaphoreGive(lock);
+
+    service();
+}
+
+void LiveEvents::service() {
+    if (source == nullptr) {
+        return;
+    }
+
+    // Clientes y marcos se copian bajo el mutex; write() se llama sin él
+    // (la tarea de AsyncTCP lo toma al dar de baja clientes)
+    struct Delivery {
+        uint8_t index;
+        AsyncEventSourceClient* client;
+        bool alert;
+        bool readings;
+    };
+    Delivery deliveries[SSE_MAX_CLIENTS];
+    int count = 0;
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    AsyncEvent_SharedData_t alert = alertFrame;
+    AsyncEvent_SharedData_t readings = readingsFrame;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        Client& slot = clients[i];
+        if (slot.client == nullptr || (!slot.alertPending && !slot.readingsPending)) {
+            continue;
+        }
+        slot.sending = true;
+        deliveries[count++] = {(uint8_t)i, slot.client, slot.alertPending, slot.readingsPending};
+    }
+    xSemaphoreGive(lock);
+
+    for (int i = 0; i < count; i++) {
+        Delivery& delivery = deliveries[i];
+        // Una lectura no adelanta a una alerta todavía sin entregar; con la
+        // cola llena la lectura queda pendiente (se envía la última al vaciarse)
+        if (delivery.alert && delivery.client->write(alert)) {
+            delivery.alert = false;
+            framesSent++;
+        }
+        if (delivery.readings && !delivery.alert &&
+            delivery.client->packetsWaiting() < SSE_CLIENT_QUEUE && delivery.client->write(readings)) {
+            delivery.readings = false;
+            framesSent++;
+        }
+    }
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < count; i++) {
+        Client& slot = clients[deliveries[i].index];
+        slot.alertPending = deliveries[i].alert;
+        slot.readingsPending = deliveries[i].readings;
+        slot.sending = false;
+    }
+    xSemaphoreGive(lock);
+}
+
+void LiveEvents::onAlertTransition(const Event& event, void* context) {
+    LiveEvents* events = static_cast<LiveEvents*>(context);
+    if (events->source == nullptr) {
+        return;
+    }
+
+    int header = snprintf(events->frame, sizeof(events->frame), "id: %lu\nevent: alert\n: sent=%lu\ndata: ",
+                          (unsigned long)event.cycle, (unsigned long)millis());
+    JsonWriter json(events->frame + header, sizeof(events->frame) - header - 2);
+    json.beginObject();
+    json.field("cycle", event.cycle);
+    json.field("timestamp", event.timestamp);
+    json.field("from", SmartAlert::getLevelName(event.alert.from));
+    json.field("to", SmartAlert::getLevelName(event.alert.to));
+    json.field("raw", SmartAlert::getLevelName(event.alert.raw));
+    json.field("code", (int)event.alert.to);
+    json.field("features", event.alert.features);
+    json.endObject();
+    if (!json.isComplete()) {
+        return;
+    }
+
+    size_t size = header + json.size();
+    events->frame[size++] = '\n';
+    events->frame[size++] = '\n';
+    events->frame[size] = 0;
+
+    events->broadcast(std::make_shared<String>(events->frame), true);
+}
+
+void LiveEvents::publish(const SensorSnapshot& snapshot) {
+    if (source == nullptr) {
+        return;
+    }
+
+    // Un solo marco por ciclo: las colas de los clientes comparten el mismo String
+    int header = snprintf(frame, sizeof(frame), "id: %lu\nevent: readings\n: sent=%lu\ndata: ",
+                          (unsigned long)snapshot.cycle, (unsigned long)millis());
+    size_t body = ReadingsApi::writeReadings(snapshot, frame + header, sizeof(frame) - header - 2);
+    if (body == 0) {
+        return;
+    }
+
+    size_t size = header + body;
+    frame[size++] = '\n';
+    frame[size++] = '\n';
+    frame[size] = 0;
+
+    broadcast(std::make_shared<String>(frame), false);
+}
+
+uint8_t LiveEvents::getClientCount() {
+    uint8_t count = 0;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        if (clients[i].client != nullptr) {
+            count++;
+        }
+    }
+    xSemaphoreGive(lock);
+    return count;
+}
+
+uint32_t LiveEvents::getFramesSent() const {
+    return framesSent;
+}
+
+uint32_t LiveEvents::getFramesCoalesced() const {
+    return framesCoalesced;
+}
+
+uint32_t LiveEvents::getClientsRejected() const {
+    return clientsRejected;
+}
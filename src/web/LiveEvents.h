@@ -0,0 +1,99 @@
+/*
+Eventos en vivo para pantallas (Server-Sent Events en /events):
+
+Cada ciclo de la tarea de sensores se serializa una sola vez en un marco
+"readings" (mismo JSON que /api/v1/readings) compartido por todos los clientes
+Los cambios del nivel de alerta llegan por el bus de eventos (TOPIC_ALERT)
+como marcos "alert" y salen antes que las lecturas del mismo ciclo
+Contrapresión por cliente: con la cola llena la lectura no se encola, el
+cliente queda pendiente y al vaciarse recibe la última (nunca lecturas viejas)
+Límite de clientes: los excedentes reciben "busy" con un reintento largo
+Cada marco lleva el comentario ": sent=<millis>" (los navegadores lo ignoran)
+para medir la latencia muestra → navegador con tools/sse_latency.py
+*/
+#ifndef LIVEEVENTS_H
+#define LIVEEVENTS_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "../config/Config.h"
+#include "../events/EventBus.h"
+#include "../tasks/SensorTask.h"
+
+class LiveEvents {
+private:
+    static LiveEvents* instance;
+
+    struct Client {
+        AsyncEventSourceClient* client;     // nullptr = libre
+        bool readingsPending;               // Debe recibir el último marco de lecturas
+        bool alertPending;                  // Debe recibir el último marco de alerta
+        bool sending;                       // loop le escribe fuera del mutex (la baja espera)
+    };
+
+    AsyncEventSource* source;
+    SemaphoreHandle_t lock;                 // Tabla de clientes (loop ↔ tarea de AsyncTCP)
+    Client clients[SSE_MAX_CLIENTS];
+    char frame[SSE_FRAME_BUFFER];           // Armado de marcos (solo desde loop)
+    AsyncEvent_SharedData_t readingsFrame;  // Último marco, compartido por las colas
+    AsyncEvent_SharedData_t alertFrame;
+    uint32_t framesSent;
+    uint32_t framesCoalesced;
+    uint32_t clientsRejected;
+
+    LiveEvents(); // Constructor privado
+
+    /**
+     * Suscriptor del bus de eventos (TOPIC_ALERT)
+     */
+    static void onAlertTransition(const Event& event, void* context);
+
+    /**
+     * Alta y baja de clientes (tarea de AsyncTCP)
+     */
+    void handleConnect(AsyncEventSourceClient* client);
+    void handleDisconnect(AsyncEventSourceClient* client);
+
+    /**
+     * Guarda un marco nuevo, lo marca pendiente en todos los clientes y los atiende
+     */
+    void broadcast(const AsyncEvent_SharedData_t& message, bool alert);
+
+public:
+    /**
+     * Obtiene la instancia única de LiveEvents (Singleton)
+     */
+    static LiveEvents* getInstance();
+
+    /**
+     * Registra /events en el servidor y se suscribe a las transiciones de alerta
+     * (desde setup: mismo contexto que EventBus::dispatch)
+     */
+    void registerRoutes(AsyncWebServer& server);
+
+    /**
+     * Serializa y envía una instantánea nueva (una vez por ciclo, desde loop)
+     */
+    void publish(const SensorSnapshot& snapshot);
+
+    /**
+     * Reintenta los clientes pendientes (desde loop, en cada vuelta)
+     */
+    void service();
+
+    /**
+     * Clientes conectados
+     */
+    uint8_t getClientCount();
+
+    /**
+     * Marcos encolados, marcos reemplazados por uno más nuevo y clientes rechazados
+     */
+    uint32_t getFramesSent() const;
+    uint32_t getFramesCoalesced() const;
+    uint32_t getClientsRejected() const;
+};
+
+#endif // LIVEEVENTS_H
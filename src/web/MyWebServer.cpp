@@ -1,17 +1,34 @@
 #include "MyWebServer.h"
 #include "../config/Config.h"
 #include "../utils/Validators.h"
+#include "../trace/TraceRecorder.h"
+#include "ReadingsApi.h"
+#include "LiveEvents.h"
+#include "TelemetrySocket.h"
+#include "StaticAssets.h"
 #include <LittleFS.h>
 #include <WiFi.h>
+#include <memory>
+
+// Nombres de los marcadores de index.html (mismo orden que TemplateValue)
+static const char* const TEMPLATE_NAMES[TPL_COUNT] = {"STATE", "SSID", "IP", "GATEWAY", "SUBNET"};
+
+// Estado de una respuesta de index.html en curso (valores fijados al empezar)
+struct IndexRender {
+    TemplateCursor cursor;
+    char values[TPL_COUNT][TEMPLATE_VALUE_LENGTH];
+    const char* pointers[TPL_COUNT];
+};
 
 // Inicializar instancia estática
 MyWebServer* MyWebServer::instance = nullptr;
 
-MyWebServer::MyWebServer() {
+MyWebServer::MyWebServer() : cacheTime(0), cacheValid(false) {
     server = new AsyncWebServer(WEB_SERVER_PORT);
     wifiManager = WiFiManager::getInstance();
     ledController = LEDController::getInstance();
     fileManager = FileManager::getInstance();
+    memset(cachedValues, 0, sizeof(cachedValues));
 }
 
 MyWebServer* MyWebServer::getInstance() {
@@ -21,29 +38,79 @@ MyWebServer* MyWebServer::getInstance() {
     return instance;
 }
 
-String MyWebServer::processor(const String& var) {
-    MyWebServer* ws = getInstance();
+void MyWebServer::refreshTemplateValues() {
+    if (cacheValid && millis() - cacheTime < TEMPLATE_CACHE_MS) {
+        return;
+    }
     
-    if (var == "STATE") {
-        return ws->ledController->getStateString();
+    snprintf(cachedValues[TPL_SSID], TEMPLATE_VALUE_LENGTH, "%s", wifiManager->getConfig().ssid.c_str());
+    snprintf(cachedValues[TPL_IP], TEMPLATE_VALUE_LENGTH, "%s", wifiManager->getLocalIP().c_str());
+    snprintf(cachedValues[TPL_GATEWAY], TEMPLATE_VALUE_LENGTH, "%s", wifiManager->getGateway().c_str());
+    snprintf(cachedValues[TPL_SUBNET], TEMPLATE_VALUE_LENGTH, "%s", wifiManager->getSubnet().c_str());
+    cacheTime = millis();
+    cacheValid = true;
+}
+
+bool MyWebServer::loadIndexTemplate() {
+    const char* path = "/index.html";
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
     }
-    if (var == "SSID") {
-        return ws->wifiManager->getConfig().ssid;
+    
+    size_t size = file.size();
+    char* source = (char*)malloc(size > 0 ? size : 1);
+    if (source == nullptr) {
+        file.close();
+        return false;
     }
-    if (var == "IP") {
-        return ws->wifiManager->getLocalIP();
+    size_t read = file.read((uint8_t*)source, size);
+    file.close();
+    
+    bool ok = read == size && indexTemplate.parse(source, size, TEMPLATE_NAMES, TPL_COUNT);
+    free(source);
+    
+    if (DEBUG_SERIAL) {
+        if (ok) {
+            Serial.printf("✓ Plantilla %s: %u bytes, %u segmentos\n", path, (unsigned)size,
+                          indexTemplate.getSegmentCount());
+        } else {
+            Serial.printf("❌ Plantilla %s no se pudo preparar\n", path);
+        }
     }
-    if (var == "GATEWAY") {
-        return ws->wifiManager->getGateway();
+    return ok;
+}
+
+void MyWebServer::sendIndex(AsyncWebServerRequest *request) {
+    if (!indexTemplate.isLoaded()) {
+        request->send(LittleFS, "/index.html", "text/html");
+        return;
     }
-    if (var == "SUBNET") {
-        return ws->wifiManager->getSubnet();
+    
+    refreshTemplateValues();
+    
+    // Copia de los valores: la página sale completa con el estado de este pedido
+    std::shared_ptr<IndexRender> render = std::make_shared<IndexRender>();
+    render->cursor = {0, 0};
+    memcpy(render->values, cachedValues, sizeof(cachedValues));
+    snprintf(render->values[TPL_STATE], TEMPLATE_VALUE_LENGTH, "%s", ledController->isOn() ? "ON" : "OFF");
+    for (int i = 0; i < TPL_COUNT; i++) {
+        render->pointers[i] = render->values[i];
     }
     
-    return String();
+    request->send(request->beginChunkedResponse("text/html",
+        [render](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+            return getInstance()->indexTemplate.render(buffer, maxLen, render->cursor, render->pointers);
+        }));
 }
 
 void MyWebServer::setupStationRoutes() {
+    // index.html se analiza una vez; /on y /off la renderan sin releer LittleFS
+    loadIndexTemplate();
+    
+    // Archivos del manifiesto: .gz, ETag y 304 (antes de serveStatic, que atiende el resto)
+    StaticAssets::getInstance()->registerRoutes(*server, "index.html");
+    
     // Servir archivos estáticos (esto ya maneja "/" automáticamente)
     server->serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
     
@@ -51,16 +118,38 @@ void MyWebServer::setupStationRoutes() {
     server->on("/on", HTTP_GET, [](AsyncWebServerRequest *request) {
         MyWebServer* ws = getInstance();
         ws->ledController->turnOn();
-        request->send(LittleFS, "/index.html", "text/html", false, processor);
+        ws->sendIndex(request);
     });
     
     // Apagar LED
     server->on("/off", HTTP_GET, [](AsyncWebServerRequest *request) {
         MyWebServer* ws = getInstance();
         ws->ledController->turnOff();
-        request->send(LittleFS, "/index.html", "text/html", false, processor);
+        ws->sendIndex(request);
+    });
+    
+    // Descargar trazas de sensores (en curso, hasta la última escritura de loop, y anterior)
+    server->on("/trace", HTTP_GET, [](AsyncWebServerRequest *request) {
+        request->send(LittleFS, TRACE_FILE_PATH, "application/octet-stream", true);
     });
     
+    server->on("/trace/old", HTTP_GET, [](AsyncWebServerRequest *request) {
+        if (!LittleFS.exists(TRACE_OLD_FILE_PATH)) {
+            request->send(404, "text/plain", "Sin traza anterior");
+            return;
+        }
+        request->send(LittleFS, TRACE_OLD_FILE_PATH, "application/octet-stream", true);
+    });
+    
+    // API JSON de lecturas y alerta (documentos armados una vez por ciclo)
+    ReadingsApi::getInstance()->registerRoutes(*server);
+    
+    // Lecturas y cambios de alerta en vivo (Server-Sent Events en /events)
+    LiveEvents::getInstance()->registerRoutes(*server);
+    
+    // Telemetría binaria compacta (WebSocket en /ws/telemetry, decodificador en telemetry.js)
+    TelemetrySocket::getInstance()->registerRoutes(*server);
+    
     // Reset configuración WiFi
     server->on("/reset", HTTP_GET, [](AsyncWebServerRequest *request) {
         String html = 
@@ -84,6 +173,7 @@ void MyWebServer::setupStationRoutes() {
 
 void MyWebServer::setupAPRoutes() {
     // Servir página de configuración en la raíz
+    StaticAssets::getInstance()->registerRoutes(*server, "wifimanager.html");
     server->serveStatic("/", LittleFS, "/").setDefaultFile("wifimanager.html");
     
     // Manejar POST del formulario de configuración en /save
@@ -8,6 +8,17 @@
 #include "../wifi/WiFiManager.h"
 #include "../led/LEDController.h"
 #include "../storage/FileManager.h"
+#include "HtmlTemplate.h"
+
+// Marcadores de index.html (el orden es el ID en la plantilla)
+enum TemplateValue : uint8_t {
+    TPL_STATE,
+    TPL_SSID,
+    TPL_IP,
+    TPL_GATEWAY,
+    TPL_SUBNET,
+    TPL_COUNT
+};
 
 class MyWebServer {
 private:
@@ -17,12 +28,29 @@ private:
     LEDController* ledController;
     FileManager* fileManager;
     
+    // index.html precompilada y valores de red cacheados (cambian poco)
+    HtmlTemplate indexTemplate;
+    char cachedValues[TPL_COUNT][TEMPLATE_VALUE_LENGTH];
+    unsigned long cacheTime;
+    bool cacheValid;
+    
     MyWebServer(); // Constructor privado
     
     /**
-     * Procesa placeholders en páginas HTML
+     * Actualiza los valores de red cacheados si vencieron
+     */
+    void refreshTemplateValues();
+    
+    /**
+     * Lee y analiza index.html de LittleFS (una vez, al arrancar)
+     * @return false si no existe o no se pudo preparar (se sirve sin plantilla)
+     */
+    bool loadIndexTemplate();
+    
+    /**
+     * Envía index.html renderada (respuesta chunked)
      */
-    static String processor(const String& var);
+    void sendIndex(AsyncWebServerRequest *request);
     
     /**
      * Configura las rutas para el modo Station (conectado)
@@ -0,0 +1,165 @@
+#include "ReadingsApi.h"
+#include "../utils/JsonWriter.h"
+
+// Respuesta antes del primer ciclo de la tarea de sensores
+static const char NO_DATA_JSON[] = "{\"error\":\"sin datos\"}";
+
+// Inicializar instancia estática
+ReadingsApi* ReadingsApi::instance = nullptr;
+
+ReadingsApi::ReadingsApi() : overflowReported(false) {
+}
+
+ReadingsApi* ReadingsApi::getInstance() {
+    if (instance == nullptr) {
+        instance = new ReadingsApi();
+    }
+    return instance;
+}
+
+/**
+ * Objeto de un sensor de gas
+ */
+template <typename Traits>
+static void writeGas(JsonWriter& json, const char* key, const GasReading<typename Traits::State>& reading,
+                     bool ready, int calibration) {
+    json.beginObject(key);
+    json.field("ready", ready);
+    json.field("state", Traits::stateName(reading.state));
+    json.field("raw", reading.rawValue);
+    json.field("voltage", reading.voltage, 3);
+    json.field("ppm", reading.ppm);
+    json.field("percentage", reading.percentage);
+    json.field("lel", reading.lel, 2);
+    json.field("rising", reading.rising);
+    json.field("quality", (unsigned int)reading.quality);
+    json.field("quality_name", qualityName(reading.quality));
+    json.field("calibration", calibration);
+    json.endObject();
+}
+
+/**
+ * Campos de alerta (comunes a ambos documentos)
+ */
+static void writeAlertFields(JsonWriter& json, const SensorSnapshot& snapshot) {
+    json.field("level", SmartAlert::getLevelName(snapshot.alert));
+    json.field("code", (int)snapshot.alert);
+    json.field("raw_level", SmartAlert::getLevelName(snapshot.rawAlert));
+    json.field("features", snapshot.alertFeatures);
+    json.field("transitions", snapshot.alertTransitions);
+    json.field("fire_probability", snapshot.fireProbability, 3);
+}
+
+size_t ReadingsApi::writeReadings(const SensorSnapshot& snapshot, char* buffer, size_t capacity) {
+    JsonWriter json(buffer, capacity);
+    const EnvironmentReading& env = snapshot.env;
+
+    json.beginObject();
+    json.field("cycle", snapshot.cycle);
+    json.field("timestamp", snapshot.timestamp);
+    json.field("interval_ms", snapshot.sampleIntervalMs);
+    json.field("fast", snapshot.fastSampling);
+
+    json.beginObject("alert");
+    writeAlertFields(json, snapshot);
+    json.endObject();
+
+    writeGas<SmokeTraits>(json, "smoke", snapshot.smoke, snapshot.smokeReady, snapshot.smokeCalibration);
+    writeGas<CH4Traits>(json, "ch4", snapshot.ch4, snapshot.ch4Ready, snapshot.ch4Calibration);
+
+    json.beginObject("env");
+    json.field("ready", snapshot.envReady);
+    json.field("state", EnvironmentSensor::getStateName(env.state));
+    json.field("temperature", env.temperature, 2);
+    json.field("temperature_bmp", env.temperatureBMP, 2);
+    json.field("humidity", env.humidity, 2);
+    json.field("pressure", env.pressure, 2);
+    json.field("altitude", env.altitude, 1);
+    json.field("temp_delta", env.tempDelta, 2);
+    json.field("humidity_delta", env.humidityDelta, 2);
+    json.field("pressure_delta", env.pressureDelta, 2);
+    json.field("temp_rate", env.tempRate, 3);
+    json.field("humidity_rate", env.humidityRate, 3);
+    json.field("pressure_rate", env.pressureRate, 3);
+    json.field("quality", (unsigned int)env.quality);
+    json.field("quality_name", qualityName(env.quality));
+    json.field("calibration", (int)snapshot.envCalibration);
+    json.endObject();
+
+    json.endObject();
+    return json.isComplete() ? json.size() : 0;
+}
+
+size_t ReadingsApi::writeAlert(const SensorSnapshot& snapshot, char* buffer, size_t capacity) {
+    JsonWriter json(buffer, capacity);
+
+    json.beginObject();
+    json.field("cycle", snapshot.cycle);
+    json.field("timestamp", snapshot.timestamp);
+    writeAlertFields(json, snapshot);
+    json.endObject();
+    return json.isComplete() ? json.size() : 0;
+}
+
+template <size_t Capacity>
+bool ReadingsApi::publishDocument(DoubleBuffer<Capacity>& document, const SensorSnapshot& snapshot,
+                                  size_t (*writer)(const SensorSnapshot&, char*, size_t)) {
+    char* buffer = document.beginWrite();
+    if (buffer == nullptr) {
+        return false;
+    }
+
+    size_t size = writer(snapshot, buffer, Capacity);
+    if (size == 0) {
+        if (DEBUG_SERIAL && !overflowReported) {
+            Serial.printf("❌ API: documento JSON mayor que %u bytes\n", (unsigned)Capacity);
+            overflowReported = true;
+        }
+        return false;
+    }
+
+    document.publish(size);
+    return true;
+}
+
+void ReadingsApi::publish(const SensorSnapshot& snapshot) {
+    publishDocument(readings, snapshot, writeReadings);
+    publishDocument(alert, snapshot, writeAlert);
+}
+
+template <size_t Capacity>
+void ReadingsApi::send(AsyncWebServerRequest* request, DoubleBuffer<Capacity>& document) {
+    if (document.getVersion() == 0) {
+        request->send(503, "application/json", (const uint8_t*)NO_DATA_JSON, sizeof(NO_DATA_JSON) - 1);
+        return;
+    }
+
+    // El cuerpo sale por partes directo desde el buffer, retenido hasta
+    // cerrar la conexión (sin copia intermedia del documento)
+    size_t size;
+    uint32_t slot;
+    const char* body = document.acquire(size, slot);
+    request->onDisconnect([&document, slot]() {
+        document.release(slot);
+    });
+    request->send(request->beginResponse("application/json", size,
+        [body, size](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            size_t length = size - index < maxLen ? size - index : maxLen;
+            memcpy(buffer, body + index, length);
+            return length;
+        }));
+}
+
+void ReadingsApi::registerRoutes(AsyncWebServer& server) {
+    server.on("/api/v1/readings", HTTP_GET, [](AsyncWebServerRequest* request) {
+        send(request, getInstance()->readings);
+    });
+
+    server.on("/api/v1/alert", HTTP_GET, [](AsyncWebServerRequest* request) {
+        send(request, getInstance()->alert);
+    });
+}
+
+uint32_t ReadingsApi::getSkipped() const {
+    return readings.getSkipped() + alert.getSkipped();
+}
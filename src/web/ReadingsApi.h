@@ -0,0 +1,80 @@
+/*
+API JSON de lecturas y alerta (/api/v1/readings, /api/v1/alert):
+
+Los documentos se arman una vez por ciclo de la tarea de sensores (desde
+loop, con cada instantánea nueva) en buffers dobles estáticos
+Cada petición envía el buffer publicado tal cual: sin String, sin armar
+JSON y sin memoria propia (solo la que el servidor reserva por conexión)
+El buffer enviado queda retenido hasta que termina la conexión, así una
+publicación nunca pisa una respuesta a medio enviar
+*/
+#ifndef READINGSAPI_H
+#define READINGSAPI_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../config/Config.h"
+#include "../tasks/SensorTask.h"
+#include "../utils/DoubleBuffer.h"
+
+class ReadingsApi {
+private:
+    static ReadingsApi* instance;
+
+    DoubleBuffer<API_READINGS_BUFFER> readings;
+    DoubleBuffer<API_ALERT_BUFFER> alert;
+    bool overflowReported;
+
+    ReadingsApi(); // Constructor privado
+
+    /**
+     * Envía el documento publicado (503 si todavía no hay datos)
+     */
+    template <size_t Capacity>
+    static void send(AsyncWebServerRequest* request, DoubleBuffer<Capacity>& document);
+
+    /**
+     * Arma un documento en el buffer de atrás y lo publica
+     * @return false si el buffer estaba retenido o no alcanzó
+     */
+    template <size_t Capacity>
+    bool publishDocument(DoubleBuffer<Capacity>& document, const SensorSnapshot& snapshot,
+                         size_t (*writer)(const SensorSnapshot&, char*, size_t));
+
+public:
+    /**
+     * Obtiene la instancia única de ReadingsApi (Singleton)
+     */
+    static ReadingsApi* getInstance();
+
+    /**
+     * Registra las rutas de la API en el servidor
+     */
+    void registerRoutes(AsyncWebServer& server);
+
+    /**
+     * Serializa una instantánea nueva (una vez por ciclo, desde loop)
+     */
+    void publish(const SensorSnapshot& snapshot);
+
+    /**
+     * Documento de /api/v1/readings
+     * @param snapshot Instantánea de la tarea de sensores
+     * @param buffer Salida (terminada en 0)
+     * @param capacity Tamaño de la salida
+     * @return Longitud escrita, 0 si no alcanzó el buffer
+     */
+    static size_t writeReadings(const SensorSnapshot& snapshot, char* buffer, size_t capacity);
+
+    /**
+     * Documento de /api/v1/alert (mismo contrato que writeReadings)
+     */
+    static size_t writeAlert(const SensorSnapshot& snapshot, char* buffer, size_t capacity);
+
+    /**
+     * Publicaciones omitidas porque un cliente lento retenía el buffer
+     */
+    uint32_t getSkipped() const;
+};
+
+#endif // READINGSAPI_H
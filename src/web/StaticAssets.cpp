@@ -0,0 +1,183 @@
+#include "StaticAssets.h"
+#include "../storage/FileManager.h"
+#include <LittleFS.h>
+
+// Inicializar instancia estática
+StaticAssets* StaticAssets::instance = nullptr;
+
+StaticAssets::StaticAssets()
+    : assetCount(0),
+      responses(0),
+      gzipResponses(0),
+      notModified(0),
+      bytesSaved(0) {
+}
+
+StaticAssets* StaticAssets::getInstance() {
+    if (instance == nullptr) {
+        instance = new StaticAssets();
+    }
+    return instance;
+}
+
+bool StaticAssets::loadManifest() {
+    FileManager* fileManager = FileManager::getInstance();
+    if (!fileManager->exists(STATIC_MANIFEST_PATH)) {
+        return false;
+    }
+
+    String content = fileManager->readFile(STATIC_MANIFEST_PATH);
+    assetCount = 0;
+    int start = 0;
+
+    while (start < (int)content.length()) {
+        int end = content.indexOf('\n', start);
+        if (end < 0) {
+            end = content.length();
+        }
+        String line = content.substring(start, end);
+        start = end + 1;
+        if (line.length() == 0) {
+            continue;
+        }
+
+        char path[64];
+        char hash[STATIC_HASH_LENGTH + 2];
+        unsigned long size;
+        unsigned long gzipSize;
+        if (sscanf(line.c_str(), "%63s %17s %lu %lu", path, hash, &size, &gzipSize) != 4 ||
+            path[0] != '/' || strlen(path) >= STATIC_PATH_LENGTH || strlen(hash) != STATIC_HASH_LENGTH ||
+            assetCount >= STATIC_MAX_ASSETS) {
+            if (DEBUG_SERIAL) {
+                Serial.printf("❌ %s: línea inválida o demasiados archivos: %s\n", STATIC_MANIFEST_PATH, line.c_str());
+            }
+            assetCount = 0;
+            return false;
+        }
+
+        Asset& asset = assets[assetCount++];
+        strcpy(asset.path, path);
+        strcpy(asset.hash, hash);
+        asset.size = size;
+        asset.gzipSize = gzipSize;
+    }
+    return assetCount > 0;
+}
+
+uint8_t StaticAssets::registerRoutes(AsyncWebServer& server, const char* defaultFile) {
+    if (!loadManifest()) {
+        if (DEBUG_SERIAL) {
+            Serial.println("⚠ Sin manifiesto de recursos web: se sirven sin comprimir ni ETag");
+        }
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < assetCount; i++) {
+        server.on(assets[i].path, HTTP_GET, [i](AsyncWebServerRequest* request) {
+            StaticAssets* self = getInstance();
+            self->handle(request, self->assets[i]);
+        });
+
+        if (strcmp(assets[i].path + 1, defaultFile) == 0) {
+            server.on("/", HTTP_GET, [i](AsyncWebServerRequest* request) {
+                StaticAssets* self = getInstance();
+                self->handle(request, self->assets[i]);
+            });
+        }
+    }
+
+    if (DEBUG_SERIAL) {
+        Serial.printf("✓ Recursos web: %u archivos con ETag\n", assetCount);
+    }
+    return assetCount;
+}
+
+void StaticAssets::handle(AsyncWebServerRequest* request, const Asset& asset) {
+    bool gzip = asset.gzipSize > 0 && acceptsGzip(request);
+
+    // Cada representación tiene su ETag fuerte
+    char etag[STATIC_HASH_LENGTH + 6];
+    snprintf(etag, sizeof(etag), gzip ? "\"%s-gz\"" : "\"%s\"", asset.hash);
+
+    char cacheControl[32];
+    if (isPage(asset.path)) {
+        strcpy(cacheControl, "no-cache");
+    } else {
+        snprintf(cacheControl, sizeof(cacheControl), "max-age=%d", STATIC_MAX_AGE);
+    }
+
+    AsyncWebServerResponse* response;
+    if (matches(request, etag)) {
+        response = request->beginResponse(304);
+        notModified++;
+        bytesSaved += asset.size;
+    } else if (gzip) {
+        response = request->beginResponse(LittleFS, String(asset.path) + ".gz", contentType(asset.path));
+        response->addHeader("Content-Encoding", "gzip");
+        responses++;
+        gzipResponses++;
+        bytesSaved += asset.size - asset.gzipSize;
+    } else {
+        response = request->beginResponse(LittleFS, asset.path, contentType(asset.path));
+        responses++;
+    }
+
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", cacheControl);
+    if (asset.gzipSize > 0) {
+        response->addHeader("Vary", "Accept-Encoding");
+    }
+    request->send(response);
+}
+
+bool StaticAssets::acceptsGzip(AsyncWebServerRequest* request) {
+    const AsyncWebHeader* header = request->getHeader("Accept-Encoding");
+    return header != nullptr && strstr(header->value().c_str(), "gzip") != nullptr;
+}
+
+bool StaticAssets::matches(AsyncWebServerRequest* request, const char* etag) {
+    const AsyncWebHeader* header = request->getHeader("If-None-Match");
+    if (header == nullptr) {
+        return false;
+    }
+    // Lista de ETags (comparación débil: W/"x" también coincide); las comillas
+    // evitan que "hash" coincida con "hash-gz"
+    const char* value = header->value().c_str();
+    return strcmp(value, "*") == 0 || strstr(value, etag) != nullptr;
+}
+
+const char* StaticAssets::contentType(const char* path) {
+    const char* extension = strrchr(path, '.');
+    if (extension == nullptr) {
+        return "application/octet-stream";
+    }
+    if (strcmp(extension, ".html") == 0) return "text/html";
+    if (strcmp(extension, ".css") == 0) return "text/css";
+    if (strcmp(extension, ".js") == 0) return "application/javascript";
+    if (strcmp(extension, ".json") == 0) return "application/json";
+    if (strcmp(extension, ".svg") == 0) return "image/svg+xml";
+    if (strcmp(extension, ".txt") == 0) return "text/plain";
+    if (strcmp(extension, ".png") == 0) return "image/png";
+    if (strcmp(extension, ".ico") == 0) return "image/x-icon";
+    return "application/octet-stream";
+}
+
+bool StaticAssets::isPage(const char* path) {
+    return strcmp(contentType(path), "text/html") == 0;
+}
+
+uint32_t StaticAssets::getResponses() const {
+    return responses;
+}
+
+uint32_t StaticAssets::getGzipResponses() const {
+    return gzipResponses;
+}
+
+uint32_t StaticAssets::getNotModified() const {
+    return notModified;
+}
+
+uint32_t StaticAssets::getBytesSaved() const {
+    return bytesSaved;
+}
@@ -0,0 +1,98 @@
+/*
+Archivos web precomprimidos con ETag (index.html, wifimanager.html, style.css...):
+
+tools/build_static_assets.py deja en la imagen de LittleFS una variante .gz
+de cada archivo de texto y assets.manifest con el hash de su contenido
+Al arrancar se lee el manifiesto y se registra una ruta por archivo:
+- Con Accept-Encoding: gzip se envía el .gz con Content-Encoding
+- ETag fuerte por representación ("hash" o "hash-gz", con Vary)
+- If-None-Match que coincide: 304 sin abrir el archivo
+- Cache-Control: las páginas se revalidan siempre (el 304 es barato),
+  el resto se reusa STATIC_MAX_AGE segundos sin preguntar
+Sin manifiesto (imagen armada sin el script) todo sigue por serveStatic
+*/
+#ifndef STATICASSETS_H
+#define STATICASSETS_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../config/Config.h"
+
+#define STATIC_HASH_LENGTH 16               // Hex del hash en el manifiesto
+
+class StaticAssets {
+private:
+    static StaticAssets* instance;
+
+    struct Asset {
+        char path[STATIC_PATH_LENGTH];
+        char hash[STATIC_HASH_LENGTH + 1];
+        uint32_t size;
+        uint32_t gzipSize;                  // 0 = sin variante .gz
+    };
+
+    Asset assets[STATIC_MAX_ASSETS];
+    uint8_t assetCount;
+    uint32_t responses;
+    uint32_t gzipResponses;
+    uint32_t notModified;
+    uint32_t bytesSaved;                    // Contra enviar siempre el original
+
+    StaticAssets(); // Constructor privado
+
+    /**
+     * Lee STATIC_MANIFEST_PATH
+     * @return false si no existe o tiene líneas inválidas
+     */
+    bool loadManifest();
+
+    /**
+     * Contesta un pedido de un archivo (200 o 304)
+     */
+    void handle(AsyncWebServerRequest* request, const Asset& asset);
+
+    /**
+     * @return true si el cliente acepta gzip
+     */
+    static bool acceptsGzip(AsyncWebServerRequest* request);
+
+    /**
+     * @return true si If-None-Match incluye la ETag (o es "*")
+     */
+    static bool matches(AsyncWebServerRequest* request, const char* etag);
+
+    /**
+     * Tipo MIME por extensión
+     */
+    static const char* contentType(const char* path);
+
+    /**
+     * @return true para páginas HTML (se revalidan en cada carga)
+     */
+    static bool isPage(const char* path);
+
+public:
+    /**
+     * Obtiene la instancia única de StaticAssets (Singleton)
+     */
+    static StaticAssets* getInstance();
+
+    /**
+     * Lee el manifiesto y registra una ruta por archivo
+     * Llamar antes de serveStatic(), que atiende lo que no esté en el manifiesto
+     * @param server Servidor
+     * @param defaultFile Archivo que responde en "/" (sin barra inicial)
+     * @return Cantidad de archivos registrados (0 = sin manifiesto)
+     */
+    uint8_t registerRoutes(AsyncWebServer& server, const char* defaultFile);
+
+    /**
+     * Respuestas completas, de ellas comprimidas, 304 y bytes ahorrados
+     */
+    uint32_t getResponses() const;
+    uint32_t getGzipResponses() const;
+    uint32_t getNotModified() const;
+    uint32_t getBytesSaved() const;
+};
+
+#endif // STATICASSETS_H
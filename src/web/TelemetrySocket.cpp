@@ -0,0 +1,237 @@
+#include "TelemetrySocket.h"
+
+// Inicializar instancia estática
+TelemetrySocket* TelemetrySocket::instance = nullptr;
+
+TelemetrySocket::TelemetrySocket()
+    : socket(nullptr),
+      encoder(TELEMETRY_KEYFRAME_INTERVAL),
+      framesSent(0),
+      bytesSent(0),
+      framesSkipped(0),
+      clientsRejected(0) {
+    lock = xSemaphoreCreateMutex();
+    for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+        clients[i] = {nullptr, false, false};
+    }
+}
+
+TelemetrySocket* TelemetrySocket::getInstance() {
+    if (instance == nullptr) {
+        instance = new TelemetrySocket();
+    }
+    return instance;
+}
+
+void TelemetrySocket::registerRoutes(AsyncWebServer& server) {
+    if (socket != nullptr) {
+        return;
+    }
+
+    socket = new AsyncWebSocket("/ws/telemetry");
+    socket->onEvent([](AsyncWebSocket*, AsyncWebSocketClient* client, AwsEventType type,
+                       void*, uint8_t*, size_t) {
+        getInstance()->handleEvent(client, type);
+    });
+    server.addHandler(socket);
+}
+
+void TelemetrySocket::handleEvent(AsyncWebSocketClient* client, AwsEventType type) {
+    if (type != WS_EVT_CONNECT && type != WS_EVT_DISCONNECT && type != WS_EVT_DATA) {
+        return;
+    }
+
+    if (type == WS_EVT_DISCONNECT) {
+        // El servidor libera el cliente al volver de aquí: si loop le está
+        // escribiendo (fuera del mutex), se espera a que termine
+        while (true) {
+            bool sending = false;
+            xSemaphoreTake(lock, portMAX_DELAY);
+            for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+                if (clients[i].client != client) {
+                    continue;
+                }
+                if (clients[i].sending) {
+                    sending = true;
+                } else {
+                    clients[i] = {nullptr, false, false};
+                }
+            }
+            xSemaphoreGive(lock);
+            if (!sending) {
+                return;
+            }
+            vTaskDelay(1);
+        }
+    }
+
+    bool rejected = false;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (type == WS_EVT_CONNECT) {
+        Client* slot = nullptr;
+        for (int i = 0; i < TELEMETRY_MAX_CLIENTS && slot == nullptr; i++) {
+            if (clients[i].client == nullptr) {
+                slot = &clients[i];
+            }
+        }
+        if (slot != nullptr) {
+            *slot = {client, true, false};
+        } else {
+            rejected = true;
+            clientsRejected++;
+        }
+    } else {
+        // El decodificador perdió la sincronía (o el navegador pide el estado)
+        for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+            if (clients[i].client == client) {
+                clients[i].needsKeyframe = true;
+            }
+        }
+    }
+    xSemaphoreGive(lock);
+
+    if (rejected) {
+        client->close(1013, "Limite de clientes");
+        if (DEBUG_SERIAL) {
+            Serial.printf("⚠ /ws/telemetry: límite de %d clientes, conexión rechazada\n", TELEMETRY_MAX_CLIENTS);
+        }
+    }
+}
+
+bool TelemetrySocket::send(AsyncWebSocketClient* client, const uint8_t* data, size_t size) {
+    if (!client->canSend() || client->queueLen() >= TELEMETRY_CLIENT_QUEUE ||
+        !client->binary(data, size)) {
+        return false;
+    }
+    framesSent++;
+    bytesSent += size;
+    return true;
+}
+
+void TelemetrySocket::deliver(const uint8_t* data, size_t size, bool keyframe) {
+    // Clientes se copian bajo el mutex; binary() se llama sin él
+    // (la tarea de AsyncTCP lo toma al dar de baja clientes)
+    struct Delivery {
+        uint8_t index;
+        AsyncWebSocketClient* client;
+        bool resync;                        // Recibe el cuadro clave en lugar del cuadro
+        bool sent;
+    };
+    Delivery deliveries[TELEMETRY_MAX_CLIENTS];
+    int count = 0;
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < TELEMETRY_MAX_CLIENTS; i++) {
+        Client& slot = clients[i];
+        if (slot.client == nullptr || (data == nullptr && !slot.needsKeyframe)) {
+            continue;
+        }
+        slot.sending = true;
+        deliveries[count++] = {(uint8_t)i, slot.client, slot.needsKeyframe && !keyframe, false};
+        // Un pedido de resincronización que llegue durante el envío se conserva
+        slot.needsKeyframe = false;
+    }
+    xSemaphoreGive(lock);
+
+    uint8_t keyframeData[TELEMETRY_KEYFRAME_SIZE];
+    size_t keyframeSize = 0;
+    for (int i = 0; i < count; i++) {
+        Delivery& delivery = deliveries[i];
+        if (delivery.resync) {
+            if (keyframeSize == 0) {
+                keyframeSize = encoder.encodeKeyframe(keyframeData);
+            }
+            delivery.sent = keyframeSize > 0 && send(delivery.client, keyframeData, keyframeSize);
+        } else {
+            delivery.sent = send(delivery.client, data, size);
+            if (!delivery.sent) {
+                // Delta perdido para este cliente: resincroniza al vaciarse la cola
+                framesSkipped++;
+            }
+        }
+    }
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    for (int i = 0; i < count; i++) {
+        Client& slot = clients[deliveries[i].index];
+        if (!deliveries[i].sent) {
+            slot.needsKeyframe = true;
+        }
+        slot.sending = false;
+    }
+    xSemaphoreGive(lock);
+}
+
+void TelemetrySocket::toSample(const SensorSnapshot& snapshot, TelemetrySample& sample) {
+    const EnvironmentReading& env = snapshot.env;
+
+    sample.cycle = snapshot.cycle;
+    sample.timestamp = snapshot.timestamp;
+
+    sample.fields[TF_TEMPERATURE] = telemetryFixed(env.temperature, 100.0f);
+    sample.fields[TF_HUMIDITY] = telemetryFixed(env.humidity, 100.0f);
+    sample.fields[TF_PRESSURE] = telemetryFixed(env.pressure, 10.0f, 1000.0f);
+    sample.fields[TF_SMOKE_PPM] = telemetryFixed(snapshot.smoke.ppm, 1.0f);
+    sample.fields[TF_SMOKE_RAW] = telemetryFixed(snapshot.smoke.rawValue, 1.0f);
+    sample.fields[TF_CH4_PPM] = telemetryFixed(snapshot.ch4.ppm, 1.0f);
+    sample.fields[TF_CH4_LEL] = telemetryFixed(snapshot.ch4.lel, 100.0f);
+    sample.fields[TF_CH4_RAW] = telemetryFixed(snapshot.ch4.rawValue, 1.0f);
+    sample.fields[TF_FIRE_PROBABILITY] = telemetryFixed(snapshot.fireProbability, 1000.0f);
+    sample.fields[TF_TEMP_RATE] = telemetryFixed(env.tempRate, 100.0f);
+    sample.fields[TF_PRESSURE_RATE] = telemetryFixed(env.pressureRate, 100.0f);
+
+    uint32_t state = ((uint32_t)snapshot.alert << TS_ALERT_SHIFT) |
+                     ((uint32_t)snapshot.rawAlert << TS_RAW_ALERT_SHIFT) |
+                     ((uint32_t)snapshot.smoke.state << TS_SMOKE_STATE_SHIFT) |
+                     ((uint32_t)snapshot.ch4.state << TS_CH4_STATE_SHIFT) |
+                     ((uint32_t)env.state << TS_ENV_STATE_SHIFT);
+    if (snapshot.fastSampling) state |= TS_FAST;
+    if (snapshot.smokeReady) state |= TS_SMOKE_READY;
+    if (snapshot.ch4Ready) state |= TS_CH4_READY;
+    if (snapshot.envReady) state |= TS_ENV_READY;
+    if (snapshot.smoke.rising) state |= TS_SMOKE_RISING;
+    if (snapshot.ch4.rising) state |= TS_CH4_RISING;
+    if (snapshot.smoke.quality != QUALITY_OK) state |= TS_SMOKE_QUALITY;
+    if (snapshot.ch4.quality != QUALITY_OK) state |= TS_CH4_QUALITY;
+    if (env.quality != QUALITY_OK) state |= TS_ENV_QUALITY;
+    sample.state = state;
+}
+
+void TelemetrySocket::publish(const SensorSnapshot& snapshot) {
+    if (socket == nullptr) {
+        return;
+    }
+
+    // Se codifica siempre (aun sin clientes): el delta es contra el ciclo anterior
+    TelemetrySample sample;
+    toSample(snapshot, sample);
+    bool keyframe;
+    size_t size = encoder.encode(sample, frame, keyframe);
+
+    deliver(frame, size, keyframe);
+}
+
+void TelemetrySocket::service() {
+    if (socket == nullptr) {
+        return;
+    }
+
+    deliver(nullptr, 0, false);
+    socket->cleanupClients();
+}
+
+uint32_t TelemetrySocket::getFramesSent() const {
+    return framesSent;
+}
+
+uint32_t TelemetrySocket::getBytesSent() const {
+    return bytesSent;
+}
+
+uint32_t TelemetrySocket::getFramesSkipped() const {
+    return framesSkipped;
+}
+
+uint32_t TelemetrySocket::getClientsRejected() const {
+    return clientsRejected;
+}
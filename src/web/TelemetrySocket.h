@@ -0,0 +1,101 @@
+/*
+Canal binario de telemetría (WebSocket en /ws/telemetry):
+
+Una muestra por ciclo de la tarea de sensores, cuantizada a punto fijo y
+codificada una sola vez (delta contra la anterior, cuadro clave periódico;
+formato en utils/TelemetryCodec.h, decodificador en data/telemetry.js)
+Del orden de 15 bytes por muestra contra ~800 del JSON de /api/v1/readings
+Un cliente que se une, se atrasa (cola llena) o pide resincronizar
+(cualquier mensaje del navegador) recibe un cuadro clave de la última
+muestra y sigue con los deltas compartidos; nunca recibe cuadros viejos
+Límite de clientes: los excedentes se cierran con 1013 (reintentar luego)
+*/
+#ifndef TELEMETRYSOCKET_H
+#define TELEMETRYSOCKET_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "../config/Config.h"
+#include "../tasks/SensorTask.h"
+#include "../utils/TelemetryCodec.h"
+
+class TelemetrySocket {
+private:
+    static TelemetrySocket* instance;
+
+    struct Client {
+        AsyncWebSocketClient* client;       // nullptr = libre
+        bool needsKeyframe;                 // Debe resincronizar con un cuadro clave
+        bool sending;                       // loop le escribe fuera del mutex (la baja espera)
+    };
+
+    AsyncWebSocket* socket;
+    SemaphoreHandle_t lock;                 // Tabla de clientes (loop ↔ tarea de AsyncTCP)
+    Client clients[TELEMETRY_MAX_CLIENTS];
+    TelemetryEncoder encoder;               // Solo desde loop
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    uint32_t framesSent;
+    uint32_t bytesSent;
+    uint32_t framesSkipped;
+    uint32_t clientsRejected;
+
+    TelemetrySocket(); // Constructor privado
+
+    /**
+     * Conexiones, desconexiones y mensajes (tarea de AsyncTCP)
+     */
+    void handleEvent(AsyncWebSocketClient* client, AwsEventType type);
+
+    /**
+     * Envía un cuadro a un cliente si su cola lo permite
+     * @return false si el cliente está atrasado
+     */
+    bool send(AsyncWebSocketClient* client, const uint8_t* data, size_t size);
+
+    /**
+     * Entrega un cuadro a los clientes (los que deben resincronizar reciben
+     * el cuadro clave de la última muestra)
+     * @param data Cuadro codificado, nullptr para solo resincronizar
+     * @param size Tamaño del cuadro
+     * @param keyframe El cuadro ya es un cuadro clave
+     */
+    void deliver(const uint8_t* data, size_t size, bool keyframe);
+
+public:
+    /**
+     * Obtiene la instancia única de TelemetrySocket (Singleton)
+     */
+    static TelemetrySocket* getInstance();
+
+    /**
+     * Registra /ws/telemetry en el servidor
+     */
+    void registerRoutes(AsyncWebServer& server);
+
+    /**
+     * Codifica y envía una instantánea nueva (una vez por ciclo, desde loop)
+     */
+    void publish(const SensorSnapshot& snapshot);
+
+    /**
+     * Resincroniza clientes pendientes y limpia conexiones cerradas (desde loop)
+     */
+    void service();
+
+    /**
+     * Convierte una instantánea a la muestra en punto fijo
+     */
+    static void toSample(const SensorSnapshot& snapshot, TelemetrySample& sample);
+
+    /**
+     * Cuadros y bytes encolados, deltas salteados por clientes atrasados, clientes rechazados
+     */
+    uint32_t getFramesSent() const;
+    uint32_t getBytesSent() const;
+    uint32_t getFramesSkipped() const;
+    uint32_t getClientsRejected() const;
+};
+
+#endif // TELEMETRYSOCKET_H
@@ -6,7 +6,7 @@
 WiFiManager* WiFiManager::instance = nullptr;
 
 WiFiManager::WiFiManager() 
-    : lastCheckTime(0), isConnected(false) {
+    : lastCheckTime(0), isConnected(false), powerSave(true) {
     fileManager = FileManager::getInstance();
     ledController = LEDController::getInstance();
 }
@@ -231,6 +231,19 @@ bool WiFiManager::isWiFiConnected() const {
     return WiFi.status() == WL_CONNECTED;
 }
 
+void WiFiManager::setPowerSave(bool enable) {
+    if (enable == powerSave || WiFi.getMode() != WIFI_STA) {
+        return;
+    }
+    
+    if (WiFi.setSleep(enable)) {
+        powerSave = enable;
+        if (DEBUG_SERIAL) {
+            Serial.println(enable ? "WiFi: ahorro de energía activado" : "WiFi: ahorro de energía desactivado");
+        }
+    }
+}
+
 String WiFiManager::getLocalIP() const {
     return WiFi.localIP().toString();
 }
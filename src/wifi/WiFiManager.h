@@ -32,6 +32,7 @@ private:
     WiFiConfig config;
     unsigned long lastCheckTime;
     bool isConnected;
+    bool powerSave;         // Modem sleep activo (por defecto en modo STA)
     
     WiFiManager(); // Constructor privado
     
@@ -88,6 +89,13 @@ public:
      */
     bool isWiFiConnected() const;
     
+    /**
+     * Activa o desactiva el ahorro de energía de la radio (modem sleep)
+     * Desactivado: menor latencia de red a costa de consumo
+     * @param enable true para permitir que la radio duerma
+     */
+    void setPowerSave(bool enable);
+    
     /**
      * Obtiene la dirección IP local
      * @return String con la IP
@@ -0,0 +1,305 @@
+/*
+Arduino.h para las pruebas en la PC (ver HostSim.h):
+
+String sobre std::string, Serial, tiempo virtual, pines y ADC simulados,
+ESP (heap) y las macros del core que usa src/
+*/
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "HostSim.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x12
+
+#define DEC 10
+#define HEX 16
+
+#define ADC_0db 0
+#define ADC_2_5db 1
+#define ADC_6db 2
+#define ADC_11db 3
+
+#define IRAM_ATTR
+#define F(text) text
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ==================== String ====================
+
+class String {
+private:
+    std::string text;
+
+    static std::string number(long long value, int base) {
+        char buffer[72];
+        if (base == HEX) {
+            snprintf(buffer, sizeof(buffer), "%llx", (unsigned long long)value);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%lld", value);
+        }
+        return buffer;
+    }
+
+    static std::string unsignedNumber(unsigned long long value, int base) {
+        char buffer[72];
+        snprintf(buffer, sizeof(buffer), base == HEX ? "%llx" : "%llu", value);
+        return buffer;
+    }
+
+    static std::string decimal(double value, int decimals) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        return buffer;
+    }
+
+public:
+    String() {}
+    String(const char* value) : text(value != nullptr ? value : "") {}
+    String(const std::string& value) : text(value) {}
+    explicit String(char value) : text(1, value) {}
+    explicit String(unsigned char value, int base = DEC) : text(unsignedNumber(value, base)) {}
+    explicit String(int value, int base = DEC) : text(number(value, base)) {}
+    explicit String(unsigned int value, int base = DEC) : text(unsignedNumber(value, base)) {}
+    explicit String(long value, int base = DEC) : text(number(value, base)) {}
+    explicit String(unsigned long value, int base = DEC) : text(unsignedNumber(value, base)) {}
+    explicit String(float value, int decimals = 2) : text(decimal(value, decimals)) {}
+    explicit String(double value, int decimals = 2) : text(decimal(value, decimals)) {}
+
+    unsigned int length() const { return (unsigned int)text.size(); }
+    bool isEmpty() const { return text.empty(); }
+    const char* c_str() const { return text.c_str(); }
+    bool reserve(unsigned int size) { text.reserve(size); return true; }
+
+    char operator[](unsigned int index) const { return index < text.size() ? text[index] : 0; }
+    char& operator[](unsigned int index) { return text[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    String substring(unsigned int from) const {
+        return from < text.size() ? String(text.substr(from)) : String();
+    }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            unsigned int swap = from;
+            from = to;
+            to = swap;
+        }
+        if (from >= text.size()) {
+            return String();
+        }
+        return String(text.substr(from, to - from));
+    }
+
+    int indexOf(char value, unsigned int from = 0) const {
+        size_t position = text.find(value, from);
+        return position == std::string::npos ? -1 : (int)position;
+    }
+    int indexOf(const String& value, unsigned int from = 0) const {
+        size_t position = text.find(value.text, from);
+        return position == std::string::npos ? -1 : (int)position;
+    }
+    int lastIndexOf(char value) const {
+        size_t position = text.rfind(value);
+        return position == std::string::npos ? -1 : (int)position;
+    }
+
+    bool startsWith(const String& prefix) const { return text.compare(0, prefix.text.size(), prefix.text) == 0; }
+    bool endsWith(const String& suffix) const {
+        return text.size() >= suffix.text.size() &&
+               text.compare(text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0;
+    }
+    bool equals(const String& other) const { return text == other.text; }
+
+    // Como el core: número inicial, 0 si no hay
+    long toInt() const { return atol(text.c_str()); }
+    float toFloat() const { return (float)atof(text.c_str()); }
+
+    void trim() {
+        size_t first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            text.clear();
+            return;
+        }
+        size_t last = text.find_last_not_of(" \t\r\n");
+        text = text.substr(first, last - first + 1);
+    }
+    void toLowerCase() {
+        for (char& c : text) c = (char)tolower((unsigned char)c);
+    }
+    void toUpperCase() {
+        for (char& c : text) c = (char)toupper((unsigned char)c);
+    }
+    void replace(const String& from, const String& to) {
+        if (from.text.empty()) {
+            return;
+        }
+        size_t position = 0;
+        while ((position = text.find(from.text, position)) != std::string::npos) {
+            text.replace(position, from.text.size(), to.text);
+            position += to.text.size();
+        }
+    }
+    void toCharArray(char* buffer, unsigned int size) const {
+        if (size == 0) {
+            return;
+        }
+        strncpy(buffer, text.c_str(), size - 1);
+        buffer[size - 1] = '\0';
+    }
+
+    bool concat(const String& other) { text += other.text; return true; }
+    String& operator+=(const String& other) { text += other.text; return *this; }
+    String& operator+=(const char* other) { text += other; return *this; }
+    String& operator+=(char value) { text += value; return *this; }
+    String& operator+=(int value) { text += number(value, DEC); return *this; }
+    String& operator+=(unsigned int value) { text += unsignedNumber(value, DEC); return *this; }
+    String& operator+=(long value) { text += number(value, DEC); return *this; }
+    String& operator+=(unsigned long value) { text += unsignedNumber(value, DEC); return *this; }
+
+    bool operator==(const String& other) const { return text == other.text; }
+    bool operator==(const char* other) const { return text == (other != nullptr ? other : ""); }
+    bool operator!=(const String& other) const { return text != other.text; }
+    bool operator!=(const char* other) const { return !(*this == other); }
+    bool operator<(const String& other) const { return text < other.text; }
+
+    const std::string& str() const { return text; }
+};
+
+inline String operator+(const String& a, const String& b) { return String(a.str() + b.str()); }
+inline String operator+(const String& a, const char* b) { return String(a.str() + b); }
+inline String operator+(const char* a, const String& b) { return String(a + b.str()); }
+inline String operator+(const String& a, char b) { return String(a.str() + b); }
+inline String operator+(const String& a, int b) { return a + String(b); }
+inline String operator+(const String& a, unsigned int b) { return a + String(b); }
+inline String operator+(const String& a, long b) { return a + String(b); }
+inline String operator+(const String& a, unsigned long b) { return a + String(b); }
+inline String operator+(const String& a, float b) { return a + String(b); }
+inline String operator+(const String& a, double b) { return a + String(b); }
+
+// ==================== Print / Serial ====================
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+
+    size_t write(uint8_t value) { return write(&value, 1); }
+    size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text) { return write((const uint8_t*)text.c_str(), text.length()); }
+    size_t print(char value) { return write((uint8_t)value); }
+    size_t print(unsigned char value, int base = DEC) { return print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char buffer[512];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (length < 0) {
+            return 0;
+        }
+        return write((const uint8_t*)buffer, (size_t)length < sizeof(buffer) ? length : sizeof(buffer) - 1);
+    }
+};
+
+class HardwareSerial : public Print {
+public:
+    using Print::write;
+
+    void begin(unsigned long) {}
+    void end() {}
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    void flush() {}
+    String readStringUntil(char) { return String(); }
+    size_t write(const uint8_t* data, size_t length) override {
+        HostSim::serialWrite((const char*)data, length);
+        return length;
+    }
+    operator bool() const { return true; }
+};
+
+inline HardwareSerial Serial;
+
+// ==================== Tiempo (virtual) ====================
+
+inline unsigned long millis() { return (unsigned long)(HostSim::nowUs / 1000); }
+inline unsigned long micros() { return (unsigned long)HostSim::nowUs; }
+inline void delay(unsigned long ms) { HostSim::advanceUs((uint64_t)ms * 1000); }
+inline void delayMicroseconds(unsigned int us) { HostSim::advanceUs(us); }
+inline void yield() {}
+
+// ==================== Pines y ADC ====================
+
+inline void pinMode(uint8_t pin, uint8_t mode) {
+    HostSim::setPin(pin, mode, -1);
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value) {
+    HostSim::setPin(pin, -1, value);
+}
+
+inline int digitalRead(uint8_t pin) {
+    if (pin >= HOST_PIN_COUNT) {
+        return LOW;
+    }
+    // Entrada con pull-up (o salida en alto): la línea la decide quien la tire a bajo
+    return HostSim::lineLevel(pin, HIGH);
+}
+
+inline int analogRead(uint8_t pin) { return HostSim::adc(pin); }
+inline void analogReadResolution(uint8_t) {}
+inline void analogSetAttenuation(int) {}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ==================== ESP ====================
+
+class EspClass {
+public:
+    uint32_t getHeapSize() { return HOST_HEAP_SIZE; }
+    uint32_t getFreeHeap() {
+        return HostSim::heapInUse < HOST_HEAP_SIZE ? (uint32_t)(HOST_HEAP_SIZE - HostSim::heapInUse) : 0;
+    }
+    uint32_t getMinFreeHeap() {
+        return HostSim::heapPeak < HOST_HEAP_SIZE ? (uint32_t)(HOST_HEAP_SIZE - HostSim::heapPeak) : 0;
+    }
+    uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+    void restart() { HostSim::restarted = true; }
+};
+
+inline EspClass ESP;
+
+#endif // Arduino_h
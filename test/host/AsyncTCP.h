@@ -0,0 +1,10 @@
+/*
+AsyncTCP para las pruebas en la PC: sin red (ESPAsyncWebServer.h modela
+las conexiones)
+*/
+#ifndef ASYNCTCP_H_
+#define ASYNCTCP_H_
+
+#include "Arduino.h"
+
+#endif // ASYNCTCP_H_
@@ -0,0 +1,376 @@
+/*
+ESPAsyncWebServer para las pruebas en la PC: modelo funcional de lo que usan
+ReadingsApi y TelemetrySocket
+
+HTTP: el servidor guarda las rutas; la prueba crea una petición con
+request(), la respuesta se "transmite" por partes con transmit() (como los
+segmentos TCP de AsyncTCP) y close() la termina: se llaman los manejadores
+onDisconnect() y se liberan petición y respuesta, como en la librería
+WebSocket: connect()/receive()/disconnect() generan los eventos; binary()
+encola el mensaje del cliente (límite de cola como WS_MAX_QUEUED_MESSAGES)
+y drain() lo entrega a la prueba; close() marca el cliente y
+cleanupClients() da de baja los cerrados
+*/
+#ifndef _ESPAsyncWebServer_H_
+#define _ESPAsyncWebServer_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "FS.h"
+#include "AsyncTCP.h"
+
+#define WS_MAX_QUEUED_MESSAGES 32
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111
+} WebRequestMethod;
+
+class AsyncWebServerRequest;
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(void)> ArDisconnectHandler;
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+
+// ==================== Respuestas ====================
+
+class AsyncWebServerResponse {
+protected:
+    int code;
+    std::string contentType;
+    size_t contentLength;
+    size_t sent;
+
+public:
+    AsyncWebServerResponse(int status, const char* type, size_t length)
+        : code(status), contentType(type != nullptr ? type : ""), contentLength(length), sent(0) {}
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode(int status) { code = status; }
+    void addHeader(const char*, const char*) {}
+    void addHeader(const String&, const String&) {}
+
+    int getCode() const { return code; }
+    const std::string& getContentType() const { return contentType; }
+    size_t getContentLength() const { return contentLength; }
+    bool finished() const { return sent >= contentLength; }
+
+    /**
+     * Siguiente parte del cuerpo (modelo de la pila TCP)
+     * @return Bytes escritos en buffer (0 = terminado)
+     */
+    virtual size_t fill(uint8_t* buffer, size_t maxLen) = 0;
+};
+
+// Cuerpo desde memoria del llamador (sin copia, como AsyncProgmemResponse)
+class AsyncProgmemResponse : public AsyncWebServerResponse {
+private:
+    const uint8_t* content;
+
+public:
+    AsyncProgmemResponse(int status, const char* type, const uint8_t* data, size_t length)
+        : AsyncWebServerResponse(status, type, length), content(data) {}
+
+    size_t fill(uint8_t* buffer, size_t maxLen) override {
+        size_t count = contentLength - sent < maxLen ? contentLength - sent : maxLen;
+        memcpy(buffer, content + sent, count);
+        sent += count;
+        return count;
+    }
+};
+
+// Cuerpo copiado (send() con String)
+class AsyncBasicResponse : public AsyncWebServerResponse {
+private:
+    std::string content;
+
+public:
+    AsyncBasicResponse(int status, const char* type, const String& text)
+        : AsyncWebServerResponse(status, type, text.length()), content(text.c_str(), text.length()) {}
+
+    size_t fill(uint8_t* buffer, size_t maxLen) override {
+        size_t count = contentLength - sent < maxLen ? contentLength - sent : maxLen;
+        memcpy(buffer, content.data() + sent, count);
+        sent += count;
+        return count;
+    }
+};
+
+// Cuerpo de longitud conocida producido por un callback
+class AsyncCallbackResponse : public AsyncWebServerResponse {
+private:
+    AwsResponseFiller filler;
+
+public:
+    AsyncCallbackResponse(const char* type, size_t length, AwsResponseFiller callback)
+        : AsyncWebServerResponse(200, type, length), filler(callback) {}
+
+    size_t fill(uint8_t* buffer, size_t maxLen) override {
+        if (finished()) {
+            return 0;
+        }
+        size_t count = filler(buffer, maxLen, sent);
+        sent += count;
+        return count;
+    }
+};
+
+// ==================== Peticiones ====================
+
+class AsyncWebServerRequest {
+private:
+    std::string requestUrl;
+    WebRequestMethod requestMethod;
+    AsyncWebServerResponse* response;
+    std::vector<ArDisconnectHandler> disconnectHandlers;
+
+public:
+    AsyncWebServerRequest(const char* url, WebRequestMethod method)
+        : requestUrl(url), requestMethod(method), response(nullptr) {}
+
+    // Fin de la conexión: manejadores y liberación, como la librería
+    ~AsyncWebServerRequest() {
+        for (ArDisconnectHandler& handler : disconnectHandlers) {
+            handler();
+        }
+        delete response;
+    }
+
+    String url() const { return String(requestUrl); }
+    WebRequestMethod method() const { return requestMethod; }
+
+    void onDisconnect(ArDisconnectHandler handler) { disconnectHandlers.push_back(handler); }
+
+    void send(AsyncWebServerResponse* next) {
+        delete response;
+        response = next;
+    }
+
+    void send(int code, const char* type, const uint8_t* content, size_t length) {
+        send(new AsyncProgmemResponse(code, type, content, length));
+    }
+
+    void send(int code, const char* type = "", const String& content = String()) {
+        send(new AsyncBasicResponse(code, type, content));
+    }
+
+    AsyncWebServerResponse* beginResponse(const char* type, size_t length, AwsResponseFiller callback) {
+        return new AsyncCallbackResponse(type, length, callback);
+    }
+
+    AsyncWebServerResponse* beginResponse(int code, const char* type, const uint8_t* content, size_t length) {
+        return new AsyncProgmemResponse(code, type, content, length);
+    }
+
+    AsyncWebServerResponse* beginResponse(int code, const char* type = "", const String& content = String()) {
+        return new AsyncBasicResponse(code, type, content);
+    }
+
+    // ==================== Modelo ====================
+
+    AsyncWebServerResponse* getResponse() const { return response; }
+
+    /**
+     * Siguiente segmento de la respuesta
+     * @return Bytes escritos (0 = sin respuesta o terminada)
+     */
+    size_t transmit(uint8_t* buffer, size_t maxLen) {
+        return response != nullptr ? response->fill(buffer, maxLen) : 0;
+    }
+};
+
+// ==================== Manejadores y servidor ====================
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest*) const { return false; }
+    virtual void handleRequest(AsyncWebServerRequest*) {}
+};
+
+class AsyncWebServer {
+private:
+    struct Route {
+        std::string url;
+        WebRequestMethod method;
+        ArRequestHandlerFunction handler;
+    };
+
+    std::vector<Route> routes;
+    std::vector<AsyncWebHandler*> handlers;
+
+public:
+    explicit AsyncWebServer(uint16_t) {}
+
+    void on(const char* url, WebRequestMethod method, ArRequestHandlerFunction handler) {
+        routes.push_back({url, method, handler});
+    }
+
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler) {
+        handlers.push_back(handler);
+        return *handler;
+    }
+
+    void begin() {}
+    void end() {}
+
+    // ==================== Modelo ====================
+
+    const std::vector<AsyncWebHandler*>& getHandlers() const { return handlers; }
+
+    /**
+     * Nueva petición atendida por la ruta registrada (la prueba la libera con close())
+     * @return nullptr si ninguna ruta la atiende
+     */
+    AsyncWebServerRequest* request(const char* url, WebRequestMethod method = HTTP_GET) {
+        for (Route& route : routes) {
+            if (route.url == url && (route.method & method)) {
+                AsyncWebServerRequest* request = new AsyncWebServerRequest(url, method);
+                route.handler(request);
+                return request;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Fin de la conexión (terminada o cortada por el cliente)
+     */
+    void close(AsyncWebServerRequest* request) { delete request; }
+};
+
+// ==================== WebSocket ====================
+
+typedef enum {
+    WS_EVT_CONNECT,
+    WS_EVT_DISCONNECT,
+    WS_EVT_PING,
+    WS_EVT_PONG,
+    WS_EVT_ERROR,
+    WS_EVT_DATA
+} AwsEventType;
+
+typedef std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                           void* arg, uint8_t* data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocketClient {
+private:
+    friend class AsyncWebSocket;
+
+    uint32_t clientId;
+    std::vector<std::vector<uint8_t>> queue;
+    bool closed;
+    uint16_t closeCode;
+
+public:
+    explicit AsyncWebSocketClient(uint32_t id) : clientId(id), closed(false), closeCode(0) {}
+
+    uint32_t id() const { return clientId; }
+
+    bool canSend() const { return !closed && queue.size() < WS_MAX_QUEUED_MESSAGES; }
+
+    size_t queueLen() const { return queue.size(); }
+
+    bool binary(const uint8_t* data, size_t length) {
+        if (!canSend()) {
+            return false;
+        }
+        queue.emplace_back(data, data + length);
+        return true;
+    }
+
+    void close(uint16_t code = 0, const char* = nullptr) {
+        closed = true;
+        closeCode = code;
+    }
+
+    // ==================== Modelo ====================
+
+    bool isClosed() const { return closed; }
+
+    uint16_t getCloseCode() const { return closeCode; }
+
+    /**
+     * Mensajes transmitidos desde la última llamada (vacía la cola)
+     */
+    std::vector<std::vector<uint8_t>> drain() {
+        std::vector<std::vector<uint8_t>> sent;
+        sent.swap(queue);
+        return sent;
+    }
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+private:
+    std::string socketUrl;
+    AwsEventHandler handler;
+    std::vector<AsyncWebSocketClient*> clients;
+    uint32_t nextId;
+
+public:
+    explicit AsyncWebSocket(const char* url) : socketUrl(url), nextId(1) {}
+
+    ~AsyncWebSocket() {
+        for (AsyncWebSocketClient* client : clients) {
+            delete client;
+        }
+    }
+
+    void onEvent(AwsEventHandler eventHandler) { handler = eventHandler; }
+
+    size_t count() const { return clients.size(); }
+
+    void cleanupClients(uint16_t = 8) {
+        for (size_t i = 0; i < clients.size();) {
+            if (clients[i]->isClosed()) {
+                disconnect(clients[i]);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // ==================== Modelo ====================
+
+    const char* url() const { return socketUrl.c_str(); }
+
+    AsyncWebSocketClient* connect() {
+        AsyncWebSocketClient* client = new AsyncWebSocketClient(nextId++);
+        clients.push_back(client);
+        if (handler) {
+            handler(this, client, WS_EVT_CONNECT, nullptr, nullptr, 0);
+        }
+        return client;
+    }
+
+    void receive(AsyncWebSocketClient* client, const uint8_t* data, size_t length) {
+        if (handler) {
+            handler(this, client, WS_EVT_DATA, nullptr, (uint8_t*)data, length);
+        }
+    }
+
+    void disconnect(AsyncWebSocketClient* client) {
+        for (size_t i = 0; i < clients.size(); i++) {
+            if (clients[i] == client) {
+                clients.erase(clients.begin() + i);
+                if (handler) {
+                    handler(this, client, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+                }
+                delete client;
+                return;
+            }
+        }
+    }
+};
+
+#endif // _ESPAsyncWebServer_H_
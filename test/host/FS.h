@@ -0,0 +1,270 @@
+/*
+FS.h para las pruebas en la PC: sistema de archivos en memoria
+
+Archivos planos por ruta completa (como LittleFS); "/" se lista con
+openNextFile()
+Modos "r", "w" (trunca) y "a" (agrega); File es un Print con lectura
+Capacidad configurable: escribir más allá devuelve menos bytes (flash llena)
+*/
+#ifndef FS_H
+#define FS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+#define HOST_FS_CAPACITY 1441792        // Partición default.csv (1.375 MB)
+
+namespace fs {
+
+class FS;
+
+class File : public Print {
+private:
+    friend class FS;
+
+    FS* owner;
+    std::string filePath;
+    std::shared_ptr<std::string> content;
+    size_t cursor;
+    bool writable;
+    bool directory;
+    std::vector<std::string> listing;   // Directorio: rutas pendientes
+    size_t listIndex;
+
+    size_t store(const uint8_t* data, size_t length);
+
+public:
+    File() : owner(nullptr), cursor(0), writable(false), directory(false), listIndex(0) {}
+
+    operator bool() const { return content != nullptr || directory; }
+
+    using Print::write;
+
+    size_t write(const uint8_t* data, size_t length) override {
+        if (!writable || content == nullptr) {
+            return 0;
+        }
+        return store(data, length);
+    }
+
+    size_t read(uint8_t* buffer, size_t length) {
+        if (content == nullptr || cursor >= content->size()) {
+            return 0;
+        }
+        size_t count = content->size() - cursor < length ? content->size() - cursor : length;
+        memcpy(buffer, content->data() + cursor, count);
+        cursor += count;
+        return count;
+    }
+
+    int read() {
+        uint8_t value;
+        return read(&value, 1) == 1 ? value : -1;
+    }
+
+    int peek() {
+        return (content != nullptr && cursor < content->size()) ? (uint8_t)(*content)[cursor] : -1;
+    }
+
+    int available() {
+        return content != nullptr ? (int)(content->size() - cursor) : 0;
+    }
+
+    String readString() {
+        if (content == nullptr || cursor >= content->size()) {
+            return String();
+        }
+        String text(content->substr(cursor));
+        cursor = content->size();
+        return text;
+    }
+
+    String readStringUntil(char terminator) {
+        std::string text;
+        int value;
+        while ((value = read()) >= 0 && value != terminator) {
+            text += (char)value;
+        }
+        return String(text);
+    }
+
+    bool seek(uint32_t position) {
+        if (content == nullptr || position > content->size()) {
+            return false;
+        }
+        cursor = position;
+        return true;
+    }
+
+    size_t position() const { return cursor; }
+
+    size_t size() const { return content != nullptr ? content->size() : 0; }
+
+    void flush() {}
+
+    void close() {
+        content.reset();
+        directory = false;
+        listing.clear();
+    }
+
+    const char* path() const { return filePath.c_str(); }
+
+    const char* name() const {
+        size_t slash = filePath.rfind('/');
+        return slash == std::string::npos ? filePath.c_str() : filePath.c_str() + slash + 1;
+    }
+
+    bool isDirectory() const { return directory; }
+
+    File openNextFile();
+};
+
+class FS {
+private:
+    friend class File;
+
+    std::map<std::string, std::shared_ptr<std::string>> files;
+    bool mounted;
+
+public:
+    size_t capacity;                    // Bytes disponibles para datos
+    bool failMount;                     // begin() falla (flash sin formato)
+
+    FS() : mounted(false), capacity(HOST_FS_CAPACITY), failMount(false) {}
+
+    bool begin(bool formatOnFail = false, const char* = "/littlefs", uint8_t = 10, const char* = nullptr) {
+        if (failMount && !formatOnFail) {
+            return false;
+        }
+        if (failMount) {
+            files.clear();
+            failMount = false;
+        }
+        mounted = true;
+        return true;
+    }
+
+    void end() { mounted = false; }
+
+    bool format() {
+        files.clear();
+        return true;
+    }
+
+    size_t totalBytes() const { return capacity; }
+
+    size_t usedBytes() const {
+        size_t used = 0;
+        for (const auto& entry : files) {
+            used += entry.second->size();
+        }
+        return used;
+    }
+
+    File open(const char* path, const char* mode = "r", bool create = false) {
+        File file;
+        if (path == nullptr) {
+            return file;
+        }
+        std::string name(path);
+
+        if (name == "/") {
+            file.owner = this;
+            file.filePath = name;
+            file.directory = true;
+            for (const auto& entry : files) {
+                file.listing.push_back(entry.first);
+            }
+            return file;
+        }
+
+        auto found = files.find(name);
+        bool writing = mode != nullptr && (mode[0] == 'w' || mode[0] == 'a');
+        if (found == files.end()) {
+            if (!writing && !create) {
+                return file;
+            }
+            found = files.emplace(name, std::make_shared<std::string>()).first;
+        }
+
+        file.owner = this;
+        file.filePath = name;
+        file.content = found->second;
+        file.writable = writing;
+        if (mode != nullptr && mode[0] == 'w') {
+            file.content->clear();
+        }
+        if (mode != nullptr && mode[0] == 'a') {
+            file.cursor = file.content->size();
+        }
+        return file;
+    }
+
+    File open(const String& path, const char* mode = "r", bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+
+    bool exists(const char* path) const { return path != nullptr && files.count(path) > 0; }
+
+    bool exists(const String& path) const { return exists(path.c_str()); }
+
+    bool remove(const char* path) { return path != nullptr && files.erase(path) > 0; }
+
+    bool remove(const String& path) { return remove(path.c_str()); }
+
+    bool rename(const char* from, const char* to) {
+        auto found = files.find(from);
+        if (found == files.end()) {
+            return false;
+        }
+        std::shared_ptr<std::string> content = found->second;
+        files.erase(found);
+        files[to] = content;
+        return true;
+    }
+
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+    bool mkdir(const char*) { return true; }
+
+    /**
+     * Contenido de un archivo (para las verificaciones de las pruebas)
+     */
+    std::string contents(const char* path) const {
+        auto found = files.find(path);
+        return found != files.end() ? *found->second : std::string();
+    }
+};
+
+inline size_t File::store(const uint8_t* data, size_t length) {
+    size_t used = owner->usedBytes();
+    size_t room = used < owner->capacity ? owner->capacity - used : 0;
+    size_t count = length < room ? length : room;
+
+    // Escritura desde la posición actual (sobrescribe o extiende)
+    if (cursor + count > content->size()) {
+        content->resize(cursor + count);
+    }
+    memcpy(&(*content)[cursor], data, count);
+    cursor += count;
+    return count;
+}
+
+inline File File::openNextFile() {
+    File next;
+    if (!directory || owner == nullptr || listIndex >= listing.size()) {
+        return next;
+    }
+    return owner->open(listing[listIndex++].c_str(), "r");
+}
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // FS_H
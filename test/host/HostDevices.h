@@ -0,0 +1,388 @@
+/*
+Modelos de AHT20 y BMP280 para el bus simulado de Wire.h:
+
+Implementados desde los datasheets, independientes de los drivers de src/
+(los valores crudos salen de fórmulas propias, no de convert()/compensate())
+
+HostAHT20: estado (ocupado 80 ms tras 0xAC 33 00, calibrado), resultado de
+7 bytes con CRC-8 (polinomio 0x31, inicial 0xFF)
+HostBMP280: mapa de registros (ID 0x58 en 0xD0, calibración en 0x88-0x9F,
+ctrl_meas/config, datos en 0xF7-0xFC) con puntero autoincremental; en
+modo normal los datos siguen a las condiciones fijadas por la prueba
+
+Ruido de unos LSB por medición (un sensor vivo nunca repite la trama) y
+fallas del propio dispositivo: CRC incorrecto, lecturas cortas, trama
+congelada, ocupado para siempre, pérdida de configuración (reset)
+*/
+#ifndef HOSTDEVICES_H
+#define HOSTDEVICES_H
+
+#include <math.h>
+#include "Wire.h"
+
+// Generador del ruido de medición (reproducible)
+class HostNoise {
+private:
+    uint32_t seed;
+
+public:
+    explicit HostNoise(uint32_t initial = 12345) : seed(initial) {}
+
+    /**
+     * Entero uniforme en [-amplitude, amplitude]
+     */
+    int32_t next(int32_t amplitude) {
+        seed = seed * 1664525u + 1013904223u;
+        if (amplitude <= 0) {
+            return 0;
+        }
+        return (int32_t)((seed >> 8) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+    }
+};
+
+// ==================== AHT20 ====================
+
+class HostAHT20 : public HostI2CDevice {
+private:
+    bool measuring;
+    uint64_t measureStartUs;
+    uint8_t frame[7];               // Estado + 5 de datos + CRC
+    HostNoise noise;
+
+    static uint8_t crc(const uint8_t* data, int length) {
+        uint8_t value = 0xFF;
+        for (int i = 0; i < length; i++) {
+            value ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 0x80) ? (uint8_t)((value << 1) ^ 0x31) : (uint8_t)(value << 1);
+            }
+        }
+        return value;
+    }
+
+    static uint32_t toRaw(double fraction) {
+        double raw = floor(fraction * 1048576.0 + 0.5);
+        return raw < 0 ? 0 : (raw > 1048575 ? 1048575 : (uint32_t)raw);
+    }
+
+    bool busy() const {
+        return stuckBusy || (measuring && HostSim::nowUs - measureStartUs < 80000);
+    }
+
+    /**
+     * Mide: palabras de 20 bits de las condiciones actuales (más ruido)
+     */
+    void measure() {
+        if (frozen) {
+            return;
+        }
+        uint32_t humidity = toRaw(relativeHumidity / 100.0);
+        uint32_t temperature = toRaw((celsius + 50.0) / 200.0);
+        humidity = (uint32_t)((int32_t)humidity + noise.next(noiseLsb)) & 0xFFFFF;
+        temperature = (uint32_t)((int32_t)temperature + noise.next(noiseLsb)) & 0xFFFFF;
+
+        frame[1] = (uint8_t)(humidity >> 12);
+        frame[2] = (uint8_t)(humidity >> 4);
+        frame[3] = (uint8_t)(((humidity & 0x0F) << 4) | (temperature >> 16));
+        frame[4] = (uint8_t)(temperature >> 8);
+        frame[5] = (uint8_t)temperature;
+    }
+
+public:
+    // Condiciones medidas
+    double celsius;
+    double relativeHumidity;
+    int32_t noiseLsb;               // Ruido por medición (LSB de 20 bits)
+
+    // Estado y fallas
+    bool calibrated;                // Bit 3 del estado (0xBE lo carga)
+    bool frozen;                    // Repite la última trama (sensor colgado)
+    bool stuckBusy;                 // Nunca termina de medir
+    int corruptCrc;                 // Próximas lecturas con CRC incorrecto
+    int shortReads;                 // Próximas lecturas cortas (3 de 7 bytes)
+
+    // Comandos recibidos
+    uint32_t measurements;
+    uint32_t initCommands;
+
+    HostAHT20()
+        : measuring(false),
+          measureStartUs(0),
+          frame(),
+          celsius(22.0),
+          relativeHumidity(45.0),
+          noiseLsb(16),
+          calibrated(true),
+          frozen(false),
+          stuckBusy(false),
+          corruptCrc(0),
+          shortReads(0),
+          measurements(0),
+          initCommands(0) {
+    }
+
+    bool write(const uint8_t* data, size_t length) override {
+        if (length == 3 && data[0] == 0xAC && data[1] == 0x33 && data[2] == 0x00) {
+            measuring = true;
+            measureStartUs = HostSim::nowUs;
+            measurements++;
+            measure();
+        } else if (length == 3 && data[0] == 0xBE) {
+            calibrated = true;
+            initCommands++;
+        } else if (length == 1 && data[0] == 0xBA) {
+            // Reset por software: pierde la medición en curso
+            measuring = false;
+        }
+        return true;
+    }
+
+    size_t read(uint8_t* data, size_t length) override {
+        frame[0] = (uint8_t)((busy() ? 0x80 : 0) | (calibrated ? 0x08 : 0) | 0x10);
+        frame[6] = crc(frame, 6);
+        if (length > 1 && corruptCrc > 0) {
+            corruptCrc--;
+            frame[6] ^= 0x5A;
+        }
+
+        size_t count = length < sizeof(frame) ? length : sizeof(frame);
+        if (length > 1 && shortReads > 0) {
+            shortReads--;
+            count = 3;
+        }
+        memcpy(data, frame, count);
+        return count;
+    }
+
+    /**
+     * Apagado y encendido: descalibrado hasta recibir 0xBE (según el modelo)
+     */
+    void powerCycle(bool loseCalibration) {
+        measuring = false;
+        if (loseCalibration) {
+            calibrated = false;
+        }
+    }
+};
+
+// ==================== BMP280 ====================
+
+// Coeficientes del ejemplo del datasheet (sección 3.12)
+struct HostBMP280Calibration {
+    uint16_t t1;
+    int16_t t2, t3;
+    uint16_t p1;
+    int16_t p2, p3, p4, p5, p6, p7, p8, p9;
+};
+
+static const HostBMP280Calibration HOST_BMP280_DATASHEET = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+class HostBMP280 : public HostI2CDevice {
+private:
+    uint8_t registers[256];
+    uint8_t pointer;
+    HostNoise noise;
+
+    void storeWord(uint8_t reg, uint16_t value) {
+        registers[reg] = (uint8_t)value;
+        registers[reg + 1] = (uint8_t)(value >> 8);
+    }
+
+    /**
+     * Temperatura (°C) y t_fine por la fórmula de punto flotante del datasheet
+     */
+    double temperature(int32_t adcT, double& tFine) const {
+        double var1 = (adcT / 16384.0 - calibration.t1 / 1024.0) * calibration.t2;
+        double var2 = (adcT / 131072.0 - calibration.t1 / 8192.0) *
+                      (adcT / 131072.0 - calibration.t1 / 8192.0) * calibration.t3;
+        tFine = var1 + var2;
+        return (var1 + var2) / 5120.0;
+    }
+
+    /**
+     * Presión (Pa) por la fórmula de punto flotante del datasheet
+     */
+    double pressure(int32_t adcP, double tFine) const {
+        double var1 = tFine / 2.0 - 64000.0;
+        double var2 = var1 * var1 * calibration.p6 / 32768.0;
+        var2 = var2 + var1 * calibration.p5 * 2.0;
+        var2 = var2 / 4.0 + calibration.p4 * 65536.0;
+        var1 = (calibration.p3 * var1 * var1 / 524288.0 + calibration.p2 * var1) / 524288.0;
+        var1 = (1.0 + var1 / 32768.0) * calibration.p1;
+        if (var1 == 0) {
+            return 0;
+        }
+        double p = 1048576.0 - adcP;
+        p = (p - var2 / 4096.0) * 6250.0 / var1;
+        var1 = calibration.p9 * p * p / 2147483648.0;
+        var2 = p * calibration.p8 / 32768.0;
+        return p + (var1 + var2 + calibration.p7) / 16.0;
+    }
+
+    /**
+     * Valores crudos de las condiciones actuales (búsqueda binaria sobre
+     * las fórmulas: la temperatura crece con adcT, la presión decrece con adcP)
+     */
+    void rawFor(double celsiusValue, double hPaValue, int32_t& adcT, int32_t& adcP) const {
+        int32_t low = 0;
+        int32_t high = (1 << 20) - 1;
+        double tFine = 0;
+        while (low < high) {
+            int32_t mid = (low + high) / 2;
+            if (temperature(mid, tFine) < celsiusValue) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        adcT = low;
+        temperature(adcT, tFine);
+
+        low = 0;
+        high = (1 << 20) - 1;
+        while (low < high) {
+            int32_t mid = (low + high) / 2;
+            if (pressure(mid, tFine) > hPaValue * 100.0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        adcP = low;
+    }
+
+    bool normalMode() const {
+        return (registers[0xF4] & 0x03) == 0x03;
+    }
+
+    /**
+     * Conversión en modo normal: registros de datos con las condiciones actuales
+     */
+    void convert() {
+        if (!normalMode() || frozen) {
+            return;
+        }
+        int32_t adcT = rawTemperature;
+        int32_t adcP = rawPressure;
+        if (!useRaw) {
+            rawFor(celsius, hPa, adcT, adcP);
+        }
+        adcT = (adcT + noise.next(noiseLsb)) & 0xFFFFF;
+        adcP = (adcP + noise.next(noiseLsb)) & 0xFFFFF;
+        conversions++;
+
+        registers[0xF7] = (uint8_t)(adcP >> 12);
+        registers[0xF8] = (uint8_t)(adcP >> 4);
+        registers[0xF9] = (uint8_t)((adcP & 0x0F) << 4);
+        registers[0xFA] = (uint8_t)(adcT >> 12);
+        registers[0xFB] = (uint8_t)(adcT >> 4);
+        registers[0xFC] = (uint8_t)((adcT & 0x0F) << 4);
+    }
+
+public:
+    HostBMP280Calibration calibration;
+
+    // Condiciones medidas (o valores crudos fijos con useRaw)
+    double celsius;
+    double hPa;
+    bool useRaw;
+    int32_t rawTemperature;
+    int32_t rawPressure;
+    int32_t noiseLsb;               // Ruido por conversión (LSB de 20 bits)
+
+    bool frozen;                    // Datos congelados (sensor colgado)
+    int shortReads;                 // Próximas lecturas cortas (1 byte)
+
+    uint32_t conversions;
+    uint32_t burstReads;            // Lecturas que empiezan en los registros de datos
+
+    explicit HostBMP280(const HostBMP280Calibration& coefficients = HOST_BMP280_DATASHEET)
+        : registers(),
+          pointer(0),
+          noise(54321),
+          calibration(coefficients),
+          celsius(22.0),
+          hPa(1013.25),
+          useRaw(false),
+          rawTemperature(0),
+          rawPressure(0),
+          noiseLsb(4),
+          frozen(false),
+          shortReads(0),
+          conversions(0),
+          burstReads(0) {
+        powerCycle();
+    }
+
+    /**
+     * Encendido: registros por defecto, modo sleep, datos en 0x80000
+     */
+    void powerCycle() {
+        memset(registers, 0, sizeof(registers));
+        registers[0xD0] = 0x58;
+        storeWord(0x88, calibration.t1);
+        storeWord(0x8A, (uint16_t)calibration.t2);
+        storeWord(0x8C, (uint16_t)calibration.t3);
+        storeWord(0x8E, calibration.p1);
+        storeWord(0x90, (uint16_t)calibration.p2);
+        storeWord(0x92, (uint16_t)calibration.p3);
+        storeWord(0x94, (uint16_t)calibration.p4);
+        storeWord(0x96, (uint16_t)calibration.p5);
+        storeWord(0x98, (uint16_t)calibration.p6);
+        storeWord(0x9A, (uint16_t)calibration.p7);
+        storeWord(0x9C, (uint16_t)calibration.p8);
+        storeWord(0x9E, (uint16_t)calibration.p9);
+        registers[0xF7] = 0x80;
+        registers[0xFA] = 0x80;
+        pointer = 0;
+    }
+
+    /**
+     * Presión y temperatura que compensan los valores crudos (datasheet, flotante)
+     */
+    void compensate(int32_t adcT, int32_t adcP, double& celsiusValue, double& pascal) const {
+        double tFine;
+        celsiusValue = temperature(adcT, tFine);
+        pascal = pressure(adcP, tFine);
+    }
+
+    uint8_t ctrlMeas() const { return registers[0xF4]; }
+
+    uint8_t config() const { return registers[0xF5]; }
+
+    bool write(const uint8_t* data, size_t length) override {
+        if (length == 0) {
+            return true;
+        }
+        pointer = data[0];
+        // Escritura de registros: pares dirección/valor (datasheet 5.2.1)
+        for (size_t i = 1; i < length; i += 2) {
+            registers[pointer] = data[i];
+            if (i + 1 < length) {
+                pointer = data[i + 1];
+            }
+        }
+        return true;
+    }
+
+    size_t read(uint8_t* data, size_t length) override {
+        if (pointer >= 0xF7 && pointer <= 0xFC) {
+            burstReads++;
+            convert();
+        }
+        size_t count = length;
+        if (shortReads > 0) {
+            shortReads--;
+            count = 1;
+        }
+        for (size_t i = 0; i < count; i++) {
+            data[i] = registers[pointer++];
+        }
+        return count;
+    }
+};
+
+#endif // HOSTDEVICES_H
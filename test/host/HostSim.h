@@ -0,0 +1,206 @@
+/*
+Simulación del ESP32 para las pruebas en la PC (pio test -e native):
+
+Los encabezados de esta carpeta reemplazan a los del framework (Arduino.h,
+Wire.h, LittleFS.h, FreeRTOS, esp_timer, ESPAsyncWebServer) para compilar
+los módulos de src/ que dependen de ellos; todo en encabezados, sin .cpp
+
+Reloj virtual en µs: millis(), micros() y esp_timer_get_time() solo avanzan
+con delay(), delayMicroseconds(), el tiempo de bus I2C o HostSim::advanceUs()
+Al avanzar se disparan en orden los timers periódicos vencidos (esp_timer)
+Pines: el ESP32 lleva una línea a bajo o la suelta (pull-up); un modelo de
+dispositivo (el bus I2C de Wire.h) puede retenerla en bajo
+ADC: valor por pin fijado por la prueba, o una fuente por función
+Serial: silencioso salvo echoSerial; se puede capturar en un std::string
+El reloj, los pines y el ADC son del hilo de la prueba (sin sincronización)
+*/
+#ifndef HOSTSIM_H
+#define HOSTSIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+#define HOST_PIN_COUNT 40               // GPIO del ESP32
+#define HOST_MAX_TIMERS 8               // esp_timer simultáneos
+#define HOST_HEAP_SIZE 327680           // Heap libre de un ESP32 recién arrancado (bytes)
+
+// Línea compartida con un modelo de dispositivo (drenador abierto)
+class HostPinListener {
+public:
+    virtual ~HostPinListener() {}
+
+    /**
+     * @return true si el dispositivo tira la línea a bajo
+     */
+    virtual bool holdsLow(int pin) = 0;
+
+    /**
+     * El ESP32 soltó la línea (flanco de subida si nadie la retiene)
+     */
+    virtual void onRelease(int pin) = 0;
+};
+
+namespace HostSim {
+    struct Timer {
+        void (*callback)(void*);
+        void* arg;
+        uint64_t periodUs;
+        uint64_t nextUs;
+        bool active;
+        bool used;
+    };
+
+    struct Pin {
+        uint8_t mode;
+        uint8_t output;                 // Último digitalWrite()
+        bool drivenLow;                 // El ESP32 tira la línea a bajo
+    };
+
+    inline uint64_t nowUs = 0;
+    inline uint32_t pendingNs = 0;      // Fracción de µs acumulada por advanceNs()
+    inline Timer timers[HOST_MAX_TIMERS];
+    inline Pin pins[HOST_PIN_COUNT];
+    inline HostPinListener* pinListener = nullptr;
+
+    inline uint16_t adcValues[HOST_PIN_COUNT];
+    inline uint16_t (*adcSource)(int pin, void* context) = nullptr;
+    inline void* adcContext = nullptr;
+    inline uint32_t adcReads = 0;
+
+    inline bool echoSerial = false;
+    inline std::string* serialCapture = nullptr;
+
+    // Memoria en uso: la mantiene la prueba que reemplaza operator new
+    inline size_t heapInUse = 0;
+    inline size_t heapPeak = 0;
+
+    inline bool restarted = false;      // ESP.restart()
+
+    /**
+     * Avanza el reloj virtual disparando los timers vencidos en orden
+     * (cada callback ve el reloj en su instante)
+     * @param us Microsegundos a avanzar
+     */
+    inline void advanceUs(uint64_t us) {
+        uint64_t target = nowUs + us;
+        while (true) {
+            Timer* next = nullptr;
+            for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+                Timer& timer = timers[i];
+                if (timer.used && timer.active && timer.nextUs <= target &&
+                    (next == nullptr || timer.nextUs < next->nextUs)) {
+                    next = &timer;
+                }
+            }
+            if (next == nullptr) {
+                break;
+            }
+            if (next->nextUs > nowUs) {
+                nowUs = next->nextUs;
+            }
+            next->nextUs += next->periodUs;
+            next->callback(next->arg);
+        }
+        // Un callback que espera puede haber pasado el objetivo
+        if (target > nowUs) {
+            nowUs = target;
+        }
+    }
+
+    /**
+     * Avanza el reloj en ns (tiempo de bus); acumula la fracción de µs
+     */
+    inline void advanceNs(uint64_t ns) {
+        uint64_t total = pendingNs + ns;
+        pendingNs = (uint32_t)(total % 1000);
+        advanceUs(total / 1000);
+    }
+
+    /**
+     * Línea vista desde el ESP32: baja si alguien la tira a bajo
+     * @param inputLevel Nivel de la entrada sin dispositivos (pull-up = 1)
+     */
+    inline int lineLevel(int pin, int inputLevel) {
+        if (pin < 0 || pin >= HOST_PIN_COUNT) {
+            return inputLevel;
+        }
+        if (pins[pin].drivenLow || (pinListener != nullptr && pinListener->holdsLow(pin))) {
+            return 0;
+        }
+        return inputLevel;
+    }
+
+    /**
+     * El ESP32 tira la línea a bajo o la suelta (avisa el flanco al dispositivo)
+     */
+    inline void setDrivenLow(int pin, bool low) {
+        if (pin < 0 || pin >= HOST_PIN_COUNT) {
+            return;
+        }
+        bool wasLow = pins[pin].drivenLow;
+        pins[pin].drivenLow = low;
+        if (wasLow && !low && pinListener != nullptr) {
+            pinListener->onRelease(pin);
+        }
+    }
+
+    /**
+     * pinMode()/digitalWrite(): solo OUTPUT en bajo tira la línea
+     * @param mode Modo nuevo (<0 = sin cambio)
+     * @param output Nivel de salida nuevo (<0 = sin cambio)
+     */
+    inline void setPin(int pin, int mode, int output) {
+        Pin* line = (pin >= 0 && pin < HOST_PIN_COUNT) ? pins + pin : nullptr;
+        if (line == nullptr) {
+            return;
+        }
+        if (mode >= 0) {
+            line->mode = (uint8_t)mode;
+        }
+        if (output >= 0) {
+            line->output = (uint8_t)output;
+        }
+        bool driving = line->mode == 0x03 || line->mode == 0x12;   // OUTPUT, OUTPUT_OPEN_DRAIN
+        setDrivenLow(pin, driving && line->output == 0);
+    }
+
+    /**
+     * Lectura del ADC de un pin (fuente de la prueba o valor fijo)
+     */
+    inline uint16_t adc(int pin) {
+        adcReads++;
+        uint16_t value;
+        if (adcSource != nullptr) {
+            value = adcSource(pin, adcContext);
+        } else {
+            value = (pin >= 0 && pin < HOST_PIN_COUNT) ? adcValues[pin] : 0;
+        }
+        return value > 4095 ? 4095 : value;
+    }
+
+    /**
+     * Salida de Serial (descartada salvo eco o captura)
+     */
+    inline void serialWrite(const char* text, size_t length) {
+        if (serialCapture != nullptr) {
+            serialCapture->append(text, length);
+        }
+        if (echoSerial) {
+            fwrite(text, 1, length, stdout);
+        }
+    }
+
+    /**
+     * Registra memoria reservada o liberada (desde un operator new de prueba)
+     */
+    inline void heapChanged(long delta) {
+        heapInUse += delta;
+        if (heapInUse > heapPeak) {
+            heapPeak = heapInUse;
+        }
+    }
+}
+
+#endif // HOSTSIM_H
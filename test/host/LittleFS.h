@@ -0,0 +1,19 @@
+/*
+LittleFS.h para las pruebas en la PC: una instancia del sistema de archivos
+en memoria de FS.h (vacío al arrancar cada suite)
+*/
+#ifndef _LITTLEFS_H_
+#define _LITTLEFS_H_
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+};
+
+} // namespace fs
+
+inline fs::LittleFSFS LittleFS;
+
+#endif // _LITTLEFS_H_
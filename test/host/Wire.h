@@ -0,0 +1,328 @@
+/*
+Wire.h para las pruebas en la PC: bus I2C simulado
+
+Los dispositivos (HostI2CDevice, ver HostDevices.h) se conectan por dirección
+Cada transacción avanza el reloj virtual lo que tarda en el bus: 9 bits por
+byte (8 + ACK) más START/STOP, a la frecuencia configurada (100 kHz por
+defecto, como el core del ESP32)
+Fallas inyectables:
+  failNext(): NACK de dirección en las próximas transacciones
+  detach(): el dispositivo deja de responder
+  holdSda(): un esclavo retiene SDA hasta recibir N pulsos de SCL
+  holdScl(): un esclavo retiene SCL (no hay recuperación posible)
+Con una línea retenida cada transacción espera el timeout del bus y falla
+Los pines se ven con digitalRead() (I2CBus::recover() los maneja a mano)
+Códigos de endTransmission() como el core: 0 ok, 2 NACK de dirección,
+3 NACK de datos, 4 otro error, 5 timeout
+*/
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+#define I2C_BUFFER_LENGTH 128
+#define HOST_I2C_MAX_DEVICES 4
+#define HOST_I2C_TIMEOUT_MS 50          // Timeout por defecto del core
+
+// Dispositivo conectado al bus simulado
+class HostI2CDevice {
+public:
+    virtual ~HostI2CDevice() {}
+
+    /**
+     * Escritura del maestro (la dirección ya fue reconocida)
+     * @return false si el dispositivo no reconoce algún byte (NACK de datos)
+     */
+    virtual bool write(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * Lectura del maestro
+     * @return Bytes entregados (menos que length = lectura corta)
+     */
+    virtual size_t read(uint8_t* data, size_t length) = 0;
+};
+
+// Contadores del bus (para medir latencia y errores)
+struct HostI2CStats {
+    uint32_t transactions;
+    uint32_t errors;
+    uint32_t bytes;
+    uint64_t busNs;             // Tiempo total ocupado (incluye timeouts)
+};
+
+class TwoWire : public HostPinListener {
+private:
+    struct Slot {
+        uint8_t address;
+        HostI2CDevice* device;
+        int failures;           // Transacciones con NACK pendientes
+    };
+
+    Slot slots[HOST_I2C_MAX_DEVICES];
+    int sdaPin;
+    int sclPin;
+    uint32_t frequency;
+    uint16_t timeoutMs;
+    bool running;
+
+    uint8_t txAddress;
+    uint8_t txBuffer[I2C_BUFFER_LENGTH];
+    size_t txLength;
+    uint8_t rxBuffer[I2C_BUFFER_LENGTH];
+    size_t rxLength;
+    size_t rxIndex;
+
+    int sdaPulsesToRelease;     // 0 = SDA libre, <0 = retenida siempre
+    bool sclHeld;
+    HostI2CStats stats;
+
+    Slot* find(uint8_t address) {
+        for (Slot& slot : slots) {
+            if (slot.device != nullptr && slot.address == address) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Ocupa el bus el tiempo de una transacción (dirección + bytes de datos)
+     */
+    void busTime(size_t bytes) {
+        uint64_t bits = (bytes + 1) * 9 + 2;
+        uint64_t ns = bits * 1000000000ULL / frequency;
+        stats.busNs += ns;
+        HostSim::advanceNs(ns);
+    }
+
+    /**
+     * Verifica que se pueda iniciar una transacción
+     * @return 0, 4 (bus detenido) o 5 (línea retenida: timeout)
+     */
+    uint8_t start() {
+        stats.transactions++;
+        if (!running) {
+            stats.errors++;
+            return 4;
+        }
+        if (sdaPulsesToRelease != 0 || sclHeld) {
+            stats.errors++;
+            uint64_t ns = (uint64_t)timeoutMs * 1000000ULL;
+            stats.busNs += ns;
+            HostSim::advanceNs(ns);
+            return 5;
+        }
+        return 0;
+    }
+
+    /**
+     * Dispositivo que reconoce la dirección (nullptr = NACK)
+     */
+    HostI2CDevice* acknowledge(uint8_t address) {
+        Slot* slot = find(address);
+        if (slot == nullptr) {
+            return nullptr;
+        }
+        if (slot->failures != 0) {
+            if (slot->failures > 0) {
+                slot->failures--;
+            }
+            return nullptr;
+        }
+        return slot->device;
+    }
+
+public:
+    TwoWire()
+        : slots(),
+          sdaPin(-1),
+          sclPin(-1),
+          frequency(100000),
+          timeoutMs(HOST_I2C_TIMEOUT_MS),
+          running(false),
+          txAddress(0),
+          txLength(0),
+          rxLength(0),
+          rxIndex(0),
+          sdaPulsesToRelease(0),
+          sclHeld(false),
+          stats() {
+    }
+
+    // ==================== API del core ====================
+
+    bool begin(int sda = -1, int scl = -1, uint32_t clock = 0) {
+        if (sda >= 0) sdaPin = sda;
+        if (scl >= 0) sclPin = scl;
+        if (clock > 0) frequency = clock;
+        running = true;
+        // Las líneas las maneja el periférico (el modelo las ve por holdsLow)
+        HostSim::pinListener = this;
+        return true;
+    }
+
+    bool end() {
+        running = false;
+        return true;
+    }
+
+    void setClock(uint32_t clock) {
+        if (clock > 0) frequency = clock;
+    }
+
+    uint32_t getClock() const { return frequency; }
+
+    void setTimeOut(uint16_t ms) { timeoutMs = ms; }
+
+    void beginTransmission(uint8_t address) {
+        txAddress = address;
+        txLength = 0;
+    }
+
+    size_t write(uint8_t value) {
+        if (txLength >= I2C_BUFFER_LENGTH) {
+            return 0;
+        }
+        txBuffer[txLength++] = value;
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        size_t written = 0;
+        while (written < length && write(data[written])) {
+            written++;
+        }
+        return written;
+    }
+
+    uint8_t endTransmission(bool sendStop = true) {
+        (void)sendStop;
+        uint8_t error = start();
+        if (error != 0) {
+            return error;
+        }
+
+        HostI2CDevice* device = acknowledge(txAddress);
+        if (device == nullptr) {
+            busTime(0);
+            stats.errors++;
+            return 2;
+        }
+
+        busTime(txLength);
+        stats.bytes += txLength;
+        if (!device->write(txBuffer, txLength)) {
+            stats.errors++;
+            return 3;
+        }
+        return 0;
+    }
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true) {
+        (void)sendStop;
+        rxLength = 0;
+        rxIndex = 0;
+        if (start() != 0) {
+            return 0;
+        }
+
+        HostI2CDevice* device = acknowledge(address);
+        if (device == nullptr) {
+            busTime(0);
+            stats.errors++;
+            return 0;
+        }
+
+        size_t length = quantity < I2C_BUFFER_LENGTH ? quantity : I2C_BUFFER_LENGTH;
+        rxLength = device->read(rxBuffer, length);
+        busTime(rxLength);
+        stats.bytes += rxLength;
+        if (rxLength < length) {
+            stats.errors++;
+        }
+        return (uint8_t)rxLength;
+    }
+
+    int available() { return (int)(rxLength - rxIndex); }
+
+    int read() { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
+
+    int peek() { return rxIndex < rxLength ? rxBuffer[rxIndex] : -1; }
+
+    // ==================== Modelo ====================
+
+    /**
+     * Conecta un dispositivo en una dirección (reemplaza al anterior)
+     */
+    void attach(uint8_t address, HostI2CDevice* device) {
+        Slot* slot = find(address);
+        if (slot == nullptr) {
+            for (Slot& free : slots) {
+                if (free.device == nullptr) {
+                    slot = &free;
+                    break;
+                }
+            }
+        }
+        if (slot != nullptr) {
+            *slot = {address, device, 0};
+        }
+    }
+
+    /**
+     * Desconecta el dispositivo de una dirección (NACK desde ahora)
+     */
+    void detach(uint8_t address) {
+        Slot* slot = find(address);
+        if (slot != nullptr) {
+            *slot = {0, nullptr, 0};
+        }
+    }
+
+    /**
+     * NACK de dirección en las próximas transacciones con un dispositivo
+     * @param count Transacciones que fallan (<0 = hasta que se llame con 0)
+     */
+    void failNext(uint8_t address, int count) {
+        Slot* slot = find(address);
+        if (slot != nullptr) {
+            slot->failures = count;
+        }
+    }
+
+    /**
+     * Un esclavo quedó a mitad de un byte y retiene SDA
+     * @param pulses Flancos de SCL hasta soltarla (<0 = no la suelta)
+     */
+    void holdSda(int pulses) { sdaPulsesToRelease = pulses; }
+
+    /**
+     * Un esclavo retiene SCL en bajo (estiramiento de reloj colgado)
+     */
+    void holdScl(bool held) { sclHeld = held; }
+
+    bool isSdaHeld() const { return sdaPulsesToRelease != 0; }
+
+    bool isRunning() const { return running; }
+
+    const HostI2CStats& getStats() const { return stats; }
+
+    void resetStats() { stats = HostI2CStats(); }
+
+    // ==================== Líneas (HostPinListener) ====================
+
+    bool holdsLow(int pin) override {
+        return (pin == sdaPin && sdaPulsesToRelease != 0) || (pin == sclPin && sclHeld);
+    }
+
+    void onRelease(int pin) override {
+        // Un pulso de reloj: el esclavo saca el bit siguiente
+        if (pin == sclPin && !sclHeld && sdaPulsesToRelease > 0) {
+            sdaPulsesToRelease--;
+        }
+    }
+};
+
+inline TwoWire Wire;
+
+#endif // TwoWire_h
@@ -0,0 +1,91 @@
+/*
+esp_timer para las pruebas en la PC: timers del reloj virtual de HostSim.h
+(se disparan cuando el reloj avanza, en el hilo que lo avanza)
+*/
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+#include "HostSim.h"
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+
+struct esp_timer;
+typedef struct esp_timer* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR
+} esp_timer_dispatch_t;
+
+typedef struct {
+    esp_timer_cb_t callback;
+    void* arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+inline HostSim::Timer* hostTimer(esp_timer_handle_t handle) {
+    return reinterpret_cast<HostSim::Timer*>(handle);
+}
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    if (args == nullptr || args->callback == nullptr || handle == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int i = 0; i < HOST_MAX_TIMERS; i++) {
+        HostSim::Timer& timer = HostSim::timers[i];
+        if (!timer.used) {
+            timer = {args->callback, args->arg, 0, 0, false, true};
+            *handle = reinterpret_cast<esp_timer_handle_t>(&timer);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t handle, uint64_t periodUs) {
+    HostSim::Timer* timer = hostTimer(handle);
+    if (timer == nullptr || periodUs == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->periodUs = periodUs;
+    timer->nextUs = HostSim::nowUs + periodUs;
+    timer->active = true;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t handle) {
+    HostSim::Timer* timer = hostTimer(handle);
+    if (timer == nullptr || !timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->active = false;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_delete(esp_timer_handle_t handle) {
+    HostSim::Timer* timer = hostTimer(handle);
+    if (timer == nullptr || timer->active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->used = false;
+    return ESP_OK;
+}
+
+inline int64_t esp_timer_get_time() {
+    return (int64_t)HostSim::nowUs;
+}
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,67 @@
+/*
+Tareas de FreeRTOS para las pruebas en la PC:
+
+No se crean tareas: las pruebas llaman directamente a los ciclos (por
+ejemplo SensorTask::cycle()) sobre el reloj virtual
+Una tarea es solo un contador de avisos: la prueba crea un HostTask y lo
+pasa como destino de xTaskNotifyGive() (despertar anticipado del ADC)
+vTaskDelay() duerme de verdad: la usan esperas entre hilos de la prueba
+(la tarea de AsyncTCP simulada por un std::thread)
+*/
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "FreeRTOS.h"
+#include "../Arduino.h"
+
+struct tskTaskControlBlock {
+    std::atomic<uint32_t> notifications{0};
+};
+
+typedef tskTaskControlBlock HostTask;
+typedef tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*,
+                                          UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+    if (handle != nullptr) {
+        *handle = nullptr;
+    }
+    return pdFAIL;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* arg,
+                              UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(function, name, stack, arg, priority, handle, tskNO_AFFINITY);
+}
+
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+    return 0;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (task != nullptr) {
+        task->notifications.fetch_add(1);
+    }
+    return pdPASS;
+}
+
+// Sin tarea en curso: no hay avisos propios que esperar
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) {
+    return 0;
+}
+
+#endif // INC_TASK_H
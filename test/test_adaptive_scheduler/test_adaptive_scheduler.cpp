@@ -0,0 +1,80 @@
+/*
+Pruebas de AdaptiveScheduler (periodo de muestreo según actividad):
+
+Arranca lento y pasa a rápido con la primera actividad
+Se mantiene rápido durante la histéresis y desacelera duplicando
+Nunca supera el periodo lento ni se rompe al desbordar millis()
+*/
+#include <unity.h>
+#include "tasks/AdaptiveScheduler.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_starts_slow_and_speeds_up(void) {
+    AdaptiveScheduler scheduler(2000, 250, 10000);
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.getInterval());
+    TEST_ASSERT_FALSE(scheduler.isFast());
+
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.update(false, 1000));
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.update(true, 3000));
+    TEST_ASSERT_TRUE(scheduler.isFast());
+}
+
+void test_holds_then_doubles_to_slow(void) {
+    AdaptiveScheduler scheduler(2000, 250, 10000);
+    scheduler.update(true, 0);
+
+    // Dentro de la histéresis no cambia
+    for (uint32_t t = 250; t < 10000; t += 250) {
+        TEST_ASSERT_EQUAL_UINT32(250, scheduler.update(false, t));
+    }
+
+    // Luego 500 → 1000 → 2000 (tope) y queda lento
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.update(false, 10000));
+    TEST_ASSERT_EQUAL_UINT32(1000, scheduler.update(false, 10500));
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.update(false, 11500));
+    TEST_ASSERT_EQUAL_UINT32(2000, scheduler.update(false, 13500));
+    TEST_ASSERT_FALSE(scheduler.isFast());
+}
+
+void test_activity_during_slowdown_restarts_hold(void) {
+    AdaptiveScheduler scheduler(2000, 250, 10000);
+    scheduler.update(true, 0);
+    scheduler.update(false, 10000);
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.getInterval());
+
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.update(true, 10500));
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.update(false, 20000));
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.update(false, 20500));
+}
+
+void test_slow_not_multiple_of_fast(void) {
+    // 300 → 600 → 1200 → 1500 (recortado, no 2400)
+    AdaptiveScheduler scheduler(1500, 300, 0);
+    scheduler.update(true, 0);
+    TEST_ASSERT_EQUAL_UINT32(600, scheduler.update(false, 1));
+    TEST_ASSERT_EQUAL_UINT32(1200, scheduler.update(false, 2));
+    TEST_ASSERT_EQUAL_UINT32(1500, scheduler.update(false, 3));
+    TEST_ASSERT_EQUAL_UINT32(1500, scheduler.update(false, 4));
+}
+
+void test_millis_wraparound(void) {
+    AdaptiveScheduler scheduler(2000, 250, 10000);
+    uint32_t start = 0xFFFFF000u;
+    scheduler.update(true, start);
+
+    // 4096 ms después (cruzando 0) sigue dentro de la histéresis
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.update(false, start + 4096));
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.update(false, start + 10000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_slow_and_speeds_up);
+    RUN_TEST(test_holds_then_doubles_to_slow);
+    RUN_TEST(test_activity_during_slowdown_restarts_hold);
+    RUN_TEST(test_slow_not_multiple_of_fast);
+    RUN_TEST(test_millis_wraparound);
+    return UNITY_END();
+}
@@ -0,0 +1,43 @@
+/*
+Pruebas de AdcBatch: lote vacío, promedio redondeado, mínimo y máximo
+*/
+#include <unity.h>
+#include "sensors/AdcBatch.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_empty_batch(void) {
+    AdcBatch batch;
+    TEST_ASSERT_TRUE(batch.isEmpty());
+    TEST_ASSERT_EQUAL_INT(0, batch.mean());
+}
+
+void test_mean_rounds_to_nearest(void) {
+    AdcBatch batch;
+    batch.add(10);
+    batch.add(11);
+    TEST_ASSERT_EQUAL_INT(11, batch.mean());    // 10.5 → 11
+    batch.add(10);
+    TEST_ASSERT_EQUAL_INT(10, batch.mean());    // 10.33 → 10
+}
+
+void test_min_max_and_full_scale(void) {
+    AdcBatch batch;
+    // Un lote de un segundo a 1 kHz en fondo de escala no desborda la suma
+    for (int i = 0; i < 1000; i++) {
+        batch.add(i % 2 ? 4095 : 0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, batch.count);
+    TEST_ASSERT_EQUAL_UINT16(0, batch.min);
+    TEST_ASSERT_EQUAL_UINT16(4095, batch.max);
+    TEST_ASSERT_EQUAL_INT(2048, batch.mean());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_batch);
+    RUN_TEST(test_mean_rounds_to_nearest);
+    RUN_TEST(test_min_max_and_full_scale);
+    return UNITY_END();
+}
@@ -0,0 +1,93 @@
+/*
+Pruebas de AdcScan.h (barrido intercalado con sobremuestreo):
+
+Orden intercalado de las conversiones
+Diezmado redondeado, saturación y vuelta a 12 bits
+Ruido gaussiano de 1 LSB: el sobremuestreo gana ~2 bits
+*/
+#include <unity.h>
+#include <math.h>
+#include <random>
+#include "sensors/AdcScan.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_scan_interleaves_channels(void) {
+    const int pins[] = {34, 35, 36};
+    int order[3 * ADC_OVERSAMPLE];
+    int calls = 0;
+    AdcFrame frame;
+
+    AdcScan::run(pins, 3, [&](int pin) -> uint16_t {
+        order[calls++] = pin;
+        return (uint16_t)(pin * 10);
+    }, frame);
+
+    TEST_ASSERT_EQUAL_INT(3 * ADC_OVERSAMPLE, calls);
+    for (int i = 0; i < calls; i++) {
+        TEST_ASSERT_EQUAL_INT(pins[i % 3], order[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(3, frame.count);
+    TEST_ASSERT_EQUAL_UINT16(340 * ADC_SCAN_SCALE, frame.values[0]);
+    TEST_ASSERT_EQUAL_UINT16(360 * ADC_SCAN_SCALE, frame.values[2]);
+}
+
+void test_decimate_and_native(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, AdcScan::decimate(123, 0));
+    // 16 conversiones de 1000 y 1001 alternadas → 1000.5 LSB → 4002 en escala de 14 bits
+    TEST_ASSERT_EQUAL_UINT16(1000 * ADC_SCAN_SCALE + ADC_SCAN_SCALE / 2, AdcScan::decimate(8 * 1000 + 8 * 1001, 16));
+    TEST_ASSERT_EQUAL_UINT16((1u << ADC_SCAN_BITS) - 1, AdcScan::decimate(4095u * 16 + 100, 16));
+
+    TEST_ASSERT_EQUAL_INT(1000, AdcScan::toNative(1000 * ADC_SCAN_SCALE));
+    TEST_ASSERT_EQUAL_INT(1001, AdcScan::toNative(1000 * ADC_SCAN_SCALE + ADC_SCAN_SCALE / 2));
+    TEST_ASSERT_EQUAL_INT(4095, AdcScan::toNative(0xFFFF));
+}
+
+void test_oversampling_gains_resolution(void) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 1.0);    // 1 LSB rms
+    const int pins[] = {0};
+    double singleSquares = 0;
+    double scanSquares = 0;
+    const int frames = 20000;
+
+    for (int f = 0; f < frames; f++) {
+        double truth = 1500.0 + (f % 97) / 97.0;          // Valores entre códigos
+        AdcFrame frame;
+        uint16_t single = 0;
+        bool first = true;
+        AdcScan::run(pins, 1, [&](int) -> uint16_t {
+            uint16_t code = (uint16_t)lround(truth + noise(rng));
+            if (first) {
+                single = code;
+                first = false;
+            }
+            return code;
+        }, frame);
+
+        double scanned = (double)frame.values[0] / ADC_SCAN_SCALE;
+        singleSquares += (single - truth) * (single - truth);
+        scanSquares += (scanned - truth) * (scanned - truth);
+    }
+
+    double singleRms = sqrt(singleSquares / frames);
+    double scanRms = sqrt(scanSquares / frames);
+    double bitsGained = log2(singleRms / scanRms);
+
+    char line[96];
+    snprintf(line, sizeof(line), "rms 1 conversión %.3f LSB, barrido %.3f LSB, %.2f bits", singleRms, scanRms, bitsGained);
+    TEST_MESSAGE(line);
+
+    // 16× → sqrt(16) = 4 veces menos ruido (2 bits), menos la cuantización del barrido
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 1.04, singleRms);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(1.8, bitsGained);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scan_interleaves_channels);
+    RUN_TEST(test_decimate_and_native);
+    RUN_TEST(test_oversampling_gains_resolution);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+/*
+Pruebas del driver AHT20 sobre el bus I2C simulado (test/host):
+
+CRC-8 (polinomio 0x31, inicial 0xFF) con los vectores de referencia,
+conversión de palabras crudas a unidades físicas (datasheet),
+medición en dos fases (trigger/collect) sin esperas en el camino de lectura,
+CRC incorrecto, lecturas cortas y carga de calibración (0xBE) en begin()
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include "sensors/AHT20.h"
+
+static HostAHT20* device;
+static AHT20Driver* driver;
+
+void setUp(void) {
+    HostSim::nowUs = 0;
+    device = new HostAHT20();
+    driver = new AHT20Driver();
+    Wire = TwoWire();
+    Wire.begin(21, 22);
+    Wire.attach(AHT20_ADDRESS, device);
+}
+
+void tearDown(void) {
+    Wire.detach(AHT20_ADDRESS);
+    delete driver;
+    delete device;
+}
+
+// ==================== CRC y conversión ====================
+
+void test_crc8_reference_vectors(void) {
+    // CRC-8 "123456789" con polinomio 0x31, inicial 0xFF, sin reflejar
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_ASSERT_EQUAL_HEX8(0xF7, AHT20Driver::crc8(check, sizeof(check)));
+
+    // Ejemplo de la nota de aplicación (mismo CRC en sensores de humedad)
+    const uint8_t beef[] = {0xBE, 0xEF};
+    TEST_ASSERT_EQUAL_HEX8(0x92, AHT20Driver::crc8(beef, sizeof(beef)));
+
+    // Sin datos: el valor inicial
+    TEST_ASSERT_EQUAL_HEX8(0xFF, AHT20Driver::crc8(beef, 0));
+}
+
+void test_convert_datasheet_formulas(void) {
+    float temperature;
+    float humidity;
+
+    AHT20Driver::convert(0, 0, temperature, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, -50.0f, temperature);
+
+    // Mitad de escala: 50 %HR y 50 °C
+    AHT20Driver::convert(1UL << 19, 1UL << 19, temperature, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 50.0f, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 50.0f, temperature);
+
+    // Escala completa: un LSB menos que 100 %HR y 150 °C
+    AHT20Driver::convert(0xFFFFF, 0xFFFFF, temperature, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f - 100.0f / 1048576.0f, humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 150.0f - 200.0f / 1048576.0f, temperature);
+    TEST_ASSERT_TRUE(humidity < 100.0f);
+}
+
+// ==================== Bus ====================
+
+void test_begin_detects_calibrated_sensor(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    TEST_ASSERT_EQUAL_UINT32(0, device->initCommands);
+    TEST_ASSERT_EQUAL_UINT32(0, driver->getErrorCount());
+}
+
+void test_begin_loads_calibration(void) {
+    device->powerCycle(true);
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    TEST_ASSERT_EQUAL_UINT32(1, device->initCommands);
+    TEST_ASSERT_TRUE(device->calibrated);
+}
+
+void test_begin_without_sensor(void) {
+    Wire.detach(AHT20_ADDRESS);
+    TEST_ASSERT_FALSE(driver->begin(Wire));
+    TEST_ASSERT_EQUAL_UINT32(1, driver->getErrorCount());
+}
+
+void test_two_phase_measurement(void) {
+    device->celsius = 24.5;
+    device->relativeHumidity = 61.0;
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+
+    unsigned long start = millis();
+    TEST_ASSERT_TRUE(driver->trigger(start));
+    TEST_ASSERT_TRUE(driver->isMeasuring());
+    TEST_ASSERT_EQUAL_UINT32(1, device->measurements);
+
+    // El disparo es una escritura de 3 bytes: menos de 1 ms de bus, sin esperas
+    TEST_ASSERT_TRUE(millis() - start < 1);
+
+    float temperature = 0;
+    float humidity = 0;
+    HostSim::advanceUs(79000);
+    TEST_ASSERT_FALSE(driver->isReady(millis()));
+    TEST_ASSERT_FALSE(driver->collect(millis(), temperature, humidity));
+
+    HostSim::advanceUs(1000);
+    TEST_ASSERT_TRUE(driver->isReady(millis()));
+    TEST_ASSERT_TRUE(driver->collect(millis(), temperature, humidity));
+    TEST_ASSERT_FALSE(driver->isMeasuring());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 24.5f, temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 61.0f, humidity);
+    TEST_ASSERT_EQUAL_UINT32(0, driver->getErrorCount());
+}
+
+void test_minimum_period_between_measurements(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    unsigned long start = millis();
+    TEST_ASSERT_TRUE(driver->trigger(start));
+
+    // En curso: no se reemplaza
+    TEST_ASSERT_FALSE(driver->trigger(start + 500));
+
+    float temperature;
+    float humidity;
+    HostSim::advanceUs(100000);
+    TEST_ASSERT_TRUE(driver->collect(millis(), temperature, humidity));
+
+    // Leída, pero antes del periodo mínimo (autocalentamiento)
+    TEST_ASSERT_FALSE(driver->trigger(start + AHT20_MIN_PERIOD_MS - 1));
+    TEST_ASSERT_TRUE(driver->trigger(start + AHT20_MIN_PERIOD_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, device->measurements);
+}
+
+void test_busy_sensor_is_retried(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    device->stuckBusy = true;
+    TEST_ASSERT_TRUE(driver->trigger(millis()));
+    HostSim::advanceUs(100000);
+
+    // Ocupado: sin resultado y sin error, la medición sigue pendiente
+    float temperature;
+    float humidity;
+    TEST_ASSERT_FALSE(driver->collect(millis(), temperature, humidity));
+    TEST_ASSERT_TRUE(driver->isMeasuring());
+    TEST_ASSERT_EQUAL_UINT32(0, driver->getErrorCount());
+
+    // Colgada: se reemplaza pasado el timeout
+    unsigned long triggered = millis() - 100;
+    TEST_ASSERT_FALSE(driver->trigger(triggered + AHT20_TIMEOUT_MS - 1));
+    device->stuckBusy = false;
+    TEST_ASSERT_TRUE(driver->trigger(triggered + AHT20_MIN_PERIOD_MS));
+}
+
+void test_crc_error_discards_measurement(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    TEST_ASSERT_TRUE(driver->trigger(millis()));
+    HostSim::advanceUs(80000);
+
+    device->corruptCrc = 1;
+    uint32_t rawHumidity = 0;
+    uint32_t rawTemperature = 0;
+    TEST_ASSERT_FALSE(driver->collectRaw(millis(), rawHumidity, rawTemperature));
+    TEST_ASSERT_EQUAL_UINT32(1, driver->getErrorCount());
+
+    // La medición se consumió: no se reintenta la misma trama
+    TEST_ASSERT_FALSE(driver->isMeasuring());
+}
+
+void test_short_read_is_an_error(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    TEST_ASSERT_TRUE(driver->trigger(millis()));
+    HostSim::advanceUs(80000);
+
+    device->shortReads = 1;
+    uint32_t rawHumidity;
+    uint32_t rawTemperature;
+    TEST_ASSERT_FALSE(driver->collectRaw(millis(), rawHumidity, rawTemperature));
+    TEST_ASSERT_EQUAL_UINT32(1, driver->getErrorCount());
+    TEST_ASSERT_FALSE(driver->isMeasuring());
+}
+
+void test_nack_on_trigger(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire));
+    Wire.failNext(AHT20_ADDRESS, 1);
+    TEST_ASSERT_FALSE(driver->trigger(millis()));
+    TEST_ASSERT_FALSE(driver->isMeasuring());
+    TEST_ASSERT_EQUAL_UINT32(1, driver->getErrorCount());
+
+    // El siguiente intento no espera el periodo mínimo: no hubo medición
+    TEST_ASSERT_TRUE(driver->trigger(millis()));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc8_reference_vectors);
+    RUN_TEST(test_convert_datasheet_formulas);
+    RUN_TEST(test_begin_detects_calibrated_sensor);
+    RUN_TEST(test_begin_loads_calibration);
+    RUN_TEST(test_begin_without_sensor);
+    RUN_TEST(test_two_phase_measurement);
+    RUN_TEST(test_minimum_period_between_measurements);
+    RUN_TEST(test_busy_sensor_is_retried);
+    RUN_TEST(test_crc_error_discards_measurement);
+    RUN_TEST(test_short_read_is_an_error);
+    RUN_TEST(test_nack_on_trigger);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+/*
+Benchmark de tiempo hasta la alerta en la PC (pio test -e native -f test_alert_benchmark -v):
+
+Corre AlertBenchmark::run() completo sobre los sensores reales y el reloj
+virtual, con el mismo arranque que main.cpp (LittleFS, sensores de gas y
+ambiente en el bus simulado de test/host)
+La suite falla si alguna ejecución de la matriz queda fuera de los límites
+de su escenario (BenchScenarios.h); la tabla CSV se imprime completa para
+seguir la latencia de detección entre versiones
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <LittleFS.h>
+#include <string>
+#include <vector>
+#include "bench/AlertBenchmark.h"
+#include "sensors/SmokeSensor.h"
+#include "sensors/CH4Sensor.h"
+#include "sensors/EnvironmentSensor.h"
+#include "storage/FileManager.h"
+#include "utils/Clock.h"
+#include "config/Config.h"
+
+static HostAHT20 aht;
+static HostBMP280 bmp;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/**
+ * Líneas no vacías de un texto (sin el fin de línea)
+ */
+static std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+        start = end + 1;
+    }
+    return lines;
+}
+
+// ==================== Pruebas ====================
+
+void test_benchmark_within_bounds(void) {
+    GasCalibration smokeBefore = SmokeSensor::getInstance()->getCalibration();
+    GasCalibration ch4Before = CH4Sensor::getInstance()->getCalibration();
+
+    std::string console;
+    HostSim::serialCapture = &console;
+    bool passed = AlertBenchmark::run(ALERT_BENCHMARK_PATH);
+    HostSim::serialCapture = nullptr;
+
+    std::vector<std::string> rows = splitLines(LittleFS.contents(ALERT_BENCHMARK_PATH));
+    for (const std::string& row : rows) {
+        TEST_MESSAGE(row.c_str());
+    }
+    if (!passed) {
+        for (const std::string& line : splitLines(console)) {
+            if (line.find("FAIL") != std::string::npos || line.find("❌") != std::string::npos) {
+                TEST_MESSAGE(line.c_str());
+            }
+        }
+    }
+    TEST_ASSERT_TRUE_MESSAGE(passed, "AlertBenchmark::run(): ejecuciones fuera de los límites");
+
+    // Encabezado más al menos una fila por escenario y arranque, todas dentro de los límites
+    TEST_ASSERT_TRUE(rows.size() > 1 + 2 * BENCH_SCENARIO_COUNT);
+    TEST_ASSERT_EQUAL(0, rows[0].find("scenario,read_interval_ms,"));
+    for (size_t i = 1; i < rows.size(); i++) {
+        TEST_ASSERT_TRUE_MESSAGE(rows[i].find(",pass,") != std::string::npos, rows[i].c_str());
+    }
+
+    // La tabla del archivo es la misma que salió por Serial
+    for (const std::string& row : rows) {
+        TEST_ASSERT_TRUE(console.find(row) != std::string::npos);
+    }
+
+    // Reloj y calibraciones vuelven al funcionamiento normal
+    TEST_ASSERT_FALSE(Clock::isSimulated());
+    GasCalibration smokeAfter = SmokeSensor::getInstance()->getCalibration();
+    GasCalibration ch4After = CH4Sensor::getInstance()->getCalibration();
+    TEST_ASSERT_EQUAL(smokeBefore.baselineAvg, smokeAfter.baselineAvg);
+    TEST_ASSERT_EQUAL(smokeBefore.isCalibrated, smokeAfter.isCalibrated);
+    TEST_ASSERT_EQUAL(ch4Before.baselineAvg, ch4After.baselineAvg);
+    TEST_ASSERT_EQUAL(ch4Before.isCalibrated, ch4After.isCalibrated);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    // Arranque como main.cpp
+    Wire.attach(AHT20_ADDRESS, &aht);
+    Wire.attach(BMP280_ADDRESS, &bmp);
+    FileManager::getInstance()->begin();
+    SmokeSensor::getInstance(SMOKE_SENSOR_PIN)->begin(true);
+    CH4Sensor::getInstance(CH4_SENSOR_PIN)->begin(true);
+    EnvironmentSensor::getInstance()->begin(I2C_SDA, I2C_SCL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark_within_bounds);
+    return UNITY_END();
+}
@@ -0,0 +1,274 @@
+/*
+Pruebas de AlertRuleSet (tabla de reglas de alerta):
+
+Las reglas de fábrica dan el mismo nivel que la evaluación original en
+cadena de if (copiada abajo tal cual) para vectores aleatorios, con valores
+sobre los umbrales exactos y con el ambiente sin leer (temperatura 0)
+Regla del modelo de incendio, histéresis de los umbrales y archivo de reglas
+*/
+#include <unity.h>
+#include "alert/AlertRules.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Lectura reducida a lo que miraba la evaluación original
+struct Sample {
+    int smoke;                  // 0 NORMAL, 1 DETECTED, 2 CRITICAL
+    int ch4;                    // 0 NORMAL, 1 DETECTED, 2 CRITICAL, 3 EXPLOSIVE
+    bool envFire;               // FIRE_SUSPECTED o RAPID_TEMP_RISE
+    float ppm;
+    float temperature;
+    float tempRate;
+    float humidity;
+    float pressureDelta;
+};
+
+// Evaluación original (SmartAlert::evaluate antes de la tabla de reglas)
+static uint8_t baselineEvaluate(const Sample& s) {
+    bool smokeDetected = s.smoke >= 1;
+    bool smokeCritical = s.smoke == 2;
+    bool ch4Detected = s.ch4 >= 1;
+    bool ch4Critical = s.ch4 >= 2;
+    bool ch4Explosive = s.ch4 == 3;
+    bool fireSuspected = s.envFire;
+
+    int activeSensors = 0;
+
+    if (ch4Explosive) {
+        return ALERT_EXPLOSIVE;
+    }
+
+    if (ch4Critical && (smokeDetected || s.temperature > 45)) {
+        return ALERT_GAS_CRITICAL;
+    }
+
+    if (smokeCritical &&
+        s.temperature > 60 &&
+        s.pressureDelta < -5) {
+        return ALERT_FIRE_CONFIRMED;
+    }
+
+    if (fireSuspected ||
+        (s.temperature > 50 && s.tempRate > 5)) {
+        if (smokeDetected || s.ppm > 300) {
+            return ALERT_FIRE_SUSPECTED;
+        }
+    }
+
+    if (smokeDetected &&
+        s.humidity > 75 &&
+        s.temperature < 35 &&
+        !ch4Detected) {
+        return ALERT_COOKING;
+    }
+
+    if (smokeDetected) activeSensors++;
+    if (ch4Detected) activeSensors++;
+    if (s.temperature > 40) activeSensors++;
+    if (s.pressureDelta < -3) activeSensors++;
+
+    if (activeSensors >= 3) {
+        return ALERT_WARNING;
+    }
+
+    if (activeSensors >= 2) {
+        return ALERT_CAUTION;
+    }
+
+    if (activeSensors == 1) {
+        return ALERT_ANOMALY;
+    }
+
+    return ALERT_NORMAL;
+}
+
+// Igual que SmartAlert::extractFeatures (sin CUSUM ni modelo de incendio)
+static AlertInputs toInputs(const Sample& s) {
+    AlertInputs inputs;
+    inputs.stateBits = ((uint32_t)(s.smoke >= 1) << FEAT_SMOKE_DETECTED) |
+                       ((uint32_t)(s.smoke == 2) << FEAT_SMOKE_CRITICAL) |
+                       ((uint32_t)(s.ch4 >= 1) << FEAT_CH4_DETECTED) |
+                       ((uint32_t)(s.ch4 >= 2) << FEAT_CH4_CRITICAL) |
+                       ((uint32_t)(s.ch4 == 3) << FEAT_CH4_EXPLOSIVE) |
+                       ((uint32_t)s.envFire << FEAT_ENV_FIRE);
+    inputs.values[SRC_STATE] = 0;
+    inputs.values[SRC_SMOKE_PPM] = s.ppm;
+    inputs.values[SRC_TEMPERATURE] = s.temperature;
+    inputs.values[SRC_TEMP_RATE] = s.tempRate;
+    inputs.values[SRC_HUMIDITY] = s.humidity;
+    inputs.values[SRC_PRESSURE_DELTA] = s.pressureDelta;
+    inputs.values[SRC_FIRE_PROBABILITY] = 0;
+    return inputs;
+}
+
+// xorshift32: misma secuencia en cada corrida
+static uint32_t rng = 0x2545F491u;
+static uint32_t next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Mitad de las veces un valor justo en un umbral (o a ±0.01), si no uno cualquiera del rango
+static float pick(const float* edges, int count, float low, float high) {
+    if (next() & 1) {
+        float edge = edges[next() % count];
+        static const float offsets[] = { -0.01f, 0.0f, 0.01f };
+        return edge + offsets[next() % 3];
+    }
+    return low + (high - low) * (next() % 10001) / 10000.0f;
+}
+
+static Sample randomSample() {
+    static const float tempEdges[] = { 0, 35, 40, 45, 50, 60 };
+    static const float rateEdges[] = { 0, 5 };
+    static const float humidityEdges[] = { 0, 75 };
+    static const float pressureEdges[] = { 0, -3, -5 };
+    static const float ppmEdges[] = { 0, 300 };
+
+    Sample s;
+    s.smoke = next() % 3;
+    s.ch4 = next() % 4;
+    s.envFire = (next() % 4) == 0;
+    s.ppm = pick(ppmEdges, 2, 0, 1000);
+    s.temperature = pick(tempEdges, 6, -10, 80);
+    s.tempRate = pick(rateEdges, 2, -2, 15);
+    s.humidity = pick(humidityEdges, 2, 10, 100);
+    s.pressureDelta = pick(pressureEdges, 3, -8, 2);
+
+    // Ambiente sin leer: la lectura queda en cero (como antes de la tabla)
+    if ((next() % 5) == 0) {
+        s.envFire = false;
+        s.temperature = 0;
+        s.tempRate = 0;
+        s.humidity = 0;
+        s.pressureDelta = 0;
+    }
+    return s;
+}
+
+void test_defaults_match_baseline(void) {
+    AlertRuleSet rules;
+    int levels[ALERT_LEVEL_COUNT] = {};
+
+    for (int i = 0; i < 200000; i++) {
+        Sample s = randomSample();
+        uint8_t expected = baselineEvaluate(s);
+        uint8_t actual = rules.evaluate(rules.extract(toInputs(s)));
+        if (expected != actual) {
+            char message[160];
+            snprintf(message, sizeof(message),
+                     "smoke=%d ch4=%d env=%d ppm=%.2f t=%.2f rate=%.2f h=%.2f dp=%.2f",
+                     s.smoke, s.ch4, s.envFire, s.ppm, s.temperature, s.tempRate,
+                     s.humidity, s.pressureDelta);
+            TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, actual, message);
+        }
+        levels[expected]++;
+    }
+
+    // Todos los niveles aparecen (si no, la comparación no cubre alguna regla)
+    for (int level = 0; level < ALERT_LEVEL_COUNT; level++) {
+        TEST_ASSERT_GREATER_THAN(0, levels[level]);
+    }
+}
+
+void test_env_not_ready_is_temperature_zero(void) {
+    // Humo con humedad 0 y temperatura 0: sin cocina, una sola anomalía
+    AlertRuleSet rules;
+    Sample s = { 1, 0, false, 0, 0, 0, 0, 0 };
+    TEST_ASSERT_EQUAL_UINT8(ALERT_ANOMALY, baselineEvaluate(s));
+    TEST_ASSERT_EQUAL_UINT8(ALERT_ANOMALY, rules.evaluate(rules.extract(toInputs(s))));
+
+    // CH4 crítico sin humo no llega a GAS_CRITICAL con temperatura 0
+    s = { 0, 2, false, 0, 0, 0, 0, 0 };
+    TEST_ASSERT_EQUAL_UINT8(ALERT_ANOMALY, baselineEvaluate(s));
+    TEST_ASSERT_EQUAL_UINT8(ALERT_ANOMALY, rules.evaluate(rules.extract(toInputs(s))));
+}
+
+void test_fire_model_rule(void) {
+    // Sin humo ni calor que dispare los patrones 2 y 3: decide el modelo
+    AlertRuleSet rules;
+    Sample s = { 1, 0, false, 0, 30, 0, 85, 0 };
+    AlertInputs inputs = toInputs(s);
+    TEST_ASSERT_EQUAL_UINT8(ALERT_COOKING, rules.evaluate(rules.extract(inputs)));
+
+    inputs.values[SRC_FIRE_PROBABILITY] = 0.85f;
+    uint32_t features = rules.extract(inputs);
+    TEST_ASSERT_EQUAL_UINT8(ALERT_FIRE_SUSPECTED, rules.evaluate(features));
+
+    // Banda de salida 0.1: se mantiene hasta bajar de 0.7
+    inputs.values[SRC_FIRE_PROBABILITY] = 0.75f;
+    features = rules.extract(inputs, features);
+    TEST_ASSERT_EQUAL_UINT8(ALERT_FIRE_SUSPECTED, rules.evaluate(features));
+    inputs.values[SRC_FIRE_PROBABILITY] = 0.65f;
+    features = rules.extract(inputs, features);
+    TEST_ASSERT_EQUAL_UINT8(ALERT_COOKING, rules.evaluate(features));
+
+    // Los patrones más graves siguen teniendo prioridad
+    s.ch4 = 3;
+    inputs = toInputs(s);
+    inputs.values[SRC_FIRE_PROBABILITY] = 0.95f;
+    TEST_ASSERT_EQUAL_UINT8(ALERT_EXPLOSIVE, rules.evaluate(rules.extract(inputs)));
+}
+
+void test_hysteresis_band(void) {
+    AlertRuleSet rules;
+    Sample s = { 0, 0, false, 0, 40.5f, 0, 50, 0 };
+    uint32_t features = rules.extract(toInputs(s));
+    TEST_ASSERT_TRUE(features & FEAT(FEAT_TEMP_HIGH));
+
+    // Bajo el umbral pero dentro de la banda: sigue activa
+    s.temperature = 39.5f;
+    features = rules.extract(toInputs(s), features);
+    TEST_ASSERT_TRUE(features & FEAT(FEAT_TEMP_HIGH));
+
+    // Bajo umbral - banda: se libera, y sin la previa no vuelve hasta superar 40
+    s.temperature = 38.9f;
+    features = rules.extract(toInputs(s), features);
+    TEST_ASSERT_FALSE(features & FEAT(FEAT_TEMP_HIGH));
+    s.temperature = 39.5f;
+    features = rules.extract(toInputs(s), features);
+    TEST_ASSERT_FALSE(features & FEAT(FEAT_TEMP_HIGH));
+}
+
+void test_parse_rules_and_thresholds(void) {
+    AlertRuleSet rules;
+    AlertRule rule;
+
+    TEST_ASSERT_EQUAL_INT(0, rules.parseLine("# comentario", rule));
+    TEST_ASSERT_EQUAL_INT(0, rules.parseLine("   ", rule));
+    TEST_ASSERT_EQUAL_INT(0, rules.parseLine("threshold TEMP_HIGH 42 2", rule));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, rules.getThreshold(FEAT_TEMP_HIGH));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, rules.getBand(FEAT_TEMP_HIGH));
+
+    TEST_ASSERT_EQUAL_INT(1, rules.parseLine("rule WARNING count=SMOKE_DETECTED|CH4_DETECTED min=2\r", rule));
+    TEST_ASSERT_EQUAL_UINT32(FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_CH4_DETECTED), rule.count);
+    TEST_ASSERT_EQUAL_UINT8(2, rule.minCount);
+    TEST_ASSERT_EQUAL_UINT8(ALERT_WARNING, rule.level);
+
+    // Nombres desconocidos, umbral sobre una característica de estado, clave inválida
+    TEST_ASSERT_EQUAL_INT(-1, rules.parseLine("rule PANIC all=SMOKE_DETECTED", rule));
+    TEST_ASSERT_EQUAL_INT(-1, rules.parseLine("rule WARNING all=SMOKE", rule));
+    TEST_ASSERT_EQUAL_INT(-1, rules.parseLine("threshold SMOKE_DETECTED 1", rule));
+    TEST_ASSERT_EQUAL_INT(-1, rules.parseLine("rule WARNING any=SMOKE_DETECTED", rule));
+
+    // Tabla propia: gana la primera que coincide
+    rules.clearRules();
+    rules.addRule({ FEAT(FEAT_SMOKE_DETECTED), 0, 0, 0, ALERT_CAUTION });
+    rules.addRule({ FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_CH4_DETECTED), 0, 0, 0, ALERT_WARNING });
+    TEST_ASSERT_EQUAL_UINT8(ALERT_CAUTION,
+                            rules.evaluate(FEAT(FEAT_SMOKE_DETECTED) | FEAT(FEAT_CH4_DETECTED)));
+    TEST_ASSERT_EQUAL_UINT8(ALERT_NORMAL, rules.evaluate(FEAT(FEAT_CH4_DETECTED)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_match_baseline);
+    RUN_TEST(test_env_not_ready_is_temperature_zero);
+    RUN_TEST(test_fire_model_rule);
+    RUN_TEST(test_hysteresis_band);
+    RUN_TEST(test_parse_rules_and_thresholds);
+    return UNITY_END();
+}
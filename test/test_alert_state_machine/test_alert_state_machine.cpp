@@ -0,0 +1,105 @@
+/*
+Pruebas de AlertStateMachine (antirrebote del nivel publicado):
+
+Subida inmediata y bajada tras N muestras y la permanencia mínima
+La bajada va al nivel más alto visto durante la espera
+Una señal que oscila en el borde no cambia el nivel publicado
+*/
+#include <unity.h>
+#include "alert/AlertStateMachine.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_escalates_immediately(void) {
+    AlertStateMachine machine(3, 5000, 30000);
+    TEST_ASSERT_EQUAL_INT(ALERT_NORMAL, machine.getLevel());
+    TEST_ASSERT_TRUE(machine.update(ALERT_CAUTION, 1000));
+    TEST_ASSERT_EQUAL_INT(ALERT_CAUTION, machine.getLevel());
+    TEST_ASSERT_TRUE(machine.update(ALERT_FIRE_SUSPECTED, 1500));
+    TEST_ASSERT_EQUAL_INT(ALERT_FIRE_SUSPECTED, machine.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(2, machine.getEscalations());
+    TEST_ASSERT_EQUAL_UINT32(0, machine.getDeescalations());
+}
+
+void test_deescalates_after_samples_and_dwell(void) {
+    AlertStateMachine machine(3, 5000, 30000);
+    machine.update(ALERT_CAUTION, 0);
+
+    // Tres muestras bajas pero dentro de la permanencia: se retiene
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 1000));
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 2000));
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 3000));
+    TEST_ASSERT_EQUAL_INT(ALERT_CAUTION, machine.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(3, machine.getHeld());
+
+    TEST_ASSERT_TRUE(machine.update(ALERT_NORMAL, 5000));
+    TEST_ASSERT_EQUAL_INT(ALERT_NORMAL, machine.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1, machine.getDeescalations());
+    TEST_ASSERT_EQUAL_UINT32(2, machine.getTransitions());
+}
+
+void test_confirmation_restarts_dwell_and_count(void) {
+    AlertStateMachine machine(2, 5000, 30000);
+    machine.update(ALERT_WARNING, 0);
+    machine.update(ALERT_NORMAL, 1000);
+    machine.update(ALERT_WARNING, 4000);      // Confirma: cuenta y tiempo desde aquí
+
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 6000));
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 8000));   // 2 muestras, solo 4 s
+    TEST_ASSERT_TRUE(machine.update(ALERT_NORMAL, 9000));
+}
+
+void test_steps_down_to_highest_pending(void) {
+    AlertStateMachine machine(3, 0, 0);
+    machine.update(ALERT_WARNING, 0);
+    machine.update(ALERT_ANOMALY, 100);
+    machine.update(ALERT_CAUTION, 200);
+    TEST_ASSERT_TRUE(machine.update(ALERT_NORMAL, 300));
+    TEST_ASSERT_EQUAL_INT(ALERT_CAUTION, machine.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1, machine.getEntries(ALERT_CAUTION));
+    TEST_ASSERT_EQUAL_UINT32(300, machine.getTimeInLevel(600));
+}
+
+void test_critical_levels_use_longer_dwell(void) {
+    AlertStateMachine machine(1, 1000, 30000);
+    machine.update(ALERT_FIRE_CONFIRMED, 0);
+    TEST_ASSERT_FALSE(machine.update(ALERT_NORMAL, 29999));
+    TEST_ASSERT_TRUE(machine.update(ALERT_NORMAL, 30000));
+
+    machine.setDwell(ALERT_CAUTION, 0);
+    machine.update(ALERT_CAUTION, 31000);
+    TEST_ASSERT_TRUE(machine.update(ALERT_NORMAL, 31000));
+}
+
+void test_chattering_input_is_stable(void) {
+    // Alterna CAUTION/ANOMALY en cada muestra: publica CAUTION una sola vez
+    AlertStateMachine machine(3, 5000, 30000);
+    uint32_t changes = 0;
+    for (uint32_t i = 0; i < 1000; i++) {
+        changes += machine.update((i & 1) ? ALERT_ANOMALY : ALERT_CAUTION, i * 250);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, changes);
+    TEST_ASSERT_EQUAL_INT(ALERT_CAUTION, machine.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(500, machine.getHeld());
+}
+
+void test_reset_returns_to_normal(void) {
+    AlertStateMachine machine(3, 5000, 30000);
+    machine.update(ALERT_EXPLOSIVE, 0);
+    machine.reset(100);
+    TEST_ASSERT_EQUAL_INT(ALERT_NORMAL, machine.getLevel());
+    TEST_ASSERT_TRUE(machine.update(ALERT_ANOMALY, 200));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_escalates_immediately);
+    RUN_TEST(test_deescalates_after_samples_and_dwell);
+    RUN_TEST(test_confirmation_restarts_dwell_and_count);
+    RUN_TEST(test_steps_down_to_highest_pending);
+    RUN_TEST(test_critical_levels_use_longer_dwell);
+    RUN_TEST(test_chattering_input_is_stable);
+    RUN_TEST(test_reset_returns_to_normal);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+/*
+Pruebas de BaselineTracker (seguimiento del baseline en aire limpio):
+
+Ventanas estables acercan el baseline a su media sin pasarse
+La deriva por día y la total respetan sus topes (una fuga lenta no se normaliza)
+Lecturas sucias o ventanas ruidosas no mueven el baseline
+La referencia cargada conserva la deriva guardada (acotada)
+*/
+#include <unity.h>
+#include "utils/BaselineTracker.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Mismos parámetros que GasSensor: ventana 10 min, 8 cuentas, 20/día, 300 total
+#define WINDOW_MS 600000UL
+#define READING_MS 10000UL
+
+static BaselineTracker makeTracker() {
+    BaselineTracker tracker(WINDOW_MS, 8.0f, 20, 300);
+    tracker.setAnchor(1000);
+    return tracker;
+}
+
+// Una lectura cada 10 s durante la duración indicada; devuelve el tiempo final
+static uint32_t feed(BaselineTracker& tracker, uint32_t now, uint32_t durationMs,
+                     float mean, bool clean = true) {
+    for (uint32_t t = 0; t < durationMs; t += READING_MS) {
+        now += READING_MS;
+        tracker.add(mean, clean, now);
+    }
+    return now;
+}
+
+void test_converges_without_overshoot(void) {
+    BaselineTracker tracker = makeTracker();
+    uint32_t now = feed(tracker, 0, 2 * BASELINE_TRACKER_DAY_MS, 1005.0f);
+
+    TEST_ASSERT_EQUAL_INT32(5, tracker.getDrift());
+    TEST_ASSERT_EQUAL_INT32(1005, tracker.getBaseline());
+    TEST_ASSERT_EQUAL_INT32(1000, tracker.getAnchor());
+
+    feed(tracker, now, BASELINE_TRACKER_DAY_MS, 1005.0f);
+    TEST_ASSERT_EQUAL_INT32(1005, tracker.getBaseline());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getRejectedWindows());
+}
+
+void test_daily_drift_is_capped(void) {
+    BaselineTracker tracker = makeTracker();
+    feed(tracker, 0, BASELINE_TRACKER_DAY_MS, 1100.0f);
+
+    // 144 ventanas × paso máximo: poco menos de 20 cuentas
+    TEST_ASSERT_INT32_WITHIN(1, 20, tracker.getDrift());
+    TEST_ASSERT_TRUE(tracker.getDrift() <= 20);
+}
+
+void test_total_drift_is_capped(void) {
+    BaselineTracker tracker = makeTracker();
+    feed(tracker, 0, 20 * BASELINE_TRACKER_DAY_MS, 600.0f);
+
+    TEST_ASSERT_EQUAL_INT32(-300, tracker.getDrift());
+    TEST_ASSERT_EQUAL_INT32(700, tracker.getBaseline());
+}
+
+void test_dirty_reading_discards_window(void) {
+    BaselineTracker tracker = makeTracker();
+    uint32_t now = 0;
+
+    // Una lectura sucia antes de cerrar cada ventana: ninguna cuenta
+    for (int i = 0; i < 50; i++) {
+        now = feed(tracker, now, WINDOW_MS - 2 * READING_MS, 1050.0f);
+        now = feed(tracker, now, READING_MS, 1050.0f, false);
+    }
+    TEST_ASSERT_EQUAL_INT32(0, tracker.getDrift());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getAcceptedWindows());
+    TEST_ASSERT_EQUAL_UINT32(50, tracker.getRejectedWindows());
+}
+
+void test_noisy_window_rejected(void) {
+    BaselineTracker tracker = makeTracker();
+    uint32_t now = 0;
+    for (int i = 0; i < 500; i++) {
+        now += READING_MS;
+        tracker.add(i % 2 ? 1030.0f : 1010.0f, true, now);   // Desvío ≈ 10 cuentas
+    }
+    TEST_ASSERT_EQUAL_INT32(0, tracker.getDrift());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getAcceptedWindows());
+    TEST_ASSERT_TRUE(tracker.getRejectedWindows() > 0);
+}
+
+void test_add_reports_integer_change(void) {
+    BaselineTracker tracker = makeTracker();
+    uint32_t now = 0;
+    int changes = 0;
+    for (uint32_t t = 0; t < BASELINE_TRACKER_DAY_MS; t += READING_MS) {
+        now += READING_MS;
+        changes += tracker.add(1100.0f, true, now) ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_INT(tracker.getDrift(), changes);
+}
+
+void test_set_anchor_restores_and_clamps_drift(void) {
+    BaselineTracker tracker(WINDOW_MS, 8.0f, 20, 300);
+
+    tracker.setAnchor(900, 42 * 256);
+    TEST_ASSERT_EQUAL_INT32(900, tracker.getAnchor());
+    TEST_ASSERT_EQUAL_INT32(42, tracker.getDrift());
+    TEST_ASSERT_EQUAL_INT32(942, tracker.getBaseline());
+
+    tracker.setAnchor(900, -1000 * 256);
+    TEST_ASSERT_EQUAL_INT32(-300, tracker.getDrift());
+}
+
+void test_window_across_millis_wrap(void) {
+    BaselineTracker tracker = makeTracker();
+    uint32_t start = 0xFFFFFFFFUL - WINDOW_MS / 2;
+    feed(tracker, start, 3 * WINDOW_MS, 1005.0f);   // Cada ventana cierra en la lectura 61
+    TEST_ASSERT_EQUAL_UINT32(2, tracker.getAcceptedWindows());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_converges_without_overshoot);
+    RUN_TEST(test_daily_drift_is_capped);
+    RUN_TEST(test_total_drift_is_capped);
+    RUN_TEST(test_dirty_reading_discards_window);
+    RUN_TEST(test_noisy_window_rejected);
+    RUN_TEST(test_add_reports_integer_change);
+    RUN_TEST(test_set_anchor_restores_and_clamps_drift);
+    RUN_TEST(test_window_across_millis_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,210 @@
+/*
+Pruebas del driver BMP280:
+
+Compensación entera contra el ejemplo del datasheet (sección 3.12):
+t_fine = 128422, T = 25.08 °C, P = 25767236 / 256 = 100653 Pa
+(el código entero de referencia da 25767233 con esos datos: la tabla del
+datasheet redondea desde el cálculo en punto flotante, 3/256 Pa de diferencia)
+Sobre el bus I2C simulado (test/host): detección, lectura de la calibración
+little-endian, configuración en modo normal, lectura en un único burst y
+exactitud contra las fórmulas de punto flotante del datasheet
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include "sensors/BMP280.h"
+
+static BMP280Calibration datasheet;
+static HostBMP280* device;
+static BMP280Driver* driver;
+
+void setUp(void) {
+    datasheet = {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000};
+
+    HostSim::nowUs = 0;
+    device = new HostBMP280();
+    driver = new BMP280Driver();
+    Wire = TwoWire();
+    Wire.begin(21, 22);
+    Wire.attach(BMP280_ADDRESS, device);
+}
+
+void tearDown(void) {
+    Wire.detach(BMP280_ADDRESS);
+    Wire.detach(BMP280_ADDRESS_ALT);
+    delete driver;
+    delete device;
+}
+
+// ==================== Compensación (datasheet) ====================
+
+void test_datasheet_temperature(void) {
+    int32_t tFine = 0;
+    TEST_ASSERT_EQUAL_INT32(2508, BMP280Driver::compensateTemperature(datasheet, 519888, tFine));
+    TEST_ASSERT_EQUAL_INT32(128422, tFine);
+}
+
+void test_datasheet_pressure(void) {
+    uint32_t pressureQ8 = BMP280Driver::compensatePressure(datasheet, 415148, 128422);
+    TEST_ASSERT_EQUAL_UINT32(25767233, pressureQ8);
+    TEST_ASSERT_UINT_WITHIN(4, 25767236, pressureQ8);
+    TEST_ASSERT_EQUAL_UINT32(100653, pressureQ8 >> 8);
+}
+
+void test_compensate_uses_driver_calibration(void) {
+    driver->setCalibration(datasheet);
+    int32_t temperatureCenti;
+    uint32_t pressureQ8;
+    TEST_ASSERT_TRUE(driver->compensate(519888, 415148, temperatureCenti, pressureQ8));
+    TEST_ASSERT_EQUAL_INT32(2508, temperatureCenti);
+    TEST_ASSERT_EQUAL_UINT32(100653, pressureQ8 >> 8);
+}
+
+void test_invalid_calibration_has_no_pressure(void) {
+    // digP1 = 0 (sensor sin leer): división por cero evitada, presión inválida
+    BMP280Calibration empty = {};
+    driver->setCalibration(empty);
+    int32_t temperatureCenti;
+    uint32_t pressureQ8;
+    TEST_ASSERT_FALSE(driver->compensate(519888, 415148, temperatureCenti, pressureQ8));
+    TEST_ASSERT_EQUAL_UINT32(0, pressureQ8);
+}
+
+void test_matches_floating_point_formulas(void) {
+    // La versión entera y la de punto flotante del datasheet coinciden
+    for (int32_t adcT = 400000; adcT <= 600000; adcT += 20000) {
+        for (int32_t adcP = 250000; adcP <= 450000; adcP += 20000) {
+            int32_t tFine;
+            int32_t temperatureCenti = BMP280Driver::compensateTemperature(datasheet, adcT, tFine);
+            uint32_t pressureQ8 = BMP280Driver::compensatePressure(datasheet, adcP, tFine);
+
+            double celsius;
+            double pascal;
+            device->compensate(adcT, adcP, celsius, pascal);
+            TEST_ASSERT_FLOAT_WITHIN(0.011, celsius, temperatureCenti / 100.0);
+            TEST_ASSERT_FLOAT_WITHIN(1.0, pascal, pressureQ8 / 256.0);
+        }
+    }
+}
+
+// ==================== Bus ====================
+
+void test_begin_reads_calibration(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+
+    const BMP280Calibration& calibration = driver->getCalibration();
+    TEST_ASSERT_EQUAL_UINT16(27504, calibration.digT1);
+    TEST_ASSERT_EQUAL_INT16(26435, calibration.digT2);
+    TEST_ASSERT_EQUAL_INT16(-1000, calibration.digT3);
+    TEST_ASSERT_EQUAL_UINT16(36477, calibration.digP1);
+    TEST_ASSERT_EQUAL_INT16(-10685, calibration.digP2);
+    TEST_ASSERT_EQUAL_INT16(3024, calibration.digP3);
+    TEST_ASSERT_EQUAL_INT16(2855, calibration.digP4);
+    TEST_ASSERT_EQUAL_INT16(140, calibration.digP5);
+    TEST_ASSERT_EQUAL_INT16(-7, calibration.digP6);
+    TEST_ASSERT_EQUAL_INT16(15500, calibration.digP7);
+    TEST_ASSERT_EQUAL_INT16(-14600, calibration.digP8);
+    TEST_ASSERT_EQUAL_INT16(6000, calibration.digP9);
+
+    // osrs_t x2, osrs_p x16, modo normal; standby 500 ms, filtro x16
+    TEST_ASSERT_EQUAL_HEX8(0x57, device->ctrlMeas());
+    TEST_ASSERT_EQUAL_HEX8(0x90, device->config());
+    TEST_ASSERT_EQUAL_UINT32(0, driver->getErrorCount());
+}
+
+void test_begin_alternate_address(void) {
+    Wire.detach(BMP280_ADDRESS);
+    Wire.attach(BMP280_ADDRESS_ALT, device);
+    TEST_ASSERT_FALSE(driver->begin(Wire, BMP280_ADDRESS));
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS_ALT));
+}
+
+void test_begin_rejects_other_chip(void) {
+    // Otro dispositivo en la dirección (el AHT20 responde su estado, no 0x58)
+    HostAHT20 other;
+    Wire.attach(BMP280_ADDRESS, &other);
+    TEST_ASSERT_FALSE(driver->begin(Wire, BMP280_ADDRESS));
+}
+
+void test_no_data_before_first_conversion(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+
+    // Reinicio del sensor: modo sleep y registros de datos en 0x80000
+    device->powerCycle();
+    int32_t adcT;
+    int32_t adcP;
+    TEST_ASSERT_FALSE(driver->readRaw(adcT, adcP));
+    TEST_ASSERT_EQUAL_INT32(0x80000, adcT);
+    TEST_ASSERT_EQUAL_UINT32(0, driver->getErrorCount());
+}
+
+void test_single_burst_read(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+    Wire.resetStats();
+
+    int32_t temperatureCenti;
+    uint32_t pressureQ8;
+    TEST_ASSERT_TRUE(driver->read(temperatureCenti, pressureQ8));
+
+    // Puntero + 6 bytes: dos transacciones, una sola conversión leída
+    TEST_ASSERT_EQUAL_UINT32(1, device->burstReads);
+    TEST_ASSERT_EQUAL_UINT32(2, Wire.getStats().transactions);
+    TEST_ASSERT_EQUAL_UINT32(7, Wire.getStats().bytes);
+}
+
+void test_read_accuracy(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+
+    const double conditions[][2] = {{-10.0, 950.0}, {0.0, 1013.25}, {22.0, 1000.0}, {45.5, 880.0}, {70.0, 1080.0}};
+    for (const auto& condition : conditions) {
+        device->celsius = condition[0];
+        device->hPa = condition[1];
+
+        int32_t temperatureCenti;
+        uint32_t pressureQ8;
+        TEST_ASSERT_TRUE(driver->read(temperatureCenti, pressureQ8));
+        TEST_ASSERT_FLOAT_WITHIN(0.05, condition[0], temperatureCenti / 100.0);
+        TEST_ASSERT_FLOAT_WITHIN(0.1, condition[1], pressureQ8 / 25600.0);
+    }
+}
+
+void test_short_read_is_an_error(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+    device->shortReads = 1;
+
+    int32_t adcT;
+    int32_t adcP;
+    TEST_ASSERT_FALSE(driver->readRaw(adcT, adcP));
+    TEST_ASSERT_EQUAL_UINT32(1, driver->getErrorCount());
+
+    TEST_ASSERT_TRUE(driver->readRaw(adcT, adcP));
+}
+
+void test_nack_is_an_error(void) {
+    TEST_ASSERT_TRUE(driver->begin(Wire, BMP280_ADDRESS));
+    Wire.failNext(BMP280_ADDRESS, 2);
+
+    int32_t adcT;
+    int32_t adcP;
+    TEST_ASSERT_FALSE(driver->readRaw(adcT, adcP));
+    TEST_ASSERT_FALSE(driver->readRaw(adcT, adcP));
+    TEST_ASSERT_EQUAL_UINT32(2, driver->getErrorCount());
+    TEST_ASSERT_TRUE(driver->readRaw(adcT, adcP));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_datasheet_temperature);
+    RUN_TEST(test_datasheet_pressure);
+    RUN_TEST(test_compensate_uses_driver_calibration);
+    RUN_TEST(test_invalid_calibration_has_no_pressure);
+    RUN_TEST(test_matches_floating_point_formulas);
+    RUN_TEST(test_begin_reads_calibration);
+    RUN_TEST(test_begin_alternate_address);
+    RUN_TEST(test_begin_rejects_other_chip);
+    RUN_TEST(test_no_data_before_first_conversion);
+    RUN_TEST(test_single_burst_read);
+    RUN_TEST(test_read_accuracy);
+    RUN_TEST(test_short_read_is_an_error);
+    RUN_TEST(test_nack_is_an_error);
+    return UNITY_END();
+}
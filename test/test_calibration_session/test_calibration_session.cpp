@@ -0,0 +1,102 @@
+/*
+Pruebas de CalibrationSession y WelfordStats con reloj virtual:
+
+Media/varianza contra el cálculo de dos pasadas
+Ritmo mínimo entre muestras, progreso, fin y aborto
+*/
+#include <unity.h>
+#include "utils/CalibrationSession.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_welford_matches_two_pass(void) {
+    WelfordStats stats;
+    double values[500];
+    double sum = 0;
+    for (int i = 0; i < 500; i++) {
+        values[i] = 1800.0 + (i * 37 % 23) - 11;    // Ruido determinista ±11
+        stats.add((float)values[i]);
+        sum += values[i];
+    }
+    double mean = sum / 500;
+    double squares = 0;
+    for (int i = 0; i < 500; i++) {
+        squares += (values[i] - mean) * (values[i] - mean);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(500, stats.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, mean, stats.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, squares / 499, stats.variance());
+    TEST_ASSERT_EQUAL_FLOAT(1789.0f, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(1811.0f, stats.max);
+}
+
+void test_welford_range_without_moments(void) {
+    WelfordStats stats;
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.variance());
+    stats.add(10);
+    stats.includeRange(2, 30);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.variance());
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, stats.max);
+}
+
+void test_session_paces_and_completes(void) {
+    CalibrationSession<2> session;
+    TEST_ASSERT_FALSE(session.start(0, 1000, 0));
+    TEST_ASSERT_TRUE(session.start(3, 1000, 5000));
+
+    // Primera muestra inmediata, luego como mínimo cada 1000 ms
+    uint32_t now = 5000;
+    int taken = 0;
+    bool done = false;
+    while (!done && now < 20000) {
+        if (session.shouldSample(now)) {
+            session.stats(0).add(100);
+            session.stats(1).add(200);
+            taken++;
+            done = session.commitSample(now);
+        }
+        now += 250;
+    }
+
+    TEST_ASSERT_TRUE(done);
+    TEST_ASSERT_EQUAL_INT(3, taken);
+    TEST_ASSERT_EQUAL_UINT32(7250, now);                 // 5000, 6000, 7000 (+1 paso)
+    TEST_ASSERT_EQUAL_INT(100, session.getProgress());
+    TEST_ASSERT_TRUE(session.getStatus() == CalibrationStatus::COMPLETED);
+    TEST_ASSERT_FALSE(session.shouldSample(now + 5000));
+    TEST_ASSERT_EQUAL_FLOAT(200.0f, session.stats(1).mean);
+}
+
+void test_session_abort_and_restart(void) {
+    CalibrationSession<1> session;
+    session.abort();
+    TEST_ASSERT_TRUE(session.getStatus() == CalibrationStatus::IDLE);
+
+    session.start(4, 0, 0);
+    session.stats(0).add(1);
+    session.commitSample(0);
+    TEST_ASSERT_EQUAL_INT(25, session.getProgress());
+
+    session.abort();
+    TEST_ASSERT_TRUE(session.getStatus() == CalibrationStatus::ABORTED);
+    TEST_ASSERT_FALSE(session.shouldSample(100));
+
+    // Reiniciar descarta lo acumulado
+    session.start(4, 0, 200);
+    TEST_ASSERT_EQUAL_UINT32(0, session.stats(0).count);
+    TEST_ASSERT_EQUAL_INT(0, session.getProgress());
+    TEST_ASSERT_TRUE(session.isRunning());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_welford_matches_two_pass);
+    RUN_TEST(test_welford_range_without_moments);
+    RUN_TEST(test_session_paces_and_completes);
+    RUN_TEST(test_session_abort_and_restart);
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+/*
+Pruebas de CompensationGrid (corrección temperatura × humedad):
+
+Interpolación bilineal en punto fijo contra la misma cuenta en double
+Valores exactos en los nodos y borde fuera de la grilla
+Lectura del archivo de texto: grilla completa, líneas inválidas
+apply() redondea y satura
+*/
+#include <unity.h>
+#include <math.h>
+#include "utils/CompensationGrid.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const int16_t TEMPS[] = {-100, 0, 200, 400, 500};
+static const int16_t HUMS[] = {330, 850};
+static const uint16_t GAINS[] = {
+    5325, 4997,     // 1.30 1.22
+    4915, 4669,     // 1.20 1.14
+    4096, 3891,     // 1.00 0.95
+    3604, 3400,     // 0.88 0.83
+    3441, 3236,     // 0.84 0.79
+};
+
+static CompensationGrid makeGrid() {
+    CompensationGrid grid;
+    TEST_ASSERT_TRUE(grid.set(TEMPS, 5, HUMS, 2, GAINS));
+    return grid;
+}
+
+// Bilineal en double con el mismo recorte a los bordes
+static double axisPosition(const int16_t* axis, int count, int x, int& index) {
+    if (x <= axis[0]) { index = 0; return 0.0; }
+    if (x >= axis[count - 1]) { index = count - 2; return 1.0; }
+    index = 0;
+    while (x >= axis[index + 1]) index++;
+    return (double)(x - axis[index]) / (axis[index + 1] - axis[index]);
+}
+
+static double reference(int temp, int hum) {
+    int t, h;
+    double wt = axisPosition(TEMPS, 5, temp, t);
+    double wh = axisPosition(HUMS, 2, hum, h);
+    double low = GAINS[t * 2 + h] * (1 - wh) + GAINS[t * 2 + h + 1] * wh;
+    double high = GAINS[(t + 1) * 2 + h] * (1 - wh) + GAINS[(t + 1) * 2 + h + 1] * wh;
+    return low * (1 - wt) + high * wt;
+}
+
+void test_unity_grid(void) {
+    CompensationGrid grid;
+    TEST_ASSERT_EQUAL_UINT16(COMP_GAIN_ONE, grid.gain(-400, 0));
+    TEST_ASSERT_EQUAL_UINT16(COMP_GAIN_ONE, grid.gain(250, 500));
+    TEST_ASSERT_EQUAL_UINT16(COMP_GAIN_ONE, grid.gain(850, 1000));
+}
+
+void test_exact_at_nodes(void) {
+    CompensationGrid grid = makeGrid();
+    for (int t = 0; t < 5; t++) {
+        for (int h = 0; h < 2; h++) {
+            TEST_ASSERT_EQUAL_UINT16(GAINS[t * 2 + h], grid.gain(TEMPS[t], HUMS[h]));
+        }
+    }
+}
+
+void test_edges_clamped(void) {
+    CompensationGrid grid = makeGrid();
+    TEST_ASSERT_EQUAL_UINT16(GAINS[0], grid.gain(-300, 100));
+    TEST_ASSERT_EQUAL_UINT16(GAINS[1], grid.gain(-300, 1000));
+    TEST_ASSERT_EQUAL_UINT16(GAINS[8], grid.gain(800, 0));
+    TEST_ASSERT_EQUAL_UINT16(GAINS[9], grid.gain(800, 1000));
+}
+
+void test_matches_double_bilinear(void) {
+    CompensationGrid grid = makeGrid();
+    double worst = 0;
+    for (int temp = -200; temp <= 600; temp += 3) {
+        for (int hum = 0; hum <= 1000; hum += 7) {
+            double error = fabs(grid.gain(temp, hum) - reference(temp, hum));
+            if (error > worst) worst = error;
+        }
+    }
+    // Pesos Q12 truncados: menos de un par de unidades Q12
+    TEST_ASSERT_TRUE(worst < 2.0);
+}
+
+void test_monotonic_between_nodes(void) {
+    // Ganancias decrecientes con la temperatura: la interpolación no se sale
+    CompensationGrid grid = makeGrid();
+    uint16_t previous = grid.gain(-100, 500);
+    for (int temp = -99; temp <= 500; temp++) {
+        uint16_t current = grid.gain(temp, 500);
+        TEST_ASSERT_TRUE(current <= previous);
+        previous = current;
+    }
+}
+
+void test_set_rejects_invalid_axes(void) {
+    CompensationGrid grid = makeGrid();
+    const int16_t unsorted[] = {0, 200, 100};
+    const uint16_t values[6] = {4096, 4096, 4096, 4096, 4096, 4096};
+
+    TEST_ASSERT_FALSE(grid.set(unsorted, 3, HUMS, 2, values));
+    TEST_ASSERT_FALSE(grid.set(TEMPS, COMP_GRID_MAX_AXIS + 1, HUMS, 2, values));
+    // La grilla anterior queda intacta
+    TEST_ASSERT_EQUAL_UINT8(5, grid.getTemperaturePoints());
+    TEST_ASSERT_EQUAL_UINT16(GAINS[4], grid.gain(200, 330));
+}
+
+void test_parse_file(void) {
+    const char* lines[] = {
+        "# Corrección MQ-2",
+        "temp -10 0 20 40 50",
+        "hum 33 85   # humedad relativa",
+        "",
+        "gain 1.30 1.22",
+        "gain 1.20 1.14",
+        "gain 1.00 0.95\r",
+        "gain 0.88 0.83",
+        "  gain 0.84 0.79",
+    };
+    CompensationGrid grid;
+    grid.clear();
+    for (const char* line : lines) {
+        TEST_ASSERT_EQUAL_INT(0, grid.parseLine(line));
+    }
+    TEST_ASSERT_TRUE(grid.isComplete());
+
+    CompensationGrid expected = makeGrid();
+    for (int temp = -200; temp <= 600; temp += 25) {
+        for (int hum = 0; hum <= 1000; hum += 50) {
+            TEST_ASSERT_UINT16_WITHIN(1, expected.gain(temp, hum), grid.gain(temp, hum));
+        }
+    }
+}
+
+void test_parse_rejects_invalid_lines(void) {
+    CompensationGrid grid;
+    grid.clear();
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 1.0"));            // Sin ejes
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("temp 20 10"));          // Eje no creciente
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("offset 3"));            // Directiva desconocida
+
+    grid.clear();
+    TEST_ASSERT_EQUAL_INT(0, grid.parseLine("temp 0 20"));
+    TEST_ASSERT_EQUAL_INT(0, grid.parseLine("hum 30 80"));
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 1.0"));            // Faltan columnas
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 1.0 abc"));        // No numérico
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 1.0 4.5"));        // Fuera de rango
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 0 1.0"));
+    TEST_ASSERT_EQUAL_INT(0, grid.parseLine("gain 1.0 1.1"));
+    TEST_ASSERT_FALSE(grid.isComplete());
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("temp 0 30"));           // Ejes tras filas
+    TEST_ASSERT_EQUAL_INT(0, grid.parseLine("gain 0.9 1.0"));
+    TEST_ASSERT_TRUE(grid.isComplete());
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("gain 0.9 1.0"));        // Fila de más
+    TEST_ASSERT_EQUAL_INT(-1, grid.parseLine("temp 1 2 3 4 5 6 7 8 9"));
+}
+
+void test_apply_rounds_and_saturates(void) {
+    TEST_ASSERT_EQUAL_UINT16(1000, CompensationGrid::apply(1000, COMP_GAIN_ONE, 4095));
+    TEST_ASSERT_EQUAL_UINT16(1300, CompensationGrid::apply(1000, 5325, 4095));
+    TEST_ASSERT_EQUAL_UINT16(2, CompensationGrid::apply(3, 2731, 4095));   // 2.0002 → 2
+    TEST_ASSERT_EQUAL_UINT16(4095, CompensationGrid::apply(4000, 5325, 4095));
+    TEST_ASSERT_EQUAL_UINT16(65535, CompensationGrid::apply(65535, COMP_GAIN_ONE, 65535));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_unity_grid);
+    RUN_TEST(test_exact_at_nodes);
+    RUN_TEST(test_edges_clamped);
+    RUN_TEST(test_matches_double_bilinear);
+    RUN_TEST(test_monotonic_between_nodes);
+    RUN_TEST(test_set_rejects_invalid_axes);
+    RUN_TEST(test_parse_file);
+    RUN_TEST(test_parse_rejects_invalid_lines);
+    RUN_TEST(test_apply_rounds_and_saturates);
+    return UNITY_END();
+}
@@ -0,0 +1,97 @@
+/*
+Pruebas de CusumDetector (subida sostenida bajo los umbrales):
+
+Sin falsas marcas con ruido ni con derivas más lentas que la referencia
+Una rampa lenta se detecta en tiempo acotado
+Al terminar la subida la marca se libera (S saturada en 2 × umbral)
+*/
+#include <unity.h>
+#include "utils/CusumDetector.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint32_t rng = 7;
+
+// Ruido uniforme en [-amplitude, amplitude]
+static int noise(int amplitude) {
+    rng = rng * 1664525u + 1013904223u;
+    return (int)((rng >> 16) % (2 * amplitude + 1)) - amplitude;
+}
+
+void test_noise_does_not_trigger(void) {
+    CusumDetector<8> cusum(6, 400);
+    for (int i = 0; i < 200000; i++) {
+        TEST_ASSERT_FALSE(cusum.update((uint16_t)(1000 + noise(10))));
+    }
+    TEST_ASSERT_UINT_WITHIN(3, 1000, cusum.getBaseline());
+}
+
+void test_slow_drift_is_tracked(void) {
+    // 1 cuenta cada 64 muestras: la referencia (256 muestras) la sigue de cerca
+    CusumDetector<8> cusum(6, 400);
+    for (int i = 0; i < 64000; i++) {
+        TEST_ASSERT_FALSE(cusum.update((uint16_t)(1000 + i / 64 + noise(4))));
+    }
+}
+
+void test_ramp_detected(void) {
+    // 1 cuenta por muestra: se aleja de la referencia y S crece sin parar
+    CusumDetector<8> cusum(6, 400);
+    for (int i = 0; i < 1000; i++) {
+        cusum.update((uint16_t)(1000 + noise(4)));
+    }
+
+    int detectedAt = -1;
+    for (int i = 0; i < 1000 && detectedAt < 0; i++) {
+        if (cusum.update((uint16_t)(1000 + i + noise(4)))) {
+            detectedAt = i;
+        }
+    }
+    TEST_ASSERT_TRUE(detectedAt > 0);
+    TEST_ASSERT_TRUE(detectedAt < 60);
+    TEST_ASSERT_TRUE(cusum.isRising());
+}
+
+void test_releases_after_plateau(void) {
+    CusumDetector<6> cusum(6, 400);
+    for (int i = 0; i < 500; i++) cusum.update(1000);
+    for (int i = 0; i < 300; i++) cusum.update((uint16_t)(1000 + 2 * i));
+    TEST_ASSERT_TRUE(cusum.isRising());
+    TEST_ASSERT_EQUAL_INT32(800, cusum.getSum());           // Saturada en 2 × umbral
+
+    // Meseta: la referencia alcanza al nivel y S decae hasta 0
+    int releasedAt = -1;
+    for (int i = 0; i < 2000 && releasedAt < 0; i++) {
+        if (!cusum.update(1600)) {
+            releasedAt = i;
+        }
+    }
+    TEST_ASSERT_TRUE(releasedAt > 0);
+    TEST_ASSERT_TRUE(releasedAt < 1000);
+    TEST_ASSERT_EQUAL_INT32(0, cusum.getSum());
+}
+
+void test_falling_signal_and_reset(void) {
+    CusumDetector<8> cusum(6, 400);
+    for (int i = 0; i < 2000; i++) {
+        TEST_ASSERT_FALSE(cusum.update((uint16_t)(3000 - i)));
+    }
+    TEST_ASSERT_EQUAL_INT32(0, cusum.getSum());
+
+    // La primera muestra tras reset fija la referencia
+    cusum.reset();
+    cusum.update(4000);
+    TEST_ASSERT_EQUAL_UINT16(4000, cusum.getBaseline());
+    TEST_ASSERT_FALSE(cusum.isRising());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_noise_does_not_trigger);
+    RUN_TEST(test_slow_drift_is_tracked);
+    RUN_TEST(test_ramp_detected);
+    RUN_TEST(test_releases_after_plateau);
+    RUN_TEST(test_falling_signal_and_reset);
+    return UNITY_END();
+}
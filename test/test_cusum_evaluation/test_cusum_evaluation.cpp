@@ -0,0 +1,185 @@
+/*
+Evaluación del CUSUM frente al camino solo con umbrales (pio test -e native -f test_cusum_evaluation -v):
+
+CH4Sensor real (filtro, CUSUM, LUT de estados, baseline) alimentado por
+AdcSampler en modo reproducción, reloj virtual, calibración por defecto
+Lecturas cada SENSOR_READ_INTERVAL o antes si el muestreo despierta la
+tarea (como SensorTask)
+Rampas: aire limpio PREROLL_MS y luego subida lineal de varias pendientes,
+con ruido uniforme de varias amplitudes; se mide el tiempo desde el inicio
+de la rampa hasta reading.rising (CUSUM) y hasta DETECTED (thresholdWarning)
+Falsos positivos: 24 h de aire limpio con ruido y una deriva diaria
+(temperatura del sensor); episodios de rising y de DETECTED por día
+Tablas CSV por TEST_MESSAGE; los asserts solo verifican que el CUSUM se
+adelanta al umbral y que ninguno de los dos dispara en aire limpio
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <math.h>
+#include "sensors/CH4Sensor.h"
+#include "sensors/AdcSampler.h"
+#include "utils/Clock.h"
+#include "config/Config.h"
+
+#define REST_COUNTS 250.0f          // Aire limpio (baseline de la calibración por defecto)
+#define PREROLL_MS 900000UL         // Referencia del CUSUM asentada (≈ 1.4 × 2^16 muestras)
+#define RAMP_LIMIT_MS 14400000UL    // Rampa: como mucho 4 h
+#define CLEAN_AIR_MS 86400000UL     // Falsos positivos: 24 h
+#define DAILY_DRIFT_COUNTS 20.0f    // Deriva diaria (amplitud, cuentas ADC)
+#define SEEDS 3                     // Ejecuciones por combinación
+
+static const float SLOPES[] = { 0.1f, 0.25f, 0.5f, 1.0f, 2.0f };  // Cuentas ADC por s
+static const int NOISE[] = { 4, 8, 16 };                          // Amplitud (cuentas ADC)
+
+// Resultado de una ejecución
+struct EvalRun {
+    long cusumMs;               // Primer rising desde el inicio de la rampa (-1 = nunca)
+    long thresholdMs;           // Primer DETECTED o superior (-1 = nunca)
+    int rawAtCusum;             // Valor crudo al marcar rising
+    uint32_t cusumEpisodes;     // Flancos de rising antes de la rampa
+    uint32_t thresholdEpisodes; // Flancos de DETECTED antes de la rampa
+};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/**
+ * Ejecuta una señal y mide ambos caminos
+ * @param slope Pendiente de la rampa (cuentas/s, 0 = solo aire limpio)
+ * @param noise Amplitud del ruido uniforme (cuentas)
+ * @param drift Amplitud de la deriva diaria (cuentas)
+ * @param durationMs Duración sin rampa (o límite de la rampa)
+ */
+static EvalRun evaluate(float slope, int noise, float drift, unsigned long durationMs, uint32_t seed) {
+    CH4Sensor* sensor = CH4Sensor::getInstance();
+    AdcSampler* sampler = AdcSampler::getInstance();
+
+    const unsigned long start = 1000000UL;
+    const unsigned long onset = slope > 0 ? start + PREROLL_MS : start + durationMs;
+    const unsigned long end = slope > 0 ? onset + durationMs : onset;
+    Clock::simulate(start);
+    sampler->setReplay(true);
+    sensor->restart(false);
+
+    EvalRun run = { -1, -1, 0, 0, 0 };
+    HostNoise generator(seed);
+    const int channel = sensor->getAdcChannel();
+    const uint32_t stepMs = 1000 / ADC_SAMPLE_RATE_HZ;
+    unsigned long nextRead = start;
+    bool wasRising = false;
+    bool wasDetected = false;
+
+    for (unsigned long now = start; (long)(end - now) > 0; now += stepMs) {
+        Clock::advanceTo(now);
+        float t = (float)(now - start);
+        float value = REST_COUNTS + drift * sinf(2.0f * (float)M_PI * t / 86400000.0f) +
+                      generator.next(noise);
+        if ((long)(now - onset) >= 0) {
+            value += slope * (float)(now - onset) / 1000.0f;
+        }
+
+        AdcFrame frame = {};
+        frame.count = sampler->getChannelCount();
+        frame.values[channel] = (uint16_t)constrain(lroundf(value * ADC_SCAN_SCALE), 0L,
+                                                    (long)((1 << ADC_SCAN_BITS) - 1));
+        bool wake = sampler->inject(frame);
+        if (!wake && (long)(now - nextRead) < 0) {
+            continue;
+        }
+
+        CH4Reading reading = sensor->read();
+        bool rising = reading.rising;
+        bool detected = reading.state >= CH4State::DETECTED;
+        bool ramp = (long)(now - onset) >= 0;
+
+        if (ramp) {
+            if (rising && run.cusumMs < 0) {
+                run.cusumMs = (long)(now - onset);
+                run.rawAtCusum = reading.rawValue;
+            }
+            if (detected && run.thresholdMs < 0) {
+                run.thresholdMs = (long)(now - onset);
+            }
+            if (run.cusumMs >= 0 && run.thresholdMs >= 0) {
+                break;
+            }
+        } else {
+            run.cusumEpisodes += (rising && !wasRising) ? 1 : 0;
+            run.thresholdEpisodes += (detected && !wasDetected) ? 1 : 0;
+        }
+        wasRising = rising;
+        wasDetected = detected;
+        nextRead = now + (detected ? SENSOR_FAST_INTERVAL : SENSOR_READ_INTERVAL);
+    }
+
+    sampler->setReplay(false);
+    Clock::realTime();
+    return run;
+}
+
+// ==================== Pruebas ====================
+
+void test_ramp_detection_time(void) {
+    TEST_MESSAGE("slope_counts_per_s,noise_counts,cusum_s,threshold_s,lead_s,raw_at_cusum");
+
+    for (float slope : SLOPES) {
+        for (int noise : NOISE) {
+            long cusumSum = 0;
+            long thresholdSum = 0;
+            int rawSum = 0;
+            for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+                EvalRun run = evaluate(slope, noise, 0.0f, RAMP_LIMIT_MS, seed * 7919u);
+
+                // Las dos marcas llegan dentro del límite y el CUSUM primero
+                TEST_ASSERT_EQUAL(0, run.cusumEpisodes);
+                TEST_ASSERT_TRUE(run.cusumMs >= 0);
+                TEST_ASSERT_TRUE(run.thresholdMs >= 0);
+                TEST_ASSERT_LESS_THAN(run.thresholdMs, run.cusumMs);
+
+                cusumSum += run.cusumMs;
+                thresholdSum += run.thresholdMs;
+                rawSum += run.rawAtCusum;
+            }
+
+            char line[96];
+            snprintf(line, sizeof(line), "%.2f,%d,%ld,%ld,%ld,%d", slope, noise,
+                     cusumSum / SEEDS / 1000, thresholdSum / SEEDS / 1000,
+                     (thresholdSum - cusumSum) / SEEDS / 1000, rawSum / SEEDS);
+            TEST_MESSAGE(line);
+        }
+    }
+}
+
+void test_false_positives_in_clean_air(void) {
+    TEST_MESSAGE("noise_counts,daily_drift_counts,hours,cusum_episodes,threshold_episodes");
+
+    for (int noise : NOISE) {
+        EvalRun run = evaluate(0.0f, noise, DAILY_DRIFT_COUNTS, CLEAN_AIR_MS, 104729u);
+
+        char line[96];
+        snprintf(line, sizeof(line), "%d,%.0f,%lu,%lu,%lu", noise, DAILY_DRIFT_COUNTS,
+                 CLEAN_AIR_MS / 3600000UL, (unsigned long)run.cusumEpisodes,
+                 (unsigned long)run.thresholdEpisodes);
+        TEST_MESSAGE(line);
+
+        TEST_ASSERT_EQUAL(0, run.cusumEpisodes);
+        TEST_ASSERT_EQUAL(0, run.thresholdEpisodes);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    // Calibración por defecto (baseline 250, DETECTED desde thresholdWarning)
+    CH4Sensor* sensor = CH4Sensor::getInstance(CH4_SENSOR_PIN);
+    sensor->begin(false);
+    GasCalibration calibration = CH4Traits::DEFAULT_CALIBRATION;
+    calibration.isCalibrated = true;
+    sensor->setCalibration(calibration);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_ramp_detection_time);
+    RUN_TEST(test_false_positives_in_clean_air);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/*
+Pruebas de DoubleBuffer (documento publicado, un escritor y muchos lectores):
+
+Publicación, versión y longitud en un solo hilo
+Un buffer retenido nunca se pisa: el escritor omite esa publicación
+Tortura: un escritor y tres lectores en hilos separados (como la tarea que
+publica y las conexiones de AsyncTCP). Cada documento repite su número en
+todo el cuerpo: un documento pisado mientras se envía se detecta.
+*/
+#include <unity.h>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include "utils/DoubleBuffer.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static size_t publishText(DoubleBuffer<64>& document, const char* text) {
+    char* buffer = document.beginWrite();
+    if (buffer == nullptr) {
+        return 0;
+    }
+    size_t size = strlen(text);
+    memcpy(buffer, text, size);
+    document.publish(size);
+    return size;
+}
+
+void test_publish_and_acquire(void) {
+    DoubleBuffer<64> document;
+    TEST_ASSERT_EQUAL_UINT32(0, document.getVersion());
+
+    TEST_ASSERT_EQUAL_UINT32(5, publishText(document, "{\"a\"}"));
+    TEST_ASSERT_EQUAL_UINT32(1, document.getVersion());
+
+    size_t size;
+    uint32_t slot;
+    const char* body = document.acquire(size, slot);
+    TEST_ASSERT_EQUAL_UINT32(5, size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(body, "{\"a\"}", size));
+    document.release(slot);
+
+    publishText(document, "{\"bb\"}");
+    body = document.acquire(size, slot);
+    TEST_ASSERT_EQUAL_UINT32(6, size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(body, "{\"bb\"}", size));
+    document.release(slot);
+    TEST_ASSERT_EQUAL_UINT32(2, document.getVersion());
+    TEST_ASSERT_EQUAL_UINT32(0, document.getSkipped());
+}
+
+void test_retained_buffer_is_not_overwritten(void) {
+    DoubleBuffer<64> document;
+    publishText(document, "uno");
+
+    size_t size;
+    uint32_t slot;
+    const char* held = document.acquire(size, slot);
+
+    // El de atrás está libre: se publica "dos" y el frente cambia
+    TEST_ASSERT_EQUAL_UINT32(3, publishText(document, "dos"));
+    // Ahora el de atrás es el retenido: la publicación se omite
+    TEST_ASSERT_EQUAL_UINT32(0, publishText(document, "tres"));
+    TEST_ASSERT_EQUAL_UINT32(1, document.getSkipped());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(held, "uno", size));
+
+    // Los lectores nuevos ven el último publicado
+    size_t frontSize;
+    uint32_t frontSlot;
+    const char* front = document.acquire(frontSize, frontSlot);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(front, "dos", frontSize));
+    document.release(frontSlot);
+
+    // Liberado, el escritor vuelve a publicar
+    document.release(slot);
+    TEST_ASSERT_EQUAL_UINT32(4, publishText(document, "tres"));
+    TEST_ASSERT_EQUAL_UINT32(3, document.getVersion());
+}
+
+void test_concurrent_readers(void) {
+    static DoubleBuffer<256> document;
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> reads(0);
+    std::atomic<int> started(0);
+
+    auto reader = [&]() {
+        started++;
+        while (running.load()) {
+            size_t size;
+            uint32_t slot;
+            const char* body = document.acquire(size, slot);
+            if (size > 0) {
+                // Cuerpo: el número del documento repetido hasta llenar
+                char first[12];
+                memcpy(first, body, 10);
+                first[10] = 0;
+                for (size_t i = 0; i + 10 <= size; i += 10) {
+                    if (memcmp(body + i, first, 10) != 0) {
+                        torn++;
+                    }
+                }
+                reads++;
+            }
+            document.release(slot);
+        }
+    };
+
+    std::thread r1(reader), r2(reader), r3(reader);
+    while (started.load() < 3) {
+        std::this_thread::yield();
+    }
+
+    // Con la máquina cargada los lectores pueden tardar en correr: se sigue
+    // publicando hasta que lean al menos un documento
+    uint32_t published = 0;
+    uint32_t n = 0;
+    for (; n < 200000 || reads.load() == 0; n++) {
+        char* buffer = document.beginWrite();
+        if (buffer == nullptr) {
+            continue;
+        }
+        size_t size = 10 * (1 + n % 25);
+        for (size_t i = 0; i < size; i += 10) {
+            snprintf(buffer + i, 11, "%010u", (unsigned)n);
+        }
+        document.publish(size);
+        published++;
+    }
+    running = false;
+    r1.join();
+    r2.join();
+    r3.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_TRUE(reads.load() > 0);
+    TEST_ASSERT_EQUAL_UINT32(published, document.getVersion());
+    TEST_ASSERT_EQUAL_UINT32(n - published, document.getSkipped());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_publish_and_acquire);
+    RUN_TEST(test_retained_buffer_is_not_overwritten);
+    RUN_TEST(test_concurrent_readers);
+    return UNITY_END();
+}
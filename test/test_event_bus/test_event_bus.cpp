@@ -0,0 +1,190 @@
+/*
+Pruebas de EventBus:
+
+Orden de despacho por prioridad (y de registro a igual prioridad)
+Filtro de tópicos
+Transiciones de alerta antes que las lecturas y presupuesto por llamada
+Cola llena: el productor no bloquea, el evento se descarta y se cuenta
+Altas y bajas de suscriptores
+*/
+#include <unity.h>
+#include <string.h>
+#include "events/EventBus.h"
+
+static EventBus* bus;
+
+// Registro de llamadas: suscriptor y tópico, en orden
+struct Call {
+    int subscriber;
+    uint8_t topic;
+    uint32_t cycle;
+};
+static Call calls[128];
+static int callCount;
+
+static void record(const Event& event, void* context) {
+    if (callCount < (int)(sizeof(calls) / sizeof(calls[0]))) {
+        calls[callCount++] = Call{ (int)(intptr_t)context, event.topic, event.cycle };
+    }
+}
+
+static Event captured;
+
+static void capture(const Event& event, void*) {
+    captured = event;
+}
+
+static void* id(int subscriber) {
+    return (void*)(intptr_t)subscriber;
+}
+
+static SmokeReading smoke() {
+    SmokeReading reading;
+    memset(&reading, 0, sizeof(reading));
+    reading.state = SmokeState::NORMAL;
+    return reading;
+}
+
+static EnvironmentReading environment() {
+    EnvironmentReading reading;
+    memset(&reading, 0, sizeof(reading));
+    reading.temperature = 24.5f;
+    return reading;
+}
+
+void setUp(void) {
+    bus = EventBus::getInstance();
+    callCount = 0;
+}
+
+void tearDown(void) {
+    // Singleton: sin suscriptores ni eventos pendientes para la próxima prueba
+    for (int i = 0; i < 100; i++) {
+        bus->unsubscribe(record, id(i));
+    }
+    bus->unsubscribe(capture, nullptr);
+    while (bus->dispatch() > 0) {
+    }
+}
+
+void test_priority_then_registration_order(void) {
+    TEST_ASSERT_TRUE(bus->subscribe(record, id(1), TOPIC_ALL, PRIORITY_LOW));
+    TEST_ASSERT_TRUE(bus->subscribe(record, id(2), TOPIC_ALL, PRIORITY_NORMAL));
+    TEST_ASSERT_TRUE(bus->subscribe(record, id(3), TOPIC_ALL, PRIORITY_CRITICAL));
+    TEST_ASSERT_TRUE(bus->subscribe(record, id(4), TOPIC_ALL, PRIORITY_NORMAL));
+
+    TEST_ASSERT_TRUE(bus->publish(smoke(), 7, 1000));
+    TEST_ASSERT_EQUAL_UINT(1, bus->dispatch());
+
+    const int expected[] = { 3, 2, 4, 1 };
+    TEST_ASSERT_EQUAL_INT(4, callCount);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(expected[i], calls[i].subscriber);
+        TEST_ASSERT_EQUAL_UINT32(7, calls[i].cycle);
+    }
+}
+
+void test_topic_filter(void) {
+    bus->subscribe(record, id(1), TOPIC_SMOKE);
+    bus->subscribe(record, id(2), TOPIC_ENVIRONMENT | TOPIC_ALERT);
+    bus->subscribe(record, id(3), TOPIC_READINGS);
+
+    bus->publish(smoke(), 1, 0);
+    bus->publish(environment(), 1, 0);
+    bus->dispatch();
+
+    // Humo: 1 y 3; ambiente: 2 y 3
+    TEST_ASSERT_EQUAL_INT(4, callCount);
+    TEST_ASSERT_EQUAL_INT(1, calls[0].subscriber);
+    TEST_ASSERT_EQUAL_INT(3, calls[1].subscriber);
+    TEST_ASSERT_EQUAL_UINT8(TOPIC_ENVIRONMENT, calls[2].topic);
+    TEST_ASSERT_EQUAL_INT(2, calls[2].subscriber);
+    TEST_ASSERT_EQUAL_INT(3, calls[3].subscriber);
+}
+
+void test_payload_and_timestamp_delivered(void) {
+    bus->subscribe(capture, nullptr, TOPIC_ENVIRONMENT);
+
+    bus->publish(environment(), 42, 123456);
+    bus->dispatch();
+
+    TEST_ASSERT_EQUAL_UINT8(TOPIC_ENVIRONMENT, captured.topic);
+    TEST_ASSERT_EQUAL_UINT32(42, captured.cycle);
+    TEST_ASSERT_EQUAL_UINT32(123456, captured.timestamp);
+    TEST_ASSERT_EQUAL_FLOAT(24.5f, captured.env.temperature);
+
+    // La baja exige el mismo par handler + contexto
+    TEST_ASSERT_FALSE(bus->unsubscribe(record, nullptr));
+    TEST_ASSERT_TRUE(bus->unsubscribe(capture, nullptr));
+    TEST_ASSERT_EQUAL_UINT8(0, bus->getSubscriberCount());
+}
+
+void test_alerts_first_and_budget(void) {
+    bus->subscribe(record, id(1), TOPIC_ALL);
+
+    bus->publish(smoke(), 1, 0);
+    bus->publish(environment(), 1, 0);
+    bus->publish(AlertTransition{ ALERT_NORMAL, ALERT_CAUTION, ALERT_CAUTION, 0 }, 1, 0);
+    TEST_ASSERT_EQUAL_UINT(3, bus->pending());
+
+    // Presupuesto de 2: la transición sale primero aunque se publicó última
+    TEST_ASSERT_EQUAL_UINT(2, bus->dispatch(2));
+    TEST_ASSERT_EQUAL_UINT8(TOPIC_ALERT, calls[0].topic);
+    TEST_ASSERT_EQUAL_UINT8(TOPIC_SMOKE, calls[1].topic);
+    TEST_ASSERT_EQUAL_UINT(1, bus->pending());
+
+    TEST_ASSERT_EQUAL_UINT(1, bus->dispatch(2));
+    TEST_ASSERT_EQUAL_UINT8(TOPIC_ENVIRONMENT, calls[2].topic);
+    TEST_ASSERT_EQUAL_UINT(0, bus->dispatch(2));
+}
+
+void test_full_queue_drops_without_blocking(void) {
+    bus->subscribe(record, id(1), TOPIC_SMOKE);
+    uint32_t droppedBefore = bus->getDropped();
+
+    int accepted = 0;
+    for (int i = 0; i < EVENT_QUEUE_SIZE + 5; i++) {
+        if (bus->publish(smoke(), i, 0)) {
+            accepted++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(EVENT_QUEUE_SIZE, accepted);
+    TEST_ASSERT_EQUAL_UINT32(droppedBefore + 5, bus->getDropped());
+
+    // Los que entraron salen en orden (los últimos son los descartados)
+    while (bus->dispatch() > 0) {
+    }
+    TEST_ASSERT_EQUAL_INT(EVENT_QUEUE_SIZE, callCount);
+    TEST_ASSERT_EQUAL_UINT32(0, calls[0].cycle);
+    TEST_ASSERT_EQUAL_UINT32(EVENT_QUEUE_SIZE - 1, calls[EVENT_QUEUE_SIZE - 1].cycle);
+}
+
+void test_subscriber_limit_and_unsubscribe(void) {
+    for (int i = 0; i < EVENT_MAX_SUBSCRIBERS; i++) {
+        TEST_ASSERT_TRUE(bus->subscribe(record, id(i), TOPIC_ALL));
+    }
+    TEST_ASSERT_FALSE(bus->subscribe(record, id(99), TOPIC_ALL));
+    TEST_ASSERT_FALSE(bus->subscribe(nullptr, nullptr, TOPIC_ALL));
+
+    TEST_ASSERT_TRUE(bus->unsubscribe(record, id(5)));
+    TEST_ASSERT_FALSE(bus->unsubscribe(record, id(5)));
+    TEST_ASSERT_EQUAL_UINT8(EVENT_MAX_SUBSCRIBERS - 1, bus->getSubscriberCount());
+
+    bus->publish(smoke(), 1, 0);
+    bus->dispatch();
+    TEST_ASSERT_EQUAL_INT(EVENT_MAX_SUBSCRIBERS - 1, callCount);
+    for (int i = 0; i < callCount; i++) {
+        TEST_ASSERT_NOT_EQUAL(5, calls[i].subscriber);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_priority_then_registration_order);
+    RUN_TEST(test_topic_filter);
+    RUN_TEST(test_payload_and_timestamp_delivered);
+    RUN_TEST(test_alerts_first_and_budget);
+    RUN_TEST(test_full_queue_drops_without_blocking);
+    RUN_TEST(test_subscriber_limit_and_unsubscribe);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+/*
+Benchmark de events/EventBus (pio test -e native -f test_event_bus_benchmark -v):
+
+ns por evento (publicar + despachar) con 1 a 16 suscriptores
+Lecturas y transiciones de alerta mezcladas como en la tarea de sensores
+(una transición cada 8 ciclos, tres lecturas por ciclo)
+Los tiempos son de la PC: sirven para ver cómo crece el despacho con los
+suscriptores, no como valor absoluto del ESP32
+*/
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "events/EventBus.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static volatile uint32_t sink;
+static uint32_t handlerContexts[EVENT_MAX_SUBSCRIBERS];
+
+static void onEvent(const Event& event, void* context) {
+    // Trabajo mínimo de un suscriptor: leer el evento y tocar su estado
+    uint32_t* counter = (uint32_t*)context;
+    *counter += event.cycle + event.topic;
+}
+
+/**
+ * Publica y despacha ciclos completos con los suscriptores ya registrados
+ * @return ns por evento entregado
+ */
+static double nsPerEvent(EventBus* bus, int subscribers) {
+    SmokeReading smoke;
+    CH4Reading ch4;
+    EnvironmentReading env;
+    memset(&smoke, 0, sizeof(smoke));
+    memset(&ch4, 0, sizeof(ch4));
+    memset(&env, 0, sizeof(env));
+
+    const uint32_t cycles = 200000;
+    uint32_t events = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+        if ((cycle & 7) == 0) {
+            bus->publish(AlertTransition{ ALERT_NORMAL, ALERT_CAUTION, ALERT_CAUTION, 0 }, cycle, cycle);
+        }
+        bus->publish(smoke, cycle, cycle);
+        bus->publish(ch4, cycle, cycle);
+        bus->publish(env, cycle, cycle);
+        events += bus->dispatch();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    uint32_t total = 0;
+    for (int i = 0; i < subscribers; i++) {
+        total += handlerContexts[i];
+    }
+    sink = total;
+
+    TEST_ASSERT_EQUAL_UINT32(0, bus->getDropped());
+    TEST_ASSERT_EQUAL_UINT32(cycles * 3 + cycles / 8, events);
+    return std::chrono::duration<double, std::nano>(end - start).count() / events;
+}
+
+void test_dispatch_cost_by_subscribers(void) {
+    EventBus* bus = EventBus::getInstance();
+    const int counts[] = { 1, 2, 4, 8, 16 };
+    double costs[5];
+
+    int registered = 0;
+    for (int i = 0; i < 5; i++) {
+        while (registered < counts[i]) {
+            TEST_ASSERT_TRUE(bus->subscribe(onEvent, &handlerContexts[registered], TOPIC_ALL,
+                                            (EventPriority)(registered % 4)));
+            registered++;
+        }
+
+        costs[i] = nsPerEvent(bus, registered);
+        char line[96];
+        snprintf(line, sizeof(line), "%2d suscriptores  %7.2f ns/evento  %6.2f ns/llamada",
+                 registered, costs[i], costs[i] / registered);
+        TEST_MESSAGE(line);
+    }
+
+    // Despacho acotado: costo lineal en suscriptores, sin saltos
+    // (16 suscriptores cuestan menos que 16 buses de 1)
+    TEST_ASSERT_LESS_THAN_DOUBLE(costs[0] * 16, costs[4]);
+    TEST_ASSERT_GREATER_THAN_DOUBLE(costs[0], costs[4]);
+
+    char line[96];
+    snprintf(line, sizeof(line), "Memoria del bus: %u bytes (Event %u bytes)",
+             (unsigned)sizeof(EventBus), (unsigned)sizeof(Event));
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_dispatch_cost_by_subscribers);
+    return UNITY_END();
+}
@@ -0,0 +1,75 @@
+/*
+Benchmark de utils/Filters.h (pio test -e native -f test_filter_benchmark -v):
+
+ns/muestra de cada filtro sobre una señal ADC con ruido y picos
+Memoria por instancia (sizeof) contra la documentada en cada filtro
+Los tiempos son de la PC: sirven para comparar filtros entre sí, no
+como valor absoluto del ESP32
+*/
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include "utils/Filters.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const unsigned SAMPLES = 1u << 16;
+static uint16_t signal[SAMPLES];
+static volatile uint32_t sink;
+
+static void buildSignal() {
+    uint32_t seed = 12345;
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int noise = (int)((seed >> 24) & 0x0F) - 8;            // ±8 LSB
+        int spike = (seed & 0x3FF) == 0 ? 900 : 0;              // ~1 pico cada 1024
+        signal[i] = (uint16_t)(1500 + (i / 4096) * 40 + noise + spike);
+    }
+}
+
+template <typename Filter>
+static double nsPerSample(const char* name, size_t documentedBytes) {
+    Filter filter;
+    uint32_t total = 0;
+    const int rounds = 20;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (unsigned i = 0; i < SAMPLES; i++) {
+            total += filter.update(signal[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = total;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / ((double)rounds * SAMPLES);
+    char line[96];
+    snprintf(line, sizeof(line), "%-20s %7.2f ns/muestra  %4u bytes", name, ns, (unsigned)sizeof(Filter));
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT(documentedBytes, sizeof(Filter));
+    return ns;
+}
+
+void test_filter_cost_and_memory(void) {
+    buildSignal();
+
+    // Memoria documentada: Boxcar 2N+8, EMA 8, Mediana 4N+4, Hampel 6N+10
+    double boxcar8 = nsPerSample<BoxcarFilter<3> >("BoxcarFilter<3>", 2 * 8 + 8);
+    nsPerSample<BoxcarFilter<4> >("BoxcarFilter<4>", 2 * 16 + 8);
+    nsPerSample<EmaFilter<4> >("EmaFilter<4>", 8);
+    double median7 = nsPerSample<MedianFilter<7> >("MedianFilter<7>", 4 * 7 + 4);
+    nsPerSample<MedianFilter<15> >("MedianFilter<15>", 4 * 15 + 4);
+    double hampel7 = nsPerSample<HampelFilter<7, 30> >("HampelFilter<7,30>", 6 * 7 + 10);
+
+    // Orden de costos esperado por diseño (O(1) < O(N) < O(N^2))
+    TEST_ASSERT_LESS_THAN_DOUBLE(median7, boxcar8);
+    TEST_ASSERT_LESS_THAN_DOUBLE(hampel7, median7);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_filter_cost_and_memory);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+/*
+Pruebas de utils/Filters.h:
+
+Arranque con la primera muestra (sin rampa desde cero)
+Respuesta al escalón de cada filtro
+Hampel: reemplaza picos, conserva escalones reales de 1 LSB en señal plana
+*/
+#include <unity.h>
+#include "utils/Filters.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_boxcar_primes_and_settles(void) {
+    BoxcarFilter<3> filter;
+    TEST_ASSERT_EQUAL_UINT16(1000, filter.update(1000));
+    TEST_ASSERT_EQUAL_UINT16(1000, filter.value());
+
+    // Escalón a 1800: llega en exactamente 8 muestras
+    for (int i = 0; i < 7; i++) {
+        uint16_t out = filter.update(1800);
+        TEST_ASSERT_EQUAL_UINT16(1000 + 100 * (i + 1), out);
+    }
+    TEST_ASSERT_EQUAL_UINT16(1800, filter.update(1800));
+
+    filter.reset();
+    TEST_ASSERT_EQUAL_UINT16(0, filter.value());
+    TEST_ASSERT_EQUAL_UINT16(500, filter.update(500));
+}
+
+void test_ema_converges_without_bias(void) {
+    EmaFilter<4> filter;
+    TEST_ASSERT_EQUAL_UINT16(2000, filter.update(2000));
+
+    // Q8: converge al valor exacto (sin quedar 1 LSB por debajo)
+    for (int i = 0; i < 300; i++) {
+        filter.update(2001);
+    }
+    TEST_ASSERT_EQUAL_UINT16(2001, filter.value());
+
+    for (int i = 0; i < 300; i++) {
+        filter.update(100);
+    }
+    TEST_ASSERT_EQUAL_UINT16(100, filter.value());
+}
+
+void test_median_rejects_isolated_spikes(void) {
+    MedianFilter<5> filter;
+    filter.update(100);
+    TEST_ASSERT_EQUAL_UINT16(100, filter.update(4095));
+    TEST_ASSERT_EQUAL_UINT16(100, filter.update(0));
+    TEST_ASSERT_EQUAL_UINT16(100, filter.update(100));
+
+    // Cambio sostenido: pasa cuando ocupa la mitad de la ventana
+    filter.update(300);
+    filter.update(300);
+    TEST_ASSERT_EQUAL_UINT16(300, filter.update(300));
+}
+
+void test_hampel_replaces_outliers(void) {
+    HampelFilter<7, 30> filter;
+    const uint16_t noisy[] = {1000, 1003, 998, 1001, 997, 1002, 999, 1000};
+    for (uint16_t sample : noisy) {
+        filter.update(sample);
+    }
+    TEST_ASSERT_EQUAL_UINT16(1000, filter.update(3000));
+    TEST_ASSERT_EQUAL_UINT16(1001, filter.update(1001));
+}
+
+void test_hampel_keeps_one_lsb_step_on_flat_signal(void) {
+    HampelFilter<7, 30> filter;
+    for (int i = 0; i < 20; i++) {
+        filter.update(1000);
+    }
+    // MAD = 0: el escalón de 1 LSB es real, no un outlier
+    TEST_ASSERT_EQUAL_UINT16(1001, filter.update(1001));
+    TEST_ASSERT_EQUAL_UINT16(1001, filter.update(1001));
+    // Un pico grande sobre la misma señal plana sigue rechazándose
+    TEST_ASSERT_EQUAL_UINT16(1000, filter.update(1200));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_boxcar_primes_and_settles);
+    RUN_TEST(test_ema_converges_without_bias);
+    RUN_TEST(test_median_rejects_isolated_spikes);
+    RUN_TEST(test_hampel_replaces_outliers);
+    RUN_TEST(test_hampel_keeps_one_lsb_step_on_flat_signal);
+    return UNITY_END();
+}
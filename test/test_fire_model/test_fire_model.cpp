@@ -0,0 +1,106 @@
+/*
+Pruebas de FireModel (regresión logística en punto fijo):
+
+Conversión a Q4 con recorte al rango y NaN como 0
+Probabilidad en punto fijo contra la logística en doble precisión
+Sigmoide monótona y saturada fuera de la tabla
+*/
+#include <unity.h>
+#include <math.h>
+#include "alert/FireModel.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static FireModel model;
+
+// Mismo modelo en doble precisión (variables recortadas, sin redondeo a Q4)
+static double reference(const float features[FIRE_FEATURE_COUNT]) {
+    double logit = (double)FIRE_MODEL_BIAS / (1 << FIRE_LOGIT_SHIFT);
+    for (int i = 0; i < FIRE_FEATURE_COUNT; i++) {
+        double limit = FIRE_MODEL_LIMITS[i];
+        double value = features[i] > limit ? limit : (features[i] < -limit ? -limit : features[i]);
+        logit += (double)FIRE_MODEL_WEIGHTS[i] / (1 << FIRE_MODEL_WEIGHT_SHIFT) * value;
+    }
+    return 1.0 / (1.0 + exp(-logit));
+}
+
+void test_to_fixed_rounds_and_clamps(void) {
+    TEST_ASSERT_EQUAL_INT32(0, FireModel::toFixed(FIRE_TEMP_DELTA, 0.0f));
+    TEST_ASSERT_EQUAL_INT32(40, FireModel::toFixed(FIRE_TEMP_DELTA, 2.5f));
+    TEST_ASSERT_EQUAL_INT32(-40, FireModel::toFixed(FIRE_TEMP_DELTA, -2.5f));
+    TEST_ASSERT_EQUAL_INT32(2, FireModel::toFixed(FIRE_TEMP_DELTA, 0.1f));     // 1.6 → 2
+    TEST_ASSERT_EQUAL_INT32(60 * 16, FireModel::toFixed(FIRE_TEMP_DELTA, 1000.0f));
+    TEST_ASSERT_EQUAL_INT32(-30 * 16, FireModel::toFixed(FIRE_PRESSURE_DELTA, -1e9f));
+    TEST_ASSERT_EQUAL_INT32(100 * 16, FireModel::toFixed(FIRE_SMOKE_PERCENT, INFINITY));
+}
+
+void test_nan_counts_as_zero(void) {
+    TEST_ASSERT_EQUAL_INT32(0, FireModel::toFixed(FIRE_TEMP_RATE, NAN));
+    TEST_ASSERT_EQUAL_INT32(0, FireModel::toFixed(FIRE_HUMIDITY_DELTA, -NAN));
+
+    float clean[FIRE_FEATURE_COUNT] = { 5, 2, -10, -1, 20, 0 };
+    float invalid[FIRE_FEATURE_COUNT] = { 5, 2, -10, -1, 20, NAN };
+    TEST_ASSERT_EQUAL_FLOAT(model.probability(clean), model.probability(invalid));
+}
+
+void test_matches_double_precision(void) {
+    // Barrido pseudoaleatorio de todo el rango de cada variable
+    uint32_t rng = 12345;
+    double worst = 0;
+    for (int n = 0; n < 100000; n++) {
+        float features[FIRE_FEATURE_COUNT];
+        for (int i = 0; i < FIRE_FEATURE_COUNT; i++) {
+            rng = rng * 1664525u + 1013904223u;
+            features[i] = ((rng >> 8) / 16777216.0f * 2.2f - 1.1f) * FIRE_MODEL_LIMITS[i];
+        }
+        double error = fabs(model.probability(features) - reference(features));
+        worst = error > worst ? error : worst;
+    }
+    // Redondeo de las variables a Q4 (1/32 por peso) más la tabla
+    TEST_ASSERT_TRUE_MESSAGE(worst < 0.01, "error contra la logística sin cuantizar");
+}
+
+void test_sigmoid_table_error(void) {
+    // Solo la tabla: logit exacto contra la sigmoide interpolada
+    const int32_t one = 1 << FIRE_LOGIT_SHIFT;
+    double worst = 0;
+    for (int32_t logit = -9 * one; logit <= 9 * one; logit += 97) {
+        double exact = 1.0 / (1.0 + exp(-(double)logit / one));
+        double error = fabs(model.probabilityFromLogit(logit) / 65536.0 - exact);
+        worst = error > worst ? error : worst;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(worst < 0.001, "error de interpolación de la sigmoide");
+}
+
+void test_sigmoid_monotonic_and_saturated(void) {
+    const int32_t one = 1 << FIRE_LOGIT_SHIFT;
+    uint16_t previous = 0;
+    for (int32_t logit = -10 * one; logit <= 10 * one; logit += one / 64) {
+        uint16_t p = model.probabilityFromLogit(logit);
+        TEST_ASSERT_TRUE(p >= previous);
+        previous = p;
+    }
+    TEST_ASSERT_UINT16_WITHIN(2, 32768, model.probabilityFromLogit(0));
+    TEST_ASSERT_EQUAL_UINT16(model.probabilityFromLogit(8 * one), model.probabilityFromLogit(INT32_MAX / 2));
+    TEST_ASSERT_TRUE(model.probabilityFromLogit(-8 * one) < 30);
+    TEST_ASSERT_TRUE(model.probabilityFromLogit(8 * one) > 65500);
+}
+
+void test_fire_raises_probability(void) {
+    float calm[FIRE_FEATURE_COUNT] = { 0.2f, 0.0f, 0.5f, 0.1f, 2, 1 };
+    float fire[FIRE_FEATURE_COUNT] = { 15, 6, -20, -4, 60, 5 };
+    TEST_ASSERT_TRUE(model.probability(calm) < 0.05f);
+    TEST_ASSERT_TRUE(model.probability(fire) > 0.95f);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_to_fixed_rounds_and_clamps);
+    RUN_TEST(test_nan_counts_as_zero);
+    RUN_TEST(test_matches_double_precision);
+    RUN_TEST(test_sigmoid_table_error);
+    RUN_TEST(test_sigmoid_monotonic_and_saturated);
+    RUN_TEST(test_fire_raises_probability);
+    return UNITY_END();
+}
@@ -0,0 +1,87 @@
+/*
+Pruebas de GasLut.h (curva Rs/R0 → PPM y tabla precalculada):
+
+La curva pasa por los puntos del datasheet y es monótona
+Interpolación log-log (punto medio = media geométrica), extrapolación y tope
+Tabla de 4096 entradas en uint16 contra la conversión en float (< 1 PPM)
+*/
+#include <unity.h>
+#include "sensors/GasLut.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Curva MQ-2 (humo) del datasheet, igual que SmokeTraits::CURVE
+static const GasCurvePoint SMOKE_CURVE[] = {
+    { 3.43f, 200 }, { 1.53f, 1000 }, { 0.60f, 10000 }
+};
+static const int SMOKE_POINTS = 3;
+
+void test_resistance_ratio(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 2048.0 / 2047.0, GasCurve::resistanceRatio(2047));
+    TEST_ASSERT_EQUAL_FLOAT(4094.0f, GasCurve::resistanceRatio(0));      // raw < 1 → 1
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, GasCurve::resistanceRatio(5000));      // Saturado arriba
+}
+
+void test_curve_passes_through_datasheet_points(void) {
+    for (int i = 0; i < SMOKE_POINTS; i++) {
+        float ppm = GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, SMOKE_CURVE[i].ratio);
+        TEST_ASSERT_FLOAT_WITHIN(SMOKE_CURVE[i].ppm * 1e-4f, SMOKE_CURVE[i].ppm, ppm);
+    }
+}
+
+void test_curve_is_log_log_linear(void) {
+    // Punto medio en log(ratio) → media geométrica de los PPM
+    float ratio = sqrtf(3.43f * 1.53f);
+    float ppm = GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, ratio);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, sqrtf(200.0f * 1000.0f), ppm);
+
+    // Extrapolación con el tramo más cercano y tope
+    TEST_ASSERT_LESS_THAN_FLOAT(200.0f, GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, 9.83f));
+    TEST_ASSERT_GREATER_THAN_FLOAT(10000.0f, GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, 0.3f));
+    TEST_ASSERT_EQUAL_FLOAT(GAS_CURVE_PPM_MAX, GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(GAS_CURVE_PPM_MAX, GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, 1e-6f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, GasCurve::ppmFromRatio(SMOKE_CURVE, 1, 1.0f));
+}
+
+void test_table_matches_float_conversion(void) {
+    // Como GasSensor::rawToPPM() con la curva log-log: R0 desde el baseline en
+    // aire limpio, PPM truncado a entero y saturado a uint16
+    const int baseline = 400;
+    const float r0 = GasCurve::resistanceRatio(baseline) / 9.83f;
+    static uint16_t table[GAS_LUT_SIZE];
+    for (int raw = 0; raw < GAS_LUT_SIZE; raw++) {
+        float ppm = GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, GasCurve::resistanceRatio(raw) / r0);
+        table[raw] = GasCurve::saturate16((long)ppm);
+    }
+
+    // La tabla es monótona y difiere del float menos de 1 PPM (truncado)
+    float worst = 0;
+    for (int raw = 1; raw < GAS_LUT_SIZE; raw++) {
+        TEST_ASSERT_TRUE(table[raw] >= table[raw - 1]);
+        float exact = GasCurve::ppmFromRatio(SMOKE_CURVE, SMOKE_POINTS, GasCurve::resistanceRatio(raw) / r0);
+        if (exact < 65535.0f) {
+            float error = fabsf(exact - table[raw]);
+            if (error > worst) worst = error;
+        } else {
+            TEST_ASSERT_EQUAL_UINT16(65535, table[raw]);
+        }
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(1.0f, worst);
+}
+
+void test_saturate16(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, GasCurve::saturate16(-5));
+    TEST_ASSERT_EQUAL_UINT16(1234, GasCurve::saturate16(1234));
+    TEST_ASSERT_EQUAL_UINT16(65535, GasCurve::saturate16(1000000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_resistance_ratio);
+    RUN_TEST(test_curve_passes_through_datasheet_points);
+    RUN_TEST(test_curve_is_log_log_linear);
+    RUN_TEST(test_table_matches_float_conversion);
+    RUN_TEST(test_saturate16);
+    return UNITY_END();
+}
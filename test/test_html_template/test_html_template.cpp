@@ -0,0 +1,136 @@
+/*
+Pruebas de HtmlTemplate (plantilla precompilada, render por tramos):
+
+Solo los nombres registrados entre '%' son marcadores: porcentajes del CSS
+y nombres desconocidos quedan como texto fijo
+El resultado no depende del tamaño de los tramos (de 1 byte a la página entera)
+Valores nulos o vacíos, marcadores pegados, al principio y al final
+Plantillas con más segmentos que TEMPLATE_MAX_SEGMENTS se rechazan
+*/
+#include <unity.h>
+#include <string>
+#include <string.h>
+#include "web/HtmlTemplate.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const char* const NAMES[] = {"STATE", "SSID", "IP"};
+
+static bool parse(HtmlTemplate& page, const char* text) {
+    return page.parse(text, strlen(text), NAMES, 3);
+}
+
+// Página completa en tramos de chunk bytes
+static std::string render(const HtmlTemplate& page, const char* const* values, size_t chunk) {
+    std::string output;
+    TemplateCursor cursor = {0, 0};
+    uint8_t buffer[512];
+    while (true) {
+        size_t written = page.render(buffer, chunk, cursor, values);
+        if (written == 0) {
+            break;
+        }
+        TEST_ASSERT_TRUE(written <= chunk);
+        output.append((const char*)buffer, written);
+    }
+    return output;
+}
+
+void test_placeholders_replaced(void) {
+    HtmlTemplate page;
+    TEST_ASSERT_FALSE(page.isLoaded());
+    TEST_ASSERT_TRUE(parse(page, "<p>LED: %STATE%</p><p>Red %SSID% (%IP%)</p>"));
+    TEST_ASSERT_TRUE(page.isLoaded());
+    TEST_ASSERT_EQUAL_UINT8(7, page.getSegmentCount());
+
+    const char* values[] = {"ON", "Casa", "192.168.1.20"};
+    TEST_ASSERT_EQUAL_STRING("<p>LED: ON</p><p>Red Casa (192.168.1.20)</p>",
+                             render(page, values, 512).c_str());
+}
+
+void test_unregistered_percent_is_literal(void) {
+    HtmlTemplate page;
+    const char* text = "<style>div{width:100%;height:50%}</style>%FOO% %SSID 5% %%IP%%";
+    TEST_ASSERT_TRUE(parse(page, text));
+
+    const char* values[] = {"OFF", "red", "10.0.0.1"};
+    TEST_ASSERT_EQUAL_STRING("<style>div{width:100%;height:50%}</style>%FOO% %SSID 5% %10.0.0.1%",
+                             render(page, values, 512).c_str());
+}
+
+void test_edges_and_adjacent(void) {
+    HtmlTemplate page;
+    TEST_ASSERT_TRUE(parse(page, "%STATE%%SSID%-%IP%"));
+    TEST_ASSERT_EQUAL_UINT8(4, page.getSegmentCount());
+
+    const char* values[] = {"A", nullptr, ""};
+    TEST_ASSERT_EQUAL_STRING("A-", render(page, values, 512).c_str());
+}
+
+void test_chunk_size_does_not_matter(void) {
+    HtmlTemplate page;
+    std::string text;
+    for (int i = 0; i < 6; i++) {
+        text += "<li style=\"width:10%\">%SSID%</li>\n<b>%STATE%</b>";
+    }
+    TEST_ASSERT_TRUE(parse(page, text.c_str()));
+
+    const char* values[] = {"ENCENDIDO", "una red con nombre largo", "1.2.3.4"};
+    std::string whole = render(page, values, 512);
+    for (size_t chunk = 1; chunk <= 64; chunk++) {
+        TEST_ASSERT_EQUAL_STRING(whole.c_str(), render(page, values, chunk).c_str());
+    }
+    TEST_ASSERT_TRUE(whole.find("<b>ENCENDIDO</b>") != std::string::npos);
+}
+
+void test_values_per_response(void) {
+    // La plantilla es la misma; cada respuesta lleva sus valores
+    HtmlTemplate page;
+    TEST_ASSERT_TRUE(parse(page, "LED %STATE%"));
+    const char* on[] = {"ON", "", ""};
+    const char* off[] = {"OFF", "", ""};
+
+    TemplateCursor first = {0, 0};
+    TemplateCursor second = {0, 0};
+    uint8_t a[16], b[16];
+    size_t lengthA = page.render(a, 2, first, on);
+    size_t lengthB = page.render(b, sizeof(b), second, off);
+    lengthA += page.render(a + lengthA, sizeof(a) - lengthA, first, on);
+
+    TEST_ASSERT_EQUAL_STRING("LED ON", std::string((char*)a, lengthA).c_str());
+    TEST_ASSERT_EQUAL_STRING("LED OFF", std::string((char*)b, lengthB).c_str());
+}
+
+void test_too_many_segments_rejected(void) {
+    HtmlTemplate page;
+    std::string text;
+    for (int i = 0; i < TEMPLATE_MAX_SEGMENTS; i++) {
+        text += "x%IP%";
+    }
+    TEST_ASSERT_FALSE(parse(page, text.c_str()));
+    TEST_ASSERT_FALSE(page.isLoaded());
+
+    // Reutilizable: un análisis válido después de uno fallido
+    TEST_ASSERT_TRUE(parse(page, "ok %IP%"));
+    const char* values[] = {"", "", "1"};
+    TEST_ASSERT_EQUAL_STRING("ok 1", render(page, values, 512).c_str());
+}
+
+void test_empty_template(void) {
+    HtmlTemplate page;
+    TEST_ASSERT_TRUE(page.parse("", 0, NAMES, 3));
+    TEST_ASSERT_FALSE(page.isLoaded());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_placeholders_replaced);
+    RUN_TEST(test_unregistered_percent_is_literal);
+    RUN_TEST(test_edges_and_adjacent);
+    RUN_TEST(test_chunk_size_does_not_matter);
+    RUN_TEST(test_values_per_response);
+    RUN_TEST(test_too_many_segments_rejected);
+    RUN_TEST(test_empty_template);
+    return UNITY_END();
+}
@@ -0,0 +1,292 @@
+/*
+Benchmark de HtmlTemplate (pio test -e native -f test_html_template_benchmark -v):
+
+ns por página de data/index.html en tramos de BENCH_CHUNK bytes (un segmento
+TCP), con los valores de red de un equipo en modo estación
+Plantilla: como MyWebServer::sendIndex() (copia de los valores del pedido
+y render por ID con el cursor de la respuesta)
+Procesador anterior: modelo de _fillBufferAndProcessTemplates() de
+ESPAsyncWebServer con el processor(const String&) que usaban /on y /off
+(String por cada '%', nombres comparados, WiFiConfig copiada en %SSID%);
+el archivo sale de memoria, sin el costo de LittleFS del equipo
+La salida de la plantilla debe ser exactamente la página con los marcadores
+sustituidos; la del procesador se informa (la librería toma como marcador
+el texto entre dos '%' del mismo tramo y lo borra si processor() no lo
+conoce: se pierden partes del CSS)
+Los tiempos son de la PC: sirven para comparar los dos caminos, no como
+valor absoluto del ESP32
+*/
+#include <unity.h>
+#include <Arduino.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <vector>
+#include "web/HtmlTemplate.h"
+#include "config/Config.h"
+
+#define BENCH_CHUNK 1460            // Bytes por tramo (MSS de TCP)
+#define BENCH_RENDERS 20000         // Páginas por medición
+#define PARAM_NAME_LENGTH 32        // TEMPLATE_PARAM_NAME_LENGTH de la librería
+
+// Marcadores de index.html (mismo orden que TemplateValue de MyWebServer.h)
+enum BenchValue : uint8_t { TPL_STATE, TPL_SSID, TPL_IP, TPL_GATEWAY, TPL_SUBNET, TPL_COUNT };
+static const char* const NAMES[TPL_COUNT] = {"STATE", "SSID", "IP", "GATEWAY", "SUBNET"};
+static const char* const VALUES[TPL_COUNT] = {"ON", "MiRedWiFi_Casa", "192.168.1.100", "192.168.1.1",
+                                              "255.255.255.0"};
+
+// Configuración guardada como la de WiFiManager (getConfig() la devuelve por copia)
+struct BenchWiFiConfig {
+    String ssid;
+    String password;
+    String ip;
+    String gateway;
+    String subnet;
+    bool useDHCP;
+};
+
+static std::string page;
+static BenchWiFiConfig config = {VALUES[TPL_SSID], "clave-de-prueba", VALUES[TPL_IP],
+                                 VALUES[TPL_GATEWAY], VALUES[TPL_SUBNET], false};
+static volatile size_t sink;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static BenchWiFiConfig getConfig() {
+    return config;
+}
+
+/**
+ * processor() de /on y /off antes de HtmlTemplate
+ */
+static String processor(const String& var) {
+    if (var == "STATE") {
+        return String(VALUES[TPL_STATE]);
+    }
+    if (var == "SSID") {
+        return getConfig().ssid;
+    }
+    if (var == "IP") {
+        return config.ip;
+    }
+    if (var == "GATEWAY") {
+        return config.gateway;
+    }
+    if (var == "SUBNET") {
+        return config.subnet;
+    }
+    return String();
+}
+
+// Respuesta con plantilla de la librería: archivo en memoria y caché de bytes leídos de más
+struct ProcessorResponse {
+    size_t position;
+    std::vector<uint8_t> cache;
+
+    size_t read(uint8_t* data, size_t length) {
+        size_t count = 0;
+        size_t fromCache = cache.size() < length ? cache.size() : length;
+        if (fromCache > 0) {
+            memcpy(data, cache.data(), fromCache);
+            cache.erase(cache.begin(), cache.begin() + fromCache);
+            count = fromCache;
+        }
+        size_t fromFile = page.size() - position < length - count ? page.size() - position : length - count;
+        memcpy(data + count, page.data() + position, fromFile);
+        position += fromFile;
+        return count + fromFile;
+    }
+
+    /**
+     * Un tramo con los marcadores sustituidos (como _fillBufferAndProcessTemplates)
+     * @return Bytes escritos (0 = terminada)
+     */
+    size_t fill(uint8_t* data, size_t maxLength) {
+        size_t length = read(data, maxLength);
+        size_t start = 0;
+        while (start < length) {
+            uint8_t* open = (uint8_t*)memchr(data + start, '%', length - start);
+            if (open == nullptr) {
+                break;
+            }
+            size_t begin = open - data;
+            uint8_t* close = begin + 1 < length ? (uint8_t*)memchr(open + 1, '%', length - begin - 1) : nullptr;
+            size_t end;
+            String name;
+
+            if (close != nullptr) {
+                end = close - data;
+                size_t nameLength = end - begin - 1 < PARAM_NAME_LENGTH ? end - begin - 1 : PARAM_NAME_LENGTH;
+                if (nameLength == 0) {
+                    // "%%" es un '%' escapado: se quita el segundo
+                    memmove(data + end, data + end + 1, length - end - 1);
+                    length = length - 1 + read(data + length - 1, 1);
+                    start = begin + 1;
+                    continue;
+                }
+                char buffer[PARAM_NAME_LENGTH + 1];
+                memcpy(buffer, data + begin + 1, nameLength);
+                buffer[nameLength] = '\0';
+                name = String(buffer);
+            } else if (length - begin < PARAM_NAME_LENGTH + 2) {
+                // El cierre puede estar en lo que queda del archivo
+                char buffer[PARAM_NAME_LENGTH + 2];
+                size_t tail = length - begin - 1;
+                memcpy(buffer, data + begin + 1, tail);
+                size_t ahead = read((uint8_t*)buffer + tail, PARAM_NAME_LENGTH + 1 - tail);
+                char* found = (char*)memchr(buffer + tail, '%', ahead);
+                if (found == nullptr) {
+                    cache.insert(cache.begin(), buffer + tail, buffer + tail + ahead);
+                    start = begin + 1;
+                    continue;
+                }
+                *found = '\0';
+                name = String(buffer);
+                cache.insert(cache.begin(), found + 1, buffer + tail + ahead);
+                end = length - 1;
+            } else {
+                start = begin + 1;
+                continue;
+            }
+
+            // Valor en lugar de [begin, end]; lo que no entra vuelve a la caché
+            String value = processor(name);
+            size_t valueLength = value.length();
+            size_t copied = valueLength < maxLength - begin ? valueLength : maxLength - begin;
+            size_t after = length - end - 1;
+            if (copied < valueLength) {
+                // El valor no entra en el tramo: su resto y todo lo que seguía
+                cache.insert(cache.begin(), data + end + 1, data + length);
+                cache.insert(cache.begin(), value.c_str() + copied, value.c_str() + valueLength);
+                after = 0;
+            } else if (begin + copied + after > maxLength) {
+                size_t overflow = begin + copied + after - maxLength;
+                cache.insert(cache.begin(), data + length - overflow, data + length);
+                after -= overflow;
+            }
+            memmove(data + begin + copied, data + end + 1, after);
+            memcpy(data + begin, value.c_str(), copied);
+            length = begin + copied + after;
+            if (length < maxLength) {
+                length += read(data + length, maxLength - length);
+            }
+            start = begin + copied;
+        }
+        return length;
+    }
+};
+
+/**
+ * Página esperada: cada %NOMBRE% registrado sustituido por su valor
+ */
+static std::string expectedPage() {
+    std::string result = page;
+    for (int i = 0; i < TPL_COUNT; i++) {
+        std::string marker = std::string("%") + NAMES[i] + "%";
+        size_t position;
+        while ((position = result.find(marker)) != std::string::npos) {
+            result.replace(position, marker.size(), VALUES[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * Ruta de data/index.html desde la de esta suite
+ */
+static std::string indexPath() {
+    std::string path(__FILE__);
+    size_t test = path.rfind("test/test_html_template_benchmark/");
+    return (test == std::string::npos ? std::string() : path.substr(0, test)) + "data/index.html";
+}
+
+// ==================== Pruebas ====================
+
+void test_render_against_processor(void) {
+    std::ifstream input(indexPath(), std::ios::binary);
+    TEST_ASSERT_TRUE_MESSAGE((bool)input, "data/index.html");
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    page = buffer.str();
+
+    HtmlTemplate indexTemplate;
+    TEST_ASSERT_TRUE(indexTemplate.parse(page.data(), page.size(), NAMES, TPL_COUNT));
+    std::string expected = expectedPage();
+
+    // Valores cacheados de la red (refreshTemplateValues) y copia por pedido (sendIndex)
+    char cachedValues[TPL_COUNT][TEMPLATE_VALUE_LENGTH];
+    memset(cachedValues, 0, sizeof(cachedValues));
+    for (int i = TPL_SSID; i < TPL_COUNT; i++) {
+        snprintf(cachedValues[i], TEMPLATE_VALUE_LENGTH, "%s", VALUES[i]);
+    }
+
+    uint8_t chunk[BENCH_CHUNK];
+    std::string templateOutput;
+    std::string processorOutput;
+    size_t total = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < BENCH_RENDERS; n++) {
+        char values[TPL_COUNT][TEMPLATE_VALUE_LENGTH];
+        const char* pointers[TPL_COUNT];
+        memcpy(values, cachedValues, sizeof(cachedValues));
+        snprintf(values[TPL_STATE], TEMPLATE_VALUE_LENGTH, "%s", VALUES[TPL_STATE]);
+        for (int i = 0; i < TPL_COUNT; i++) {
+            pointers[i] = values[i];
+        }
+
+        TemplateCursor cursor = {0, 0};
+        size_t written;
+        while ((written = indexTemplate.render(chunk, sizeof(chunk), cursor, pointers)) > 0) {
+            total += written;
+            if (n == 0) {
+                templateOutput.append((const char*)chunk, written);
+            }
+        }
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int n = 0; n < BENCH_RENDERS; n++) {
+        ProcessorResponse response = {0, {}};
+        size_t written;
+        while ((written = response.fill(chunk, sizeof(chunk))) > 0) {
+            total += written;
+            if (n == 0) {
+                processorOutput.append((const char*)chunk, written);
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = total;
+
+    double templateNs = std::chrono::duration<double, std::nano>(middle - start).count() / BENCH_RENDERS;
+    double processorNs = std::chrono::duration<double, std::nano>(end - middle).count() / BENCH_RENDERS;
+
+    char line[128];
+    snprintf(line, sizeof(line), "index.html: %u bytes, %u segmentos, tramos de %d bytes",
+             (unsigned)page.size(), (unsigned)indexTemplate.getSegmentCount(), BENCH_CHUNK);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "HtmlTemplate  %8.0f ns/página  %u bytes",
+             templateNs, (unsigned)templateOutput.size());
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "processor()   %8.0f ns/página  %u bytes (%d respecto de lo esperado)",
+             processorNs, (unsigned)processorOutput.size(),
+             (int)processorOutput.size() - (int)expected.size());
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "Plantilla x%.1f más rápida", processorNs / templateNs);
+    TEST_MESSAGE(line);
+
+    // La plantilla produce exactamente la página esperada y no es más lenta
+    TEST_ASSERT_EQUAL(expected.size(), templateOutput.size());
+    TEST_ASSERT_TRUE(templateOutput == expected);
+    TEST_ASSERT_LESS_THAN_DOUBLE(processorNs, templateNs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_render_against_processor);
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+/*
+Benchmark de latencia del bus I2C (pio test -e native -f test_i2c_latency -v):
+
+Tiempo que una lectura ambiental ocupa el ciclo de la tarea de sensores,
+sobre el bus simulado de test/host (100 kHz, tiempo virtual: 9 bits por
+byte más START/STOP, y los delay() de cada camino)
+Camino actual: EnvironmentSensor::read() (AHT20 en dos fases, BMP280 en un burst)
+Camino anterior: secuencia de las librerías de Adafruit que usaba read()
+  AHT20 getEvent(): dispara, consulta el estado con delay(10) hasta que
+  termina la conversión (~80 ms) y lee 6 bytes
+  BMP280 readTemperature() + readPressure() + readAltitude(): cada una vuelve
+  a leer la temperatura, 5 lecturas de registros de 3 bytes
+Los tiempos son del modelo del bus, no medidos en el ESP32
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <LittleFS.h>
+#include "sensors/EnvironmentSensor.h"
+#include "config/Config.h"
+
+#define LATENCY_CYCLES 200
+
+static HostAHT20 aht;
+static HostBMP280 bmp;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ==================== Camino anterior (Adafruit) ====================
+
+static uint8_t legacyStatus() {
+    Wire.requestFrom((uint8_t)AHT20_ADDRESS, (uint8_t)1);
+    return (uint8_t)Wire.read();
+}
+
+static void legacyRead24(uint8_t reg) {
+    Wire.beginTransmission(BMP280_ADDRESS);
+    Wire.write(reg);
+    Wire.endTransmission();
+    Wire.requestFrom((uint8_t)BMP280_ADDRESS, (uint8_t)3);
+    while (Wire.available()) {
+        Wire.read();
+    }
+}
+
+/**
+ * Una lectura ambiental como la hacía read() con las librerías de Adafruit
+ */
+static void legacyRead() {
+    // Adafruit_AHTX0::getEvent()
+    Wire.beginTransmission(AHT20_ADDRESS);
+    Wire.write(0xAC);
+    Wire.write(0x33);
+    Wire.write(0x00);
+    Wire.endTransmission();
+    while (legacyStatus() & 0x80) {
+        delay(10);
+    }
+    Wire.requestFrom((uint8_t)AHT20_ADDRESS, (uint8_t)6);
+    while (Wire.available()) {
+        Wire.read();
+    }
+
+    // Adafruit_BMP280: readTemperature(), readPressure(), readAltitude()
+    legacyRead24(0xFA);
+    legacyRead24(0xFA);
+    legacyRead24(0xF7);
+    legacyRead24(0xFA);
+    legacyRead24(0xF7);
+}
+
+// ==================== Medición ====================
+
+struct Latency {
+    double meanUs;
+    uint64_t maxUs;
+    double transactions;
+};
+
+/**
+ * Ciclos de la tarea de sensores con ritmo rápido (SENSOR_FAST_INTERVAL)
+ * @param current true = EnvironmentSensor::read(), false = camino anterior
+ */
+static Latency measure(bool current) {
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    Latency result = {0, 0, 0};
+    uint64_t total = 0;
+    Wire.resetStats();
+
+    for (int cycle = 0; cycle < LATENCY_CYCLES; cycle++) {
+        aht.celsius = 22.0 + cycle * 0.01;
+        bmp.celsius = aht.celsius;
+
+        uint64_t start = HostSim::nowUs;
+        if (current) {
+            EnvironmentReading reading = sensor->read();
+            TEST_ASSERT_FLOAT_WITHIN(0.5f, (float)aht.celsius, reading.temperatureBMP);
+        } else {
+            legacyRead();
+        }
+        uint64_t elapsed = HostSim::nowUs - start;
+
+        total += elapsed;
+        if (elapsed > result.maxUs) {
+            result.maxUs = elapsed;
+        }
+        HostSim::advanceUs((uint64_t)SENSOR_FAST_INTERVAL * 1000 - elapsed % (SENSOR_FAST_INTERVAL * 1000));
+    }
+
+    result.meanUs = (double)total / LATENCY_CYCLES;
+    result.transactions = (double)Wire.getStats().transactions / LATENCY_CYCLES;
+    return result;
+}
+
+void test_read_latency_against_blocking_path(void) {
+    LittleFS.begin(true);
+    Wire.attach(AHT20_ADDRESS, &aht);
+    Wire.attach(BMP280_ADDRESS, &bmp);
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->begin(I2C_SDA, I2C_SCL));
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->isAHT20Ready());
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->isBMP280Ready());
+
+    Latency current = measure(true);
+    Latency legacy = measure(false);
+
+    char line[112];
+    snprintf(line, sizeof(line), "%d lecturas cada %d ms, bus a %lu kHz",
+             LATENCY_CYCLES, SENSOR_FAST_INTERVAL, (unsigned long)Wire.getClock() / 1000);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "read() actual:    media %8.1f us  máx %6llu us  %4.1f transacciones",
+             current.meanUs, (unsigned long long)current.maxUs, current.transactions);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "Adafruit (antes): media %8.1f us  máx %6llu us  %4.1f transacciones",
+             legacy.meanUs, (unsigned long long)legacy.maxUs, legacy.transactions);
+    TEST_MESSAGE(line);
+
+    // Sin esperas: ninguna lectura ocupa el ciclo más de unos pocos ms de bus
+    TEST_ASSERT_LESS_THAN(5000, current.maxUs);
+
+    // El camino anterior espera la conversión completa del AHT20 en cada lectura
+    TEST_ASSERT_GREATER_OR_EQUAL(AHT20_MEASURE_MS * 1000, legacy.meanUs);
+    TEST_ASSERT_LESS_THAN_DOUBLE(legacy.meanUs / 10, current.meanUs);
+    TEST_ASSERT_LESS_THAN_DOUBLE(legacy.transactions, current.transactions);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_read_latency_against_blocking_path);
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+/*
+Pruebas de JsonWriter (JSON sobre buffer fijo):
+
+Objetos anidados con comas automáticas, enteros, booleanos, decimales
+Texto escapado (comillas, barra invertida, caracteres de control)
+NaN e infinitos como null
+Desbordamiento: el documento se marca incompleto y el buffer no se pasa
+*/
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "utils/JsonWriter.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_nested_objects(void) {
+    char buffer[256];
+    JsonWriter json(buffer, sizeof(buffer));
+
+    json.beginObject();
+    json.field("cycle", 42u);
+    json.field("offset", -7);
+    json.beginObject("smoke");
+    json.field("ppm", 12.345f, 1);
+    json.field("rising", true);
+    json.endObject();
+    json.beginObject("env");
+    json.endObject();
+    json.field("name", "MQ-2");
+    json.field("missing", (const char*)nullptr);
+    json.endObject();
+
+    const char* expected =
+        "{\"cycle\":42,\"offset\":-7,\"smoke\":{\"ppm\":12.3,\"rising\":true},"
+        "\"env\":{},\"name\":\"MQ-2\",\"missing\":null}";
+    TEST_ASSERT_TRUE(json.isComplete());
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), json.size());
+}
+
+void test_integer_limits(void) {
+    char buffer[128];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("max", 4294967295ul);
+    json.field("min", (long)INT32_MIN);
+    json.field("zero", 0);
+    json.endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"max\":4294967295,\"min\":-2147483648,\"zero\":0}", buffer);
+}
+
+void test_string_escaping(void) {
+    char buffer[128];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("s", "a\"b\\c\nd\x01" "é");
+    json.endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"s\":\"a\\\"b\\\\c\\u000ad\\u0001é\"}", buffer);
+}
+
+void test_non_finite_as_null(void) {
+    char buffer[128];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.field("nan", NAN, 2);
+    json.field("inf", INFINITY, 2);
+    json.field("neg", -0.5f, 2);
+    json.endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"nan\":null,\"inf\":null,\"neg\":-0.50}", buffer);
+}
+
+void test_overflow_marks_incomplete(void) {
+    const char* full = "{\"name\":\"temperatura\",\"value\":1234567}";
+    for (size_t capacity = 0; capacity <= strlen(full) + 1; capacity++) {
+        char buffer[64];
+        memset(buffer, 'X', sizeof(buffer));
+        JsonWriter json(buffer, capacity);
+        json.beginObject();
+        json.field("name", "temperatura");
+        json.field("value", 1234567);
+        json.endObject();
+
+        bool fits = capacity > strlen(full);
+        TEST_ASSERT_EQUAL(fits, json.isComplete());
+        TEST_ASSERT_TRUE(json.size() < capacity || capacity == 0);
+        // Nunca escribe fuera del buffer
+        TEST_ASSERT_EQUAL('X', buffer[capacity]);
+        if (fits) {
+            TEST_ASSERT_EQUAL_STRING(full, buffer);
+        } else if (capacity > 0) {
+            TEST_ASSERT_EQUAL_UINT32(json.size(), strlen(buffer));
+        }
+    }
+}
+
+void test_unclosed_is_incomplete(void) {
+    char buffer[64];
+    JsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.beginObject("a");
+    json.endObject();
+    TEST_ASSERT_FALSE(json.isComplete());
+    json.endObject();
+    TEST_ASSERT_TRUE(json.isComplete());
+}
+
+void test_depth_limit(void) {
+    char buffer[128];
+    JsonWriter json(buffer, sizeof(buffer));
+    for (int i = 0; i <= JSON_MAX_DEPTH; i++) {
+        json.beginObject(i == 0 ? nullptr : "n");
+    }
+    for (int i = 0; i <= JSON_MAX_DEPTH; i++) {
+        json.endObject();
+    }
+    TEST_ASSERT_FALSE(json.isComplete());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nested_objects);
+    RUN_TEST(test_integer_limits);
+    RUN_TEST(test_string_escaping);
+    RUN_TEST(test_non_finite_as_null);
+    RUN_TEST(test_overflow_marks_incomplete);
+    RUN_TEST(test_unclosed_is_incomplete);
+    RUN_TEST(test_depth_limit);
+    return UNITY_END();
+}
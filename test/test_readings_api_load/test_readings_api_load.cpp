@@ -0,0 +1,348 @@
+/*
+Prueba de carga de web/ReadingsApi (pio test -e native -f test_readings_api_load -v):
+
+Decenas de clientes consultan /api/v1/readings y /api/v1/alert sobre el
+modelo de ESPAsyncWebServer de test/host mientras otro hilo publica
+instantáneas sin pausa (como loop con cada ciclo de la tarea de sensores)
+El hilo del servidor atiende todas las conexiones a la vez, un segmento TCP
+por turno (como la tarea de AsyncTCP); algunos clientes cortan a mitad de
+la respuesta
+Cada cuerpo se verifica completo y sin mezclar: todos los campos derivan
+del número de ciclo, un documento pisado mientras se envía se detecta
+Se informa req/s y la memoria dinámica (operator new contado en esta suite):
+pico en uso, reservas por petición y que todo vuelve al terminar
+Los tiempos son de la PC, no del ESP32
+*/
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <ESPAsyncWebServer.h>
+#include "web/ReadingsApi.h"
+
+#define LOAD_CLIENTS 48             // Conexiones simultáneas
+#define LOAD_SEGMENT 256            // Bytes por segmento (ventana de un cliente lento)
+#define LOAD_ABORT_EVERY 10         // Una de cada N peticiones se corta a la mitad
+#define LOAD_DURATION_MS 1000
+
+// ==================== Memoria dinámica ====================
+
+static std::atomic<long> heapInUse(0);
+static std::atomic<long> heapPeak(0);
+static std::atomic<unsigned long> heapAllocations(0);
+
+static void* countedAlloc(size_t size) {
+    // Encabezado con el tamaño (alineado a 16) para descontarlo al liberar
+    char* block = (char*)malloc(size + 16);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *(size_t*)block = size;
+    long now = heapInUse.fetch_add((long)size) + (long)size;
+    long peak = heapPeak.load();
+    while (now > peak && !heapPeak.compare_exchange_weak(peak, now)) {
+    }
+    heapAllocations++;
+    return block + 16;
+}
+
+static void countedFree(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    char* block = (char*)pointer - 16;
+    heapInUse.fetch_sub((long)*(size_t*)block);
+    free(block);
+}
+
+void* operator new(size_t size) {
+    void* pointer = countedAlloc(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+
+// ==================== Documentos ====================
+
+static AsyncWebServer server(80);
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/**
+ * Instantánea cuyos campos derivan todos del número de ciclo
+ */
+static void makeSnapshot(SensorSnapshot& snapshot, uint32_t cycle) {
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.cycle = cycle;
+    snapshot.timestamp = cycle * 250UL;
+    snapshot.sampleIntervalMs = 250;
+    snapshot.alert = (GlobalAlertLevel)(cycle % 4);
+    snapshot.rawAlert = snapshot.alert;
+    snapshot.alertTransitions = cycle / 2;
+    snapshot.smoke.rawValue = (int)(cycle % 4096);
+    snapshot.ch4.rawValue = (int)((cycle * 7) % 4096);
+    snapshot.smoke.state = SmokeState::NORMAL;
+    snapshot.ch4.state = CH4State::NORMAL;
+    snapshot.env.temperature = 20.0f + (cycle % 100) / 10.0f;
+    snapshot.smokeReady = true;
+    snapshot.ch4Ready = true;
+    snapshot.envReady = true;
+    snapshot.smokeCalibration = -1;
+    snapshot.ch4Calibration = -1;
+    snapshot.envCalibration = -1;
+}
+
+static bool readNumber(const char* body, const char* key, unsigned long& value) {
+    const char* found = strstr(body, key);
+    if (found == nullptr) {
+        return false;
+    }
+    value = strtoul(found + strlen(key), nullptr, 10);
+    return true;
+}
+
+/**
+ * Verifica un cuerpo completo: JSON cerrado y todos los campos del mismo ciclo
+ * @return Ciclo del documento (0 si está incompleto o mezclado)
+ */
+static uint32_t checkBody(const char* body, size_t size, bool readings) {
+    if (size == 0 || body[0] != '{' || body[size - 1] != '}') {
+        return 0;
+    }
+    unsigned long cycle;
+    unsigned long timestamp;
+    unsigned long transitions;
+    if (!readNumber(body, "{\"cycle\":", cycle) || !readNumber(body, "\"timestamp\":", timestamp) ||
+        !readNumber(body, "\"transitions\":", transitions)) {
+        return 0;
+    }
+    if (timestamp != cycle * 250UL || transitions != cycle / 2) {
+        return 0;
+    }
+    if (readings) {
+        unsigned long smokeRaw;
+        unsigned long ch4Raw;
+        if (!readNumber(body, "\"smoke\":{\"ready\":true,\"state\":\"NORMAL\",\"raw\":", smokeRaw) ||
+            !readNumber(body, "\"ch4\":{\"ready\":true,\"state\":\"NORMAL\",\"raw\":", ch4Raw) ||
+            smokeRaw != cycle % 4096 || ch4Raw != (cycle * 7) % 4096) {
+            return 0;
+        }
+    }
+    return (uint32_t)cycle;
+}
+
+// ==================== Clientes ====================
+
+struct Connection {
+    AsyncWebServerRequest* request;
+    bool readings;
+    bool abort;
+    size_t received;
+    char body[API_READINGS_BUFFER];
+};
+
+struct LoadResult {
+    unsigned long requests;
+    unsigned long aborted;
+    unsigned long failures;
+    unsigned long bytes;
+    unsigned long maxOpen;
+    uint32_t newestCycle;
+};
+
+/**
+ * Hilo del servidor: atiende todas las conexiones por turnos hasta que se
+ * pide parar y luego cierra las que quedan
+ */
+static void serve(Connection* connections, std::atomic<bool>& running, LoadResult& result) {
+    unsigned long started = 0;
+    while (running.load()) {
+        unsigned long open = 0;
+        for (int i = 0; i < LOAD_CLIENTS; i++) {
+            Connection& connection = connections[i];
+            if (connection.request == nullptr) {
+                connection.readings = (started % 3) != 0;
+                connection.abort = (started % LOAD_ABORT_EVERY) == LOAD_ABORT_EVERY - 1;
+                connection.received = 0;
+                connection.request = server.request(connection.readings ? "/api/v1/readings" : "/api/v1/alert");
+                started++;
+                if (connection.request == nullptr) {
+                    result.failures++;
+                    continue;
+                }
+            }
+            open++;
+
+            size_t room = sizeof(connection.body) - connection.received;
+            size_t sent = connection.request->transmit((uint8_t*)connection.body + connection.received,
+                                                       room < LOAD_SEGMENT ? room : LOAD_SEGMENT);
+            connection.received += sent;
+            AsyncWebServerResponse* response = connection.request->getResponse();
+
+            if (connection.abort && connection.received > 0) {
+                // El cliente corta: se libera sin terminar la respuesta
+                server.close(connection.request);
+                connection.request = nullptr;
+                result.aborted++;
+            } else if (sent == 0 || response->finished()) {
+                uint32_t cycle = 0;
+                if (response->getCode() == 200 && connection.received == response->getContentLength()) {
+                    cycle = checkBody(connection.body, connection.received, connection.readings);
+                }
+                if (cycle == 0) {
+                    result.failures++;
+                } else if (cycle > result.newestCycle) {
+                    result.newestCycle = cycle;
+                }
+                result.requests++;
+                result.bytes += connection.received;
+                server.close(connection.request);
+                connection.request = nullptr;
+            }
+        }
+        if (open > result.maxOpen) {
+            result.maxOpen = open;
+        }
+    }
+
+    for (int i = 0; i < LOAD_CLIENTS; i++) {
+        if (connections[i].request != nullptr) {
+            server.close(connections[i].request);
+            connections[i].request = nullptr;
+        }
+    }
+}
+
+// ==================== Pruebas ====================
+
+void test_no_data_before_first_cycle(void) {
+    ReadingsApi::getInstance()->registerRoutes(server);
+
+    AsyncWebServerRequest* request = server.request("/api/v1/readings");
+    TEST_ASSERT_NOT_NULL(request);
+    TEST_ASSERT_EQUAL_INT(503, request->getResponse()->getCode());
+    char body[64] = {0};
+    size_t size = request->transmit((uint8_t*)body, sizeof(body) - 1);
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"error\":\"sin datos\"}", body, size);
+    server.close(request);
+}
+
+void test_concurrent_pollers(void) {
+    static Connection connections[LOAD_CLIENTS];
+    ReadingsApi* api = ReadingsApi::getInstance();
+    SensorSnapshot snapshot;
+    makeSnapshot(snapshot, 1);
+    api->publish(snapshot);
+
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> published(1);
+    LoadResult result = {};
+
+    long heapBefore = heapInUse.load();
+    heapPeak.store(heapBefore);
+    unsigned long allocationsBefore = heapAllocations.load();
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread server(serve, connections, std::ref(running), std::ref(result));
+    std::thread loop([&]() {
+        SensorSnapshot next;
+        uint32_t cycle = 1;
+        while (running.load()) {
+            makeSnapshot(next, ++cycle);
+            api->publish(next);
+            published.store(cycle);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOAD_DURATION_MS));
+    running = false;
+    loop.join();
+    server.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long heapPeakBytes = heapPeak.load() - heapBefore;
+    unsigned long allocations = heapAllocations.load() - allocationsBefore;
+    unsigned long handled = result.requests + result.aborted;
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d clientes, segmentos de %d bytes, %lu abiertas a la vez",
+             LOAD_CLIENTS, LOAD_SEGMENT, result.maxOpen);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%lu respuestas completas + %lu cortadas en %.2f s: %.0f req/s, %.1f MB/s",
+             result.requests, result.aborted, seconds, handled / seconds, result.bytes / seconds / 1e6);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "%lu publicaciones, %lu omitidas por buffers retenidos",
+             (unsigned long)published.load(), (unsigned long)api->getSkipped());
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "Heap: pico %ld bytes (%.0f por conexión), %.2f reservas por petición",
+             heapPeakBytes, (double)heapPeakBytes / LOAD_CLIENTS, (double)allocations / handled);
+    TEST_MESSAGE(line);
+
+    // Todas las respuestas completas, sin cuerpos pisados ni mezclados
+    TEST_ASSERT_EQUAL_UINT32(0, result.failures);
+    TEST_ASSERT_GREATER_THAN(1000, result.requests);
+    TEST_ASSERT_GREATER_THAN(0, result.aborted);
+    TEST_ASSERT_EQUAL_UINT32(LOAD_CLIENTS, result.maxOpen);
+
+    // Los documentos siguen avanzando pese a los lectores
+    TEST_ASSERT_GREATER_THAN(published.load() / 2, result.newestCycle);
+
+    // La memoria la reserva solo el servidor por conexión: nada queda al cerrar
+    TEST_ASSERT_EQUAL_INT32(heapBefore, heapInUse.load());
+    TEST_ASSERT_LESS_THAN(LOAD_CLIENTS * 512, heapPeakBytes);
+
+    // Con todas las conexiones cerradas, la publicación siguiente se ve entera
+    makeSnapshot(snapshot, published.load() + 1);
+    api->publish(snapshot);
+    AsyncWebServerRequest* request = ::server.request("/api/v1/readings");
+    static char body[API_READINGS_BUFFER];
+    size_t size = 0;
+    size_t sent;
+    while ((sent = request->transmit((uint8_t*)body + size, sizeof(body) - size)) > 0) {
+        size += sent;
+    }
+    TEST_ASSERT_EQUAL_UINT32(published.load() + 1, checkBody(body, size, true));
+    ::server.close(request);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_data_before_first_cycle);
+    RUN_TEST(test_concurrent_pollers);
+    return UNITY_END();
+}
@@ -0,0 +1,347 @@
+/*
+Pruebas de fallas de sensores con inyección en el bus I2C y el ADC simulados (test/host):
+
+I2CBus::recover(): pulsos de SCL hasta que el esclavo suelta SDA, límite de
+9 pulsos y SCL retenido (sin recuperación posible)
+EnvironmentSensor: NACK seguidos → fuera de línea → reintentos con espera
+creciente → reinicio del sensor; SDA retenida por un esclavo colgado
+(ambos sensores caen y vuelven tras los pulsos); trama congelada
+(valor trabado tras HEALTH_STUCK_READS lecturas)
+GasSensor con el muestreo en segundo plano: ADC en un riel, valor trabado
+y señal plana, y vuelta a QUALITY_OK cuando la señal se mueve
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <LittleFS.h>
+#include "sensors/I2CBus.h"
+#include "sensors/EnvironmentSensor.h"
+#include "sensors/SmokeSensor.h"
+#include "sensors/AdcSampler.h"
+#include "config/Config.h"
+
+#define READ_PERIOD_MS SENSOR_FAST_INTERVAL
+
+static HostAHT20 aht;
+static HostBMP280 bmp;
+
+void setUp(void) {
+    aht.frozen = false;
+    aht.calibrated = true;
+    bmp.frozen = false;
+    Wire.holdSda(0);
+    Wire.holdScl(false);
+    Wire.attach(AHT20_ADDRESS, &aht);
+    Wire.attach(BMP280_ADDRESS, &bmp);
+    Wire.failNext(AHT20_ADDRESS, 0);
+    Wire.failNext(BMP280_ADDRESS, 0);
+}
+
+void tearDown(void) {}
+
+/**
+ * Lecturas del sensor ambiental al ritmo rápido de la tarea de sensores
+ * @param ms Tiempo a simular
+ * @return OR de las banderas de calidad de todas las lecturas
+ */
+static uint8_t readFor(unsigned long ms) {
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    uint8_t flags = 0;
+    unsigned long end = millis() + ms;
+    while ((long)(end - millis()) > 0) {
+        unsigned long start = millis();
+        flags |= sensor->read().quality;
+        unsigned long elapsed = millis() - start;
+        if (elapsed < READ_PERIOD_MS) {
+            delay(READ_PERIOD_MS - elapsed);
+        }
+    }
+    return flags;
+}
+
+static void beginEnvironment() {
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->begin(I2C_SDA, I2C_SCL));
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->isAHT20Ready());
+    TEST_ASSERT_TRUE(EnvironmentSensor::getInstance()->isBMP280Ready());
+    readFor(3000);
+}
+
+// ==================== I2CBus::recover() ====================
+
+void test_recover_clocks_out_held_sda(void) {
+    Wire.begin(I2C_SDA, I2C_SCL);
+    Wire.holdSda(5);
+    TEST_ASSERT_EQUAL(LOW, digitalRead(I2C_SDA));
+    TEST_ASSERT_EQUAL(5, Wire.endTransmission());
+
+    uint64_t start = HostSim::nowUs;
+    TEST_ASSERT_TRUE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+    TEST_ASSERT_FALSE(Wire.isSdaHeld());
+    TEST_ASSERT_TRUE(Wire.isRunning());
+    TEST_ASSERT_EQUAL(HIGH, digitalRead(I2C_SDA));
+    TEST_ASSERT_EQUAL(HIGH, digitalRead(I2C_SCL));
+
+    // 5 pulsos + START/STOP a medio periodo de 5 µs: ~100 µs bloqueando
+    TEST_ASSERT_LESS_THAN(200, HostSim::nowUs - start);
+
+    Wire.beginTransmission(AHT20_ADDRESS);
+    TEST_ASSERT_EQUAL(0, Wire.endTransmission());
+}
+
+void test_recover_gives_up_after_nine_pulses(void) {
+    Wire.begin(I2C_SDA, I2C_SCL);
+
+    // Suelta al noveno pulso: todavía se recupera
+    Wire.holdSda(I2C_RECOVERY_PULSES);
+    TEST_ASSERT_TRUE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+
+    // Un décimo pulso ya no se da
+    Wire.holdSda(I2C_RECOVERY_PULSES + 1);
+    TEST_ASSERT_FALSE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+    TEST_ASSERT_TRUE(Wire.isSdaHeld());
+    TEST_ASSERT_TRUE(Wire.isRunning());
+
+    // El intento siguiente termina el trabajo
+    TEST_ASSERT_TRUE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+}
+
+void test_recover_with_scl_held(void) {
+    Wire.begin(I2C_SDA, I2C_SCL);
+    Wire.holdScl(true);
+    Wire.holdSda(1);
+
+    // Sin reloj no hay pulsos: SDA sigue retenida y el periférico vuelve a iniciarse
+    TEST_ASSERT_FALSE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+    TEST_ASSERT_TRUE(Wire.isSdaHeld());
+    TEST_ASSERT_TRUE(Wire.isRunning());
+
+    Wire.holdScl(false);
+    TEST_ASSERT_TRUE(I2CBus::recover(Wire, I2C_SDA, I2C_SCL));
+}
+
+// ==================== EnvironmentSensor ====================
+
+void test_nack_takes_aht20_offline_and_backs_off(void) {
+    LittleFS.begin(true);
+    beginEnvironment();
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    const DeviceHealth& health = sensor->getAHT20Health();
+    uint32_t dropouts = health.getDropouts();
+    uint32_t recoveries = health.getRecoveries();
+    uint32_t initial = aht.measurements;
+
+    // El AHT20 deja de reconocer su dirección
+    Wire.failNext(AHT20_ADDRESS, -1);
+    uint8_t flags = readFor(15000);
+    TEST_ASSERT_FALSE(sensor->isAHT20Ready());
+    TEST_ASSERT_TRUE(sensor->isBMP280Ready());
+    TEST_ASSERT_EQUAL_UINT32(dropouts + 1, health.getDropouts());
+    TEST_ASSERT_TRUE(flags & QUALITY_BUS_ERROR);
+    TEST_ASSERT_TRUE(flags & QUALITY_OFFLINE);
+    EnvironmentReading reading = sensor->getLastReading();
+    TEST_ASSERT_TRUE(reading.temperatureQuality & QUALITY_OFFLINE);
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, reading.pressureQuality);
+
+    // Reintentos con espera creciente: 1, 2, 4, 8 s... hasta el máximo
+    uint32_t backoff = health.getBackoff();
+    TEST_ASSERT_GREATER_THAN(HEALTH_RECOVERY_BACKOFF, backoff);
+    readFor(200000);
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_RECOVERY_BACKOFF_MAX, health.getBackoff());
+    TEST_ASSERT_FALSE(health.isOnline());
+
+    // Vuelve a responder: se reinicia en el próximo intento (como máximo 60 s)
+    Wire.failNext(AHT20_ADDRESS, 0);
+    readFor(HEALTH_RECOVERY_BACKOFF_MAX + 5000);
+    TEST_ASSERT_TRUE(sensor->isAHT20Ready());
+    TEST_ASSERT_TRUE(health.isOnline());
+    TEST_ASSERT_EQUAL_UINT32(recoveries + 1, health.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_RECOVERY_BACKOFF, health.getBackoff());
+    TEST_ASSERT_GREATER_THAN(initial, aht.measurements);
+
+    // Mediciones nuevas sin banderas
+    readFor(5000);
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, sensor->getLastReading().temperatureQuality);
+}
+
+void test_uncalibrated_aht20_is_reinitialized(void) {
+    beginEnvironment();
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    uint32_t commands = aht.initCommands;
+
+    // Corte de alimentación del sensor: no responde un rato y vuelve descalibrado
+    Wire.failNext(AHT20_ADDRESS, -1);
+    readFor(10000);
+    TEST_ASSERT_FALSE(sensor->isAHT20Ready());
+    aht.powerCycle(true);
+    Wire.failNext(AHT20_ADDRESS, 0);
+    readFor(HEALTH_RECOVERY_BACKOFF_MAX);
+
+    // La recuperación repite begin(): carga la calibración (0xBE)
+    TEST_ASSERT_TRUE(sensor->isAHT20Ready());
+    TEST_ASSERT_EQUAL_UINT32(commands + 1, aht.initCommands);
+    TEST_ASSERT_TRUE(aht.calibrated);
+}
+
+void test_held_sda_recovers_both_sensors(void) {
+    beginEnvironment();
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    uint32_t ahtRecoveries = sensor->getAHT20Health().getRecoveries();
+    uint32_t bmpRecoveries = sensor->getBMP280Health().getRecoveries();
+
+    // Un esclavo colgado retiene SDA: todas las transacciones expiran y
+    // los pulsos de los reintentos no alcanzan
+    Wire.holdSda(-1);
+    uint8_t flags = readFor(15000);
+    TEST_ASSERT_TRUE(flags & QUALITY_BUS_ERROR);
+    TEST_ASSERT_FALSE(sensor->isAHT20Ready());
+    TEST_ASSERT_FALSE(sensor->isBMP280Ready());
+    TEST_ASSERT_TRUE(sensor->getLastReading().temperatureQuality & QUALITY_OFFLINE);
+    TEST_ASSERT_TRUE(sensor->getLastReading().pressureQuality & QUALITY_OFFLINE);
+
+    // El esclavo suelta SDA tras unos pulsos: ambos sensores vuelven sin reiniciar el equipo
+    Wire.holdSda(3);
+    readFor(20000);
+    TEST_ASSERT_FALSE(Wire.isSdaHeld());
+    TEST_ASSERT_TRUE(sensor->isAHT20Ready());
+    TEST_ASSERT_TRUE(sensor->isBMP280Ready());
+    TEST_ASSERT_EQUAL_UINT32(ahtRecoveries + 1, sensor->getAHT20Health().getRecoveries());
+    TEST_ASSERT_EQUAL_UINT32(bmpRecoveries + 1, sensor->getBMP280Health().getRecoveries());
+
+    readFor(5000);
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, sensor->getLastReading().quality);
+}
+
+void test_held_scl_keeps_sensors_offline(void) {
+    beginEnvironment();
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+
+    Wire.holdScl(true);
+    readFor(60000);
+    TEST_ASSERT_FALSE(sensor->isAHT20Ready());
+    TEST_ASSERT_FALSE(sensor->isBMP280Ready());
+    TEST_ASSERT_TRUE(sensor->getLastReading().quality & QUALITY_OFFLINE);
+
+    // Reintentos espaciados: el bus retenido no bloquea cada ciclo con timeouts
+    Wire.resetStats();
+    readFor(30000);
+    TEST_ASSERT_LESS_THAN(20, Wire.getStats().errors);
+
+    Wire.holdScl(false);
+    readFor(HEALTH_RECOVERY_BACKOFF_MAX + 5000);
+    TEST_ASSERT_TRUE(sensor->isAHT20Ready());
+    TEST_ASSERT_TRUE(sensor->isBMP280Ready());
+}
+
+void test_frozen_frame_is_stuck(void) {
+    beginEnvironment();
+    EnvironmentSensor* sensor = EnvironmentSensor::getInstance();
+    uint32_t dropouts = sensor->getBMP280Health().getDropouts();
+
+    // El BMP280 responde pero repite la misma conversión (lógica interna colgada)
+    bmp.frozen = true;
+    readFor((HEALTH_STUCK_READS - 2) * READ_PERIOD_MS);
+    TEST_ASSERT_FALSE(sensor->getLastReading().pressureQuality & QUALITY_STUCK);
+    TEST_ASSERT_TRUE(sensor->isBMP280Ready());
+
+    uint8_t flags = readFor(5 * READ_PERIOD_MS);
+    TEST_ASSERT_TRUE(flags & QUALITY_STUCK);
+    TEST_ASSERT_EQUAL_UINT32(dropouts + 1, sensor->getBMP280Health().getDropouts());
+
+    // El reinicio del sensor lo destraba
+    bmp.frozen = false;
+    readFor(5000);
+    TEST_ASSERT_TRUE(sensor->isBMP280Ready());
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, sensor->getLastReading().pressureQuality);
+}
+
+// ==================== ADC ====================
+
+struct AdcFault {
+    int32_t level;          // Cuentas nativas
+    int32_t noise;          // Amplitud del ruido (0 = valor fijo)
+    HostNoise generator;
+};
+
+static AdcFault smokeInput = {1200, 6, HostNoise(777)};
+
+static uint16_t smokeSource(int pin, void* context) {
+    AdcFault* fault = (AdcFault*)context;
+    if (pin != SMOKE_SENSOR_PIN) {
+        return 1000;
+    }
+    int32_t value = fault->level + fault->generator.next(fault->noise);
+    return (uint16_t)(value < 0 ? 0 : value);
+}
+
+/**
+ * Lecturas del sensor de humo (el muestreo en segundo plano corre con el tiempo virtual)
+ * @return OR de las banderas de calidad
+ */
+static uint8_t readSmokeFor(unsigned long ms) {
+    SmokeSensor* smoke = SmokeSensor::getInstance(SMOKE_SENSOR_PIN);
+    uint8_t flags = 0;
+    for (unsigned long t = 0; t < ms; t += READ_PERIOD_MS) {
+        delay(READ_PERIOD_MS);
+        flags |= smoke->read().quality;
+    }
+    return flags;
+}
+
+void test_adc_faults(void) {
+    HostSim::adcSource = smokeSource;
+    HostSim::adcContext = &smokeInput;
+    SmokeSensor* smoke = SmokeSensor::getInstance(SMOKE_SENSOR_PIN);
+    TEST_ASSERT_TRUE(smoke->begin(false));
+    TEST_ASSERT_TRUE(AdcSampler::getInstance()->begin());
+
+    // Señal viva: ruido de unos LSB
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, readSmokeFor(20000));
+
+    // Cable cortado: entrada en el riel
+    smokeInput.level = 0;
+    smokeInput.noise = 0;
+    TEST_ASSERT_TRUE(readSmokeFor(2000) & QUALITY_OUT_OF_RANGE);
+
+    // Valor trabado: mismo valor sin ruido en cada lote
+    smokeInput.level = 1500;
+    uint8_t flags = readSmokeFor((HEALTH_STUCK_READS + 4) * READ_PERIOD_MS);
+    TEST_ASSERT_TRUE(flags & QUALITY_STUCK);
+    TEST_ASSERT_TRUE(smoke->read().quality & QUALITY_STUCK);
+
+    // Vuelve el ruido: se libera en la primera lectura
+    smokeInput.noise = 6;
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, readSmokeFor(READ_PERIOD_MS));
+
+    // Señal plana: varía un LSB (no está trabada) pero nada en toda la ventana
+    smokeInput.noise = 0;
+    unsigned long flatStart = millis();
+    unsigned long flatAt = 0;
+    while (millis() - flatStart < 2 * HEALTH_FLAT_WINDOW && flatAt == 0) {
+        smokeInput.level = 1500 + (int32_t)((millis() / 1000) & 1);
+        if (readSmokeFor(1000) & QUALITY_FLATLINE) {
+            flatAt = millis();
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, flatAt);
+    TEST_ASSERT_GREATER_OR_EQUAL(HEALTH_FLAT_WINDOW, flatAt - flatStart);
+
+    smokeInput.noise = 6;
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, readSmokeFor(READ_PERIOD_MS * 2) & ~QUALITY_FLATLINE);
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, smoke->read().quality);
+
+    AdcSampler::getInstance()->stop();
+    HostSim::adcSource = nullptr;
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recover_clocks_out_held_sda);
+    RUN_TEST(test_recover_gives_up_after_nine_pulses);
+    RUN_TEST(test_recover_with_scl_held);
+    RUN_TEST(test_nack_takes_aht20_offline_and_backs_off);
+    RUN_TEST(test_uncalibrated_aht20_is_reinitialized);
+    RUN_TEST(test_held_sda_recovers_both_sensors);
+    RUN_TEST(test_held_scl_keeps_sensors_offline);
+    RUN_TEST(test_frozen_frame_is_stuck);
+    RUN_TEST(test_adc_faults);
+    return UNITY_END();
+}
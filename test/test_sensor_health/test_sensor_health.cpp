@@ -0,0 +1,201 @@
+/*
+Pruebas de SensorHealth (calidad de las lecturas):
+
+SignalMonitor: fuera de rango, valor trabado (solo sin variación interna),
+señal plana por ventana y liberación al volver la variación
+DeviceHealth: errores de bus seguidos, medición vieja, fuera de línea,
+reintentos con espera creciente y recuperación
+*/
+#include <unity.h>
+#include "utils/SensorHealth.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_out_of_range(void) {
+    SignalMonitor monitor(10, 4085, 0, 0, 0);
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(100, 200, 0));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OUT_OF_RANGE, monitor.update(5, 200, 10));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OUT_OF_RANGE, monitor.update(4000, 4095, 20));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(4000, 4085, 30));
+}
+
+void test_stuck_value(void) {
+    SignalMonitor monitor(0, 4095, 5, 0, 0);
+    uint32_t now = 0;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(1234, now += 100));
+    }
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_STUCK, monitor.update(1234, now += 100));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_STUCK, monitor.update(1234, now += 100));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(1235, now += 100));
+}
+
+void test_internal_spread_is_not_stuck(void) {
+    // Mismo mínimo en cada lectura, pero con ruido dentro de ella: sensor vivo
+    SignalMonitor monitor(0, 4095, 5, 0, 0);
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(1234, 1236, i * 100));
+    }
+}
+
+void test_flatline_window(void) {
+    SignalMonitor monitor(0, 4095, 0, 1000, 2);
+    uint32_t now = 0;
+
+    // Primera ventana plana: se marca al cerrarla
+    for (; now < 1000; now += 100) {
+        TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(500 + (now / 100) % 2, now));
+    }
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_FLATLINE, monitor.update(500, now));
+
+    // Sigue plana en la ventana siguiente
+    now += 100;
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_FLATLINE, monitor.update(501, now));
+
+    // La variación libera la marca sin esperar a cerrar la ventana
+    now += 100;
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(510, now));
+}
+
+void test_varying_signal_never_flat(void) {
+    SignalMonitor monitor(0, 4095, 3, 1000, 2);
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(500 + (i % 7), i * 50));
+    }
+}
+
+void test_reset_forgets_history(void) {
+    SignalMonitor monitor(0, 4095, 2, 0, 0);
+    for (uint32_t i = 0; i < 5; i++) {
+        monitor.update(77, i);
+    }
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_STUCK, monitor.getFlags());
+    monitor.reset();
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.getFlags());
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, monitor.update(77, 10));
+}
+
+// 3 errores seguidos, vieja a 2 s, fuera de línea a 5 s, espera de 1 s a 8 s
+static DeviceHealth makeDevice() {
+    return DeviceHealth(3, 2000, 5000, 1000, 8000);
+}
+
+void test_never_attached_is_not_offline(void) {
+    DeviceHealth device = makeDevice();
+    device.setOffline(0);
+    TEST_ASSERT_FALSE(device.isAttached());
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, device.update(0, false, false, 10000));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_BUS_ERROR, device.update(1, false, false, 11000));
+    TEST_ASSERT_FALSE(device.shouldRecover(20000));
+    TEST_ASSERT_EQUAL_UINT32(0, device.getDropouts());
+}
+
+void test_consecutive_bus_errors(void) {
+    DeviceHealth device = makeDevice();
+    device.setOnline(0, 0);
+
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_BUS_ERROR, device.update(1, false, false, 100));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_BUS_ERROR, device.update(2, false, false, 200));
+    // Una lectura buena reinicia la cuenta
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, device.update(2, true, false, 300));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_BUS_ERROR, device.update(3, false, false, 400));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_BUS_ERROR, device.update(4, false, false, 500));
+    TEST_ASSERT_TRUE(device.isOnline());
+
+    uint8_t flags = device.update(5, false, false, 600);
+    TEST_ASSERT_TRUE(flags & QUALITY_OFFLINE);
+    TEST_ASSERT_FALSE(device.isOnline());
+    TEST_ASSERT_EQUAL_UINT32(1, device.getDropouts());
+}
+
+void test_stale_then_offline(void) {
+    DeviceHealth device = makeDevice();
+    device.setOnline(0, 0);
+
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, device.update(0, false, false, 2000));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_STALE, device.update(0, false, false, 2001));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_STALE, device.update(0, false, false, 5000));
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_HELD, device.update(0, false, false, 5001));
+
+    // Mientras está caído, toda lectura es un valor retenido
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_HELD, device.update(0, true, false, 5100));
+}
+
+void test_faulty_data_takes_offline(void) {
+    DeviceHealth device = makeDevice();
+    device.setOnline(0, 0);
+    TEST_ASSERT_TRUE(device.update(0, true, true, 100) & QUALITY_OFFLINE);
+    TEST_ASSERT_FALSE(device.isOnline());
+}
+
+void test_backoff_doubles_and_caps(void) {
+    DeviceHealth device = makeDevice();
+    device.setOnline(0, 0);
+    device.setOffline(1000);
+
+    uint32_t now = 1000;
+    TEST_ASSERT_TRUE(device.shouldRecover(now));
+
+    const uint32_t expected[] = {1000, 2000, 4000, 8000, 8000, 8000};
+    for (uint32_t wait : expected) {
+        device.recovered(false, 0, now);
+        TEST_ASSERT_FALSE(device.shouldRecover(now + wait - 1));
+        TEST_ASSERT_TRUE(device.shouldRecover(now + wait));
+        now += wait;
+    }
+    TEST_ASSERT_EQUAL_UINT32(8000, device.getBackoff());
+}
+
+void test_recovery_restores_online(void) {
+    DeviceHealth device = makeDevice();
+    device.setOnline(0, 0);
+    device.update(0, false, true, 100);
+    device.recovered(false, 7, 100);
+    device.recovered(false, 9, 1100);
+
+    device.recovered(true, 9, 3100);
+    TEST_ASSERT_TRUE(device.isOnline());
+    TEST_ASSERT_EQUAL_UINT32(1, device.getRecoveries());
+    TEST_ASSERT_EQUAL_UINT32(1000, device.getBackoff());
+    TEST_ASSERT_FALSE(device.shouldRecover(3200));
+
+    // El contador del driver tras la recuperación no cuenta como error nuevo
+    TEST_ASSERT_EQUAL_UINT8(QUALITY_OK, device.update(9, true, false, 3200));
+}
+
+void test_backoff_across_millis_wrap(void) {
+    DeviceHealth device = makeDevice();
+    uint32_t now = 0xFFFFFFFFUL - 500;
+    device.setOnline(0, now);
+    device.setOffline(now);
+    device.recovered(false, 0, now);
+    TEST_ASSERT_FALSE(device.shouldRecover(now + 999));
+    TEST_ASSERT_TRUE(device.shouldRecover(now + 1000));
+}
+
+void test_quality_name_priority(void) {
+    TEST_ASSERT_EQUAL_STRING("OK", qualityName(QUALITY_OK));
+    TEST_ASSERT_EQUAL_STRING("FUERA DE LÍNEA", qualityName(QUALITY_HELD | QUALITY_STUCK));
+    TEST_ASSERT_EQUAL_STRING("SIN DATOS NUEVOS", qualityName(QUALITY_STALE | QUALITY_DISAGREE));
+    TEST_ASSERT_EQUAL_STRING("DISCREPANCIA", qualityName(QUALITY_DISAGREE));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_out_of_range);
+    RUN_TEST(test_stuck_value);
+    RUN_TEST(test_internal_spread_is_not_stuck);
+    RUN_TEST(test_flatline_window);
+    RUN_TEST(test_varying_signal_never_flat);
+    RUN_TEST(test_reset_forgets_history);
+    RUN_TEST(test_never_attached_is_not_offline);
+    RUN_TEST(test_consecutive_bus_errors);
+    RUN_TEST(test_stale_then_offline);
+    RUN_TEST(test_faulty_data_takes_offline);
+    RUN_TEST(test_backoff_doubles_and_caps);
+    RUN_TEST(test_recovery_restores_online);
+    RUN_TEST(test_backoff_across_millis_wrap);
+    RUN_TEST(test_quality_name_priority);
+    return UNITY_END();
+}
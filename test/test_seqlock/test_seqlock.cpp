@@ -0,0 +1,97 @@
+/*
+Pruebas de SeqLock:
+
+Versión y copia en un solo hilo
+Tortura: un escritor y tres lectores en hilos separados (como la tarea de
+sensores, loop y AsyncTCP). Cada instantánea repite su número de versión
+en todas sus palabras: una lectura mezclada de dos escrituras se detecta.
+Los lectores nunca ven versiones que retroceden.
+*/
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "utils/SeqLock.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Del tamaño aproximado de SensorSnapshot
+struct Snapshot {
+    uint32_t version;
+    uint32_t payload[60];
+    float reading;
+};
+
+static void fill(Snapshot& s, uint32_t version) {
+    s.version = version;
+    for (uint32_t& word : s.payload) word = version * 2654435761u;
+    s.reading = (float)version;
+}
+
+static bool consistent(const Snapshot& s) {
+    for (uint32_t word : s.payload) {
+        if (word != s.version * 2654435761u) return false;
+    }
+    return s.reading == (float)s.version;
+}
+
+void test_single_thread_roundtrip(void) {
+    SeqLock<Snapshot> lock;
+    TEST_ASSERT_EQUAL_UINT32(0, lock.getVersion());
+    TEST_ASSERT_EQUAL_UINT32(0, lock.read().version);
+
+    Snapshot s;
+    fill(s, 42);
+    lock.write(s);
+    TEST_ASSERT_EQUAL_UINT32(1, lock.getVersion());
+    Snapshot copy = lock.read();
+    TEST_ASSERT_EQUAL_UINT32(42, copy.version);
+    TEST_ASSERT_TRUE(consistent(copy));
+}
+
+void test_torture_one_writer_three_readers(void) {
+    static SeqLock<Snapshot> lock;
+    const uint32_t writes = 500000;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backwards(0);
+    std::atomic<uint32_t> reads(0);
+
+    auto reader = [&]() {
+        uint32_t last = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            Snapshot s = lock.read();
+            if (!consistent(s)) torn++;
+            if (s.version < last) backwards++;
+            last = s.version;
+            reads++;
+        }
+    };
+
+    std::thread r1(reader), r2(reader), r3(reader);
+    Snapshot s;
+    for (uint32_t v = 1; v <= writes; v++) {
+        fill(s, v);
+        lock.write(s);
+    }
+    done.store(true, std::memory_order_release);
+    r1.join();
+    r2.join();
+    r3.join();
+
+    char line[64];
+    snprintf(line, sizeof(line), "%u escrituras, %u lecturas", (unsigned)writes, (unsigned)reads.load());
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+    TEST_ASSERT_GREATER_THAN(0, reads.load());
+    TEST_ASSERT_EQUAL_UINT32(writes, lock.getVersion());
+    TEST_ASSERT_EQUAL_UINT32(writes, lock.read().version);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_thread_roundtrip);
+    RUN_TEST(test_torture_one_writer_three_readers);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+/*
+Pruebas de SpscRing:
+
+Orden FIFO, cola llena/vacía y descartes
+drain() por lotes
+Estrés con productor y consumidor en hilos separados (como el timer
+del ADC y la tarea de sensores): sin elementos rotos, repetidos ni
+fuera de orden, y recibidos + descartados = enviados
+*/
+#include <unity.h>
+#include <thread>
+#include "utils/SpscRing.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_fifo_order_and_bounds(void) {
+    SpscRing<uint16_t, 8> ring;
+    uint16_t value;
+
+    TEST_ASSERT_TRUE(ring.isEmpty());
+    TEST_ASSERT_FALSE(ring.pop(value));
+
+    for (uint16_t i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_EQUAL_UINT(8, ring.size());
+    TEST_ASSERT_FALSE(ring.push(99));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.getDropped());
+
+    for (uint16_t i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL_UINT16(i, value);
+    }
+    TEST_ASSERT_TRUE(ring.isEmpty());
+}
+
+void test_drain_wraps_around(void) {
+    SpscRing<uint16_t, 4> ring;
+    uint16_t next = 0;
+    uint16_t expected = 0;
+
+    // Muchas vueltas del índice: drain() entrega todo, en orden
+    for (int round = 0; round < 1000; round++) {
+        int count = round % 6;          // 5 no entra: se descarta uno
+        for (int i = 0; i < count; i++) {
+            ring.push(next++);
+        }
+        size_t drained = ring.drain([&](const uint16_t& v) {
+            TEST_ASSERT_EQUAL_UINT16(expected, v);
+            expected++;
+        });
+        TEST_ASSERT_EQUAL_UINT(count > 4 ? 4 : count, drained);
+        expected = next;
+    }
+    TEST_ASSERT_EQUAL_UINT32(166, ring.getDropped());
+}
+
+struct Sample {
+    uint32_t sequence;
+    uint32_t check;         // ~sequence: detecta elementos rotos
+};
+
+void test_concurrent_producer_consumer(void) {
+    static SpscRing<Sample, 64> ring;
+    const uint32_t total = 2000000;
+    uint32_t received = 0;
+    uint32_t last = 0;
+    bool torn = false;
+    bool disordered = false;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 1; i <= total; i++) {
+            ring.push({i, ~i});
+        }
+    });
+
+    bool done = false;
+    while (!done) {
+        done = ring.getDropped() + received == total;
+        ring.drain([&](const Sample& s) {
+            if (s.check != ~s.sequence) torn = true;
+            if (s.sequence <= last) disordered = true;
+            last = s.sequence;
+            received++;
+        });
+    }
+    producer.join();
+
+    TEST_ASSERT_FALSE(torn);
+    TEST_ASSERT_FALSE(disordered);
+    TEST_ASSERT_EQUAL_UINT32(total, received + ring.getDropped());
+    TEST_ASSERT_GREATER_THAN(0, received);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fifo_order_and_bounds);
+    RUN_TEST(test_drain_wraps_around);
+    RUN_TEST(test_concurrent_producer_consumer);
+    return UNITY_END();
+}
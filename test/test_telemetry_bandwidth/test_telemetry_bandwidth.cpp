@@ -0,0 +1,423 @@
+/*
+Ancho de banda del canal binario de telemetría (pio test -e native -f test_telemetry_bandwidth -v):
+
+Trazas: cada escenario de BenchScenarios.h grabado en vivo sobre los
+sensores simulados (como test_trace_replay) y, con TRACE_CORPUS=<carpeta>,
+cada <nombre>.bin de la carpeta (trazas descargadas del equipo)
+Cada traza se reproduce con TraceReplay::run(); en cada ciclo la
+instantánea se publica por TelemetrySocket a un cliente de /ws/telemetry
+(modelo de test/host) y se serializa como /api/v1/readings
+Los cuadros recibidos se decodifican y deben dar exactamente la muestra
+cuantizada de la instantánea; bytes por muestra contra el JSON
+Decodificador web: si node está instalado, los mismos cuadros se escriben
+como vectores y tools/telemetry_js_check.js los decodifica con data/telemetry.js
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <LittleFS.h>
+#include <ESPAsyncWebServer.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "trace/TraceRecorder.h"
+#include "trace/TraceReplay.h"
+#include "bench/BenchScenarios.h"
+#include "sensors/AdcSampler.h"
+#include "sensors/SmokeSensor.h"
+#include "sensors/CH4Sensor.h"
+#include "sensors/EnvironmentSensor.h"
+#include "tasks/SensorTask.h"
+#include "alert/SmartAlert.h"
+#include "web/ReadingsApi.h"
+#include "web/TelemetrySocket.h"
+#include "utils/Clock.h"
+#include "config/Config.h"
+
+#define PREROLL_MS 60000            // Aire limpio antes del evento
+#define GAS_NOISE_COUNTS 8          // Ruido de los gases (cuentas ADC)
+#define WS_HEADER_BYTES 2           // Encabezado WebSocket servidor → cliente (< 126 bytes)
+#define MIN_REDUCTION 10            // JSON / binario como mínimo (un orden de magnitud)
+
+static HostAHT20 aht;
+static HostBMP280 bmp;
+static AsyncWebServer server(80);
+static AsyncWebSocket* socket = nullptr;
+
+// Traza a medir (grabada aquí o leída del corpus)
+struct BandwidthTrace {
+    std::string name;
+    std::string data;
+};
+
+static std::vector<BandwidthTrace> traces;
+
+// Entradas del escenario en curso (leídas por el timer ADC simulado)
+struct LiveInput {
+    const BenchScenario* scenario;
+    unsigned long onsetMs;
+    HostNoise noise;
+};
+
+static LiveInput liveInput = {nullptr, 0, HostNoise(4242)};
+
+// Medición de la traza en curso (la llena el suscriptor de cada ciclo)
+struct BandwidthRun {
+    AsyncWebSocketClient* client;
+    TelemetryDecoder decoder;
+    uint32_t samples;
+    uint32_t frames;
+    uint32_t keyframes;
+    uint32_t mismatches;
+    uint64_t binaryBytes;
+    uint64_t jsonBytes;
+    size_t largestFrame;
+    FILE* vectors;                  // nullptr = sin node
+};
+
+static BandwidthRun* current = nullptr;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint16_t scenarioAdc(int pin, void* context) {
+    LiveInput* input = (LiveInput*)context;
+    int signal = pin == SMOKE_SENSOR_PIN ? BENCH_SMOKE : BENCH_CH4;
+    int32_t t = (int32_t)(millis() - input->onsetMs);
+    int32_t value = (int32_t)input->scenario->signals[signal].at(t, BENCH_REST[signal]) +
+                    input->noise.next(GAS_NOISE_COUNTS);
+    return (uint16_t)constrain(value, 0, 4095);
+}
+
+/**
+ * Estado de arranque conocido antes de grabar o reproducir
+ */
+static void freshBoot() {
+    Clock::realTime();
+
+    EnvironmentSensor::getInstance()->setBaseline(BENCH_REST[BENCH_TEMPERATURE],
+                                                  BENCH_REST[BENCH_HUMIDITY],
+                                                  BENCH_REST[BENCH_PRESSURE]);
+    EnvironmentSensor::getInstance()->setReplay(false);
+    AdcSampler::getInstance()->setReplay(true);
+    AdcSampler::getInstance()->setReplay(false);
+
+    GasCalibration smokeCalibration = SmokeTraits::DEFAULT_CALIBRATION;
+    GasCalibration ch4Calibration = CH4Traits::DEFAULT_CALIBRATION;
+    smokeCalibration.isCalibrated = true;
+    ch4Calibration.isCalibrated = true;
+    SmokeSensor::getInstance()->setCalibration(smokeCalibration);
+    CH4Sensor::getInstance()->setCalibration(ch4Calibration);
+    SmokeSensor::getInstance()->restart(false);
+    CH4Sensor::getInstance()->restart(false);
+
+    SensorTask::getInstance()->reset();
+    while (EventBus::getInstance()->dispatch() > 0) {
+        // Descartar eventos anteriores
+    }
+}
+
+/**
+ * Corre un escenario en vivo con la grabación activa (como setup() y loop())
+ * @return Trazas grabadas: los archivos rotados y el último, en orden
+ */
+static std::vector<std::string> recordScenario(const BenchScenario& scenario) {
+    AdcSampler* sampler = AdcSampler::getInstance();
+    SensorTask* sensorTask = SensorTask::getInstance();
+    EventBus* eventBus = EventBus::getInstance();
+    TraceRecorder* recorder = TraceRecorder::getInstance();
+
+    freshBoot();
+    liveInput.scenario = &scenario;
+    liveInput.onsetMs = millis() + PREROLL_MS;
+    HostSim::adcSource = scenarioAdc;
+    HostSim::adcContext = &liveInput;
+
+    LittleFS.remove(TRACE_FILE_PATH);
+    LittleFS.remove(TRACE_OLD_FILE_PATH);
+
+    HostTask task;
+    TEST_ASSERT_TRUE(recorder->begin(sampler->getChannelCount(), ADC_SAMPLE_RATE_HZ,
+                                     EnvironmentSensor::getInstance()->getBMP280Calibration()));
+    sampler->setWakeTask(&task);
+    TEST_ASSERT_TRUE(sampler->begin(ADC_SAMPLE_RATE_HZ));
+
+    std::vector<std::string> files;
+    unsigned long end = liveInput.onsetMs + scenario.durationMs;
+    unsigned long cycleStart = millis();
+    bool adcWake = false;
+    while ((long)(end - millis()) > 0) {
+        int32_t t = (int32_t)(millis() - liveInput.onsetMs);
+        aht.celsius = scenario.signals[BENCH_TEMPERATURE].at(t, BENCH_REST[BENCH_TEMPERATURE]);
+        aht.relativeHumidity = scenario.signals[BENCH_HUMIDITY].at(t, BENCH_REST[BENCH_HUMIDITY]);
+        bmp.celsius = aht.celsius;
+        bmp.hPa = scenario.signals[BENCH_PRESSURE].at(t, BENCH_REST[BENCH_PRESSURE]);
+
+        sensorTask->cycle(adcWake);
+
+        unsigned long deadline = cycleStart + sensorTask->getSnapshot().sampleIntervalMs;
+        bool late = (long)(deadline - millis()) <= 0;
+        adcWake = false;
+        while (!adcWake && (long)(deadline - millis()) > 0) {
+            eventBus->dispatch();
+            recorder->flush();
+            // Cada archivo rotado es una traza completa (con su encabezado)
+            if (LittleFS.exists(TRACE_OLD_FILE_PATH)) {
+                files.push_back(LittleFS.contents(TRACE_OLD_FILE_PATH));
+                LittleFS.remove(TRACE_OLD_FILE_PATH);
+            }
+            delay(1);
+            adcWake = task.notifications.exchange(0) > 0;
+        }
+        cycleStart = (adcWake || late) ? millis() : deadline;
+    }
+
+    sampler->stop();
+    sampler->setWakeTask(nullptr);
+    HostSim::adcSource = nullptr;
+    eventBus->dispatch();
+    recorder->stop();
+
+    TEST_ASSERT_EQUAL(0, recorder->getDropped());
+    files.push_back(LittleFS.contents(TRACE_FILE_PATH));
+    return files;
+}
+
+/**
+ * Agrega las trazas de TRACE_CORPUS (en orden alfabético)
+ * @return Trazas agregadas
+ */
+static int loadHostCorpus(const char* directory) {
+    DIR* dir = opendir(directory);
+    if (dir == nullptr) {
+        return 0;
+    }
+
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string file(entry->d_name);
+        if (file.size() > 4 && file.compare(file.size() - 4, 4, ".bin") == 0) {
+            names.push_back(file);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const std::string& name : names) {
+        std::ifstream input(std::string(directory) + "/" + name, std::ios::binary);
+        std::stringstream buffer;
+        buffer << input.rdbuf();
+        traces.push_back({name.substr(0, name.size() - 4), buffer.str()});
+    }
+    return (int)names.size();
+}
+
+/**
+ * Escribe un cuadro y lo esperado de su muestra (una línea por cuadro,
+ * formato en tools/telemetry_js_check.js)
+ */
+static void writeVector(FILE* out, const std::vector<uint8_t>& frame, const SensorSnapshot& snapshot,
+                        const TelemetrySample& sample) {
+    for (uint8_t byte : frame) {
+        fprintf(out, "%02x", byte);
+    }
+    fprintf(out, " %lu %lu %lu %s %s", (unsigned long)sample.cycle, (unsigned long)sample.timestamp,
+            (unsigned long)sample.state, SmartAlert::getLevelName(snapshot.alert),
+            SmartAlert::getLevelName(snapshot.rawAlert));
+    for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+        fprintf(out, " %d", sample.fields[i]);
+    }
+
+    // Valores físicos en el orden de TelemetryField
+    const EnvironmentReading& env = snapshot.env;
+    float physical[TELEMETRY_FIELDS] = {
+        env.temperature, env.humidity, env.pressure,
+        (float)snapshot.smoke.ppm, (float)snapshot.smoke.rawValue,
+        (float)snapshot.ch4.ppm, snapshot.ch4.lel, (float)snapshot.ch4.rawValue,
+        snapshot.fireProbability, env.tempRate, env.pressureRate
+    };
+    for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+        fprintf(out, " %.9g", physical[i]);
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * Cada ciclo reproducido: publicar como loop() y comparar lo recibido
+ * (TOPIC_ENVIRONMENT es el último evento del ciclo)
+ */
+static void onCycle(const Event& event, void*) {
+    BandwidthRun& run = *current;
+    SensorSnapshot snapshot = SensorTask::getInstance()->getSnapshot();
+    if (snapshot.cycle != event.cycle) {
+        run.mismatches++;
+        return;
+    }
+
+    static char json[API_READINGS_BUFFER];
+    run.jsonBytes += ReadingsApi::writeReadings(snapshot, json, sizeof(json));
+    run.samples++;
+
+    TelemetrySocket::getInstance()->publish(snapshot);
+    TelemetrySample expected;
+    TelemetrySocket::toSample(snapshot, expected);
+
+    for (const std::vector<uint8_t>& frame : run.client->drain()) {
+        TelemetrySample decoded;
+        run.frames++;
+        run.keyframes += frame[0] == TELEMETRY_KEYFRAME ? 1 : 0;
+        run.binaryBytes += frame.size();
+        run.largestFrame = std::max(run.largestFrame, frame.size());
+        if (!run.decoder.decode(frame.data(), frame.size(), decoded) ||
+            decoded.cycle != expected.cycle || decoded.timestamp != expected.timestamp ||
+            decoded.state != expected.state ||
+            memcmp(decoded.fields, expected.fields, sizeof(decoded.fields)) != 0) {
+            run.mismatches++;
+        }
+        if (run.vectors != nullptr) {
+            writeVector(run.vectors, frame, snapshot, expected);
+        }
+    }
+}
+
+/**
+ * Ruta de tools/telemetry_js_check.js desde la de esta suite
+ */
+static std::string checkScriptPath() {
+    std::string path(__FILE__);
+    size_t test = path.rfind("test/test_telemetry_bandwidth/");
+    return test == std::string::npos ? std::string() : path.substr(0, test) + "tools/telemetry_js_check.js";
+}
+
+// ==================== Pruebas ====================
+
+void test_record_scenarios(void) {
+    for (const BenchScenario& scenario : BENCH_SCENARIOS) {
+        std::vector<std::string> files = recordScenario(scenario);
+        for (size_t i = 0; i < files.size(); i++) {
+            TEST_ASSERT_GREATER_THAN(TRACE_HEADER_SIZE, files[i].size());
+            std::string name = files.size() > 1 ? std::string(scenario.name) + "." + std::to_string(i + 1)
+                                                : std::string(scenario.name);
+            traces.push_back({name, files[i]});
+        }
+    }
+
+    const char* directory = getenv("TRACE_CORPUS");
+    if (directory != nullptr) {
+        char line[96];
+        snprintf(line, sizeof(line), "%d trazas en %s", loadHostCorpus(directory), directory);
+        TEST_MESSAGE(line);
+    }
+    TEST_ASSERT_TRUE(traces.size() >= BENCH_SCENARIO_COUNT);
+}
+
+void test_bandwidth_per_sample(void) {
+    // Vectores para el decodificador web solo si hay node
+    std::string script = checkScriptPath();
+    bool node = !script.empty() && access(script.c_str(), R_OK) == 0 &&
+                system("node --version > /dev/null 2>&1") == 0;
+    char vectorsPath[] = "/tmp/telemetry_vectors_XXXXXX";
+    FILE* vectors = nullptr;
+    if (node) {
+        int fd = mkstemp(vectorsPath);
+        vectors = fd >= 0 ? fdopen(fd, "w") : nullptr;
+    }
+
+    EventBus::getInstance()->subscribe(onCycle, nullptr, TOPIC_ENVIRONMENT, PRIORITY_NORMAL);
+    TEST_MESSAGE("trace,samples,keyframes,json_bytes_per_sample,binary_bytes_per_sample,"
+                 "ws_bytes_per_sample,largest_frame,reduction");
+
+    uint64_t totalJson = 0;
+    uint64_t totalBinary = 0;
+    uint64_t totalSamples = 0;
+
+    for (const BandwidthTrace& trace : traces) {
+        File file = LittleFS.open(TRACE_REPLAY_PATH, "w");
+        file.write((const uint8_t*)trace.data.data(), trace.data.size());
+        file.close();
+
+        // Cliente nuevo por traza: recibe un cuadro clave y sigue con los deltas
+        BandwidthRun run = {};
+        run.client = socket->connect();
+        run.vectors = vectors;
+        current = &run;
+
+        freshBoot();
+        TraceReplayResult result;
+        TEST_ASSERT_TRUE_MESSAGE(TraceReplay::run(TRACE_REPLAY_PATH, nullptr, result), trace.name.c_str());
+
+        current = nullptr;
+        socket->disconnect(run.client);
+
+        // Una muestra por ciclo, decodificada exacta, sin huecos ni cuadros salteados
+        TEST_ASSERT_GREATER_THAN(0, run.samples);
+        TEST_ASSERT_EQUAL(run.samples, run.frames);
+        TEST_ASSERT_EQUAL_MESSAGE(0, run.mismatches, trace.name.c_str());
+        TEST_ASSERT_EQUAL(0, run.decoder.getGaps());
+        TEST_ASSERT_TRUE(run.largestFrame <= TELEMETRY_MAX_FRAME);
+
+        double json = (double)run.jsonBytes / run.samples;
+        double binary = (double)run.binaryBytes / run.samples;
+        char line[160];
+        snprintf(line, sizeof(line), "%s,%lu,%lu,%.1f,%.2f,%.2f,%lu,%.1f", trace.name.c_str(),
+                 (unsigned long)run.samples, (unsigned long)run.keyframes, json, binary,
+                 binary + WS_HEADER_BYTES, (unsigned long)run.largestFrame, json / (binary + WS_HEADER_BYTES));
+        TEST_MESSAGE(line);
+
+        totalJson += run.jsonBytes;
+        totalBinary += run.binaryBytes + (uint64_t)WS_HEADER_BYTES * run.frames;
+        totalSamples += run.samples;
+    }
+    EventBus::getInstance()->unsubscribe(onCycle, nullptr);
+
+    char line[128];
+    snprintf(line, sizeof(line), "Total: %lu muestras, JSON %.1f B, WebSocket %.2f B por muestra (x%.1f)",
+             (unsigned long)totalSamples, (double)totalJson / totalSamples,
+             (double)totalBinary / totalSamples, (double)totalJson / totalBinary);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_OR_EQUAL(MIN_REDUCTION * totalBinary, totalJson);
+
+    // Los mismos cuadros con data/telemetry.js
+    if (vectors == nullptr) {
+        TEST_MESSAGE("node no disponible: no se verifica data/telemetry.js");
+        return;
+    }
+    fclose(vectors);
+    std::string command = "node \"" + script + "\" \"" + vectorsPath + "\" 2>&1";
+    FILE* output = popen(command.c_str(), "r");
+    TEST_ASSERT_NOT_NULL(output);
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), output) != nullptr) {
+        buffer[strcspn(buffer, "\n")] = '\0';
+        TEST_MESSAGE(buffer);
+    }
+    int status = pclose(output);
+    unlink(vectorsPath);
+    TEST_ASSERT_EQUAL_MESSAGE(0, status, "tools/telemetry_js_check.js");
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    // Arranque como main.cpp (los sensores registran los canales ADC)
+    Wire.attach(AHT20_ADDRESS, &aht);
+    Wire.attach(BMP280_ADDRESS, &bmp);
+    LittleFS.begin(true);
+    SmokeSensor::getInstance(SMOKE_SENSOR_PIN)->begin(false);
+    CH4Sensor::getInstance(CH4_SENSOR_PIN)->begin(false);
+    EnvironmentSensor::getInstance()->begin(I2C_SDA, I2C_SCL);
+
+    TelemetrySocket::getInstance()->registerRoutes(server);
+    socket = static_cast<AsyncWebSocket*>(server.getHandlers()[0]);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_record_scenarios);
+    RUN_TEST(test_bandwidth_per_sample);
+    return UNITY_END();
+}
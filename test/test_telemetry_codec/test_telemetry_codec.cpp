@@ -0,0 +1,218 @@
+/*
+Pruebas de TelemetryCodec (cuadros clave y delta del canal WebSocket):
+
+Ida y vuelta exacta en recorridos aleatorios: pasos chicos, saltos entre
+extremos de int16, lecturas inválidas, cambios de estado, ciclos y tiempos
+que fuerzan cuadro clave
+Tamaños: muestra sin cambios en 7 bytes, nunca más que TELEMETRY_MAX_FRAME
+Cuadro perdido: el decodificador espera el cuadro clave y cuenta el hueco
+Cuadros truncados o desconocidos se rechazan
+*/
+#include <unity.h>
+#include <string.h>
+#include "utils/TelemetryCodec.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint32_t rng = 12345;
+
+static uint32_t next() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static TelemetrySample baseSample() {
+    TelemetrySample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.cycle = 1;
+    sample.timestamp = 1000;
+    sample.fields[TF_TEMPERATURE] = 2450;
+    sample.fields[TF_HUMIDITY] = 5500;
+    sample.fields[TF_PRESSURE] = 132;
+    return sample;
+}
+
+// Muestra siguiente con cambios de distinto tamaño
+static void step(TelemetrySample& sample) {
+    uint32_t r = next();
+    sample.cycle += (r % 50 == 0) ? 300 : 1 + r % 3;          // A veces salta (cuadro clave)
+    sample.timestamp += (r % 97 == 0) ? 70000 : 100 + r % 900;
+    if (r % 7 == 0) {
+        sample.state ^= 1u << (next() % 27);
+    }
+    for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+        uint32_t kind = next() % 20;
+        if (kind < 10) {
+            continue;                                           // Sin cambio
+        } else if (kind < 16) {
+            sample.fields[i] += (int16_t)(next() % 41) - 20;    // Ruido
+        } else if (kind < 18) {
+            sample.fields[i] = (int16_t)next();                 // Salto arbitrario
+        } else if (kind < 19) {
+            sample.fields[i] = next() % 2 ? INT16_MAX : INT16_MIN + 1;
+        } else {
+            sample.fields[i] = TELEMETRY_INVALID;
+        }
+    }
+}
+
+static void assertSameSample(const TelemetrySample& expected, const TelemetrySample& actual) {
+    TEST_ASSERT_EQUAL_UINT32(expected.cycle, actual.cycle);
+    TEST_ASSERT_EQUAL_UINT32(expected.timestamp, actual.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(expected.state, actual.state);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected.fields, actual.fields, sizeof(expected.fields)));
+}
+
+void test_random_round_trip(void) {
+    TelemetryEncoder encoder(50);
+    TelemetryDecoder decoder;
+    TelemetrySample sample = baseSample();
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    int keyframes = 0;
+
+    for (int n = 0; n < 100000; n++) {
+        step(sample);
+        bool keyframe;
+        size_t size = encoder.encode(sample, frame, keyframe);
+        TEST_ASSERT_TRUE(size <= TELEMETRY_MAX_FRAME);
+        keyframes += keyframe ? 1 : 0;
+
+        TelemetrySample decoded;
+        TEST_ASSERT_TRUE(decoder.decode(frame, size, decoded));
+        assertSameSample(sample, decoded);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.getGaps());
+    TEST_ASSERT_TRUE(keyframes > 2000);         // Periódicos y por saltos
+    TEST_ASSERT_TRUE(keyframes < 100000 / 4);
+}
+
+void test_unchanged_sample_is_header_only(void) {
+    TelemetryEncoder encoder(0);
+    TelemetrySample sample = baseSample();
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    bool keyframe;
+
+    TEST_ASSERT_EQUAL_UINT32(TELEMETRY_KEYFRAME_SIZE, encoder.encode(sample, frame, keyframe));
+    TEST_ASSERT_TRUE(keyframe);
+
+    sample.cycle++;
+    sample.timestamp += 100;
+    TEST_ASSERT_EQUAL_UINT32(7, encoder.encode(sample, frame, keyframe));
+    TEST_ASSERT_FALSE(keyframe);
+
+    // Diferencias chicas: un byte cada una
+    sample.cycle++;
+    sample.fields[TF_TEMPERATURE] += 63;
+    sample.fields[TF_HUMIDITY] -= 64;
+    TEST_ASSERT_EQUAL_UINT32(9, encoder.encode(sample, frame, keyframe));
+}
+
+void test_worst_case_delta_fits(void) {
+    TelemetryEncoder encoder(0);
+    TelemetryDecoder decoder;
+    TelemetrySample sample = baseSample();
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    TelemetrySample decoded;
+    bool keyframe;
+
+    for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+        sample.fields[i] = INT16_MIN;
+    }
+    decoder.decode(frame, encoder.encode(sample, frame, keyframe), decoded);
+
+    for (int i = 0; i < TELEMETRY_FIELDS; i++) {
+        sample.fields[i] = INT16_MAX;
+    }
+    sample.cycle++;
+    sample.state = 0xFFFFFFFF;
+    size_t size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(keyframe);
+    TEST_ASSERT_EQUAL_UINT32(TELEMETRY_MAX_FRAME, size);
+    TEST_ASSERT_TRUE(decoder.decode(frame, size, decoded));
+    assertSameSample(sample, decoded);
+}
+
+void test_lost_frame_waits_for_keyframe(void) {
+    TelemetryEncoder encoder(0);
+    TelemetryDecoder decoder;
+    TelemetrySample sample = baseSample();
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    TelemetrySample decoded;
+    bool keyframe;
+
+    TEST_ASSERT_TRUE(decoder.decode(frame, encoder.encode(sample, frame, keyframe), decoded));
+
+    // Se pierde un delta
+    sample.cycle++;
+    sample.fields[TF_SMOKE_PPM] = 40;
+    encoder.encode(sample, frame, keyframe);
+
+    sample.cycle++;
+    sample.fields[TF_SMOKE_PPM] = 45;
+    size_t size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(decoder.decode(frame, size, decoded));
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getGaps());
+
+    sample.cycle++;
+    sample.fields[TF_SMOKE_PPM] = 47;
+    size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(decoder.decode(frame, size, decoded));
+    TEST_ASSERT_EQUAL_UINT32(1, decoder.getGaps());
+
+    // Cuadro clave a pedido: resincroniza y los deltas siguientes sirven
+    size = encoder.encodeKeyframe(frame);
+    TEST_ASSERT_TRUE(decoder.decode(frame, size, decoded));
+    assertSameSample(sample, decoded);
+
+    sample.cycle++;
+    sample.fields[TF_SMOKE_PPM] = 50;
+    size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(keyframe);
+    TEST_ASSERT_TRUE(decoder.decode(frame, size, decoded));
+    assertSameSample(sample, decoded);
+}
+
+void test_invalid_frames_rejected(void) {
+    TelemetryEncoder encoder(0);
+    TelemetryDecoder decoder;
+    TelemetrySample sample = baseSample();
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    TelemetrySample decoded;
+    bool keyframe;
+
+    TEST_ASSERT_EQUAL_UINT32(0, encoder.encodeKeyframe(frame));
+
+    size_t size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(decoder.decode(frame, size - 1, decoded));    // Clave truncado
+    TEST_ASSERT_TRUE(decoder.decode(frame, size, decoded));
+
+    sample.cycle++;
+    sample.state = 0x1234;
+    sample.fields[TF_CH4_PPM] = 1000;
+    size = encoder.encode(sample, frame, keyframe);
+    TEST_ASSERT_FALSE(decoder.decode(frame, size - 1, decoded));    // Sin estados completos
+    frame[0] = 'X';
+    TEST_ASSERT_FALSE(decoder.decode(frame, size, decoded));
+}
+
+void test_fixed_point_conversion(void) {
+    TEST_ASSERT_EQUAL_INT(2457, telemetryFixed(24.567f, 100));
+    TEST_ASSERT_EQUAL_INT(-132, telemetryFixed(986.8f, 10, 1000));
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, telemetryFixed(1e9f, 1));
+    TEST_ASSERT_EQUAL_INT(INT16_MIN + 1, telemetryFixed(-1e9f, 1));
+    TEST_ASSERT_EQUAL_INT(TELEMETRY_INVALID, telemetryFixed(NAN, 100));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_random_round_trip);
+    RUN_TEST(test_unchanged_sample_is_header_only);
+    RUN_TEST(test_worst_case_delta_fits);
+    RUN_TEST(test_lost_frame_waits_for_keyframe);
+    RUN_TEST(test_invalid_frames_rejected);
+    RUN_TEST(test_fixed_point_conversion);
+    return UNITY_END();
+}
@@ -0,0 +1,211 @@
+/*
+Pruebas del formato de trazas (TraceEncoder / TraceDecoder):
+
+Ida y vuelta exacta de barridos ADC (delta y absolutos), lecturas I2C y
+cambios de nivel en vivo
+Solo se aceptan trazas de TRACE_VERSION; un final truncado corta limpio
+Comparación de la línea de tiempo reproducida con la grabada en vivo
+*/
+#include <unity.h>
+#include <vector>
+#include "trace/TraceFormat.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Fuente en memoria con la interfaz de File (read)
+struct MemorySource {
+    const std::vector<uint8_t>& data;
+    size_t position;
+
+    size_t read(uint8_t* buffer, size_t length) {
+        size_t available = data.size() - position;
+        length = length < available ? length : available;
+        memcpy(buffer, data.data() + position, length);
+        position += length;
+        return length;
+    }
+};
+
+static void append(std::vector<uint8_t>& out, const uint8_t* bytes, size_t length) {
+    out.insert(out.end(), bytes, bytes + length);
+}
+
+static TraceHeader makeHeader() {
+    TraceHeader header = {};
+    header.channels = 2;
+    header.scanBits = 12;
+    header.sampleRateHz = 100;
+    header.startMs = 123456;
+    for (int i = 0; i < 24; i++) header.bmpCalibration[i] = (uint8_t)(i * 7);
+    return header;
+}
+
+void test_round_trip(void) {
+    std::vector<uint8_t> trace;
+    uint8_t buffer[TRACE_MAX_RECORD_SIZE];
+    TraceHeader header = makeHeader();
+    uint8_t raw[TRACE_HEADER_SIZE];
+    TEST_ASSERT_EQUAL_UINT(TRACE_HEADER_SIZE, TraceEncoder::encodeHeader(header, raw));
+    append(trace, raw, sizeof(raw));
+
+    // 1 h a 100 Hz con ruido, saltos grandes (absolutos) y I2C/alertas intercalados
+    std::vector<TraceAdcRecord> scans;
+    std::vector<TraceEnvRecord> envs;
+    std::vector<TraceAlertRecord> alerts;
+    TraceEncoder encoder;
+    uint32_t rng = 1;
+    uint16_t level[2] = { 800, 1500 };
+    size_t deltaBytes = 0;
+
+    for (uint32_t i = 0; i < 360000; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        TraceAdcRecord scan;
+        scan.timeMs = header.startMs + i * 10 + (rng >> 30);
+        scan.count = 2;
+        for (int c = 0; c < 2; c++) {
+            int noise = (int)((rng >> (8 + 8 * c)) & 0x0F) - 8;
+            if ((i % 50000) == 49999) level[c] = (uint16_t)(level[c] + 900) & 0x0FFF;
+            scan.values[c] = (uint16_t)(level[c] + noise);
+        }
+        size_t length = encoder.encodeAdc(scan, buffer);
+        deltaBytes += (buffer[0] == TRACE_ADC_DELTA) ? length : 0;
+        append(trace, buffer, length);
+        scans.push_back(scan);
+
+        if (i % 200 == 0) {
+            uint8_t flags = TRACE_AHT_FRESH | ((i % 400 == 0) ? TRACE_BMP_FRESH : 0);
+            TraceEnvRecord env = { scan.timeMs, flags,
+                                   rng & 0xFFFFF, (rng >> 12) & 0xFFFFF, -(int32_t)(rng >> 13), (int32_t)(rng >> 11) };
+            append(trace, buffer, TraceEncoder::encodeEnvironment(env, buffer));
+            envs.push_back(env);
+        }
+        if (i % 30000 == 0) {
+            TraceAlertRecord alert = { scan.timeMs, (uint8_t)(i % 9), (uint8_t)((i + 1) % 9), 4, rng };
+            append(trace, buffer, TraceEncoder::encodeAlert(alert, buffer));
+            alerts.push_back(alert);
+        }
+    }
+
+    MemorySource source = { trace, 0 };
+    TraceDecoder<MemorySource> decoder(source);
+    TraceHeader read;
+    TEST_ASSERT_TRUE(decoder.readHeader(read));
+    TEST_ASSERT_EQUAL_UINT8(2, read.channels);
+    TEST_ASSERT_EQUAL_UINT8(12, read.scanBits);
+    TEST_ASSERT_EQUAL_UINT16(100, read.sampleRateHz);
+    TEST_ASSERT_EQUAL_UINT32(header.startMs, read.startMs);
+    TEST_ASSERT_EQUAL_MEMORY(header.bmpCalibration, read.bmpCalibration, 24);
+
+    TraceRecordType type;
+    TraceAdcRecord adc;
+    TraceEnvRecord env;
+    TraceAlertRecord alert;
+    size_t scanIndex = 0, envIndex = 0, alertIndex = 0;
+    while (decoder.next(type, adc, env, alert)) {
+        if (type == TRACE_ENVIRONMENT) {
+            const TraceEnvRecord& expected = envs[envIndex++];
+            TEST_ASSERT_EQUAL_UINT32(expected.timeMs, env.timeMs);
+            TEST_ASSERT_EQUAL_UINT8(expected.flags, env.flags);
+            TEST_ASSERT_EQUAL_UINT32(expected.ahtHumidity, env.ahtHumidity);
+            TEST_ASSERT_EQUAL_UINT32(expected.ahtTemperature, env.ahtTemperature);
+            TEST_ASSERT_EQUAL_INT32(expected.bmpTemperature, env.bmpTemperature);
+            TEST_ASSERT_EQUAL_INT32(expected.bmpPressure, env.bmpPressure);
+        } else if (type == TRACE_ALERT) {
+            const TraceAlertRecord& expected = alerts[alertIndex++];
+            TEST_ASSERT_EQUAL_UINT32(expected.timeMs, alert.timeMs);
+            TEST_ASSERT_EQUAL_UINT8(expected.from, alert.from);
+            TEST_ASSERT_EQUAL_UINT8(expected.to, alert.to);
+            TEST_ASSERT_EQUAL_UINT8(expected.raw, alert.raw);
+            TEST_ASSERT_EQUAL_UINT32(expected.features, alert.features);
+        } else {
+            const TraceAdcRecord& expected = scans[scanIndex++];
+            TEST_ASSERT_EQUAL_UINT32(expected.timeMs, adc.timeMs);
+            TEST_ASSERT_EQUAL_UINT8(2, adc.count);
+            TEST_ASSERT_EQUAL_UINT16(expected.values[0], adc.values[0]);
+            TEST_ASSERT_EQUAL_UINT16(expected.values[1], adc.values[1]);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT(scans.size(), scanIndex);
+    TEST_ASSERT_EQUAL_UINT(envs.size(), envIndex);
+    TEST_ASSERT_EQUAL_UINT(alerts.size(), alertIndex);
+
+    // Casi todo en deltas de 4 bytes (2 + canales)
+    TEST_ASSERT_TRUE(deltaBytes > (scans.size() - 20) * 4);
+    TEST_ASSERT_TRUE(trace.size() < scans.size() * 4.3);
+}
+
+void test_version_and_truncated_tail(void) {
+    uint8_t raw[TRACE_HEADER_SIZE];
+    TraceHeader header = makeHeader();
+    TraceEncoder::encodeHeader(header, raw);
+
+    std::vector<uint8_t> trace(raw, raw + sizeof(raw));
+    TraceEncoder encoder;
+    uint8_t buffer[TRACE_MAX_RECORD_SIZE];
+    TraceAdcRecord scan = { 1000, 2, { 100, 200 } };
+    append(trace, buffer, encoder.encodeAdc(scan, buffer));
+    scan.timeMs += 10;
+    append(trace, buffer, encoder.encodeAdc(scan, buffer));
+    trace.push_back(TRACE_ENVIRONMENT);                   // Registro cortado a la mitad
+    trace.push_back(0x11);
+
+    MemorySource source = { trace, 0 };
+    TraceDecoder<MemorySource> decoder(source);
+    TraceHeader read;
+    TEST_ASSERT_TRUE(decoder.readHeader(read));
+
+    TraceRecordType type;
+    TraceAdcRecord adc;
+    TraceEnvRecord env;
+    TraceAlertRecord alert;
+    TEST_ASSERT_TRUE(decoder.next(type, adc, env, alert));
+    TEST_ASSERT_TRUE(decoder.next(type, adc, env, alert));
+    TEST_ASSERT_EQUAL_INT(TRACE_ADC_DELTA, type);
+    TEST_ASSERT_EQUAL_UINT32(1010, adc.timeMs);
+    TEST_ASSERT_FALSE(decoder.next(type, adc, env, alert));
+
+    // Otra versión (anterior o futura) o magia distinta: rechazada
+    trace[4] = TRACE_VERSION + 1;
+    MemorySource future = { trace, 0 };
+    TraceDecoder<MemorySource> futureDecoder(future);
+    TEST_ASSERT_FALSE(futureDecoder.readHeader(read));
+    trace[4] = TRACE_VERSION - 1;
+    MemorySource older = { trace, 0 };
+    TraceDecoder<MemorySource> olderDecoder(older);
+    TEST_ASSERT_FALSE(olderDecoder.readHeader(read));
+    trace[4] = TRACE_VERSION;
+    trace[0] ^= 0xFF;
+    MemorySource corrupt = { trace, 0 };
+    TraceDecoder<MemorySource> corruptDecoder(corrupt);
+    TEST_ASSERT_FALSE(corruptDecoder.readHeader(read));
+}
+
+void test_compare_alerts(void) {
+    TraceAlertRecord live[3] = {
+        { 1000, 0, 2, 2, 0 }, { 5000, 2, 4, 4, 0 }, { 9000, 4, 0, 0, 0 }
+    };
+    TraceAlertRecord replayed[3] = {
+        { 1250, 0, 2, 2, 0 }, { 4100, 2, 4, 4, 0 }, { 9000, 4, 0, 0, 0 }
+    };
+
+    TEST_ASSERT_EQUAL_INT32(-1, traceCompareAlerts(live, 3, replayed, 3, 3, 1000));
+    TEST_ASSERT_EQUAL_INT32(1, traceCompareAlerts(live, 3, replayed, 3, 3, 500));    // Desfase
+    TEST_ASSERT_EQUAL_INT32(2, traceCompareAlerts(live, 3, replayed, 2, 3, 1000));   // Falta uno
+    TEST_ASSERT_EQUAL_INT32(-1, traceCompareAlerts(live, 0, replayed, 0, 3, 1000));
+
+    replayed[2].to = 2;
+    TEST_ASSERT_EQUAL_INT32(2, traceCompareAlerts(live, 3, replayed, 3, 3, 1000));   // Otro nivel
+
+    // Más cambios que los guardados: se comparan los guardados y la cantidad
+    TEST_ASSERT_EQUAL_INT32(-1, traceCompareAlerts(live, 100, replayed, 100, 2, 1000));
+    TEST_ASSERT_EQUAL_INT32(2, traceCompareAlerts(live, 100, replayed, 99, 2, 1000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_version_and_truncated_tail);
+    RUN_TEST(test_compare_alerts);
+    return UNITY_END();
+}
@@ -0,0 +1,354 @@
+/*
+Reproducción de trazas en la PC (pio test -e native -f test_trace_replay -v):
+
+Grabación: cada escenario de BenchScenarios.h corre en vivo sobre los
+sensores simulados de test/host (ADC con esp_timer, AHT20/BMP280 en el bus
+I2C, tarea de sensores con su planificador y avisos del ADC) mientras
+TraceRecorder graba como en el equipo
+Reproducción: TraceReplay::run() con cada traza; los cambios de nivel
+deben coincidir con los publicados en vivo
+Corpus de incidentes: con TRACE_CORPUS=<carpeta> también se reproduce
+cada <nombre>.bin de la carpeta (trazas descargadas del equipo), se
+escribe <nombre>.timeline.csv y se compara con <nombre>.expected.csv si
+existe (sin la columna cycle); TRACE_CORPUS_UPDATE=1 reescribe los .expected.csv
+Velocidad: tiempo de traza / tiempo real de la reproducción (reloj de la PC)
+*/
+#include <unity.h>
+#include <HostDevices.h>
+#include <LittleFS.h>
+#include <dirent.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "trace/TraceRecorder.h"
+#include "trace/TraceReplay.h"
+#include "bench/BenchScenarios.h"
+#include "sensors/AdcSampler.h"
+#include "sensors/SmokeSensor.h"
+#include "sensors/CH4Sensor.h"
+#include "sensors/EnvironmentSensor.h"
+#include "tasks/SensorTask.h"
+#include "utils/Clock.h"
+#include "config/Config.h"
+
+#define PREROLL_MS 60000            // Aire limpio antes del evento
+#define GAS_NOISE_COUNTS 8          // Ruido de los gases (cuentas ADC)
+#define MIN_SPEEDUP 1000            // Reproducción: veces el tiempo real como mínimo
+
+static HostAHT20 aht;
+static HostBMP280 bmp;
+
+// Traza a reproducir (grabada aquí o leída del corpus)
+struct CorpusTrace {
+    std::string name;
+    std::string data;
+    std::string basePath;           // Corpus: <carpeta>/<nombre> (vacío: grabada en la suite)
+};
+
+static std::vector<CorpusTrace> corpus;
+
+// Entradas del escenario en curso (leídas por el timer ADC simulado)
+struct LiveInput {
+    const BenchScenario* scenario;
+    unsigned long onsetMs;
+    HostNoise noise;
+};
+
+static LiveInput liveInput = {nullptr, 0, HostNoise(4242)};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint16_t scenarioAdc(int pin, void* context) {
+    LiveInput* input = (LiveInput*)context;
+    int signal = pin == SMOKE_SENSOR_PIN ? BENCH_SMOKE : BENCH_CH4;
+    int32_t t = (int32_t)(millis() - input->onsetMs);
+    int32_t value = (int32_t)input->scenario->signals[signal].at(t, BENCH_REST[signal]) +
+                    input->noise.next(GAS_NOISE_COUNTS);
+    return (uint16_t)constrain(value, 0, 4095);
+}
+
+/**
+ * Estado de arranque conocido (el mismo para grabar y para reproducir)
+ */
+static void freshBoot() {
+    Clock::realTime();
+
+    // Sin muestras ADC pendientes ni valores o tendencias de la ejecución anterior
+    EnvironmentSensor::getInstance()->setBaseline(BENCH_REST[BENCH_TEMPERATURE],
+                                                  BENCH_REST[BENCH_HUMIDITY],
+                                                  BENCH_REST[BENCH_PRESSURE]);
+    EnvironmentSensor::getInstance()->setReplay(false);
+    AdcSampler::getInstance()->setReplay(true);
+    AdcSampler::getInstance()->setReplay(false);
+
+    GasCalibration smokeCalibration = SmokeTraits::DEFAULT_CALIBRATION;
+    GasCalibration ch4Calibration = CH4Traits::DEFAULT_CALIBRATION;
+    smokeCalibration.isCalibrated = true;
+    ch4Calibration.isCalibrated = true;
+    SmokeSensor::getInstance()->setCalibration(smokeCalibration);
+    CH4Sensor::getInstance()->setCalibration(ch4Calibration);
+    SmokeSensor::getInstance()->restart(false);
+    CH4Sensor::getInstance()->restart(false);
+
+    SensorTask::getInstance()->reset();
+    while (EventBus::getInstance()->dispatch() > 0) {
+        // Descartar eventos anteriores
+    }
+}
+
+/**
+ * Corre un escenario en vivo con la grabación activa (como setup() y loop())
+ * @return Contenido de la traza
+ */
+static std::string recordScenario(const BenchScenario& scenario) {
+    AdcSampler* sampler = AdcSampler::getInstance();
+    SensorTask* sensorTask = SensorTask::getInstance();
+    EventBus* eventBus = EventBus::getInstance();
+    TraceRecorder* recorder = TraceRecorder::getInstance();
+
+    freshBoot();
+    liveInput.scenario = &scenario;
+    liveInput.onsetMs = millis() + PREROLL_MS;
+    HostSim::adcSource = scenarioAdc;
+    HostSim::adcContext = &liveInput;
+
+    // Sin traza anterior: la primera rotación deja en la vieja la parte desde el arranque
+    LittleFS.remove(TRACE_FILE_PATH);
+    LittleFS.remove(TRACE_OLD_FILE_PATH);
+
+    HostTask task;
+    TEST_ASSERT_TRUE(recorder->begin(sampler->getChannelCount(), ADC_SAMPLE_RATE_HZ,
+                                     EnvironmentSensor::getInstance()->getBMP280Calibration()));
+    sampler->setWakeTask(&task);
+    TEST_ASSERT_TRUE(sampler->begin(ADC_SAMPLE_RATE_HZ));
+
+    // SensorTask::run() con el tiempo virtual; loop() escribe la traza mientras espera
+    unsigned long end = liveInput.onsetMs + scenario.durationMs;
+    unsigned long cycleStart = millis();
+    bool adcWake = false;
+    std::string fromBoot;
+    while ((long)(end - millis()) > 0) {
+        int32_t t = (int32_t)(millis() - liveInput.onsetMs);
+        aht.celsius = scenario.signals[BENCH_TEMPERATURE].at(t, BENCH_REST[BENCH_TEMPERATURE]);
+        aht.relativeHumidity = scenario.signals[BENCH_HUMIDITY].at(t, BENCH_REST[BENCH_HUMIDITY]);
+        bmp.celsius = aht.celsius;
+        bmp.hPa = scenario.signals[BENCH_PRESSURE].at(t, BENCH_REST[BENCH_PRESSURE]);
+
+        sensorTask->cycle(adcWake);
+
+        unsigned long deadline = cycleStart + sensorTask->getSnapshot().sampleIntervalMs;
+        bool late = (long)(deadline - millis()) <= 0;
+        adcWake = false;
+        while (!adcWake && (long)(deadline - millis()) > 0) {
+            eventBus->dispatch();
+            recorder->flush();
+            if (fromBoot.empty() && LittleFS.exists(TRACE_OLD_FILE_PATH)) {
+                fromBoot = LittleFS.contents(TRACE_OLD_FILE_PATH);
+            }
+            delay(1);
+            adcWake = task.notifications.exchange(0) > 0;
+        }
+        cycleStart = (adcWake || late) ? millis() : deadline;
+    }
+
+    sampler->stop();
+    sampler->setWakeTask(nullptr);
+    HostSim::adcSource = nullptr;
+    eventBus->dispatch();
+    recorder->stop();
+
+    TEST_ASSERT_EQUAL(0, recorder->getDropped());
+
+    // La comparación con lo publicado en vivo solo es exacta desde el arranque:
+    // si rotó, el primer archivo
+    return fromBoot.empty() ? LittleFS.contents(TRACE_FILE_PATH) : fromBoot;
+}
+
+/**
+ * Lee un archivo de la PC
+ * @return false si no existe
+ */
+static bool readHostFile(const std::string& path, std::string& content) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+static void writeHostFile(const std::string& path, const std::string& content) {
+    std::ofstream output(path, std::ios::binary);
+    output << content;
+}
+
+/**
+ * Línea de tiempo sin la columna cycle (cuenta desde el arranque del proceso:
+ * depende de las trazas reproducidas antes)
+ */
+static std::string withoutCycles(const std::string& timeline) {
+    std::string result;
+    size_t start = 0;
+    while (start < timeline.size()) {
+        size_t end = timeline.find('\n', start);
+        end = end == std::string::npos ? timeline.size() : end + 1;
+        std::string line = timeline.substr(start, end - start);
+        size_t first = line.find(',');
+        size_t second = first == std::string::npos ? first : line.find(',', first + 1);
+        result += second == std::string::npos ? line : line.substr(0, first) + line.substr(second);
+        start = end;
+    }
+    return result;
+}
+
+/**
+ * Agrega al corpus las trazas de TRACE_CORPUS (en orden alfabético)
+ * @return Trazas agregadas
+ */
+static int loadHostCorpus(const char* directory) {
+    DIR* dir = opendir(directory);
+    if (dir == nullptr) {
+        return 0;
+    }
+
+    std::vector<std::string> names;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string file(entry->d_name);
+        if (file.size() > 4 && file.compare(file.size() - 4, 4, ".bin") == 0) {
+            names.push_back(file.substr(0, file.size() - 4));
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for (const std::string& name : names) {
+        CorpusTrace trace;
+        trace.name = name;
+        trace.basePath = std::string(directory) + "/" + name;
+        if (readHostFile(trace.basePath + ".bin", trace.data)) {
+            corpus.push_back(trace);
+        }
+    }
+    return (int)names.size();
+}
+
+// ==================== Pruebas ====================
+
+void test_record_scenarios(void) {
+    for (const BenchScenario& scenario : BENCH_SCENARIOS) {
+        CorpusTrace trace;
+        trace.name = scenario.name;
+        trace.data = recordScenario(scenario);
+        bool rotated = LittleFS.exists(TRACE_OLD_FILE_PATH);
+
+        // Un archivo rota al pasar TRACE_FILE_MAX_BYTES (como mucho una escritura agrupada más)
+        TEST_ASSERT_GREATER_THAN(TRACE_HEADER_SIZE, trace.data.size());
+        TEST_ASSERT_LESS_THAN(TRACE_FILE_MAX_BYTES + 512, trace.data.size());
+
+        char line[128];
+        snprintf(line, sizeof(line), "%s: %lu s en vivo, traza de %lu bytes%s", trace.name.c_str(),
+                 (unsigned long)((PREROLL_MS + scenario.durationMs) / 1000),
+                 (unsigned long)trace.data.size(), rotated ? " (rotó: se reproduce la parte desde el arranque)" : "");
+        TEST_MESSAGE(line);
+        corpus.push_back(trace);
+    }
+}
+
+void test_replay_corpus(void) {
+    const char* directory = getenv("TRACE_CORPUS");
+    if (directory != nullptr) {
+        char line[96];
+        snprintf(line, sizeof(line), "%d trazas en %s", loadHostCorpus(directory), directory);
+        TEST_MESSAGE(line);
+    }
+    bool update = getenv("TRACE_CORPUS_UPDATE") != nullptr;
+    TEST_ASSERT_TRUE(corpus.size() >= BENCH_SCENARIO_COUNT);
+
+    uint64_t totalVirtualMs = 0;
+    double totalWallMs = 0;
+    int failures = 0;
+
+    for (const CorpusTrace& trace : corpus) {
+        File file = LittleFS.open(TRACE_REPLAY_PATH, "w");
+        file.write((const uint8_t*)trace.data.data(), trace.data.size());
+        file.close();
+
+        freshBoot();
+        TraceReplayResult result;
+        auto wallStart = std::chrono::steady_clock::now();
+        bool ok = TraceReplay::run(TRACE_REPLAY_PATH, TRACE_TIMELINE_PATH, result);
+        double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+        TEST_ASSERT_TRUE_MESSAGE(ok, trace.name.c_str());
+
+        totalVirtualMs += result.virtualMs;
+        totalWallMs += wallMs;
+        std::string timeline = LittleFS.contents(TRACE_TIMELINE_PATH);
+
+        // Grabadas aquí (desde el arranque): los mismos cambios de nivel que en vivo
+        // Corpus: la línea de tiempo esperada (lo vivo solo se informa: puede ser una traza rotada)
+        std::string verdict = "ok";
+        bool failed = false;
+        if (trace.basePath.empty()) {
+            failed = !result.complete || result.liveTransitions == 0 || result.firstMismatch >= 0;
+            verdict = !result.complete ? "traza truncada"
+                    : result.liveTransitions == 0 ? "sin cambios de nivel en vivo"
+                    : result.firstMismatch >= 0 ? "difiere de la ejecución en vivo" : "ok";
+        } else {
+            std::string expected;
+            writeHostFile(trace.basePath + ".timeline.csv", timeline);
+            if (update) {
+                writeHostFile(trace.basePath + ".expected.csv", timeline);
+                verdict = ".expected.csv actualizado";
+            } else if (!readHostFile(trace.basePath + ".expected.csv", expected)) {
+                verdict = "sin .expected.csv";
+            } else if (withoutCycles(expected) != withoutCycles(timeline)) {
+                failed = true;
+                verdict = "difiere de .expected.csv";
+            }
+            if (!result.complete) {
+                verdict += ", traza truncada";
+            }
+        }
+        failures += failed ? 1 : 0;
+
+        char line[192];
+        snprintf(line, sizeof(line), "%s: %lu s en %.1f ms (x%.0f), %lu ciclos, %lu cambios (vivo %lu): %s",
+                 trace.name.c_str(), (unsigned long)(result.virtualMs / 1000), wallMs,
+                 result.virtualMs / (wallMs > 0 ? wallMs : 1), (unsigned long)result.cycles,
+                 (unsigned long)result.transitions, (unsigned long)result.liveTransitions, verdict.c_str());
+        TEST_MESSAGE(line);
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "Total: %lu s de trazas en %.0f ms (x%.0f)",
+             (unsigned long)(totalVirtualMs / 1000), totalWallMs,
+             totalVirtualMs / (totalWallMs > 0 ? totalWallMs : 1));
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL(0, failures);
+    TEST_ASSERT_GREATER_OR_EQUAL(MIN_SPEEDUP, totalVirtualMs / (totalWallMs > 1 ? totalWallMs : 1));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    // Arranque como main.cpp (los sensores registran los canales ADC)
+    Wire.attach(AHT20_ADDRESS, &aht);
+    Wire.attach(BMP280_ADDRESS, &bmp);
+    LittleFS.begin(true);
+    SmokeSensor::getInstance(SMOKE_SENSOR_PIN)->begin(false);
+    CH4Sensor::getInstance(CH4_SENSOR_PIN)->begin(false);
+    EnvironmentSensor::getInstance()->begin(I2C_SDA, I2C_SCL);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_record_scenarios);
+    RUN_TEST(test_replay_corpus);
+    return UNITY_END();
+}
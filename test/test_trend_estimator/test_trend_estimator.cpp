@@ -0,0 +1,98 @@
+/*
+Pruebas de TrendEstimator (mínimos cuadrados en ventana de tiempo):
+
+Pendiente e intercepto exactos en una recta
+Expulsión por ventana y por capacidad
+Sin deriva de redondeo tras muchas horas de muestras
+*/
+#include <unity.h>
+#include "utils/TrendEstimator.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_needs_three_spread_samples(void) {
+    TrendEstimator<16> trend(60000);
+    TEST_ASSERT_FALSE(trend.isValid());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, trend.intercept());
+    trend.add(0, 20);
+    trend.add(1000, 21);
+    TEST_ASSERT_FALSE(trend.isValid());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, trend.slopePerMinute());
+    TEST_ASSERT_EQUAL_FLOAT(21.0f, trend.intercept());
+    trend.add(2000, 22);
+    TEST_ASSERT_TRUE(trend.isValid());
+}
+
+void test_exact_line(void) {
+    TrendEstimator<32> trend(60000);
+    // 0.5 °C/min muestreado cada 2 s
+    for (uint32_t t = 0; t <= 30000; t += 2000) {
+        trend.add(t, 25.0f + 0.5f * t / 60000.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.5, trend.slopePerMinute());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 25.25, trend.intercept());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, trend.residualVariance());
+}
+
+void test_window_drops_old_samples(void) {
+    TrendEstimator<64> trend(10000);
+    // Escalón viejo fuera de la ventana: la pendiente vuelve a 0
+    for (uint32_t t = 0; t < 5000; t += 1000) trend.add(t, 0);
+    for (uint32_t t = 5000; t <= 30000; t += 1000) trend.add(t, 100);
+    TEST_ASSERT_EQUAL_UINT(11, trend.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.0, trend.slopePerMinute());
+
+    // Capacidad: con 4 lugares solo quedan las 4 últimas aunque la ventana sea larga
+    TrendEstimator<4> small(600000);
+    for (uint32_t t = 0; t < 10000; t += 1000) small.add(t, t < 6000 ? 0.0f : (t - 6000) / 1000.0f);
+    TEST_ASSERT_EQUAL_UINT(4, small.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 60.0, small.slopePerMinute());
+}
+
+void test_no_drift_over_long_runs(void) {
+    TrendEstimator<32> trend(60000);
+    // 24 h a 1 Hz de presión ~1013 hPa con deriva lenta y ruido determinista:
+    // la pendiente debe coincidir con una regresión en double de las mismas
+    // 32 muestras (sin error acumulado por sumar y restar en float)
+    const int total = 86400;
+    static float values[total];
+    for (int i = 0; i < total; i++) {
+        float noise = (float)((i * 7919) % 21 - 10) * 0.01f;
+        values[i] = 1013.0f - 0.2f * i / 3600.0f + noise;
+        trend.add((uint32_t)i * 1000, values[i]);
+    }
+
+    int n = (int)trend.size();
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = total - n; i < total; i++) {
+        double x = i - (total - n);
+        sx += x;
+        sy += values[i];
+        sxx += x * x;
+        sxy += x * values[i];
+    }
+    double slope = (sxy - sx * sy / n) / (sxx - sx * sx / n) * 60.0;
+
+    TEST_ASSERT_EQUAL_INT(32, n);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, slope, trend.slopePerMinute());
+}
+
+void test_slope_across_millis_wrap(void) {
+    TrendEstimator<16> trend(60000);
+    uint32_t start = 0xFFFFFFFFu - 5000;
+    for (uint32_t i = 0; i < 10; i++) {
+        trend.add(start + i * 1000, (float)i);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 60.0, trend.slopePerMinute());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_needs_three_spread_samples);
+    RUN_TEST(test_exact_line);
+    RUN_TEST(test_window_drops_old_samples);
+    RUN_TEST(test_no_drift_over_long_runs);
+    RUN_TEST(test_slope_across_millis_wrap);
+    return UNITY_END();
+}
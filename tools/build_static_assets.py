@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Prepara los archivos web de data/ para la imagen de LittleFS
+
+Por cada página, hoja de estilo o script genera <archivo>.gz (gzip -9,
+reproducible: sin fecha ni nombre) y escribe data/assets.manifest con el
+hash del contenido de cada archivo. El servidor (src/web/StaticAssets.cpp)
+lee el manifiesto al arrancar y con él arma ETags fuertes y contesta 304
+sin abrir los archivos. Los originales quedan en la imagen: index.html se
+usa como plantilla y son la respuesta para clientes sin gzip.
+
+Formato del manifiesto (una línea por archivo):
+    <ruta> <hash> <bytes> <bytes .gz, 0 = sin variante comprimida>
+
+Se ejecuta solo antes de cada build de PlatformIO (extra_scripts en
+platformio.ini), así buildfs/uploadfs siempre llevan variantes al día.
+A mano:
+    python tools/build_static_assets.py [carpeta data]
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+MANIFEST = "assets.manifest"
+HASH_LENGTH = 16                                  # Hex (64 bits de SHA-256)
+COMPRESS = (".html", ".css", ".js", ".json", ".svg", ".txt")
+SERVE = COMPRESS + (".png", ".ico")
+MIN_SAVING = 0.10                                 # Menos ahorro no justifica el .gz
+
+
+def build(data_dir):
+    """Genera variantes .gz y el manifiesto; devuelve las líneas del manifiesto"""
+    lines = []
+    for name in sorted(os.listdir(data_dir)):
+        path = os.path.join(data_dir, name)
+        if not os.path.isfile(path) or not name.endswith(SERVE):
+            continue
+
+        with open(path, "rb") as source:
+            content = source.read()
+        digest = hashlib.sha256(content).hexdigest()[:HASH_LENGTH]
+
+        gz_path = path + ".gz"
+        gz_size = 0
+        if name.endswith(COMPRESS):
+            compressed = gzip.compress(content, compresslevel=9, mtime=0)
+            if len(compressed) <= len(content) * (1.0 - MIN_SAVING):
+                gz_size = len(compressed)
+                write_if_changed(gz_path, compressed)
+        if gz_size == 0 and os.path.exists(gz_path):
+            os.remove(gz_path)
+
+        lines.append("/%s %s %d %d" % (name, digest, len(content), gz_size))
+
+    # Variantes huérfanas (el original se borró o cambió de nombre)
+    for name in os.listdir(data_dir):
+        if name.endswith(".gz") and not os.path.exists(os.path.join(data_dir, name[:-3])):
+            os.remove(os.path.join(data_dir, name))
+
+    write_if_changed(os.path.join(data_dir, MANIFEST), ("\n".join(lines) + "\n").encode())
+    return lines
+
+
+def write_if_changed(path, content):
+    """No toca archivos iguales (evita rearmar la imagen sin motivo)"""
+    if os.path.exists(path):
+        with open(path, "rb") as current:
+            if current.read() == content:
+                return
+    with open(path, "wb") as output:
+        output.write(content)
+
+
+def report(lines):
+    total = 0
+    sent = 0
+    for line in lines:
+        path, digest, size, gz_size = line.split()
+        total += int(size)
+        sent += int(gz_size) or int(size)
+        print("  %-20s %6s B -> %6s B  %s" % (path, size, gz_size if gz_size != "0" else "-", digest))
+    print("  total %d B -> %d B" % (total, sent))
+
+
+try:
+    Import("env")                                 # noqa: F821 (PlatformIO / SCons)
+    print("Recursos web precomprimidos:")
+    report(build(env.subst("$PROJECT_DATA_DIR")))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        data = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), "..", "data")
+        report(build(data))
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+Cliente de prueba de /events (Server-Sent Events): latencia muestra → cliente
+
+Cada marco del equipo trae el instante de la muestra ("timestamp" del JSON)
+y el del envío (comentario ": sent=<millis>"), ambos en millis() del ESP32:
+    equipo = sent - timestamp                          (exacto)
+    red    = recepción - sent - desfase de relojes     (estimado)
+El desfase se estima con el marco más rápido de la corrida y medio RTT
+mínimo de GET /api/v1/alert (error acotado por la asimetría de la red).
+Los saltos en el id de los marcos "readings" son ciclos coalescidos por
+contrapresión (cliente lento) o perdidos.
+
+Uso:
+    python tools/sse_latency.py <ip> --seconds 60
+    python tools/sse_latency.py <ip> --clients 6      (prueba el límite de clientes)
+"""
+
+import argparse
+import http.client
+import json
+import socket
+import sys
+import threading
+import time
+
+
+def now_ms():
+    return time.monotonic() * 1000.0
+
+
+def measure_rtt(host, port, samples):
+    """RTT mínimo de GET /api/v1/alert (ms), None si no responde"""
+    best = None
+    for _ in range(samples):
+        try:
+            conn = http.client.HTTPConnection(host, port, timeout=5)
+            start = now_ms()
+            conn.request("GET", "/api/v1/alert")
+            conn.getresponse().read()
+            rtt = now_ms() - start
+            conn.close()
+        except OSError:
+            continue
+        best = rtt if best is None else min(best, rtt)
+    return best
+
+
+class Stream(threading.Thread):
+    """Una conexión a /events; guarda (tipo, id, sample, sent, recepción) por marco"""
+
+    def __init__(self, host, port, seconds):
+        super().__init__(daemon=True)
+        self.host = host
+        self.port = port
+        self.seconds = seconds
+        self.frames = []
+        self.busy = False
+        self.error = None
+
+    def run(self):
+        try:
+            conn = http.client.HTTPConnection(self.host, self.port, timeout=self.seconds + 10)
+            conn.request("GET", "/events", headers={"Accept": "text/event-stream"})
+            sock = conn.sock  # getresponse() lo suelta si el flujo no tiene largo
+            response = conn.getresponse()
+            if response.status != 200:
+                self.error = "HTTP %d" % response.status
+                return
+            deadline = now_ms() + self.seconds * 1000.0
+            fields = {}
+            while True:
+                remaining = (deadline - now_ms()) / 1000.0
+                if remaining <= 0:
+                    break
+                sock.settimeout(remaining)
+                try:
+                    line = response.fp.readline()
+                except socket.timeout:
+                    break
+                if not line:
+                    break
+                line = line.decode("utf-8").rstrip("\r\n")
+                if line == "":
+                    self.finish(fields, now_ms())
+                    fields = {}
+                elif line.startswith(": sent="):
+                    fields["sent"] = int(line[7:])
+                elif ":" in line and not line.startswith(":"):
+                    name, value = line.split(":", 1)
+                    fields[name] = value[1:] if value.startswith(" ") else value
+            conn.close()
+        except OSError as error:
+            self.error = str(error)
+
+    def finish(self, fields, received):
+        event = fields.get("event", "message")
+        if event == "busy":
+            self.busy = True
+            return
+        if "data" not in fields or "sent" not in fields:
+            return
+        try:
+            data = json.loads(fields["data"])
+        except ValueError:
+            self.error = "JSON inválido en el marco %s" % fields.get("id")
+            return
+        self.frames.append((event, int(fields.get("id", 0)), data.get("timestamp"), fields["sent"], received))
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def report(label, values):
+    if values:
+        print("  %-22s p50 %7.1f  p95 %7.1f  máx %7.1f ms" %
+              (label, percentile(values, 0.5), percentile(values, 0.95), max(values)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Latencia de /events (SSE)")
+    parser.add_argument("host", help="IP o nombre del ESP32")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--seconds", type=float, default=30.0, help="Duración de la medición")
+    parser.add_argument("--clients", type=int, default=1, help="Conexiones simultáneas")
+    args = parser.parse_args()
+
+    rtt = measure_rtt(args.host, args.port, 10)
+    floor = rtt / 2.0 if rtt is not None else 0.0
+
+    streams = [Stream(args.host, args.port, args.seconds) for _ in range(args.clients)]
+    for stream in streams:
+        stream.start()
+        time.sleep(0.05)
+    for stream in streams:
+        stream.join()
+
+    frames = [frame for stream in streams for frame in stream.frames]
+    if not frames:
+        print("Sin marcos recibidos", file=sys.stderr)
+        for stream in streams:
+            if stream.error:
+                print("  " + stream.error, file=sys.stderr)
+        return 1
+
+    # recepción - sent = desfase + red; el marco más rápido tuvo la red mínima
+    offset = min(received - sent for _, _, _, sent, received in frames) - floor
+
+    print("RTT mínimo: %s" % ("%.1f ms" % rtt if rtt is not None else "sin /api/v1/alert (red mínima = 0)"))
+    for index, stream in enumerate(streams):
+        readings = [frame for frame in stream.frames if frame[0] == "readings"]
+        alerts = [frame for frame in stream.frames if frame[0] == "alert"]
+        ids = [frame[1] for frame in readings]
+        skipped = sum(b - a - 1 for a, b in zip(ids, ids[1:]) if b > a + 1)
+        state = "RECHAZADO (busy)" if stream.busy else (stream.error or "ok")
+        print("Cliente %d: %s, %d lecturas, %d alertas, %d ciclos coalescidos" %
+              (index + 1, state, len(readings), len(alerts), skipped))
+
+    for event in ("readings", "alert"):
+        selected = [frame for frame in frames if frame[0] == event and frame[2] is not None]
+        if not selected:
+            continue
+        device = [sent - sample for _, _, sample, sent, _ in selected]
+        network = [received - sent - offset for _, _, _, sent, received in selected]
+        total = [d + n for d, n in zip(device, network)]
+        print("%s (%d marcos):" % (event, len(selected)))
+        report("muestra → envío", device)
+        report("envío → cliente (est.)", network)
+        report("muestra → cliente", total)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
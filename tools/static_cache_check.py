@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Bytes transferidos y tiempo hasta el primer byte de los archivos web
+
+Por cada ruta hace tres pedidos (conexión nueva cada uno, como el navegador
+tras un rato sin tráfico):
+    plano   sin Accept-Encoding ni validadores (lo que enviaba serveStatic)
+    gzip    Accept-Encoding: gzip (primera carga de un navegador)
+    304     gzip + If-None-Match con la ETag recibida (recarga)
+Los bytes son los del socket (encabezados + cuerpo); el TTFB va desde el
+envío del pedido hasta el primer byte de la respuesta. Mediana de N rondas.
+
+Uso:
+    python tools/static_cache_check.py <ip> [--rounds 10] [rutas...]
+"""
+
+import argparse
+import socket
+import statistics
+import time
+
+DEFAULT_PATHS = ["/", "/style.css", "/telemetry.js", "/favicon.png"]
+
+
+def fetch(host, port, path, headers):
+    """Un pedido HTTP/1.1 crudo: (estado, encabezados, bytes, ttfb ms, total ms)"""
+    request = "GET %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n" % (path, host)
+    for name, value in headers.items():
+        request += "%s: %s\r\n" % (name, value)
+    request += "\r\n"
+
+    sock = socket.create_connection((host, port), timeout=10)
+    start = time.monotonic()
+    sock.sendall(request.encode())
+    chunks = []
+    ttfb = None
+    while True:
+        data = sock.recv(4096)
+        if not data:
+            break
+        if ttfb is None:
+            ttfb = (time.monotonic() - start) * 1000.0
+        chunks.append(data)
+    total = (time.monotonic() - start) * 1000.0
+    sock.close()
+
+    raw = b"".join(chunks)
+    head = raw.split(b"\r\n\r\n", 1)[0].decode("latin-1").split("\r\n")
+    status = int(head[0].split()[1]) if head and len(head[0].split()) > 1 else 0
+    fields = {}
+    for line in head[1:]:
+        if ":" in line:
+            name, value = line.split(":", 1)
+            fields[name.strip().lower()] = value.strip()
+    return status, fields, len(raw), ttfb or total, total
+
+
+def measure(host, port, path, rounds):
+    results = {}
+    etag = None
+    for mode in ("plano", "gzip", "304"):
+        samples = []
+        status = None
+        for _ in range(rounds):
+            headers = {}
+            if mode != "plano":
+                headers["Accept-Encoding"] = "gzip"
+            if mode == "304" and etag:
+                headers["If-None-Match"] = etag
+            status, fields, size, ttfb, total = fetch(host, port, path, headers)
+            if mode == "gzip":
+                etag = fields.get("etag")
+            samples.append((size, ttfb, total))
+        results[mode] = (status,
+                         statistics.median(s[0] for s in samples),
+                         statistics.median(s[1] for s in samples),
+                         statistics.median(s[2] for s in samples))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host")
+    parser.add_argument("paths", nargs="*", default=DEFAULT_PATHS)
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--rounds", type=int, default=10)
+    args = parser.parse_args()
+
+    print("%-16s %-6s %6s %9s %10s %10s" % ("ruta", "modo", "estado", "bytes", "ttfb ms", "total ms"))
+    totals = {"plano": 0, "gzip": 0, "304": 0}
+    for path in args.paths:
+        for mode, (status, size, ttfb, total) in measure(args.host, args.port, path, args.rounds).items():
+            totals[mode] += size
+            print("%-16s %-6s %6s %9d %10.1f %10.1f" % (path, mode, status, size, ttfb, total))
+    print("bytes totales: plano %d, gzip %d, 304 %d" % (totals["plano"], totals["gzip"], totals["304"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+#!/usr/bin/env node
+/*
+ * Verifica data/telemetry.js con cuadros reales del firmware
+ *
+ * Vectores: una línea por cuadro, en el orden en que los recibió un cliente
+ *   <cuadro hex> <ciclo> <timestamp> <estados> <alerta> <alerta evaluada>
+ *   <11 campos en punto fijo> <11 valores físicos (nan = no válido)>
+ * (los escribe la suite test_telemetry_bandwidth; campos en el orden de TelemetryField)
+ *
+ * Cada cuadro debe decodificarse a la muestra exacta del firmware y cada
+ * valor físico debe quedar a medio paso de cuantización del original
+ * (la escala y el offset de FIELDS son los de TelemetrySocket::toSample)
+ * También se pierde un delta a propósito: el decodificador debe devolver
+ * null hasta el próximo cuadro clave y contar un hueco
+ *
+ * Uso:
+ *   node tools/telemetry_js_check.js <vectores>
+ */
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+const { TelemetryDecoder } = require(path.join(__dirname, '..', 'data', 'telemetry.js'));
+
+// Mismo orden que TelemetryField: nombre en la muestra, escala
+const FIELDS = [
+    ['temperature', 100], ['humidity', 100], ['pressure', 10],
+    ['smokePpm', 1], ['smokeRaw', 1], ['ch4Ppm', 1], ['ch4Lel', 100], ['ch4Raw', 1],
+    ['fireProbability', 1000], ['tempRate', 100], ['pressureRate', 100]
+];
+const INVALID = -32768;
+const SATURATED = [32767, -32767];
+
+function parse(line) {
+    const parts = line.trim().split(/\s+/);
+    const bytes = Buffer.from(parts[0], 'hex');
+    const n = FIELDS.length;
+    return {
+        buffer: bytes.buffer.slice(bytes.byteOffset, bytes.byteOffset + bytes.length),
+        keyframe: bytes[0] === 0x4B,
+        cycle: Number(parts[1]),
+        timestamp: Number(parts[2]),
+        state: Number(parts[3]),
+        alert: parts[4],
+        rawAlert: parts[5],
+        fixed: parts.slice(6, 6 + n).map(Number),
+        physical: parts.slice(6 + n, 6 + 2 * n).map(parseFloat)
+    };
+}
+
+/**
+ * Diferencias entre la muestra decodificada y la esperada
+ * @return Lista de descripciones (vacía = igual)
+ */
+function compare(sample, decoder, vector) {
+    const errors = [];
+    for (const key of ['cycle', 'timestamp', 'state', 'alert', 'rawAlert']) {
+        if (sample[key] !== vector[key]) {
+            errors.push(key + ' ' + sample[key] + ' != ' + vector[key]);
+        }
+    }
+    FIELDS.forEach(function(field, i) {
+        const name = field[0];
+        const fixed = vector.fixed[i];
+        if (decoder.values[i] !== fixed) {
+            errors.push(name + ' (punto fijo) ' + decoder.values[i] + ' != ' + fixed);
+        } else if (fixed === INVALID) {
+            if (sample[name] !== null) {
+                errors.push(name + ' ' + sample[name] + ' != null');
+            }
+        } else if (!SATURATED.includes(fixed)) {
+            const tolerance = 0.5 / field[1] * 1.001 + 1e-6;
+            if (!(Math.abs(sample[name] - vector.physical[i]) <= tolerance)) {
+                errors.push(name + ' ' + sample[name] + ' != ' + vector.physical[i]);
+            }
+        }
+    });
+    return errors;
+}
+
+function main() {
+    if (process.argv.length < 3) {
+        console.error('Uso: node tools/telemetry_js_check.js <vectores>');
+        process.exit(2);
+    }
+
+    const vectors = fs.readFileSync(process.argv[2], 'utf8')
+        .split('\n').filter(function(line) { return line.trim().length > 0; }).map(parse);
+    let failures = 0;
+
+    // Todos los cuadros en orden (cada cliente nuevo empieza con un cuadro clave)
+    const decoder = new TelemetryDecoder();
+    vectors.forEach(function(vector, index) {
+        const sample = decoder.decode(vector.buffer);
+        const errors = sample ? compare(sample, decoder, vector) : ['cuadro rechazado'];
+        if (errors.length > 0) {
+            failures++;
+            if (failures <= 10) {
+                console.log('❌ cuadro ' + index + ': ' + errors.join(', '));
+            }
+        }
+    });
+
+    // Delta perdido: null hasta el siguiente cuadro clave, un hueco
+    const lost = vectors.findIndex(function(vector, index) {
+        return index > 0 && !vector.keyframe && vectors[index - 1].keyframe;
+    });
+    let resynced = false;
+    if (lost > 0) {
+        const gapDecoder = new TelemetryDecoder();
+        for (let i = 0; i < lost; i++) {
+            gapDecoder.decode(vectors[i].buffer);
+        }
+        let i = lost + 1;
+        while (i < vectors.length && !vectors[i].keyframe) {
+            if (gapDecoder.decode(vectors[i].buffer) !== null) {
+                break;
+            }
+            i++;
+        }
+        resynced = i < vectors.length && vectors[i].keyframe && gapDecoder.gaps === 1 &&
+                   compare(gapDecoder.decode(vectors[i].buffer), gapDecoder, vectors[i]).length === 0;
+        if (!resynced) {
+            failures++;
+            console.log('❌ delta perdido en el cuadro ' + lost + ': no resincroniza con el cuadro clave');
+        }
+    }
+
+    const keyframes = vectors.filter(function(vector) { return vector.keyframe; }).length;
+    console.log('data/telemetry.js: ' + vectors.length + ' cuadros (' + keyframes + ' clave), ' +
+                failures + ' errores' + (resynced ? ', resincroniza tras un delta perdido' : ''));
+    process.exit(failures === 0 && vectors.length > 0 ? 0 : 1);
+}
+
+main();
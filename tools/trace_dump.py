@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Decodifica trazas de sensores (/trace.bin, /trace.old.bin) a CSV
+
+Formato: ver src/trace/TraceFormat.h. Una fila por registro:
+    time_ms,type,ch0..chN,aht_humidity,aht_temperature,bmp_temperature,bmp_pressure,alert
+Los barridos ADC van en la escala del encabezado; las lecturas I2C se
+convierten a unidades físicas con las fórmulas de los sensores (la
+compensación del BMP280 usa la calibración guardada en el encabezado).
+Los cambios de nivel publicados en vivo van como "DESDE>HACIA" en la columna alert.
+
+Uso:
+    curl -o trace.bin http://<ip>/trace
+    python tools/trace_dump.py trace.bin > trace.csv
+    python tools/trace_dump.py trace.bin --summary
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x43525446
+VERSION = 2
+HEADER_SIZE = 40
+
+ADC_ABSOLUTE = 1
+ADC_DELTA = 2
+ENVIRONMENT = 3
+ALERT = 4
+
+LEVELS = ["NORMAL", "COOKING", "ANOMALY", "CAUTION", "WARNING",
+          "FIRE_SUSPECTED", "FIRE_CONFIRMED", "GAS_CRITICAL", "EXPLOSIVE"]
+
+AHT_FRESH = 0x01
+BMP_FRESH = 0x02
+
+
+def read_header(data):
+    if len(data) < HEADER_SIZE:
+        raise ValueError("archivo demasiado corto")
+    magic, version, channels, scan_bits, _, rate, _, start = struct.unpack_from("<IBBBBHHI", data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("no es una traza de versión %d" % VERSION)
+    calib = struct.unpack_from("<HhhHhhhhhhhh", data, 16)
+    return {"channels": channels, "scan_bits": scan_bits, "rate": rate, "start": start, "calib": calib}
+
+
+def records(data):
+    """Genera (tipo, tiempo, valores) hasta el final o un registro truncado"""
+    pos = HEADER_SIZE
+    last_time = None
+    last_values = None
+    while pos < len(data):
+        tag = data[pos]
+        pos += 1
+        if tag == ADC_ABSOLUTE:
+            if pos + 5 > len(data):
+                return
+            time_ms, count = struct.unpack_from("<IB", data, pos)
+            if pos + 5 + 2 * count > len(data):
+                return
+            values = list(struct.unpack_from("<%dH" % count, data, pos + 5))
+            pos += 5 + 2 * count
+            last_time, last_values = time_ms, values
+            yield ADC_ABSOLUTE, time_ms, values
+        elif tag == ADC_DELTA:
+            if last_values is None or pos + 1 + len(last_values) > len(data):
+                return
+            dt = data[pos]
+            deltas = struct.unpack_from("<%db" % len(last_values), data, pos + 1)
+            pos += 1 + len(last_values)
+            last_time = (last_time + dt) & 0xFFFFFFFF
+            last_values = [(v + d) & 0xFFFF for v, d in zip(last_values, deltas)]
+            yield ADC_DELTA, last_time, last_values
+        elif tag == ENVIRONMENT:
+            if pos + 21 > len(data):
+                return
+            time_ms, flags, aht_h, aht_t, bmp_t, bmp_p = struct.unpack_from("<IBIIii", data, pos)
+            pos += 21
+            yield ENVIRONMENT, time_ms, (flags, aht_h, aht_t, bmp_t, bmp_p)
+        elif tag == ALERT:
+            if pos + 11 > len(data):
+                return
+            time_ms, level_from, level_to, raw, features = struct.unpack_from("<IBBBI", data, pos)
+            pos += 11
+            yield ALERT, time_ms, (level_from, level_to, raw, features)
+        else:
+            print("⚠ registro desconocido 0x%02X en el byte %d" % (tag, pos - 1), file=sys.stderr)
+            return
+
+
+def level_name(level):
+    return LEVELS[level] if level < len(LEVELS) else str(level)
+
+
+def aht20(raw_h, raw_t):
+    return raw_h * 100.0 / (1 << 20), raw_t * 200.0 / (1 << 20) - 50.0
+
+
+def bmp280(calib, adc_t, adc_p):
+    """Compensación en coma flotante del datasheet (°C, hPa)"""
+    t1, t2, t3, p1, p2, p3, p4, p5, p6, p7, p8, p9 = calib
+    v1 = (adc_t / 16384.0 - t1 / 1024.0) * t2
+    v2 = ((adc_t / 131072.0 - t1 / 8192.0) ** 2) * t3
+    t_fine = v1 + v2
+    temperature = t_fine / 5120.0
+
+    v1 = t_fine / 2.0 - 64000.0
+    v2 = v1 * v1 * p6 / 32768.0 + v1 * p5 * 2.0
+    v2 = v2 / 4.0 + p4 * 65536.0
+    v1 = (p3 * v1 * v1 / 524288.0 + p2 * v1) / 524288.0
+    v1 = (1.0 + v1 / 32768.0) * p1
+    if v1 == 0:
+        return temperature, None
+    p = 1048576.0 - adc_p
+    p = (p - v2 / 4096.0) * 6250.0 / v1
+    v1 = p9 * p * p / 2147483648.0
+    v2 = p * p8 / 32768.0
+    return temperature, (p + (v1 + v2 + p7) / 16.0) / 100.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodifica trazas de sensores a CSV")
+    parser.add_argument("trace", help="archivo de traza (trace.bin)")
+    parser.add_argument("--summary", action="store_true", help="solo mostrar un resumen")
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+
+    try:
+        header = read_header(data)
+    except ValueError as error:
+        sys.exit("❌ %s: %s" % (args.trace, error))
+
+    channels = header["channels"]
+    counts = {ADC_ABSOLUTE: 0, ADC_DELTA: 0, ENVIRONMENT: 0, ALERT: 0}
+    first = last = None
+    out = None
+
+    if not args.summary:
+        out = sys.stdout
+        columns = ["time_ms", "type"] + ["ch%d" % i for i in range(channels)]
+        columns += ["aht_humidity", "aht_temperature", "bmp_temperature", "bmp_pressure", "alert"]
+        out.write(",".join(columns) + "\n")
+
+    for kind, time_ms, values in records(data):
+        counts[kind] += 1
+        first = time_ms if first is None else first
+        last = time_ms
+        if out is None:
+            continue
+
+        relative = (time_ms - header["start"]) & 0xFFFFFFFF
+        if kind == ALERT:
+            level_from, level_to = values[0], values[1]
+            row = [""] * (channels + 4) + ["%s>%s" % (level_name(level_from), level_name(level_to))]
+            out.write("%d,alert,%s\n" % (relative, ",".join(row)))
+        elif kind == ENVIRONMENT:
+            flags, aht_h, aht_t, bmp_t, bmp_p = values
+            row = [""] * channels
+            if flags & AHT_FRESH:
+                humidity, temperature = aht20(aht_h, aht_t)
+                row += ["%.2f" % humidity, "%.2f" % temperature]
+            else:
+                row += ["", ""]
+            if flags & BMP_FRESH:
+                temperature, pressure = bmp280(header["calib"], bmp_t, bmp_p)
+                row += ["%.2f" % temperature, "%.2f" % pressure if pressure is not None else ""]
+            else:
+                row += ["", ""]
+            out.write("%d,env,%s,\n" % (relative, ",".join(row)))
+        else:
+            row = [str(v) for v in values] + [""] * (channels - len(values)) + [""] * 5
+            out.write("%d,adc,%s\n" % (relative, ",".join(row)))
+
+    scans = counts[ADC_ABSOLUTE] + counts[ADC_DELTA]
+    duration = ((last - first) & 0xFFFFFFFF) / 1000.0 if first is not None else 0.0
+    print("%s: %d canales @ %d Hz (%d bits), %.0f s, %d barridos (%d absolutos), "
+          "%d lecturas I2C, %d cambios de nivel, %.2f bytes/barrido"
+          % (args.trace, channels, header["rate"], header["scan_bits"], duration, scans,
+             counts[ADC_ABSOLUTE], counts[ENVIRONMENT], counts[ALERT], (len(data) - HEADER_SIZE) / max(scans, 1)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
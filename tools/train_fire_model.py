@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+"""
+Entrenamiento del modelo de probabilidad de incendio (regresión logística)
+
+Lee trazas CSV con una fila por muestra:
+    temp_delta,temp_rate,humidity_delta,pressure_delta,smoke_pct,ch4_pct,fire
+(fire = 1 si la muestra pertenece a un incendio, 0 si no)
+
+Ajusta los coeficientes (IRLS con regularización L2 sobre variables
+estandarizadas), los lleva a unidades nativas y genera el encabezado de
+punto fijo que compila el firmware (src/alert/FireModelWeights.h).
+
+Uso:
+    python tools/train_fire_model.py trazas/*.csv -o src/alert/FireModelWeights.h
+    python tools/train_fire_model.py --synthetic 20000 -o src/alert/FireModelWeights.h
+
+--synthetic genera escenarios simulados (reposo, cocina, fuga de gas,
+calor ambiente, incendio lento y con llama) para tener pesos iniciales
+mientras no haya trazas reales. Sin dependencias fuera de la biblioteca estándar.
+"""
+
+import argparse
+import csv
+import math
+import random
+import sys
+
+FEATURES = ["temp_delta", "temp_rate", "humidity_delta", "pressure_delta", "smoke_pct", "ch4_pct"]
+LABEL = "fire"
+
+# Rango de cada variable en el dispositivo (se recorta antes de evaluar)
+LIMITS = [60.0, 30.0, 100.0, 30.0, 100.0, 100.0]
+
+INPUT_SHIFT = 4        # Variables en Q4
+WEIGHT_SHIFT = 12      # Pesos en Q12 -> producto y logit en Q16
+LOGIT_SHIFT = INPUT_SHIFT + WEIGHT_SHIFT
+
+
+def load_csv(paths):
+    rows = []
+    for path in paths:
+        with open(path, newline="") as handle:
+            reader = csv.DictReader(handle)
+            missing = [name for name in FEATURES + [LABEL] if name not in reader.fieldnames]
+            if missing:
+                sys.exit("%s: faltan columnas %s" % (path, ", ".join(missing)))
+            for record in reader:
+                x = [float(record[name]) for name in FEATURES]
+                rows.append((x, 1.0 if float(record[LABEL]) >= 0.5 else 0.0))
+    return rows
+
+
+def synthetic(count, seed):
+    rng = random.Random(seed)
+    g = rng.gauss
+    u = rng.uniform
+
+    # (peso, etiqueta, generador)
+    scenarios = [
+        (0.40, 0, lambda: [g(0, 1.5), g(0, 0.5), g(0, 5), g(0, 0.8), u(0, 8), u(0, 8)]),          # reposo
+        (0.15, 0, lambda: [g(3, 2), g(1, 1), g(15, 8), g(0, 0.8), u(10, 50), u(0, 10)]),         # cocina/vapor
+        (0.10, 0, lambda: [g(0, 1.5), g(0, 0.5), g(0, 5), g(0, 0.8), u(0, 10), u(20, 90)]),      # fuga de gas
+        (0.10, 0, lambda: [g(8, 3), g(0.5, 0.5), g(-10, 5), g(0, 0.8), u(0, 8), u(0, 8)]),       # calor ambiente
+        (0.10, 1, lambda: [g(6, 3), g(2, 1), g(-8, 5), g(-1, 1), u(25, 80), u(0, 15)]),          # incendio lento
+        (0.15, 1, lambda: [g(20, 8), g(8, 4), g(-20, 8), g(-4, 2), u(15, 90), u(0, 20)]),        # incendio con llama
+    ]
+
+    rows = []
+    for _ in range(count):
+        pick = rng.random()
+        for weight, label, make in scenarios:
+            pick -= weight
+            if pick <= 0:
+                break
+        x = [max(-limit, min(limit, value)) for value, limit in zip(make(), LIMITS)]
+        if rng.random() < 0.02:
+            label = 1 - label   # Ruido de etiquetado
+        rows.append((x, float(label)))
+    return rows
+
+
+def solve(matrix, vector):
+    """Eliminación gaussiana con pivoteo parcial"""
+    n = len(vector)
+    a = [row[:] + [vector[i]] for i, row in enumerate(matrix)]
+    for col in range(n):
+        pivot = max(range(col, n), key=lambda r: abs(a[r][col]))
+        a[col], a[pivot] = a[pivot], a[col]
+        for r in range(col + 1, n):
+            factor = a[r][col] / a[col][col]
+            for c in range(col, n + 1):
+                a[r][c] -= factor * a[col][c]
+    result = [0.0] * n
+    for r in range(n - 1, -1, -1):
+        result[r] = (a[r][n] - sum(a[r][c] * result[c] for c in range(r + 1, n))) / a[r][r]
+    return result
+
+
+def sigmoid(z):
+    return 1.0 / (1.0 + math.exp(-max(-30.0, min(30.0, z))))
+
+
+def train(rows, l2, iterations):
+    d = len(FEATURES)
+    means = [sum(x[i] for x, _ in rows) / len(rows) for i in range(d)]
+    stds = [math.sqrt(sum((x[i] - means[i]) ** 2 for x, _ in rows) / len(rows)) or 1.0 for i in range(d)]
+    data = [([1.0] + [(x[i] - means[i]) / stds[i] for i in range(d)], y) for x, y in rows]
+
+    w = [0.0] * (d + 1)
+    for _ in range(iterations):
+        hessian = [[0.0] * (d + 1) for _ in range(d + 1)]
+        gradient = [0.0] * (d + 1)
+        for z, y in data:
+            p = sigmoid(sum(wi * zi for wi, zi in zip(w, z)))
+            s = p * (1 - p)
+            for i in range(d + 1):
+                gradient[i] += (p - y) * z[i]
+                for j in range(i, d + 1):
+                    hessian[i][j] += s * z[i] * z[j]
+        for i in range(d + 1):
+            for j in range(i):
+                hessian[i][j] = hessian[j][i]
+            if i > 0:
+                hessian[i][i] += l2
+                gradient[i] += l2 * w[i]
+        step = solve(hessian, gradient)
+        w = [wi - si for wi, si in zip(w, step)]
+        if max(abs(si) for si in step) < 1e-6:
+            break
+
+    # Volver a unidades nativas: logit = bias + sum(weight * x)
+    weights = [w[i + 1] / stds[i] for i in range(d)]
+    bias = w[0] - sum(weights[i] * means[i] for i in range(d))
+    return bias, weights
+
+
+def quantize(bias, weights):
+    q_weights = [int(round(wi * (1 << WEIGHT_SHIFT))) for wi in weights]
+    q_bias = int(round(bias * (1 << LOGIT_SHIFT)))
+    worst = abs(q_bias) + sum(abs(q) * int(limit * (1 << INPUT_SHIFT)) for q, limit in zip(q_weights, LIMITS))
+    if worst >= 2 ** 31:
+        sys.exit("Los pesos desbordan int32 (peor caso %d); revisar LIMITS o regularizar más" % worst)
+    return q_bias, q_weights
+
+
+def to_fixed(value):
+    """Igual que FireModel::toFixed (redondeo alejándose de cero)"""
+    scaled = value * (1 << INPUT_SHIFT)
+    return int(scaled + 0.5) if scaled >= 0 else -int(-scaled + 0.5)
+
+
+def evaluate(rows, q_bias, q_weights):
+    loss = 0.0
+    correct = 0
+    for x, y in rows:
+        acc = q_bias
+        for value, limit, q in zip(x, LIMITS, q_weights):
+            clamped = max(-limit, min(limit, value))
+            acc += q * to_fixed(clamped)
+        p = sigmoid(acc / float(1 << LOGIT_SHIFT))
+        p = min(max(p, 1e-6), 1 - 1e-6)
+        loss -= y * math.log(p) + (1 - y) * math.log(1 - p)
+        correct += (p >= 0.5) == (y >= 0.5)
+    return loss / len(rows), correct / float(len(rows))
+
+
+def emit(path, source, rows, bias, weights, q_bias, q_weights, loss, accuracy):
+    positives = int(sum(y for _, y in rows))
+    lines = [
+        "/*",
+        "Pesos del modelo de probabilidad de incendio (generado, no editar)",
+        "",
+        "Generado por tools/train_fire_model.py",
+        "Datos: %s" % source,
+        "Muestras: %d (%d incendio)" % (len(rows), positives),
+        "Entrenamiento: log-loss %.4f, exactitud %.1f%% (punto fijo)" % (loss, accuracy * 100),
+        "logit = bias + sum(peso * variable), variables recortadas a +-LIMITS",
+        "*/",
+        "#ifndef FIREMODELWEIGHTS_H",
+        "#define FIREMODELWEIGHTS_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define FIRE_MODEL_FEATURES %d" % len(FEATURES),
+        "#define FIRE_MODEL_INPUT_SHIFT %d      // Variables en Q%d" % (INPUT_SHIFT, INPUT_SHIFT),
+        "#define FIRE_MODEL_WEIGHT_SHIFT %d    // Pesos en Q%d (logit en Q%d)" % (WEIGHT_SHIFT, WEIGHT_SHIFT, LOGIT_SHIFT),
+        "",
+        "// Orden: %s" % ", ".join(FEATURES),
+        "constexpr float FIRE_MODEL_LIMITS[FIRE_MODEL_FEATURES] = { %s };" % ", ".join("%.1ff" % v for v in LIMITS),
+        "",
+        "constexpr int32_t FIRE_MODEL_BIAS = %d;   // %.4f" % (q_bias, bias),
+        "constexpr int32_t FIRE_MODEL_WEIGHTS[FIRE_MODEL_FEATURES] = {",
+    ]
+    for name, q, w in zip(FEATURES, q_weights, weights):
+        lines.append("    %8d,     // %-15s %.5f" % (q, name, w))
+    lines += ["};", "", "#endif // FIREMODELWEIGHTS_H", ""]
+    with open(path, "w") as handle:
+        handle.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Entrena el modelo de probabilidad de incendio")
+    parser.add_argument("csv", nargs="*", help="Trazas CSV etiquetadas")
+    parser.add_argument("-o", "--output", default="src/alert/FireModelWeights.h")
+    parser.add_argument("--synthetic", type=int, default=0, help="Generar N muestras simuladas")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--l2", type=float, default=1.0, help="Regularización L2")
+    parser.add_argument("--iterations", type=int, default=25)
+    args = parser.parse_args()
+
+    if args.synthetic > 0:
+        rows = synthetic(args.synthetic, args.seed)
+        source = "escenarios simulados (--synthetic %d --seed %d)" % (args.synthetic, args.seed)
+    elif args.csv:
+        rows = load_csv(args.csv)
+        source = ", ".join(args.csv)
+    else:
+        parser.error("indicar trazas CSV o --synthetic N")
+
+    if not rows:
+        sys.exit("Sin muestras")
+
+    bias, weights = train(rows, args.l2, args.iterations)
+    q_bias, q_weights = quantize(bias, weights)
+    loss, accuracy = evaluate(rows, q_bias, q_weights)
+    emit(args.output, source, rows, bias, weights, q_bias, q_weights, loss, accuracy)
+    print("%s: %d muestras, log-loss %.4f, exactitud %.1f%%" % (args.output, len(rows), loss, accuracy * 100))
+
+
+if __name__ == "__main__":
+    main()